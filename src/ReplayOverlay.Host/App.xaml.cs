@@ -85,6 +85,13 @@ public partial class App : System.Windows.Application
         _tray.SettingsClicked += OnSettingsClicked;
         _tray.OpenLibraryClicked += _ => OpenLibrary();
         _tray.RestartClicked += OnRestart;
+        _tray.OverlayMetricsClicked += () => _ipc.SendGetOverlayMetrics();
+        _tray.OverlayTraceToggled += recording =>
+        {
+            // Stopping writes the buffered trace to a file on the overlay side
+            _ipc.SendSetTracing(recording);
+            if (!recording) _ipc.SendFlushTrace();
+        };
         _tray.ExitClicked += () => Shutdown();
 
         // --- Register hotkeys (after tray so balloon notifications work) ---
@@ -808,6 +815,15 @@ public partial class App : System.Windows.Application
                 }
                 break;
 
+            // --- Diagnostics ---
+            case "overlay_metrics":
+                LogToFile($"Overlay metrics: {msg.Payload}");
+                break;
+
+            case "trace_flushed":
+                LogToFile($"Overlay trace written: {msg.Payload}");
+                break;
+
             default:
                 Debug.WriteLine($"Unknown overlay message: {msg.Type}");
                 break;
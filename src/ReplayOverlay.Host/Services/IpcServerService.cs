@@ -177,6 +177,9 @@ public class IpcServerService : IDisposable
     public bool SendShowOverlay() => SendMessage(IpcMessage.Create("show_overlay"));
     public bool SendHideOverlay() => SendMessage(IpcMessage.Create("hide_overlay"));
     public bool SendShutdown() => SendMessage(IpcMessage.Create("shutdown"));
+    public bool SendGetOverlayMetrics() => SendMessage(IpcMessage.Create("get_overlay_metrics"));
+    public bool SendSetTracing(bool enabled) => SendMessage(IpcMessage.Create("set_tracing", new { enabled }));
+    public bool SendFlushTrace() => SendMessage(IpcMessage.Create("flush_trace"));
 
     public bool SendNotification(string text, string color, double duration)
     {
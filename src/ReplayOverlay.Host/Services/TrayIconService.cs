@@ -18,6 +18,8 @@ public class TrayIconService : IDisposable
     public event Action? SettingsClicked;
     public event Action<string>? OpenLibraryClicked;
     public event Action? RestartClicked;
+    public event Action? OverlayMetricsClicked;
+    public event Action<bool>? OverlayTraceToggled;
     public event Action? ExitClicked;
 
     public void Initialize()
@@ -33,6 +35,12 @@ public class TrayIconService : IDisposable
         _menu.Items.Add("Open Library", null, (_, _) => OpenLibraryClicked?.Invoke(""));
         _menu.Items.Add(new ToolStripSeparator());
         _menu.Items.Add("Restart", null, (_, _) => RestartClicked?.Invoke());
+#if DEBUG
+        _menu.Items.Add("Dump Overlay Metrics", null, (_, _) => OverlayMetricsClicked?.Invoke());
+        var traceItem = new ToolStripMenuItem("Record Overlay Trace") { CheckOnClick = true };
+        traceItem.CheckedChanged += (_, _) => OverlayTraceToggled?.Invoke(traceItem.Checked);
+        _menu.Items.Add(traceItem);
+#endif
         _menu.Items.Add("Exit", null, (_, _) => ExitClicked?.Invoke());
 
         _icon = new NotifyIcon
@@ -0,0 +1,245 @@
+#include "Base64.h"
+#include <cstdint>
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
+#define BASE64_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define BASE64_TARGET(isa)
+#else
+#define BASE64_TARGET(isa) __attribute__((target(isa)))
+#endif
+#endif
+
+namespace
+{
+    constexpr unsigned char Invalid = 0xFF;
+
+    struct DecodeTable
+    {
+        unsigned char value[256];
+
+        constexpr DecodeTable() : value()
+        {
+            constexpr char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+            for (int c = 0; c < 256; c++)
+                value[c] = Invalid;
+            for (int i = 0; i < 64; i++)
+                value[static_cast<unsigned char>(alphabet[i])] = static_cast<unsigned char>(i);
+        }
+    };
+    constexpr DecodeTable Table;
+
+    // Full groups of four characters from in[i] up to 'end'; false at the
+    // first character outside the alphabet
+    bool DecodeGroups(const unsigned char* in, size_t& i, size_t end, unsigned char*& out)
+    {
+        for (; i + 4 <= end; i += 4)
+        {
+            const uint32_t a = Table.value[in[i]], b = Table.value[in[i + 1]];
+            const uint32_t c = Table.value[in[i + 2]], d = Table.value[in[i + 3]];
+            if ((a | b | c | d) & 0x80) return false;
+            const uint32_t v = (a << 18) | (b << 12) | (c << 6) | d;
+            out[0] = static_cast<unsigned char>(v >> 16);
+            out[1] = static_cast<unsigned char>(v >> 8);
+            out[2] = static_cast<unsigned char>(v);
+            out += 3;
+        }
+        return true;
+    }
+
+    // Everything after the vector loop: full groups, then the last group,
+    // which may end in one or two '=' whose bits must be zero
+    bool DecodeTail(const unsigned char* in, size_t i, size_t length, unsigned char* out, unsigned char* begin,
+                    size_t& written)
+    {
+        if (i < length)
+        {
+            if (!DecodeGroups(in, i, length - 4, out)) return false;
+
+            const unsigned char* g = in + i;
+            const int padding = g[3] != '=' ? 0 : g[2] != '=' ? 1 : 2;
+            if (g[2] == '=' && padding != 2) return false;
+            const uint32_t a = Table.value[g[0]], b = Table.value[g[1]];
+            const uint32_t c = padding == 2 ? 0 : Table.value[g[2]];
+            const uint32_t d = padding ? 0 : Table.value[g[3]];
+            if ((a | b | c | d) & 0x80) return false;
+            const uint32_t v = (a << 18) | (b << 12) | (c << 6) | d;
+            if (v & (padding == 2 ? 0xFFFFu : padding == 1 ? 0xFFu : 0u)) return false; // non-canonical
+            out[0] = static_cast<unsigned char>(v >> 16);
+            out[1] = static_cast<unsigned char>(v >> 8);
+            out[2] = static_cast<unsigned char>(v);
+            out += 3 - padding;
+        }
+        written = static_cast<size_t>(out - begin);
+        return true;
+    }
+
+#if defined(BASE64_X86)
+    // Validation and translation LUTs indexed by nibble (Klomp / Muła): a
+    // character is valid iff lut_lo[low nibble] & lut_hi[high nibble] == 0,
+    // and adding lut_roll[high nibble] ('/' shifted to index 1) maps it to
+    // its 6-bit value
+    BASE64_TARGET("ssse3")
+    bool DecodeSsse3(const unsigned char* in, size_t length, unsigned char* out, size_t& written)
+    {
+        const __m128i lutLo = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                            0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+        const __m128i lutHi = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                            0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+        const __m128i lutRoll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+        const __m128i mask2F = _mm_set1_epi8(0x2F);
+        const __m128i pack = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+        unsigned char* begin = out;
+
+        // 16 characters -> 12 bytes, stored as 16; the last group (padding)
+        // and the store overrun are left to the scalar tail
+        size_t i = 0;
+        for (; length - i >= 24; i += 16, out += 12)
+        {
+            const __m128i str = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+            const __m128i hiNibbles = _mm_and_si128(_mm_srli_epi32(str, 4), mask2F);
+            const __m128i loNibbles = _mm_and_si128(str, mask2F);
+            const __m128i hi = _mm_shuffle_epi8(lutHi, hiNibbles);
+            const __m128i lo = _mm_shuffle_epi8(lutLo, loNibbles);
+            if (_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128())))
+                break; // the scalar path finds the bad character
+            const __m128i eq2F = _mm_cmpeq_epi8(str, mask2F);
+            const __m128i roll = _mm_shuffle_epi8(lutRoll, _mm_add_epi8(eq2F, hiNibbles));
+            const __m128i values = _mm_add_epi8(str, roll);
+
+            // aaaaaa bbbbbb cccccc dddddd -> 24 bits per lane, then bytes
+            // in big-endian order
+            const __m128i ab = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+            const __m128i abcd = _mm_madd_epi16(ab, _mm_set1_epi32(0x00011000));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_shuffle_epi8(abcd, pack));
+        }
+        return DecodeTail(in, i, length, out, begin, written);
+    }
+
+    BASE64_TARGET("avx2")
+    bool DecodeAvx2(const unsigned char* in, size_t length, unsigned char* out, size_t& written)
+    {
+        const __m256i lutLo = _mm256_setr_epi8(
+            0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+            0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+        const __m256i lutHi = _mm256_setr_epi8(
+            0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+            0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+        const __m256i lutRoll = _mm256_setr_epi8(
+            0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+        const __m256i mask2F = _mm256_set1_epi8(0x2F);
+        const __m256i pack = _mm256_setr_epi8(
+            2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+            2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+        const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7);
+        unsigned char* begin = out;
+
+        // 32 characters -> 24 bytes, stored as 32
+        size_t i = 0;
+        for (; length - i >= 48; i += 32, out += 24)
+        {
+            const __m256i str = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+            const __m256i hiNibbles = _mm256_and_si256(_mm256_srli_epi32(str, 4), mask2F);
+            const __m256i loNibbles = _mm256_and_si256(str, mask2F);
+            const __m256i hi = _mm256_shuffle_epi8(lutHi, hiNibbles);
+            const __m256i lo = _mm256_shuffle_epi8(lutLo, loNibbles);
+            if (!_mm256_testz_si256(lo, hi))
+                break;
+            const __m256i eq2F = _mm256_cmpeq_epi8(str, mask2F);
+            const __m256i roll = _mm256_shuffle_epi8(lutRoll, _mm256_add_epi8(eq2F, hiNibbles));
+            const __m256i values = _mm256_add_epi8(str, roll);
+
+            const __m256i ab = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+            const __m256i abcd = _mm256_madd_epi16(ab, _mm256_set1_epi32(0x00011000));
+            // 12 bytes at the start of each lane -> 24 contiguous bytes
+            const __m256i packed = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(abcd, pack), lanes);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), packed);
+        }
+        size_t tail = 0;
+        if (!DecodeSsse3(in + i, length - i, out, tail)) return false;
+        written = static_cast<size_t>(out - begin) + tail;
+        return true;
+    }
+
+    bool CpuHas(Base64::Isa isa)
+    {
+#if defined(_MSC_VER)
+        int info[4] = {};
+        __cpuid(info, 1);
+        const bool ssse3 = (info[2] & (1 << 9)) != 0;
+        if (isa == Base64::Isa::Ssse3) return ssse3;
+        // AVX2 needs the OS to save the YMM registers (OSXSAVE + XCR0)
+        const bool osxsave = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0;
+        if (!ssse3 || !osxsave || (_xgetbv(0) & 6) != 6) return false;
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#else
+        __builtin_cpu_init();
+        return isa == Base64::Isa::Ssse3 ? __builtin_cpu_supports("ssse3") != 0 : __builtin_cpu_supports("avx2") != 0;
+#endif
+    }
+#endif
+}
+
+namespace Base64
+{
+    Isa BestIsa()
+    {
+#if defined(BASE64_X86)
+        static const Isa best = CpuHas(Isa::Avx2) ? Isa::Avx2 : CpuHas(Isa::Ssse3) ? Isa::Ssse3 : Isa::Scalar;
+        return best;
+#else
+        return Isa::Scalar;
+#endif
+    }
+
+    bool Supported(Isa isa)
+    {
+        return static_cast<int>(isa) <= static_cast<int>(BestIsa());
+    }
+
+    const char* IsaName(Isa isa)
+    {
+        switch (isa)
+        {
+        case Isa::Avx2:  return "avx2";
+        case Isa::Ssse3: return "ssse3";
+        default:         return "scalar";
+        }
+    }
+
+    bool DecodeWith(Isa isa, const char* in, size_t length, unsigned char* out, size_t& written)
+    {
+        written = 0;
+        if (length % 4) return false;
+        const auto* bytes = reinterpret_cast<const unsigned char*>(in);
+        bool ok;
+#if defined(BASE64_X86)
+        if (isa == Isa::Avx2 && Supported(Isa::Avx2))
+            ok = DecodeAvx2(bytes, length, out, written);
+        else if (isa != Isa::Scalar && Supported(Isa::Ssse3))
+            ok = DecodeSsse3(bytes, length, out, written);
+        else
+#endif
+            ok = DecodeTail(bytes, 0, length, out, out, written);
+        if (!ok) written = 0;
+        return ok;
+    }
+
+    bool Decode(const char* in, size_t length, unsigned char* out, size_t& written)
+    {
+        return DecodeWith(BestIsa(), in, length, out, written);
+    }
+
+    bool Decode(std::string_view in, std::vector<unsigned char>& out)
+    {
+        out.resize(MaxDecodedSize(in.size()));
+        size_t written = 0;
+        const bool ok = Decode(in.data(), in.size(), out.data(), written);
+        out.resize(written);
+        return ok;
+    }
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+// Strict base64 decoding (RFC 4648 standard alphabet) for preview frames,
+// which arrive as a few hundred KB of base64 PNG several times a second.
+//
+// Input must be padded to a multiple of four characters; anything outside
+// the alphabet (whitespace included), misplaced '=' or non-zero bits left
+// over in the last group rejects the whole input. Blocks of 32 (AVX2) or 16
+// (SSSE3) characters are translated and validated with pshufb lookups and
+// packed with multiply-adds; the instruction set is picked at run time. The
+// tail, and CPUs without SSSE3, go through a 256-entry table four
+// characters at a time.
+
+namespace Base64
+{
+    enum class Isa { Scalar, Ssse3, Avx2 };
+
+    // The best implementation this CPU runs; Decode() uses it
+    Isa BestIsa();
+    bool Supported(Isa isa);
+    const char* IsaName(Isa isa);
+
+    // Bytes decoded from 'length' valid characters, at most
+    constexpr size_t MaxDecodedSize(size_t length) { return length / 4 * 3; }
+
+    // Decodes into 'out', which must hold MaxDecodedSize(length) bytes.
+    // Returns false if the input is not valid base64; 'written' is then 0.
+    bool Decode(const char* in, size_t length, unsigned char* out, size_t& written);
+    bool DecodeWith(Isa isa, const char* in, size_t length, unsigned char* out, size_t& written);
+
+    // Decodes into a reused buffer: 'out' is resized to the decoded bytes
+    // (keeping its capacity) or cleared on failure
+    bool Decode(std::string_view in, std::vector<unsigned char>& out);
+}
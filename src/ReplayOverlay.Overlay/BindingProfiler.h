@@ -0,0 +1,216 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+// Counts data-model DirtyVariable() calls per variable and attributes the
+// cost of the Context::Update() that follows to the variables dirtied in
+// that frame.
+//
+// Attribution is an equal split of the frame's update time across the
+// distinct variables dirtied that frame; frames with nothing dirty are
+// accounted as idle update cost. A frame runs until EndFrame(): loop
+// iterations that skip rendering keep adding marks to it, since the next
+// Update() is the one that consumes them. Totals are kept in one-second buckets so
+// the report covers roughly the last WindowS seconds without storing
+// per-frame history.
+
+class BindingProfiler
+{
+public:
+    static constexpr int BucketCount = 10;
+    static constexpr double BucketS = 1.0;
+    static constexpr double WindowS = BucketCount * BucketS;
+
+    enum class Kind : uint8_t { Scalar, Array };
+
+    // Declare a variable as an array binding (affects reporting only)
+    void SetKind(const char* name, Kind kind)
+    {
+        m_vars[Lookup(name)].kind = kind;
+    }
+
+    // Advance to time 'now' (seconds, monotonic), once per loop iteration.
+    // Marks since the last EndFrame() stay with the open frame.
+    void BeginFrame(double now)
+    {
+        long long bucket = static_cast<long long>(now / BucketS);
+        if (m_bucketEpoch < 0 || bucket - m_bucketEpoch >= BucketCount)
+        {
+            ClearAllBuckets();
+        }
+        else
+        {
+            for (long long b = m_bucketEpoch + 1; b <= bucket; b++)
+                ClearBucket(static_cast<int>(b % BucketCount));
+        }
+        if (bucket > m_bucketEpoch) m_bucketEpoch = bucket;
+        m_bucket = static_cast<int>(m_bucketEpoch % BucketCount);
+    }
+
+    // Record one DirtyVariable() call
+    void MarkDirty(const char* name)
+    {
+        int idx = Lookup(name);
+        Var& v = m_vars[idx];
+        if (v.frameMarks++ == 0) m_frameDirty.push_back(idx);
+        v.buckets[m_bucket].marks++;
+    }
+
+    // Record the cost of the Context::Update() that consumed this frame's
+    // marks, and close the frame
+    void EndFrame(double updateMs)
+    {
+        Frame& f = m_frames[m_bucket];
+        f.frames++;
+        f.updateMs += updateMs;
+        if (updateMs > f.maxUpdateMs) f.maxUpdateMs = updateMs;
+
+        if (m_frameDirty.empty())
+        {
+            f.idleFrames++;
+            f.idleUpdateMs += updateMs;
+            return;
+        }
+
+        const double share = updateMs / static_cast<double>(m_frameDirty.size());
+        for (int idx : m_frameDirty)
+        {
+            Var& v = m_vars[idx];
+            v.buckets[m_bucket].dirtyFrames++;
+            v.buckets[m_bucket].attributedMs += share;
+            v.frameMarks = 0;
+        }
+        m_frameDirty.clear();
+    }
+
+    // Rolling report over the last WindowS seconds
+    nlohmann::json Report() const
+    {
+        Frame total;
+        for (auto& f : m_frames)
+        {
+            total.frames += f.frames;
+            total.idleFrames += f.idleFrames;
+            total.updateMs += f.updateMs;
+            total.idleUpdateMs += f.idleUpdateMs;
+            total.maxUpdateMs = std::max(total.maxUpdateMs, f.maxUpdateMs);
+        }
+
+        struct Row { const std::string* name; Kind kind; Bucket sum; };
+        std::vector<Row> rows;
+        for (auto& [name, idx] : m_index)
+        {
+            Row r{ &name, m_vars[idx].kind, {} };
+            for (auto& b : m_vars[idx].buckets)
+            {
+                r.sum.marks += b.marks;
+                r.sum.dirtyFrames += b.dirtyFrames;
+                r.sum.attributedMs += b.attributedMs;
+            }
+            if (r.sum.marks > 0) rows.push_back(r);
+        }
+        std::sort(rows.begin(), rows.end(), [](const Row& a, const Row& b) {
+            return a.sum.attributedMs > b.sum.attributedMs;
+        });
+
+        nlohmann::json bindings = nlohmann::json::array();
+        for (auto& r : rows)
+        {
+            bindings.push_back({
+                {"name", *r.name},
+                {"kind", r.kind == Kind::Array ? "array" : "scalar"},
+                {"marks", r.sum.marks},
+                {"dirty_frames", r.sum.dirtyFrames},
+                {"marks_per_frame", total.frames ? static_cast<double>(r.sum.marks) / total.frames : 0.0},
+                {"attributed_ms", r.sum.attributedMs},
+            });
+        }
+
+        return {
+            {"window_s", WindowS},
+            {"frames", total.frames},
+            {"update_ms_avg", total.frames ? total.updateMs / total.frames : 0.0},
+            {"update_ms_max", total.maxUpdateMs},
+            {"idle_frames", total.idleFrames},
+            {"idle_update_ms_avg", total.idleFrames ? total.idleUpdateMs / total.idleFrames : 0.0},
+            {"bindings", bindings},
+        };
+    }
+
+    // Human-readable version of Report() for the debug log
+    static std::string FormatReport(const nlohmann::json& r)
+    {
+        std::string out;
+        char line[192];
+        snprintf(line, sizeof(line), "binding profile (%.0fs): %d frames, update avg %.3f ms max %.3f ms, idle avg %.3f ms\n",
+                 r.value("window_s", 0.0), r.value("frames", 0),
+                 r.value("update_ms_avg", 0.0), r.value("update_ms_max", 0.0), r.value("idle_update_ms_avg", 0.0));
+        out += line;
+        for (auto& b : r["bindings"])
+        {
+            snprintf(line, sizeof(line), "  %-24s %-6s marks %6d  frames %6d  %7.3f ms\n",
+                     b.value("name", "").c_str(), b.value("kind", "").c_str(),
+                     b.value("marks", 0), b.value("dirty_frames", 0), b.value("attributed_ms", 0.0));
+            out += line;
+        }
+        return out;
+    }
+
+private:
+    struct Bucket
+    {
+        int marks = 0;
+        int dirtyFrames = 0;
+        double attributedMs = 0.0;
+    };
+
+    struct Var
+    {
+        Bucket buckets[BucketCount];
+        int frameMarks = 0;
+        Kind kind = Kind::Scalar;
+    };
+
+    struct Frame
+    {
+        int frames = 0;
+        int idleFrames = 0;
+        double updateMs = 0.0;
+        double idleUpdateMs = 0.0;
+        double maxUpdateMs = 0.0;
+    };
+
+    int Lookup(const char* name)
+    {
+        // Transparent comparator: no allocation once the name is known
+        auto it = m_index.find(name);
+        if (it != m_index.end()) return it->second;
+        int idx = static_cast<int>(m_vars.size());
+        m_vars.emplace_back();
+        m_index.emplace(name, idx);
+        return idx;
+    }
+
+    void ClearBucket(int b)
+    {
+        for (auto& v : m_vars) v.buckets[b] = Bucket{};
+        m_frames[b] = Frame{};
+    }
+
+    void ClearAllBuckets()
+    {
+        for (int b = 0; b < BucketCount; b++) ClearBucket(b);
+    }
+
+    std::map<std::string, int, std::less<>> m_index;
+    std::vector<Var> m_vars;
+    std::vector<int> m_frameDirty;
+    Frame m_frames[BucketCount];
+    long long m_bucketEpoch = -1;
+    int m_bucket = 0;
+};
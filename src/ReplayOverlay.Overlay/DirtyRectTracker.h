@@ -0,0 +1,215 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+#include "GeometryBatcher.h"
+#include "RenderCommandList.h"
+
+// Finds the part of the UI that changed between two drawn frames, so a
+// retained layer holding the last frame only needs that part redrawn.
+//
+// Each frame is replayed into the tracker (it is a RenderCommandList
+// backend) and reduced to one signature per draw: its screen bounds
+// (transformed, clipped to its scissor and the target) and a hash of
+// everything that decides its pixels - texture, scissor, transform and the
+// vertices its indices reference, so a draw whose geometry only moved
+// within the batched stream still matches. Draws are compared in order;
+// where they differ, the old and new bounds are both dirty. Draws of a
+// texture whose contents were replaced (RenderCommandList::UpdateTexture)
+// are dirty too. The result is one rectangle: the union of all of that.
+
+class DirtyRectTracker
+{
+public:
+    using Rect = GeometryBatcher::Scissor; // right / bottom exclusive
+
+    static bool Empty(const Rect& r) { return r.right <= r.left || r.bottom <= r.top; }
+    static Rect Union(const Rect& a, const Rect& b)
+    {
+        if (Empty(a)) return b;
+        if (Empty(b)) return a;
+        return { std::min(a.left, b.left), std::min(a.top, b.top),
+                 std::max(a.right, b.right), std::max(a.bottom, b.bottom) };
+    }
+    static Rect Intersect(const Rect& a, const Rect& b)
+    {
+        Rect r = { std::max(a.left, b.left), std::max(a.top, b.top),
+                   std::min(a.right, b.right), std::min(a.bottom, b.bottom) };
+        return Empty(r) ? Rect{} : r;
+    }
+    static bool Overlaps(const Rect& a, const Rect& b) { return !Empty(Intersect(a, b)); }
+    static uint64_t Area(const Rect& r)
+    {
+        return Empty(r) ? 0 : static_cast<uint64_t>(r.right - r.left) * static_cast<uint64_t>(r.bottom - r.top);
+    }
+
+    // Sets the target size; everything is dirty until the next Update()
+    void Resize(int width, int height) { SetTarget({ 0, 0, std::max(width, 0), std::max(height, 0) }); }
+
+    // Sets the target to a part of the UI's coordinate space (a surface
+    // that does not start at the origin)
+    void SetTarget(const Rect& target)
+    {
+        m_target = Empty(target) ? Rect{} : target;
+        Invalidate();
+    }
+    const Rect& Target() const { return m_target; }
+
+    // The whole target is dirty at the next Update() (e.g. the layer was lost)
+    void Invalidate() { m_pending = m_target; }
+
+    // Marks an area dirty at the next Update()
+    void AddRect(const Rect& rect) { m_pending = Union(m_pending, Intersect(rect, m_target)); }
+
+    // Diffs 'frame' against the frame of the previous Update(), which it
+    // then replaces. Returns the area to redraw (empty: none).
+    Rect Update(const RenderCommandList& frame)
+    {
+        std::swap(m_previous, m_current);
+        m_current.clear();
+        frame.Replay(*this);
+        m_vertices = nullptr;
+        m_indices = nullptr;
+
+        Rect dirty = m_pending;
+        m_pending = {};
+        const size_t common = std::min(m_previous.size(), m_current.size());
+        for (size_t i = 0; i < common; i++)
+        {
+            if (m_previous[i].hash != m_current[i].hash || m_previous[i].bounds != m_current[i].bounds)
+                dirty = Union(dirty, Union(m_previous[i].bounds, m_current[i].bounds));
+        }
+        for (size_t i = common; i < m_previous.size(); i++)
+            dirty = Union(dirty, m_previous[i].bounds);
+        for (size_t i = common; i < m_current.size(); i++)
+            dirty = Union(dirty, m_current[i].bounds);
+
+        for (const auto& c : frame.Commands())
+        {
+            if (c.op != RenderCommandList::Op::UpdateTexture) continue;
+            for (const DrawSignature& d : m_current)
+                if (d.texture == c.handle)
+                    dirty = Union(dirty, d.bounds);
+        }
+
+        m_lastDirty = Intersect(dirty, m_target);
+        return m_lastDirty;
+    }
+
+    // Screen bounds of the last Update()'s draws, in replay order; a draw
+    // that does not overlap the dirty rect need not be redrawn
+    size_t Draws() const { return m_current.size(); }
+    const Rect& DrawBounds(size_t draw) const { return m_current[draw].bounds; }
+    const Rect& LastDirty() const { return m_lastDirty; }
+
+private:
+    friend class RenderCommandList; // calls Upload() / Draw()
+
+    struct DrawSignature
+    {
+        Rect bounds;
+        uint64_t hash = 0;
+        uintptr_t texture = 0;
+    };
+
+    static uint64_t Mix(uint64_t hash, uint64_t value)
+    {
+        hash ^= value;
+        return hash * 0x100000001B3ull;
+    }
+
+    bool Upload(const BatchVertex* vertices, size_t vertexCount, const uint32_t* indices, size_t indexCount)
+    {
+        m_vertices = vertices;
+        m_vertexCount = vertexCount;
+        m_indices = indices;
+        m_indexCount = indexCount;
+        return true;
+    }
+
+    void Draw(const GeometryBatcher::Batch& batch, const float* transform)
+    {
+        uint64_t hash = 0xCBF29CE484222325ull;
+        hash = Mix(hash, batch.texture);
+        hash = Mix(hash, batch.scissorEnabled);
+        if (batch.scissorEnabled)
+        {
+            hash = Mix(hash, (static_cast<uint64_t>(static_cast<uint32_t>(batch.scissor.left)) << 32) |
+                             static_cast<uint32_t>(batch.scissor.top));
+            hash = Mix(hash, (static_cast<uint64_t>(static_cast<uint32_t>(batch.scissor.right)) << 32) |
+                             static_cast<uint32_t>(batch.scissor.bottom));
+        }
+        if (transform)
+        {
+            uint32_t bits[16];
+            std::memcpy(bits, transform, sizeof(bits));
+            for (uint32_t b : bits) hash = Mix(hash, b);
+        }
+
+        float minX = INFINITY, minY = INFINITY, maxX = -INFINITY, maxY = -INFINITY;
+        bool unbounded = false;
+        const size_t end = std::min<size_t>(static_cast<size_t>(batch.firstIndex) + batch.indexCount, m_indexCount);
+        for (size_t i = batch.firstIndex; i < end; i++)
+        {
+            const uint32_t index = m_indices[i];
+            if (index >= m_vertexCount) continue;
+            const BatchVertex& v = m_vertices[index];
+            uint32_t words[5];
+            static_assert(sizeof(BatchVertex) == sizeof(words), "BatchVertex is five 32-bit words");
+            std::memcpy(words, &v, sizeof(words));
+            hash = Mix(hash, (static_cast<uint64_t>(words[0]) << 32) | words[1]);
+            hash = Mix(hash, (static_cast<uint64_t>(words[2]) << 32) | words[3]);
+            hash = Mix(hash, words[4]);
+
+            float x = v.x, y = v.y;
+            if (transform)
+            {
+                // Column-major, as the vertex shader applies it
+                const float w = transform[3] * x + transform[7] * y + transform[15];
+                if (!(w > 1e-6f)) { unbounded = true; continue; }
+                const float tx = transform[0] * x + transform[4] * y + transform[12];
+                const float ty = transform[1] * x + transform[5] * y + transform[13];
+                x = tx / w;
+                y = ty / w;
+            }
+            minX = std::min(minX, x);
+            minY = std::min(minY, y);
+            maxX = std::max(maxX, x);
+            maxY = std::max(maxY, y);
+        }
+
+        DrawSignature d;
+        d.hash = hash;
+        d.texture = batch.texture;
+        if (unbounded)
+        {
+            d.bounds = m_target;
+        }
+        else if (minX <= maxX && minY <= maxY)
+        {
+            // Pixel centres covered, padded a pixel for rasterizer snapping
+            auto clampToInt = [](float f) { return static_cast<int>(std::max(-1e9f, std::min(f, 1e9f))); };
+            d.bounds = { clampToInt(std::floor(minX)) - 1, clampToInt(std::floor(minY)) - 1,
+                         clampToInt(std::ceil(maxX)) + 1, clampToInt(std::ceil(maxY)) + 1 };
+        }
+        if (batch.scissorEnabled)
+            d.bounds = Intersect(d.bounds, batch.scissor);
+        d.bounds = Intersect(d.bounds, m_target);
+        m_current.push_back(d);
+    }
+
+    Rect m_target;
+    Rect m_pending;
+    Rect m_lastDirty;
+    std::vector<DrawSignature> m_previous;
+    std::vector<DrawSignature> m_current;
+
+    // Frame being replayed
+    const BatchVertex* m_vertices = nullptr;
+    size_t m_vertexCount = 0;
+    const uint32_t* m_indices = nullptr;
+    size_t m_indexCount = 0;
+};
@@ -1,10 +1,14 @@
 #include "DxRenderer.h"
+#include "Logger.h"
 #include "OverlayAssets.h"
+#include "StartupTimeline.h"
+#include <dwmapi.h>
 #include <string>
 
 #pragma comment(lib, "d3d11.lib")
 #pragma comment(lib, "dxgi.lib")
 #pragma comment(lib, "dcomp.lib")
+#pragma comment(lib, "dwmapi.lib")
 
 bool DxRenderer::Init(HWND hwnd, int width, int height)
 {
@@ -59,6 +63,8 @@ bool DxRenderer::Init(HWND hwnd, int width, int height)
         return false;
 
     m_swapChain = swapChain1;
+    m_bufferWidth = width;
+    m_bufferHeight = height;
 
     // Associate swap chain with the HWND using DirectComposition
     // (required for DXGI_ALPHA_MODE_PREMULTIPLIED)
@@ -67,6 +73,7 @@ bool DxRenderer::Init(HWND hwnd, int width, int height)
         return false;
 
     CreateRenderTarget();
+    StartupTimeline::Get().Mark("d3d");
 
     // Initialize RmlUi
     if (!InitRmlUi(hwnd, width, height))
@@ -89,46 +96,71 @@ bool DxRenderer::InitRmlUi(HWND hwnd, int width, int height)
 
     if (!Rml::Initialise())
         return false;
+    StartupTimeline::Get().Mark("rml_init");
 
-    // Load Segoe UI system font (regular + bold)
+    // Load Segoe UI system font (regular + bold) and the icon font
     {
         char winDir[MAX_PATH] = {};
         GetWindowsDirectoryA(winDir, MAX_PATH);
         std::string basePath = std::string(winDir) + "\\Fonts\\";
-        if (!Rml::LoadFontFace(basePath + "segoeui.ttf", true))
-            Rml::LoadFontFace(basePath + "arial.ttf", true);
-        Rml::LoadFontFace(basePath + "segoeuib.ttf", false); // Bold variant
-        Rml::LoadFontFace(basePath + "segmdl2.ttf", false);  // Icon font (Segoe MDL2 Assets)
+        using Rml::Style::FontWeight;
+        if (!LoadMappedFontFace(basePath + "segoeui.ttf", "Segoe UI", FontWeight::Normal, true))
+            LoadMappedFontFace(basePath + "arial.ttf", "Segoe UI", FontWeight::Normal, true);
+        LoadMappedFontFace(basePath + "segoeuib.ttf", "Segoe UI", FontWeight::Bold, false);
+        LoadMappedFontFace(basePath + "segmdl2.ttf", "Segoe MDL2 Assets", FontWeight::Normal, false);
     }
+    StartupTimeline::Get().Mark("fonts");
 
     // Create context at viewport size
     m_rmlContext = Rml::CreateContext("main", Rml::Vector2i(width, height));
     if (!m_rmlContext)
         return false;
 
-    // Register theme CSS as a virtual document
-    // RmlUi can load documents that reference other documents via link tags,
-    // but for embedded assets we load the stylesheet directly into a document string.
-    // We inject the theme CSS inline into the overlay RML.
+    // The theme RCSS is inlined into the overlay document at build time
+    // (see OverlayAssets.h)
 
     return true;
 }
 
-Rml::ElementDocument* DxRenderer::LoadOverlayDocument()
+// Registers a font straight from a read-only mapping of the file instead of
+// letting RmlUi read it into a heap copy. RmlUi uses the bytes in place, so
+// the mapping is kept until after Rml::Shutdown().
+bool DxRenderer::LoadMappedFontFace(const std::string& path, const char* family,
+                                    Rml::Style::FontWeight weight, bool fallback)
 {
-    if (!m_rmlContext) return nullptr;
+    MappedFile file;
+    if (!file.Open(path))
+        return false;
+    Rml::Span<const Rml::byte> data(file.Data(), file.Size());
+    if (!Rml::LoadFontFace(data, family, Rml::Style::FontStyle::Normal, weight, fallback))
+        return false;
+    m_fontFiles.push_back(std::move(file));
+    return true;
+}
 
-    // Build the complete RML with inline CSS
-    std::string rml = GetOverlayDocumentRml();
-    std::string css = GetOverlayThemeRcss();
+// Renders an off-screen document once so the glyphs it uses are rasterized
+// and packed into atlas textures ahead of the first show. The frame's draws
+// are discarded unrecorded, and the next frame is drawn in full.
+void DxRenderer::WarmGlyphs(const std::string& rml)
+{
+    if (!m_rmlContext) return;
+    Rml::ElementDocument* doc = m_rmlContext->LoadDocumentFromMemory(rml);
+    if (!doc) return;
+    doc->Show(Rml::ModalFlag::None, Rml::FocusFlag::None);
+    m_rmlContext->Update();
+    m_rmlContext->Render();
+    m_rmlRender.DiscardFrame(); // glyphs are rasterized; nothing is drawn
+    doc->Close();
+    m_rmlContext->Update(); // closed documents are released on the next update
+}
 
-    // Replace __THEME__ placeholder with actual CSS
-    std::string placeholder = "__THEME__";
-    auto pos = rml.find(placeholder);
-    if (pos != std::string::npos)
-        rml.replace(pos, placeholder.length(), css);
+Rml::ElementDocument* DxRenderer::LoadOverlayDocument()
+{
+    if (!m_rmlContext) return nullptr;
 
-    auto* doc = m_rmlContext->LoadDocumentFromMemory(rml);
+    // Theme RCSS is inlined into the document at build time
+    std::string_view rml = GetOverlayDocument();
+    auto* doc = m_rmlContext->LoadDocumentFromMemory(Rml::String(rml));
     if (doc)
         doc->Show();
 
@@ -165,6 +197,7 @@ void DxRenderer::Shutdown()
         m_rmlContext = nullptr;
     }
     Rml::Shutdown();
+    m_fontFiles.clear(); // font faces referenced these mappings
     m_rmlRender.Shutdown();
 
     CleanupRenderTarget();
@@ -176,20 +209,53 @@ void DxRenderer::Shutdown()
     if (m_device)    { m_device->Release();     m_device = nullptr; }
 }
 
+// The clear is deferred to Render(): a frame identical to the last one
+// never touches the render target
 void DxRenderer::BeginFrame(float clearR, float clearG, float clearB, float clearA)
 {
-    float clearColor[4] = { clearR, clearG, clearB, clearA };
-    m_context->OMSetRenderTargets(1, &m_rtv, nullptr);
-    m_context->ClearRenderTargetView(m_rtv, clearColor);
+    if (clearR != m_clearColor[0] || clearG != m_clearColor[1] ||
+        clearB != m_clearColor[2] || clearA != m_clearColor[3])
+        m_rmlRender.InvalidateFrame();
+    m_clearColor[0] = clearR;
+    m_clearColor[1] = clearG;
+    m_clearColor[2] = clearB;
+    m_clearColor[3] = clearA;
 }
 
 void DxRenderer::EndFrame()
+{
+    Render();
+    Present();
+}
+
+void DxRenderer::Render()
 {
     if (m_rmlContext)
     {
         // Update() is called earlier in OverlayApp::Tick() so that direct
         // element manipulation (SetAttribute) happens after data-if processing.
         m_rmlContext->Render();
+        m_frameChanged = m_rmlRender.Flush(); // recorded, not yet drawn
+    }
+    else
+    {
+        m_frameChanged = true;
+    }
+    if (!m_frameChanged) return;
+
+    m_context->ClearRenderTargetView(m_rtv, m_clearColor);
+    m_rmlRender.Submit(m_rtv); // redraws what changed in the UI layer, composites it
+}
+
+void DxRenderer::Present()
+{
+    if (!m_frameChanged)
+    {
+        // DirectComposition keeps showing the last presented frame. Wait
+        // for the compositor instead, so the loop stays paced as if VSync
+        // had blocked.
+        DwmFlush();
+        return;
     }
     m_swapChain->Present(1, 0); // VSync on
 }
@@ -197,16 +263,49 @@ void DxRenderer::EndFrame()
 void DxRenderer::Resize(int width, int height)
 {
     if (width <= 0 || height <= 0) return;
-
-    CleanupRenderTarget();
-    m_swapChain->ResizeBuffers(0, width, height, DXGI_FORMAT_UNKNOWN, 0);
-    CreateRenderTarget();
+    if (!ResizeBuffers(width, height)) return;
 
     m_rmlRender.SetViewport(width, height);
     if (m_rmlContext)
         m_rmlContext->SetDimensions(Rml::Vector2i(width, height));
 }
 
+void DxRenderer::SetSurfaceBounds(int x, int y, int width, int height)
+{
+    if (width <= 0 || height <= 0) return;
+
+    // A move alone keeps the buffers; either way the next frame is redrawn
+    if ((width != m_bufferWidth || height != m_bufferHeight) && !ResizeBuffers(width, height))
+        return;
+    m_rmlRender.SetViewport(width, height, x, y);
+}
+
+// DXGI refuses to resize while anything still references the back buffer,
+// and Submit() leaves it bound as the render target. On failure the old
+// buffers are kept and get their view back, so the caller keeps the old size.
+bool DxRenderer::ResizeBuffers(int width, int height)
+{
+    if (width == m_bufferWidth && height == m_bufferHeight) return true;
+
+    ID3D11ShaderResourceView* noSrv = nullptr;
+    m_context->OMSetRenderTargets(0, nullptr, nullptr);
+    m_context->PSSetShaderResources(0, 1, &noSrv);
+    CleanupRenderTarget();
+    m_context->Flush(); // releases the deferred references to the old view
+
+    HRESULT hr = m_swapChain->ResizeBuffers(0, width, height, DXGI_FORMAT_UNKNOWN, 0);
+    CreateRenderTarget();
+    if (FAILED(hr))
+    {
+        LOG_WARN("dx", "ResizeBuffers %dx%d failed (0x%08X); keeping %dx%d",
+                 width, height, static_cast<unsigned>(hr), m_bufferWidth, m_bufferHeight);
+        return false;
+    }
+    m_bufferWidth = width;
+    m_bufferHeight = height;
+    return true;
+}
+
 void DxRenderer::CreateRenderTarget()
 {
     ID3D11Texture2D* backBuffer = nullptr;
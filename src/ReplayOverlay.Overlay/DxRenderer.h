@@ -5,6 +5,9 @@
 #include <RmlUi/Core.h>
 #include "RmlRenderInterface_DX11.h"
 #include "RmlSystemInterface_Win32.h"
+#include "MappedFile.h"
+#include <string>
+#include <vector>
 
 namespace Rml { class ElementDocument; }
 
@@ -15,9 +18,16 @@ public:
     void Shutdown();
 
     void BeginFrame(float clearR = 0.0f, float clearG = 0.0f, float clearB = 0.0f, float clearA = 0.0f);
-    void EndFrame();
+    void EndFrame(); // Render() + Present()
+    void Render();   // draws only if the UI's command list changed
+    void Present();  // skipped (waits for the compositor) after an unchanged frame
     void Resize(int width, int height);
 
+    // Places the swap chain over part of the UI (screen pixels): resizes the
+    // buffers if the size changed and offsets the projection, so the RmlUi
+    // context keeps its full-screen layout
+    void SetSurfaceBounds(int x, int y, int width, int height);
+
     ID3D11Device*        GetDevice()  const { return m_device; }
     ID3D11DeviceContext* GetContext() const { return m_context; }
     Rml::Context*        GetRmlContext() const { return m_rmlContext; }
@@ -25,6 +35,9 @@ public:
     // Load the overlay document (call after data model is set up)
     Rml::ElementDocument* LoadOverlayDocument();
 
+    // Render an off-screen document once to pre-rasterize its glyphs
+    void WarmGlyphs(const std::string& rml);
+
     // Create a texture from raw RGBA pixel data
     ID3D11ShaderResourceView* CreateTextureFromRGBA(
         const unsigned char* pixels, int width, int height);
@@ -36,17 +49,30 @@ public:
     void SetPreviewTexture(ID3D11ShaderResourceView* srv, int w, int h)
     { m_rmlRender.SetPreviewTexture(srv, w, h); }
     void ClearPreviewTexture() { m_rmlRender.ClearPreviewTexture(); }
+    size_t GetUiTextureBytes() const { return m_rmlRender.GetTextureBytes(); }
+    size_t GetLastDrawCalls() const { return m_rmlRender.GetLastDrawCalls(); }
+    size_t GetLastStateChanges() const { return m_rmlRender.GetLastStateChanges().StateChanges(); }
+    size_t GetLastSubmittedDraws() const { return m_rmlRender.GetLastStateChanges().draws; }
+    bool LastFrameChanged() const { return m_frameChanged; }
+    uint64_t GetUnchangedFrames() const { return m_rmlRender.GetUnchangedFrames(); }
 
 private:
     void CreateRenderTarget();
     void CleanupRenderTarget();
+    bool ResizeBuffers(int width, int height); // false: the old buffers are kept
     HRESULT CreateDCompTarget(HWND hwnd, IDXGISwapChain1* swapChain);
     bool InitRmlUi(HWND hwnd, int width, int height);
+    bool LoadMappedFontFace(const std::string& path, const char* family,
+                            Rml::Style::FontWeight weight, bool fallback);
 
     ID3D11Device*           m_device  = nullptr;
     ID3D11DeviceContext*    m_context = nullptr;
     IDXGISwapChain1*        m_swapChain = nullptr;
     ID3D11RenderTargetView* m_rtv = nullptr;
+    int m_bufferWidth = 0;   // swap chain buffer size
+    int m_bufferHeight = 0;
+    float m_clearColor[4] = {};
+    bool m_frameChanged = true;  // set by Render(): Present() is skipped if false
 
     // DirectComposition for transparent swap chain
     IDCompositionDevice*  m_dcompDevice = nullptr;
@@ -56,5 +82,6 @@ private:
     // RmlUi
     RmlRenderInterface_DX11 m_rmlRender;
     RmlSystemInterface_Win32 m_rmlSystem;
+    std::vector<MappedFile> m_fontFiles; // backing memory of the loaded font faces
     Rml::Context* m_rmlContext = nullptr;
 };
@@ -0,0 +1,134 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Cached handle to one document element plus write-through setters.
+//
+// Resolve() looks the element up by id only when the cached element was
+// destroyed (tracked through the element's observer pointer) or the caller's
+// structure generation changed (tab switch, document reload), so steady-state
+// frames do no GetElementById searches. The setters remember the last value
+// written to the element and skip the DOM call when it is unchanged; the
+// remembered values are dropped whenever the handle resolves to a different
+// element. Templated on the element type so it can be tested without RmlUi.
+
+template <typename Element>
+class ElementHandle
+{
+public:
+    using Observer = decltype(std::declval<Element&>().GetObserverPtr());
+
+    explicit ElementHandle(const char* id) : m_id(id) {}
+
+    // Returns the element (or nullptr if it is not in the document)
+    template <typename Root>
+    Element* Resolve(Root* root, uint32_t generation)
+    {
+        Element* el = m_observer.get();
+        bool lost = m_found && !el;
+        if (!m_valid || lost || generation != m_generation)
+        {
+            el = root ? root->GetElementById(m_id) : nullptr;
+            Rebind(el);
+            m_generation = generation;
+            m_valid = true;
+            m_lookups++;
+        }
+        return el;
+    }
+
+    // Bind to an element found some other way (e.g. a fallback search)
+    void Rebind(Element* el)
+    {
+        if (el != m_observer.get() || !el) m_writes.clear();
+        m_observer = el ? el->GetObserverPtr() : Observer();
+        m_found = el != nullptr;
+    }
+
+    // Force a lookup on the next Resolve()
+    void Invalidate() { m_valid = false; }
+
+    Element* Get() const { return m_observer.get(); }
+
+    // Write-through setters: return true if the DOM was touched
+    bool SetClass(const char* name, bool on)
+    {
+        Element* el = m_observer.get();
+        if (!el) return false;
+        Entry& e = Find(name, Kind::Class);
+        if (e.known && e.on == on) return false;
+        e.known = true;
+        e.on = on;
+        el->SetClass(name, on);
+        m_domWrites++;
+        return true;
+    }
+
+    bool SetProperty(const char* name, std::string_view value)
+    {
+        Element* el = m_observer.get();
+        if (!el) return false;
+        Entry& e = Find(name, Kind::Property);
+        if (e.known && e.on && e.value == value) return false;
+        e.known = true;
+        e.on = true;
+        e.value.assign(value.data(), value.size());
+        el->SetProperty(name, e.value);
+        m_domWrites++;
+        return true;
+    }
+
+    bool RemoveProperty(const char* name)
+    {
+        Element* el = m_observer.get();
+        if (!el) return false;
+        Entry& e = Find(name, Kind::Property);
+        if (e.known && !e.on) return false;
+        e.known = true;
+        e.on = false;
+        e.value.clear();
+        el->RemoveProperty(name);
+        m_domWrites++;
+        return true;
+    }
+
+    // Counters for diagnostics and tests
+    uint64_t Lookups() const { return m_lookups; }
+    uint64_t DomWrites() const { return m_domWrites; }
+
+private:
+    enum class Kind : uint8_t { Class, Property };
+
+    struct Entry
+    {
+        const char* name;
+        Kind kind;
+        bool known = false; // value unknown until first written through us
+        bool on = false;    // class set / property set (vs removed)
+        std::string value;
+    };
+
+    Entry& Find(const char* name, Kind kind)
+    {
+        // A handful of entries per element; linear search beats hashing
+        for (auto& e : m_writes)
+            if (e.kind == kind && (e.name == name || std::strcmp(e.name, name) == 0))
+                return e;
+        m_writes.push_back(Entry{ name, kind, false, false, {} });
+        return m_writes.back();
+    }
+
+    const char* m_id;
+    Observer m_observer;
+    bool m_valid = false;
+    bool m_found = false;
+    uint32_t m_generation = 0;
+    std::vector<Entry> m_writes;
+
+    uint64_t m_lookups = 0;
+    uint64_t m_domWrites = 0;
+};
@@ -0,0 +1,147 @@
+#pragma once
+#include <cstdint>
+#include <cstdlib>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Glyph warm-up for the overlay's fonts.
+//
+// FreeType rasterizes glyphs and RmlUi packs them into atlas textures the
+// first time a (face, size) renders them, which otherwise happens on the
+// first show of the panel. The helpers here derive the set of font sizes
+// (font-size: Ndp) and codepoints (text plus &#x..; entities) the embedded
+// assets use, and build an off-screen document that renders every such
+// glyph once so the work is done while the overlay is still idle.
+
+namespace FontWarmup
+{
+    // Private-use codepoints come from the icon font (Segoe MDL2 Assets)
+    inline bool IsIconCodepoint(uint32_t cp) { return cp >= 0xE000 && cp <= 0xF8FF; }
+
+    inline void AppendUtf8(std::string& out, uint32_t cp)
+    {
+        if (cp < 0x80)
+        {
+            out += static_cast<char>(cp);
+        }
+        else if (cp < 0x800)
+        {
+            out += static_cast<char>(0xC0 | (cp >> 6));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        }
+        else if (cp < 0x10000)
+        {
+            out += static_cast<char>(0xE0 | (cp >> 12));
+            out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        }
+        else
+        {
+            out += static_cast<char>(0xF0 | (cp >> 18));
+            out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        }
+    }
+
+    // Adds every printable codepoint of 'text': UTF-8 sequences and numeric
+    // character references (&#xE7B3; / &#169;). Markup is included as-is;
+    // it is ASCII, which is always warmed anyway.
+    inline void CollectCodepoints(std::string_view text, std::set<uint32_t>& out)
+    {
+        for (size_t i = 0; i < text.size();)
+        {
+            unsigned char c = static_cast<unsigned char>(text[i]);
+            if (c == '&' && i + 2 < text.size() && text[i + 1] == '#')
+            {
+                size_t end = text.find(';', i);
+                if (end != std::string_view::npos && end - i <= 10)
+                {
+                    bool hex = text[i + 2] == 'x' || text[i + 2] == 'X';
+                    std::string digits(text.substr(i + (hex ? 3 : 2), end - i - (hex ? 3 : 2)));
+                    char* parsedEnd = nullptr;
+                    unsigned long cp = std::strtoul(digits.c_str(), &parsedEnd, hex ? 16 : 10);
+                    if (!digits.empty() && *parsedEnd == '\0' && cp >= 0x20 && cp <= 0x10FFFF)
+                    {
+                        out.insert(static_cast<uint32_t>(cp));
+                        i = end + 1;
+                        continue;
+                    }
+                }
+            }
+
+            uint32_t cp = c;
+            size_t len = 1;
+            if (c >= 0xF0) { cp = c & 0x07; len = 4; }
+            else if (c >= 0xE0) { cp = c & 0x0F; len = 3; }
+            else if (c >= 0xC0) { cp = c & 0x1F; len = 2; }
+            if (i + len > text.size()) break;
+            for (size_t k = 1; k < len; k++)
+                cp = (cp << 6) | (static_cast<unsigned char>(text[i + k]) & 0x3F);
+            if (cp >= 0x20 && cp != 0x7F) out.insert(cp);
+            i += len;
+        }
+    }
+
+    // Distinct "font-size: Ndp" values, ascending
+    inline std::vector<int> CollectFontSizes(std::string_view text)
+    {
+        std::set<int> sizes;
+        const std::string_view key = "font-size:";
+        for (size_t pos = text.find(key); pos != std::string_view::npos; pos = text.find(key, pos + 1))
+        {
+            size_t i = pos + key.size();
+            while (i < text.size() && text[i] == ' ') i++;
+            int value = 0;
+            size_t digits = 0;
+            while (i < text.size() && text[i] >= '0' && text[i] <= '9')
+            {
+                value = value * 10 + (text[i] - '0');
+                i++;
+                digits++;
+            }
+            if (digits > 0 && text.substr(i, 2) == "dp") sizes.insert(value);
+        }
+        return std::vector<int>(sizes.begin(), sizes.end());
+    }
+
+    inline void AppendEscaped(std::string& out, uint32_t cp)
+    {
+        if (cp == '<') out += "&lt;";
+        else if (cp == '>') out += "&gt;";
+        else if (cp == '&') out += "&amp;";
+        else if (cp == '{' || cp == '}') out += ' '; // keep "{{" from reading as a binding
+        else AppendUtf8(out, cp);
+    }
+
+    // Off-screen document rendering every codepoint at every size: text in
+    // regular and bold, private-use codepoints in the icon family. Printable
+    // ASCII is always included (dynamic text such as scene names).
+    inline std::string BuildDocument(const std::vector<int>& sizes, const std::set<uint32_t>& codepoints,
+                                     const char* textFamily, const char* iconFamily)
+    {
+        std::string text, icons;
+        for (uint32_t cp = 0x20; cp < 0x7F; cp++)
+            if (!codepoints.count(cp)) AppendEscaped(text, cp);
+        for (uint32_t cp : codepoints)
+            AppendEscaped(IsIconCodepoint(cp) ? icons : text, cp);
+
+        std::string doc = "<rml><head><style>"
+                          "body { position: absolute; left: -10000dp; top: 0; width: 8000dp; font-family: ";
+        doc += textFamily;
+        doc += "; } p { display: block; white-space: nowrap; } .b { font-weight: bold; } .i { font-family: ";
+        doc += iconFamily;
+        doc += "; }</style></head><body>";
+        for (int size : sizes)
+        {
+            std::string style = " style=\"font-size: " + std::to_string(size) + "dp;\">";
+            doc += "<p" + style + text + "</p>";
+            doc += "<p class=\"b\"" + style + text + "</p>";
+            if (!icons.empty()) doc += "<p class=\"i\"" + style + icons + "</p>";
+        }
+        doc += "</body></rml>";
+        return doc;
+    }
+}
@@ -0,0 +1,139 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+#include <nlohmann/json.hpp>
+
+// Picks the overlay's frame rate from what is on screen and what the user
+// is doing:
+//   Interactive - full (VSync) rate while there is recent input or a fade
+//                 is running
+//   Passive     - 10 Hz while the panel is visible but idle
+//   Indicator   - at most 2 Hz while only the REC dot / a static
+//                 notification is visible
+//   Hidden      - nothing visible; frames only on invalidation
+//
+// Update() is called once per main-loop iteration; the resulting pacing is
+// applied to the FrameScheduler. Time spent in each state and the measured
+// frame rate are kept for the overlay metrics report.
+
+enum class GovernorState : uint8_t
+{
+    Interactive = 0,
+    Passive,
+    Indicator,
+    Hidden,
+    Count
+};
+
+class FrameGovernor
+{
+public:
+    static constexpr int StateCount = static_cast<int>(GovernorState::Count);
+    static constexpr double InputLingerS = 0.5;       // stay interactive after the last input
+    static constexpr double PassiveIntervalS = 0.1;   // 10 Hz
+    static constexpr double IndicatorIntervalS = 0.5; // 2 Hz, one frame per REC blink
+
+    struct Signals
+    {
+        bool panelVisible = false;
+        bool indicatorVisible = false; // REC dot or notification on screen
+        bool animating = false;        // a fade needs every frame
+    };
+
+    static const char* StateName(GovernorState s)
+    {
+        static constexpr const char* Names[StateCount] = { "interactive", "passive", "indicator", "hidden" };
+        return Names[static_cast<int>(s)];
+    }
+
+    // Input forwarded to RmlUi at time 'now'
+    void NoteInput(double now) { m_lastInput = now; }
+
+    // A frame was rendered (for the measured rate)
+    void NoteFrame() { m_windowFrames++; }
+
+    GovernorState Update(double now, const Signals& signals)
+    {
+        if (m_lastUpdate >= 0.0 && now > m_lastUpdate)
+            m_timeInState[static_cast<int>(m_state)] += now - m_lastUpdate;
+        m_lastUpdate = now;
+
+        GovernorState next;
+        if (signals.animating || (signals.panelVisible && now - m_lastInput < InputLingerS))
+            next = GovernorState::Interactive;
+        else if (signals.panelVisible)
+            next = GovernorState::Passive;
+        else if (signals.indicatorVisible)
+            next = GovernorState::Indicator;
+        else
+            next = GovernorState::Hidden;
+
+        if (next != m_state)
+        {
+            m_state = next;
+            m_transitions++;
+        }
+
+        // Roll the measured-rate window once a second
+        if (m_windowStart < 0.0) m_windowStart = now;
+        if (now - m_windowStart >= 1.0)
+        {
+            m_measuredHz = m_windowFrames / (now - m_windowStart);
+            m_windowStart = now;
+            m_windowFrames = 0;
+        }
+        return m_state;
+    }
+
+    GovernorState State() const { return m_state; }
+
+    // Minimum seconds between frames (0 = no cap)
+    double IntervalS() const
+    {
+        switch (m_state)
+        {
+        case GovernorState::Passive:   return PassiveIntervalS;
+        case GovernorState::Indicator: return IndicatorIntervalS;
+        default:                       return 0.0;
+        }
+    }
+
+    // Whether frames are produced on a clock (true) or only on invalidation
+    bool IsPeriodic() const
+    {
+        return m_state == GovernorState::Interactive || m_state == GovernorState::Passive;
+    }
+
+    double TimeInState(GovernorState s) const { return m_timeInState[static_cast<int>(s)]; }
+    int Transitions() const { return m_transitions; }
+    double MeasuredHz() const { return m_measuredHz; }
+
+    nlohmann::json Metrics() const
+    {
+        nlohmann::json time = nlohmann::json::object();
+        for (int s = 0; s < StateCount; s++)
+            time[StateName(static_cast<GovernorState>(s))] = m_timeInState[s];
+
+        // Interactive runs at the display rate and Hidden has no clock; both
+        // report a target of 0
+        double target = IntervalS() > 0.0 ? 1.0 / IntervalS() : 0.0;
+        return {
+            {"state", StateName(m_state)},
+            {"target_hz", target},
+            {"measured_hz", m_measuredHz},
+            {"transitions", m_transitions},
+            {"time_in_state_s", time},
+        };
+    }
+
+private:
+    GovernorState m_state = GovernorState::Hidden;
+    double m_lastInput = -std::numeric_limits<double>::infinity();
+    double m_lastUpdate = -1.0;
+    double m_timeInState[StateCount] = {};
+    int m_transitions = 0;
+
+    double m_windowStart = -1.0;
+    int m_windowFrames = 0;
+    double m_measuredHz = 0.0;
+};
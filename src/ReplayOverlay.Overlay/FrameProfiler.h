@@ -0,0 +1,261 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <nlohmann/json.hpp>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Per-phase frame timing for OverlayApp::Tick.
+//
+// Each phase records into a log-linear ("HDR-style") histogram: 16 linear
+// sub-buckets per power of two of nanoseconds, so any recorded value is
+// reported within ~6% and the whole range from 1 ns to ~18 minutes fits in
+// a fixed 592-bucket array. Recording is a bucket index computation plus a
+// few relaxed atomic stores; there is one writer (the main loop), so readers
+// on any thread see consistent-enough counts without locks.
+//
+// Two windows are kept per phase and rotated every WindowS seconds; reports
+// merge both, covering the last WindowS..2*WindowS seconds.
+
+enum class FramePhase : uint8_t
+{
+    Pump = 0,     // Win32 message pump
+    Ipc,          // ProcessIpcMessages
+    Sync,         // SyncFromState + animations
+    Update,       // first Context::Update
+    DomSync,      // direct element updates
+    Update2,      // second Context::Update (only when the DOM changed)
+    Render,       // clear + Context::Render
+    Present,      // swap chain Present (includes the VSync wait)
+    ClickThrough, // UpdateClickThrough
+    Frame,        // whole rendered Tick
+    Count
+};
+
+class LatencyHistogram
+{
+public:
+    static constexpr int SubBits = 4;
+    static constexpr int SubCount = 1 << SubBits;
+    static constexpr int MaxExponent = 39;
+    static constexpr int BucketCount = (MaxExponent - SubBits + 2) * SubCount;
+
+    static int BucketIndex(uint64_t ns)
+    {
+        if (ns < 2 * SubCount) return static_cast<int>(ns);
+        int e = 63 - CountLeadingZeros(ns);
+        if (e > MaxExponent) return BucketCount - 1;
+        int sub = static_cast<int>((ns >> (e - SubBits)) & (SubCount - 1));
+        return (e - SubBits + 1) * SubCount + sub;
+    }
+
+    // Smallest value that maps to bucket 'idx'
+    static uint64_t BucketLow(int idx)
+    {
+        if (idx < 2 * SubCount) return static_cast<uint64_t>(idx);
+        int e = idx / SubCount + SubBits - 1;
+        uint64_t sub = static_cast<uint64_t>(idx % SubCount);
+        return (SubCount + sub) << (e - SubBits);
+    }
+
+    static uint64_t BucketHigh(int idx)
+    {
+        return idx + 1 < BucketCount ? BucketLow(idx + 1) - 1 : BucketLow(idx);
+    }
+
+    // Single writer
+    void Record(uint64_t ns)
+    {
+        Bump(m_buckets[BucketIndex(ns)], 1);
+        Bump(m_count, 1);
+        Bump(m_sum, ns);
+        if (ns > m_max.load(std::memory_order_relaxed))
+            m_max.store(ns, std::memory_order_relaxed);
+    }
+
+    void Clear()
+    {
+        for (auto& b : m_buckets) b.store(0, std::memory_order_relaxed);
+        m_count.store(0, std::memory_order_relaxed);
+        m_sum.store(0, std::memory_order_relaxed);
+        m_max.store(0, std::memory_order_relaxed);
+    }
+
+    uint32_t Bucket(int idx) const { return m_buckets[idx].load(std::memory_order_relaxed); }
+    uint64_t Count() const { return m_count.load(std::memory_order_relaxed); }
+    uint64_t Sum() const { return m_sum.load(std::memory_order_relaxed); }
+    uint64_t Max() const { return m_max.load(std::memory_order_relaxed); }
+
+private:
+    template <typename T, typename V>
+    static void Bump(std::atomic<T>& a, V v)
+    {
+        a.store(a.load(std::memory_order_relaxed) + static_cast<T>(v), std::memory_order_relaxed);
+    }
+
+    static int CountLeadingZeros(uint64_t v)
+    {
+#if defined(_MSC_VER)
+        unsigned long idx;
+        _BitScanReverse64(&idx, v);
+        return 63 - static_cast<int>(idx);
+#else
+        return __builtin_clzll(v);
+#endif
+    }
+
+    std::atomic<uint32_t> m_buckets[BucketCount] = {};
+    std::atomic<uint64_t> m_count{ 0 };
+    std::atomic<uint64_t> m_sum{ 0 };
+    std::atomic<uint64_t> m_max{ 0 };
+};
+
+class FrameProfiler
+{
+public:
+    static constexpr int PhaseCount = static_cast<int>(FramePhase::Count);
+    static constexpr double WindowS = 10.0;
+
+    struct Summary
+    {
+        uint64_t count = 0;
+        double meanUs = 0.0;
+        double p50Us = 0.0;
+        double p95Us = 0.0;
+        double p99Us = 0.0;
+        double maxUs = 0.0;
+    };
+
+    static const char* PhaseName(FramePhase p)
+    {
+        static constexpr const char* Names[PhaseCount] = {
+            "pump", "ipc", "sync", "update", "dom_sync", "update2",
+            "render", "present", "click_through", "frame",
+        };
+        return Names[static_cast<int>(p)];
+    }
+
+    static uint64_t NowNs()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    // Closes a window every WindowS seconds (seconds, monotonic)
+    void Rotate(double now)
+    {
+        if (m_windowStart < 0.0) m_windowStart = now;
+        if (now - m_windowStart < WindowS) return;
+        m_current ^= 1;
+        for (auto& h : m_windows[m_current]) h.Clear();
+        m_windowStart = now;
+    }
+
+    void Record(FramePhase phase, uint64_t ns)
+    {
+        m_windows[m_current][static_cast<int>(phase)].Record(ns);
+    }
+
+    // Percentiles over both windows, reported at the bucket midpoint
+    Summary Summarize(FramePhase phase) const
+    {
+        return Summarize(m_windows[0][static_cast<int>(phase)], m_windows[1][static_cast<int>(phase)]);
+    }
+
+    // Percentiles over the union of two histograms
+    static Summary Summarize(const LatencyHistogram& a, const LatencyHistogram& b)
+    {
+        Summary s;
+        s.count = a.Count() + b.Count();
+        if (s.count == 0) return s;
+        s.meanUs = static_cast<double>(a.Sum() + b.Sum()) / s.count / 1000.0;
+        s.maxUs = static_cast<double>(a.Max() > b.Max() ? a.Max() : b.Max()) / 1000.0;
+
+        const double targets[3] = { 0.50, 0.95, 0.99 };
+        double* outs[3] = { &s.p50Us, &s.p95Us, &s.p99Us };
+        int next = 0;
+        uint64_t seen = 0;
+        for (int i = 0; i < LatencyHistogram::BucketCount && next < 3; i++)
+        {
+            seen += static_cast<uint64_t>(a.Bucket(i)) + b.Bucket(i);
+            while (next < 3 && seen >= static_cast<uint64_t>(targets[next] * s.count + 0.5) && seen > 0)
+            {
+                double mid = 0.5 * (LatencyHistogram::BucketLow(i) + LatencyHistogram::BucketHigh(i));
+                *outs[next] = mid / 1000.0;
+                if (*outs[next] > s.maxUs) *outs[next] = s.maxUs;
+                next++;
+            }
+        }
+        return s;
+    }
+
+    static Summary Summarize(const LatencyHistogram& h)
+    {
+        static const LatencyHistogram empty;
+        return Summarize(h, empty);
+    }
+
+    static nlohmann::json ToJson(const Summary& s)
+    {
+        return {
+            {"count", s.count},
+            {"mean_us", s.meanUs},
+            {"p50_us", s.p50Us},
+            {"p95_us", s.p95Us},
+            {"p99_us", s.p99Us},
+            {"max_us", s.maxUs},
+        };
+    }
+
+    nlohmann::json Report() const
+    {
+        nlohmann::json phases = nlohmann::json::object();
+        for (int p = 0; p < PhaseCount; p++)
+        {
+            phases[PhaseName(static_cast<FramePhase>(p))] = ToJson(Summarize(static_cast<FramePhase>(p)));
+        }
+        return phases;
+    }
+
+    // One line for the periodic debug log: "phase p50/p95/p99/max" in us
+    std::string FormatLine() const
+    {
+        std::string out = "frame phases (us p50/p95/p99/max):";
+        char buf[96];
+        for (int p = 0; p < PhaseCount; p++)
+        {
+            Summary s = Summarize(static_cast<FramePhase>(p));
+            if (s.count == 0) continue;
+            snprintf(buf, sizeof(buf), " %s %.0f/%.0f/%.0f/%.0f",
+                     PhaseName(static_cast<FramePhase>(p)), s.p50Us, s.p95Us, s.p99Us, s.maxUs);
+            out += buf;
+        }
+        return out;
+    }
+
+private:
+    LatencyHistogram m_windows[2][PhaseCount];
+    int m_current = 0;
+    double m_windowStart = -1.0;
+};
+
+// Times the enclosing scope into one phase
+class ScopedPhase
+{
+public:
+    ScopedPhase(FrameProfiler& profiler, FramePhase phase)
+        : m_profiler(profiler), m_phase(phase), m_start(FrameProfiler::NowNs()) {}
+    ~ScopedPhase() { m_profiler.Record(m_phase, FrameProfiler::NowNs() - m_start); }
+
+    ScopedPhase(const ScopedPhase&) = delete;
+    ScopedPhase& operator=(const ScopedPhase&) = delete;
+
+private:
+    FrameProfiler& m_profiler;
+    FramePhase m_phase;
+    uint64_t m_start;
+};
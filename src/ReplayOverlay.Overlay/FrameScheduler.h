@@ -0,0 +1,103 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+
+// Decides, once per main-loop iteration, whether to run the expensive part
+// of a frame (RmlUi update, render, present) and how long the loop may then
+// sleep waiting for OS or IPC events.
+//
+// Pacing is set by the FrameGovernor as a minimum interval between frames
+// plus whether frames are produced on that clock (periodic) or only after
+// Invalidate(). With a zero interval and periodic pacing every iteration
+// renders and the loop never sleeps (Present's VSync wait paces it).
+// Otherwise the loop sleeps until the next due frame, the earliest
+// RequestWakeAt() deadline, or indefinitely if neither applies. Times are
+// seconds on the caller's monotonic clock, so tests can drive it with a
+// fake one.
+
+class FrameScheduler
+{
+public:
+    static constexpr double WaitForever = -1.0;
+
+    // Minimum seconds between frames, and whether frames are produced on
+    // that clock or only after Invalidate(). A change renders one frame
+    // immediately (show/hide must not wait for the next slot).
+    void SetPacing(double intervalS, bool periodic)
+    {
+        if (intervalS != m_interval || periodic != m_periodic) m_force = true;
+        m_interval = intervalS;
+        m_periodic = periodic;
+    }
+
+    // Full rate (panel in use) or invalidation-only
+    void SetInteractive(bool interactive) { SetPacing(0.0, interactive); }
+    bool IsInteractive() const { return m_periodic && m_interval == 0.0; }
+
+    // Something visible changed; render on the next iteration
+    void Invalidate() { m_invalidated = true; }
+
+    // Ask to be woken by time 't' (animation step, reconnect attempt, ...).
+    // Requests are per iteration: repeat them every iteration they still apply.
+    void RequestWakeAt(double t)
+    {
+        if (t < m_wakeAt) m_wakeAt = t;
+    }
+
+    // Call after input, IPC and state sync for this iteration. Returns true
+    // if the frame should be updated, rendered and presented.
+    bool ShouldRender(double now)
+    {
+        bool due = now >= m_lastRender + m_interval;
+        bool render = m_force || (due && (m_periodic || m_invalidated));
+        if (render)
+        {
+            m_lastRender = now;
+            m_invalidated = false;
+            m_force = false;
+            m_rendered++;
+        }
+        else
+        {
+            m_skipped++;
+        }
+        return render;
+    }
+
+    // Seconds to block before the next iteration (0 = don't block,
+    // WaitForever = until an OS/IPC event). Clears this iteration's wake
+    // requests.
+    double WaitTimeout(double now)
+    {
+        double wakeAt = m_wakeAt;
+        m_wakeAt = NoWake;
+        if (m_force) return 0.0;
+        if (m_periodic || m_invalidated)
+        {
+            double due = m_lastRender + m_interval;
+            if (due < wakeAt) wakeAt = due;
+        }
+        if (wakeAt == NoWake) return WaitForever;
+        return wakeAt > now ? wakeAt - now : 0.0;
+    }
+
+    // Counters for diagnostics
+    void NoteWakeup() { m_wakeups++; }
+    uint64_t RenderedFrames() const { return m_rendered; }
+    uint64_t SkippedFrames() const { return m_skipped; }
+    uint64_t Wakeups() const { return m_wakeups; }
+
+private:
+    static constexpr double NoWake = std::numeric_limits<double>::infinity();
+
+    double m_interval = 0.0;
+    bool m_periodic = false;
+    bool m_invalidated = false;
+    bool m_force = true; // first frame always renders
+    double m_lastRender = -NoWake;
+    double m_wakeAt = NoWake;
+
+    uint64_t m_rendered = 0;
+    uint64_t m_skipped = 0;
+    uint64_t m_wakeups = 0;
+};
@@ -0,0 +1,350 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Sub-allocation of compiled UI geometry from a few large pages.
+//
+// RmlUi compiles one small mesh per box or text run and releases it again
+// whenever the element changes, so stats updates and data-for rebuilds
+// churn hundreds of tiny allocations. ArenaAllocator hands out element
+// ranges inside fixed-size pages instead. Ranges are whole granules of
+// Granularity elements. Free blocks sit in segregated lists, one per size
+// up to 63 granules plus one for larger blocks, with a bitmap of non-empty
+// lists; boundary tags let a freed block merge with both neighbours in
+// constant time. No allocation touches the C++ heap once the pages exist.
+//
+// It only manages offsets, so it can back CPU storage (GeometryArena below)
+// or GPU buffers drawn with base-vertex / start-index offsets alike.
+
+class ArenaAllocator
+{
+public:
+    struct Allocation
+    {
+        uint32_t page = 0;
+        uint32_t offset = 0;  // in elements
+        uint32_t size = 0;    // in elements, rounded up to Granularity
+        bool Valid() const { return size != 0; }
+    };
+
+    struct Stats
+    {
+        size_t pages = 0;
+        size_t capacity = 0;      // elements across all pages
+        size_t used = 0;          // elements allocated (after rounding)
+        size_t freeBlocks = 0;
+        size_t largestFree = 0;
+
+        // 0 when all free space is one block; approaches 1 as it splinters
+        double Fragmentation() const
+        {
+            const size_t free = capacity - used;
+            return free ? 1.0 - static_cast<double>(largestFree) / static_cast<double>(free) : 0.0;
+        }
+    };
+
+    // Sizes are rounded up to this many elements, so small meshes of
+    // slightly different sizes can reuse each other's ranges
+    static constexpr uint32_t Granularity = 16;
+
+    explicit ArenaAllocator(uint32_t pageSize = 64 * 1024)
+        : m_pageGranules(std::max<uint32_t>((pageSize + Granularity - 1) / Granularity, 1))
+    {
+    }
+
+    // Returns an invalid allocation for count == 0. Requests larger than a
+    // page get a dedicated page of their own size.
+    Allocation Allocate(uint32_t count)
+    {
+        if (count == 0) return {};
+        const uint32_t n = (count + Granularity - 1) / Granularity;
+
+        uint32_t block = FindFree(n);
+        if (block == None)
+        {
+            AddPage(std::max(n, m_pageGranules));
+            block = FindFree(n);
+        }
+
+        Unlink(block);
+        const uint32_t size = m_size[block];
+        if (size > n)
+        {
+            SetBlock(block + n, size - n, true);
+            Link(block + n);
+        }
+        SetBlock(block, n, false);
+        m_used += n;
+
+        const uint32_t page = m_pageOf[block];
+        return { page, (block - m_pages[page].base) * Granularity, n * Granularity };
+    }
+
+    void Free(const Allocation& a)
+    {
+        if (!a.Valid() || a.page >= m_pages.size()) return;
+        const Page& page = m_pages[a.page];
+        uint32_t block = page.base + a.offset / Granularity;
+        uint32_t n = a.size / Granularity;
+        if (m_free[block] || m_size[block] != n) return; // not a live allocation
+        m_used -= n;
+
+        const uint32_t next = block + n;
+        if (next < page.base + page.granules && m_free[next])
+        {
+            Unlink(next);
+            n += m_size[next];
+        }
+        if (block > page.base)
+        {
+            const uint32_t prev = m_startOf[block - 1];
+            if (m_free[prev])
+            {
+                Unlink(prev);
+                n += m_size[prev];
+                block = prev;
+            }
+        }
+        SetBlock(block, n, true);
+        Link(block);
+    }
+
+    // Drops every allocation but keeps the pages
+    void Reset()
+    {
+        m_heads.fill(None);
+        m_nonEmpty = 0;
+        m_freeBlocks = 0;
+        m_used = 0;
+        for (const Page& page : m_pages)
+        {
+            SetBlock(page.base, page.granules, true);
+            Link(page.base);
+        }
+    }
+
+    size_t PageCount() const { return m_pages.size(); }
+    uint32_t PageCapacity(uint32_t page) const { return m_pages[page].granules * Granularity; }
+
+    Stats GetStats() const
+    {
+        Stats s;
+        s.pages = m_pages.size();
+        for (const Page& p : m_pages) s.capacity += static_cast<size_t>(p.granules) * Granularity;
+        s.used = m_used * Granularity;
+        s.freeBlocks = m_freeBlocks;
+        for (uint32_t head : m_heads)
+            for (uint32_t b = head; b != None; b = m_next[b])
+                s.largestFree = std::max<size_t>(s.largestFree, static_cast<size_t>(m_size[b]) * Granularity);
+        return s;
+    }
+
+private:
+    static constexpr uint32_t None = 0xFFFFFFFFu;
+    static constexpr uint32_t Classes = 64; // sizes 1..63 exact, 64+ share the last list
+
+    struct Page
+    {
+        uint32_t base = 0;      // first granule in the global granule space
+        uint32_t granules = 0;
+    };
+
+    static uint32_t ClassOf(uint32_t granules) { return std::min(granules, Classes) - 1; }
+
+    static uint32_t LowestBit(uint64_t mask)
+    {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward64(&index, mask);
+        return static_cast<uint32_t>(index);
+#else
+        return static_cast<uint32_t>(__builtin_ctzll(mask));
+#endif
+    }
+
+    uint32_t FindFree(uint32_t n) const
+    {
+        const uint32_t c = ClassOf(n);
+        if (c < Classes - 1)
+        {
+            // Any block in an exact class >= c fits; take the smallest
+            const uint64_t exact = m_nonEmpty & ~(~0ull << (Classes - 1));
+            const uint64_t mask = exact & (~0ull << c);
+            if (mask) return m_heads[LowestBit(mask)];
+        }
+        // Large blocks: first fit
+        for (uint32_t b = m_heads[Classes - 1]; b != None; b = m_next[b])
+            if (m_size[b] >= n) return b;
+        return None;
+    }
+
+    void AddPage(uint32_t granules)
+    {
+        Page page;
+        page.base = static_cast<uint32_t>(m_size.size());
+        page.granules = granules;
+        const size_t total = m_size.size() + granules;
+        m_size.resize(total, 0);
+        m_startOf.resize(total, 0);
+        m_free.resize(total, 0);
+        m_next.resize(total, None);
+        m_prev.resize(total, None);
+        m_pageOf.resize(total, static_cast<uint32_t>(m_pages.size()));
+        m_pages.push_back(page);
+        SetBlock(page.base, granules, true);
+        Link(page.base);
+    }
+
+    // Boundary tags: size and state at the first granule, start at the last
+    void SetBlock(uint32_t start, uint32_t granules, bool free)
+    {
+        m_size[start] = granules;
+        m_free[start] = free ? 1 : 0;
+        m_startOf[start + granules - 1] = start;
+    }
+
+    void Link(uint32_t block)
+    {
+        const uint32_t c = ClassOf(m_size[block]);
+        m_prev[block] = None;
+        m_next[block] = m_heads[c];
+        if (m_heads[c] != None) m_prev[m_heads[c]] = block;
+        m_heads[c] = block;
+        m_nonEmpty |= 1ull << c;
+        m_freeBlocks++;
+    }
+
+    void Unlink(uint32_t block)
+    {
+        const uint32_t c = ClassOf(m_size[block]);
+        if (m_prev[block] != None) m_next[m_prev[block]] = m_next[block];
+        else m_heads[c] = m_next[block];
+        if (m_next[block] != None) m_prev[m_next[block]] = m_prev[block];
+        if (m_heads[c] == None) m_nonEmpty &= ~(1ull << c);
+        m_free[block] = 0;
+        m_freeBlocks--;
+    }
+
+    uint32_t m_pageGranules;
+    std::vector<Page> m_pages;
+
+    // Per granule; only block starts (size, free, links) and block ends
+    // (startOf) are meaningful
+    std::vector<uint32_t> m_size;
+    std::vector<uint32_t> m_startOf;
+    std::vector<uint8_t> m_free;
+    std::vector<uint32_t> m_next;
+    std::vector<uint32_t> m_prev;
+    std::vector<uint32_t> m_pageOf;
+
+    std::array<uint32_t, Classes> m_heads = MakeHeads();
+    uint64_t m_nonEmpty = 0;   // bit c set when list c is non-empty
+    size_t m_freeBlocks = 0;
+    size_t m_used = 0;         // granules
+
+    static std::array<uint32_t, Classes> MakeHeads()
+    {
+        std::array<uint32_t, Classes> heads;
+        heads.fill(None);
+        return heads;
+    }
+};
+
+// Element storage for one ArenaAllocator: each page is a fixed array, so
+// pointers stay valid while the allocation lives
+template <typename T>
+class ArenaHeap
+{
+public:
+    using Allocation = ArenaAllocator::Allocation;
+
+    explicit ArenaHeap(uint32_t pageSize = 64 * 1024) : m_allocator(pageSize) {}
+
+    Allocation Allocate(const T* data, uint32_t count)
+    {
+        Allocation a = m_allocator.Allocate(count);
+        if (!a.Valid()) return a;
+        while (m_pages.size() < m_allocator.PageCount())
+        {
+            const uint32_t capacity = m_allocator.PageCapacity(static_cast<uint32_t>(m_pages.size()));
+            m_pages.emplace_back(new T[capacity]);
+        }
+        std::memcpy(Data(a), data, count * sizeof(T));
+        return a;
+    }
+
+    void Free(const Allocation& a) { m_allocator.Free(a); }
+    void Reset() { m_allocator.Reset(); }
+
+    T* Data(const Allocation& a) { return m_pages[a.page].get() + a.offset; }
+    const T* Data(const Allocation& a) const { return m_pages[a.page].get() + a.offset; }
+
+    const ArenaAllocator& Allocator() const { return m_allocator; }
+    size_t CapacityBytes() const { return m_allocator.GetStats().capacity * sizeof(T); }
+
+private:
+    ArenaAllocator m_allocator;
+    std::vector<std::unique_ptr<T[]>> m_pages;
+};
+
+// Compiled geometry for the render interfaces: vertices and indices live in
+// two arena heaps, addressed by the returned Mesh
+template <typename Vertex>
+class GeometryArena
+{
+public:
+    struct Mesh
+    {
+        ArenaAllocator::Allocation vertices;
+        ArenaAllocator::Allocation indices;
+        uint32_t vertexCount = 0;
+        uint32_t indexCount = 0;
+    };
+
+    // Page sizes in elements: 16K vertices (320 KB) and 48K indices (192 KB)
+    GeometryArena(uint32_t vertexPage = 16 * 1024, uint32_t indexPage = 48 * 1024)
+        : m_vertices(vertexPage), m_indices(indexPage)
+    {
+    }
+
+    Mesh Allocate(const Vertex* vertices, size_t vertexCount, const int* indices, size_t indexCount)
+    {
+        Mesh m;
+        m.vertexCount = static_cast<uint32_t>(vertexCount);
+        m.indexCount = static_cast<uint32_t>(indexCount);
+        m.vertices = m_vertices.Allocate(vertices, m.vertexCount);
+        m.indices = m_indices.Allocate(indices, m.indexCount);
+        return m;
+    }
+
+    void Free(const Mesh& m)
+    {
+        m_vertices.Free(m.vertices);
+        m_indices.Free(m.indices);
+    }
+
+    // Frees every mesh; the pages are kept
+    void Reset()
+    {
+        m_vertices.Reset();
+        m_indices.Reset();
+    }
+
+    const Vertex* Vertices(const Mesh& m) const { return m.vertexCount ? m_vertices.Data(m.vertices) : nullptr; }
+    const int* Indices(const Mesh& m) const { return m.indexCount ? m_indices.Data(m.indices) : nullptr; }
+
+    const ArenaAllocator& VertexAllocator() const { return m_vertices.Allocator(); }
+    const ArenaAllocator& IndexAllocator() const { return m_indices.Allocator(); }
+    size_t CapacityBytes() const { return m_vertices.CapacityBytes() + m_indices.CapacityBytes(); }
+
+private:
+    ArenaHeap<Vertex> m_vertices;
+    ArenaHeap<int> m_indices;
+};
@@ -0,0 +1,316 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GEOMETRY_BATCHER_SSE2 1
+#include <emmintrin.h>
+#endif
+
+// Merges RmlUi geometry into a few draws per frame.
+//
+// RmlUi hands the render interface one small mesh per box, text run or
+// image, each with its own translation. Instead of drawing them one by one,
+// Add() appends the mesh to a per-frame vertex/index stream with the
+// translation baked into the positions, and extends the current batch when
+// texture, scissor and transform match the previous geometry. Flush() then
+// uploads the stream once and issues one draw per batch. Draw order is
+// preserved: only consecutive geometries are merged. Geometry whose texture
+// lives in an atlas page passes the page as its texture plus a UvTransform,
+// so meshes using different atlas entries still share a batch.
+//
+// Backend provides:
+//   bool Upload(const BatchVertex* vertices, size_t vertexCount,
+//               const uint32_t* indices, size_t indexCount);
+//   void Draw(const GeometryBatcher::Batch& batch, const float* transform);
+// 'transform' is the batch's column-major 4x4 matrix, or null for none.
+// Templated on the backend so batching can be tested without a GPU.
+
+// Same layout as Rml::Vertex (position, premultiplied RGBA8, UV)
+struct BatchVertex
+{
+    float x, y;
+    uint32_t colour;
+    float u, v;
+};
+static_assert(sizeof(BatchVertex) == 20, "BatchVertex must match Rml::Vertex");
+
+// Maps a texture's own [0,1] UVs into its rectangle of an atlas page:
+// u' = offsetU + u * scaleU
+struct UvTransform
+{
+    float offsetU = 0.0f, offsetV = 0.0f;
+    float scaleU = 1.0f, scaleV = 1.0f;
+};
+
+class GeometryBatcher
+{
+public:
+    struct Scissor
+    {
+        int left = 0, top = 0, right = 0, bottom = 0;
+        bool operator==(const Scissor& o) const
+        {
+            return left == o.left && top == o.top && right == o.right && bottom == o.bottom;
+        }
+        bool operator!=(const Scissor& o) const { return !(*this == o); }
+    };
+
+    struct Batch
+    {
+        uintptr_t texture = 0;
+        bool scissorEnabled = false;
+        Scissor scissor;
+        int transform = NoTransform; // index into the frame's transforms
+        uint32_t firstIndex = 0;
+        uint32_t indexCount = 0;
+        uint32_t geometries = 0;     // meshes merged into this batch
+    };
+
+    static constexpr int NoTransform = -1;
+
+    // --- State (applies to geometry added afterwards) ---
+
+    void EnableScissor(bool enable) { m_scissorEnabled = enable; }
+    void SetScissor(const Scissor& region) { m_scissor = region; }
+
+    // Column-major 4x4, or null to clear. Repeating the current matrix keeps
+    // the batch open.
+    void SetTransform(const float* matrix)
+    {
+        if (!matrix)
+        {
+            m_transform = NoTransform;
+            return;
+        }
+        if (m_transform != NoTransform &&
+            std::memcmp(&m_transforms[static_cast<size_t>(m_transform) * 16], matrix, 16 * sizeof(float)) == 0)
+            return;
+        m_transforms.insert(m_transforms.end(), matrix, matrix + 16);
+        m_transform = static_cast<int>(m_transforms.size() / 16 - 1);
+    }
+
+    // --- Geometry ---
+
+    // 'uv' remaps the UVs into an atlas page; 'texture' is then the page
+    void Add(const BatchVertex* vertices, size_t vertexCount, const int* indices, size_t indexCount,
+             float tx, float ty, uintptr_t texture, const UvTransform* uv = nullptr)
+    {
+        if (vertexCount == 0 || indexCount == 0) return;
+
+        const uint32_t base = static_cast<uint32_t>(m_vertices.size());
+        const uint32_t firstIndex = static_cast<uint32_t>(m_indices.size());
+        m_vertices.resize(m_vertices.size() + vertexCount);
+        if (uv)
+            BakeTranslationUv(vertices, m_vertices.data() + base, vertexCount, tx, ty, *uv);
+        else
+            BakeTranslation(vertices, m_vertices.data() + base, vertexCount, tx, ty);
+        m_indices.resize(m_indices.size() + indexCount);
+        RebaseIndices(indices, m_indices.data() + firstIndex, indexCount, base);
+
+        if (!m_batches.empty() && Matches(m_batches.back(), texture))
+        {
+            m_batches.back().indexCount += static_cast<uint32_t>(indexCount);
+            m_batches.back().geometries++;
+        }
+        else
+        {
+            Batch b;
+            b.texture = texture;
+            b.scissorEnabled = m_scissorEnabled;
+            b.scissor = m_scissor;
+            b.transform = m_transform;
+            b.firstIndex = firstIndex;
+            b.indexCount = static_cast<uint32_t>(indexCount);
+            b.geometries = 1;
+            m_batches.push_back(b);
+        }
+        m_geometries++;
+    }
+
+    // Uploads the stream and draws every batch, then starts a new frame.
+    // Scissor and transform state carry over. Returns the draws issued.
+    template <typename Backend>
+    size_t Flush(Backend& backend)
+    {
+        size_t draws = 0;
+        if (!m_batches.empty() &&
+            backend.Upload(m_vertices.data(), m_vertices.size(), m_indices.data(), m_indices.size()))
+        {
+            for (const Batch& b : m_batches)
+            {
+                const float* matrix = b.transform == NoTransform
+                    ? nullptr : &m_transforms[static_cast<size_t>(b.transform) * 16];
+                backend.Draw(b, matrix);
+                draws++;
+            }
+        }
+        m_lastGeometries = m_geometries;
+        m_lastDraws = draws;
+        Reset();
+        return draws;
+    }
+
+    // Drops the pending frame without drawing
+    void Reset()
+    {
+        m_vertices.clear();
+        m_indices.clear();
+        m_batches.clear();
+        m_geometries = 0;
+        // Keep the current transform valid for the next frame
+        if (m_transform != NoTransform)
+        {
+            std::vector<float> current(m_transforms.begin() + m_transform * 16,
+                                       m_transforms.begin() + m_transform * 16 + 16);
+            m_transforms.swap(current);
+            m_transform = 0;
+        }
+        else
+        {
+            m_transforms.clear();
+        }
+    }
+
+    // Pending frame
+    const std::vector<BatchVertex>& Vertices() const { return m_vertices; }
+    const std::vector<uint32_t>& Indices() const { return m_indices; }
+    const std::vector<Batch>& Batches() const { return m_batches; }
+
+    // Geometries submitted and draws issued by the last Flush()
+    size_t LastGeometries() const { return m_lastGeometries; }
+    size_t LastDraws() const { return m_lastDraws; }
+
+    // dst[i] = src[i] with (tx, ty) added to the position. Colour and UV
+    // bits are copied unchanged (masked, not added with zero, so no float
+    // canonicalization touches them).
+    static void BakeTranslation(const BatchVertex* src, BatchVertex* dst, size_t count, float tx, float ty)
+    {
+        size_t i = 0;
+#if defined(GEOMETRY_BATCHER_SSE2)
+        // Four vertices are 80 bytes = five 16-byte lanes; x/y sit at float
+        // offsets 0,1 | 5,6 | 10,11 | 15 | 16 of that block
+        const __m128 t0 = _mm_setr_ps(tx, ty, 0.0f, 0.0f);
+        const __m128 t1 = _mm_setr_ps(0.0f, tx, ty, 0.0f);
+        const __m128 t2 = _mm_setr_ps(0.0f, 0.0f, tx, ty);
+        const __m128 t3 = _mm_setr_ps(0.0f, 0.0f, 0.0f, tx);
+        const __m128 t4 = _mm_setr_ps(ty, 0.0f, 0.0f, 0.0f);
+        const __m128 m0 = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, 0, 0));
+        const __m128 m1 = _mm_castsi128_ps(_mm_setr_epi32(0, -1, -1, 0));
+        const __m128 m2 = _mm_castsi128_ps(_mm_setr_epi32(0, 0, -1, -1));
+        const __m128 m3 = _mm_castsi128_ps(_mm_setr_epi32(0, 0, 0, -1));
+        const __m128 m4 = _mm_castsi128_ps(_mm_setr_epi32(-1, 0, 0, 0));
+        for (; i + 4 <= count; i += 4)
+        {
+            const float* s = reinterpret_cast<const float*>(src + i);
+            float* d = reinterpret_cast<float*>(dst + i);
+            __m128 v0 = _mm_loadu_ps(s);
+            __m128 v1 = _mm_loadu_ps(s + 4);
+            __m128 v2 = _mm_loadu_ps(s + 8);
+            __m128 v3 = _mm_loadu_ps(s + 12);
+            __m128 v4 = _mm_loadu_ps(s + 16);
+            _mm_storeu_ps(d,      _mm_or_ps(_mm_and_ps(m0, _mm_add_ps(v0, t0)), _mm_andnot_ps(m0, v0)));
+            _mm_storeu_ps(d + 4,  _mm_or_ps(_mm_and_ps(m1, _mm_add_ps(v1, t1)), _mm_andnot_ps(m1, v1)));
+            _mm_storeu_ps(d + 8,  _mm_or_ps(_mm_and_ps(m2, _mm_add_ps(v2, t2)), _mm_andnot_ps(m2, v2)));
+            _mm_storeu_ps(d + 12, _mm_or_ps(_mm_and_ps(m3, _mm_add_ps(v3, t3)), _mm_andnot_ps(m3, v3)));
+            _mm_storeu_ps(d + 16, _mm_or_ps(_mm_and_ps(m4, _mm_add_ps(v4, t4)), _mm_andnot_ps(m4, v4)));
+        }
+#endif
+        BakeTranslationScalar(src + i, dst + i, count - i, tx, ty);
+    }
+
+    static void BakeTranslationScalar(const BatchVertex* src, BatchVertex* dst, size_t count, float tx, float ty)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            dst[i] = src[i];
+            dst[i].x += tx;
+            dst[i].y += ty;
+        }
+    }
+
+    // BakeTranslation plus the atlas UV remap. Each lane computes
+    // v * mul + add (mul 1 for positions), and the colour stays masked out.
+    static void BakeTranslationUv(const BatchVertex* src, BatchVertex* dst, size_t count,
+                                  float tx, float ty, const UvTransform& uv)
+    {
+        size_t i = 0;
+#if defined(GEOMETRY_BATCHER_SSE2)
+        const float su = uv.scaleU, sv = uv.scaleV, ou = uv.offsetU, ov = uv.offsetV;
+        // Lanes of four vertices: x y c u | v x y c | u v x y | c u v x | y c u v
+        const __m128 mul[5] = {
+            _mm_setr_ps(1.0f, 1.0f, 0.0f, su), _mm_setr_ps(sv, 1.0f, 1.0f, 0.0f),
+            _mm_setr_ps(su, sv, 1.0f, 1.0f),   _mm_setr_ps(0.0f, su, sv, 1.0f),
+            _mm_setr_ps(1.0f, 0.0f, su, sv) };
+        const __m128 add[5] = {
+            _mm_setr_ps(tx, ty, 0.0f, ou),     _mm_setr_ps(ov, tx, ty, 0.0f),
+            _mm_setr_ps(ou, ov, tx, ty),       _mm_setr_ps(0.0f, ou, ov, tx),
+            _mm_setr_ps(ty, 0.0f, ou, ov) };
+        const __m128 mask[5] = {
+            _mm_castsi128_ps(_mm_setr_epi32(-1, -1, 0, -1)), _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0)),
+            _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, -1)), _mm_castsi128_ps(_mm_setr_epi32(0, -1, -1, -1)),
+            _mm_castsi128_ps(_mm_setr_epi32(-1, 0, -1, -1)) };
+        for (; i + 4 <= count; i += 4)
+        {
+            const float* s = reinterpret_cast<const float*>(src + i);
+            float* d = reinterpret_cast<float*>(dst + i);
+            for (int lane = 0; lane < 5; lane++)
+            {
+                __m128 v = _mm_loadu_ps(s + lane * 4);
+                __m128 r = _mm_add_ps(_mm_mul_ps(v, mul[lane]), add[lane]);
+                _mm_storeu_ps(d + lane * 4, _mm_or_ps(_mm_and_ps(mask[lane], r), _mm_andnot_ps(mask[lane], v)));
+            }
+        }
+#endif
+        BakeTranslationUvScalar(src + i, dst + i, count - i, tx, ty, uv);
+    }
+
+    static void BakeTranslationUvScalar(const BatchVertex* src, BatchVertex* dst, size_t count,
+                                        float tx, float ty, const UvTransform& uv)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            dst[i] = src[i];
+            dst[i].x += tx;
+            dst[i].y += ty;
+            dst[i].u = src[i].u * uv.scaleU + uv.offsetU;
+            dst[i].v = src[i].v * uv.scaleV + uv.offsetV;
+        }
+    }
+
+    // dst[i] = src[i] + base
+    static void RebaseIndices(const int* src, uint32_t* dst, size_t count, uint32_t base)
+    {
+        size_t i = 0;
+#if defined(GEOMETRY_BATCHER_SSE2)
+        const __m128i b = _mm_set1_epi32(static_cast<int>(base));
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_add_epi32(v, b));
+        }
+#endif
+        for (; i < count; i++)
+            dst[i] = static_cast<uint32_t>(src[i]) + base;
+    }
+
+private:
+    bool Matches(const Batch& b, uintptr_t texture) const
+    {
+        return b.texture == texture && b.scissorEnabled == m_scissorEnabled &&
+               (!m_scissorEnabled || b.scissor == m_scissor) && b.transform == m_transform;
+    }
+
+    std::vector<BatchVertex> m_vertices;
+    std::vector<uint32_t> m_indices;
+    std::vector<Batch> m_batches;
+    std::vector<float> m_transforms; // 16 floats per transform set this frame
+
+    bool m_scissorEnabled = false;
+    Scissor m_scissor;
+    int m_transform = NoTransform;
+
+    size_t m_geometries = 0;
+    size_t m_lastGeometries = 0;
+    size_t m_lastDraws = 0;
+};
@@ -0,0 +1,271 @@
+#include "OverlayApp.h"
+#include "HeadlessScript.h"
+#include "Logger.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Headless overlay (OVERLAY_HEADLESS): runs the real OverlayApp main loop
+// against scripted host traffic (HeadlessScript.h) and reports what the
+// rendered frames cost. Waits are skipped on the app's clock, so a run
+// covers minutes of overlay time in a fraction of it.
+//
+//   OverlayHeadless [--ticks N] [--sources N] [--fonts DIR] [--log PATH]
+//                   [--json PATH] [--max-p95-us US] [--dump-commands PATH]
+//                   [--screenshot PATH] [--idle-gap S]
+//
+// --dump-commands writes the last drawn frame's RenderCommandList to PATH
+// (binary, for replay) and PATH.txt (one command per line, for diffing).
+// --screenshot draws every frame with the SoftwareRasterizer as well and
+// writes the last one to PATH (binary PPM); frame costs then include it.
+// --idle-gap hides the panel after the run, leaves the app idle for S
+// seconds of its clock and then sends show_notification, which must show.
+//
+// Exits non-zero if init fails, nothing rendered, the panel was never laid
+// out, the p95 frame time exceeds --max-p95-us (CI regression gate) or the
+// --idle-gap notification was dropped.
+
+struct HeadlessArgs
+{
+    uint64_t ticks = 3000;
+    HeadlessScript::Options script;
+    std::string fontDir;
+    std::string logPath;
+    std::string jsonPath;
+    std::string dumpPath;
+    std::string screenshotPath;
+    double maxP95Us = 0.0;
+    double idleGapS = 0.0;
+};
+
+static bool ParseArgs(int argc, char** argv, HeadlessArgs& args)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (!value)
+        {
+            fprintf(stderr, "missing value for %s\n", arg.c_str());
+            return false;
+        }
+        if (arg == "--ticks") args.ticks = std::strtoull(value, nullptr, 10);
+        else if (arg == "--sources") args.script.sources = std::atoi(value);
+        else if (arg == "--fonts") args.fontDir = value;
+        else if (arg == "--log") args.logPath = value;
+        else if (arg == "--json") args.jsonPath = value;
+        else if (arg == "--max-p95-us") args.maxP95Us = std::atof(value);
+        else if (arg == "--dump-commands") args.dumpPath = value;
+        else if (arg == "--screenshot") args.screenshotPath = value;
+        else if (arg == "--idle-gap") args.idleGapS = std::atof(value);
+        else
+        {
+            fprintf(stderr, "unknown option %s\n", arg.c_str());
+            return false;
+        }
+        i++;
+    }
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    HeadlessArgs args;
+    if (!ParseArgs(argc, argv, args))
+        return 2;
+
+    StartupTimeline::Get().Start();
+    TraceRecorder::SetThreadName("main");
+    if (!args.logPath.empty())
+    {
+        Logger::Options options;
+        options.path = args.logPath;
+        Logger::Get().Start(options);
+    }
+
+    OverlayApp app;
+    if (!args.fontDir.empty())
+        app.GetRenderer().SetFontDirectory(args.fontDir);
+    if (!args.screenshotPath.empty())
+        app.GetRenderer().EnableRasterizer();
+    if (!app.Init("loopback"))
+    {
+        fprintf(stderr, "headless: init failed\n");
+        Logger::Get().Stop();
+        return 1;
+    }
+
+    LoopbackIpc& ipc = app.GetIpc();
+    const HeadlessRenderer& renderer = app.GetRenderer();
+    LatencyHistogram frameCost; // whole Tick() of iterations that presented
+    uint64_t geometries = 0, batches = 0, draws = 0, stateChanges = 0, verticesDrawn = 0, sent = 0;
+    uint64_t idleFrames = 0, idleBatches = 0, idleDraws = 0; // drawn, but the layer was only composited
+    uint64_t tick = 0;
+    for (; tick < args.ticks; tick++)
+    {
+        for (auto& msg : HeadlessScript::MessagesForTick(tick, args.script))
+            ipc.Inject(std::move(msg));
+        if (const char* tab = HeadlessScript::TabForTick(tick))
+            app.GetDataModel().SelectTab(tab);
+
+        uint64_t presents = renderer.Presents();
+        uint64_t start = FrameProfiler::NowNs();
+        if (!app.Tick())
+            break;
+        uint64_t ns = FrameProfiler::NowNs() - start;
+        if (renderer.Presents() != presents)
+        {
+            frameCost.Record(ns);
+            const auto& counts = renderer.GetRenderInterface().LastFrame();
+            geometries += counts.geometries;
+            batches += counts.batches;
+            draws += counts.drawCalls;
+            if (renderer.LastFrameChanged() && counts.dirtyPixels == 0)
+            {
+                idleFrames++;
+                idleBatches += counts.batches;
+                idleDraws += counts.drawCalls;
+            }
+            stateChanges += renderer.GetRenderInterface().LastFrame().stateChanges;
+            verticesDrawn += renderer.GetRenderInterface().LastFrame().verticesDrawn;
+        }
+        sent += ipc.TakeSent().size();
+        app.WaitForWork();
+    }
+
+    // A notification that wakes the hidden overlay after a long sleep gets
+    // that whole sleep as its first tick's dt
+    bool idleNotificationShown = true;
+    if (args.idleGapS > 0.0)
+    {
+        ipc.Inject({"hide_overlay", {}});
+        app.Tick();
+        app.WaitForWork();
+        app.AdvanceClock(args.idleGapS);
+        ipc.Inject({"show_notification", {{"text", "Replay saved"}}});
+        app.Tick();
+        idleNotificationShown = app.GetDataModel().IsNotificationActive();
+        printf("headless: notification after %.0f s idle %s\n", args.idleGapS,
+               idleNotificationShown ? "shown" : "dropped");
+    }
+
+    const auto& totals = renderer.GetRenderInterface().GetTotals();
+    const auto& arena = renderer.GetRenderInterface().GetGeometryArena();
+    FrameProfiler::Summary frame = FrameProfiler::Summarize(frameCost);
+    const uint64_t frames = frame.count;
+    const int panelW = app.GetWindow().PanelWidth();
+    const int panelH = app.GetWindow().PanelHeight();
+    const int surfaceW = app.GetWindow().BoundsWidth();
+    const int surfaceH = app.GetWindow().BoundsHeight();
+    const double screenPixels = static_cast<double>(app.GetWindow().GetWidth()) * app.GetWindow().GetHeight();
+    const double surfaceFraction = screenPixels > 0.0 ? surfaceW * static_cast<double>(surfaceH) / screenPixels : 0.0;
+
+    nlohmann::json report = {
+        {"ticks", tick},
+        {"frames", frames},
+        {"frames_unchanged", renderer.SkippedPresents()},
+        {"frame_us", FrameProfiler::ToJson(frame)},
+        {"phases", app.GetFrameProfiler().Report()},
+        {"geometries_per_frame", frames ? static_cast<double>(geometries) / frames : 0.0},
+        {"batches_per_frame", frames ? static_cast<double>(batches) / frames : 0.0},
+        {"draw_calls_per_frame", frames ? static_cast<double>(draws) / frames : 0.0},
+        {"layer", {
+            {"composite_only_frames", idleFrames},
+            {"batches_per_composite_only_frame", idleFrames ? static_cast<double>(idleBatches) / idleFrames : 0.0},
+            {"draws_per_composite_only_frame", idleFrames ? static_cast<double>(idleDraws) / idleFrames : 0.0},
+        }},
+        {"state_changes_per_frame", frames ? static_cast<double>(stateChanges) / frames : 0.0},
+        {"vertices_per_frame", frames ? static_cast<double>(verticesDrawn) / frames : 0.0},
+        {"geometry_compiled", totals.geometryCompiled},
+        {"vertex_bytes_compiled", totals.vertexBytesCompiled},
+        {"index_bytes_compiled", totals.indexBytesCompiled},
+        {"live_geometry_bytes", renderer.GetRenderInterface().LiveGeometryBytes()},
+        {"geometry_arena", {
+            {"bytes", arena.CapacityBytes()},
+            {"vertex_pages", arena.VertexAllocator().GetStats().pages},
+            {"vertex_fragmentation", arena.VertexAllocator().GetStats().Fragmentation()},
+            {"index_fragmentation", arena.IndexAllocator().GetStats().Fragmentation()},
+        }},
+        {"texture_bytes", renderer.GetUiTextureBytes()},
+        {"atlas", {
+            {"pages", renderer.GetRenderInterface().GetAtlas().GetStats().pages},
+            {"entries", renderer.GetRenderInterface().GetAtlas().GetStats().entries},
+            {"occupancy", renderer.GetRenderInterface().GetAtlas().GetStats().Occupancy()},
+        }},
+        {"font_faces", renderer.LoadedFontFaces()},
+        {"messages_sent", sent},
+        {"panel", {panelW, panelH}},
+        {"surface", {
+            {"size", {surfaceW, surfaceH}},
+            {"screen_fraction", surfaceFraction},
+            {"placements", app.GetSurfaceLayout().Changes()},
+        }},
+        {"startup", StartupTimeline::Get().Report()},
+    };
+
+    printf("headless: %llu ticks, %llu frames (%llu unchanged, not drawn); frame us mean %.0f p50 %.0f p95 %.0f p99 %.0f max %.0f\n",
+           static_cast<unsigned long long>(tick), static_cast<unsigned long long>(frames),
+           static_cast<unsigned long long>(renderer.SkippedPresents()), frame.meanUs, frame.p50Us, frame.p95Us, frame.p99Us, frame.maxUs);
+    printf("headless: %.1f geometries -> %.1f batches -> %.1f draws/frame (%llu frames only composited the UI layer), %.1f state changes/frame, %.0f vertices/frame, %llu KB vertices + %llu KB indices compiled, "
+           "%zu KB textures, panel %dx%d\n",
+           report["geometries_per_frame"].get<double>(), report["batches_per_frame"].get<double>(),
+           report["draw_calls_per_frame"].get<double>(), static_cast<unsigned long long>(idleFrames),
+           report["state_changes_per_frame"].get<double>(),
+           report["vertices_per_frame"].get<double>(),
+           static_cast<unsigned long long>(totals.vertexBytesCompiled / 1024),
+           static_cast<unsigned long long>(totals.indexBytesCompiled / 1024),
+           renderer.GetUiTextureBytes() / 1024, panelW, panelH);
+    printf("headless: surface %dx%d (%.1f%% of the screen), %llu placements\n", surfaceW, surfaceH,
+           surfaceFraction * 100.0, static_cast<unsigned long long>(app.GetSurfaceLayout().Changes()));
+    printf("headless: %s\n", app.GetFrameProfiler().FormatLine().c_str());
+    if (const SoftwareRasterizer* raster = renderer.GetRasterizer())
+    {
+        const auto& r = raster->GetTotals();
+        report["raster"] = {
+            {"frames", r.frames},
+            {"frames_per_s", r.FramesPerSecond()},
+            {"mpixels_per_s", r.MegapixelsPerSecond()},
+            {"fragments_per_frame", r.frames ? static_cast<double>(r.fragments) / r.frames : 0.0},
+            {"checksum", raster->Checksum()},
+        };
+        printf("headless: rasterized %llu frames at %dx%d, %.0f frames/s, %.0f Mpixels/s\n",
+               static_cast<unsigned long long>(r.frames), raster->Width(), raster->Height(),
+               r.FramesPerSecond(), r.MegapixelsPerSecond());
+    }
+
+    if (!args.jsonPath.empty())
+        std::ofstream(args.jsonPath) << report.dump(2) << "\n";
+    if (!args.dumpPath.empty())
+    {
+        const RenderCommandList& commands = renderer.GetRenderInterface().LastCommands();
+        std::vector<uint8_t> bytes = commands.Serialize();
+        std::ofstream(args.dumpPath, std::ios::binary)
+            .write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        std::ofstream(args.dumpPath + ".txt") << commands.Describe();
+    }
+    if (!args.screenshotPath.empty() && !renderer.WriteScreenshot(args.screenshotPath))
+        fprintf(stderr, "headless: could not write %s\n", args.screenshotPath.c_str());
+
+    app.Shutdown();
+    Logger::Get().Stop();
+
+    if (frames == 0 || panelW <= 0 || panelH <= 0)
+    {
+        fprintf(stderr, "headless: no frame laid out the panel\n");
+        return 1;
+    }
+    if (args.maxP95Us > 0.0 && frame.p95Us > args.maxP95Us)
+    {
+        fprintf(stderr, "headless: p95 frame %.0f us exceeds %.0f us\n", frame.p95Us, args.maxP95Us);
+        return 1;
+    }
+    if (!idleNotificationShown)
+    {
+        fprintf(stderr, "headless: show_notification after an idle gap was dropped\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,197 @@
+#include "HeadlessRenderer.h"
+#include "Base64.h"
+#include "Logger.h"
+#include "OverlayAssets.h"
+#include "StartupTimeline.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// stb_image for the preview PNG, when rasterizing
+#define STB_IMAGE_IMPLEMENTATION
+#define STBI_ONLY_PNG
+#include "stb_image.h"
+
+// --- System interface ---
+
+double HeadlessSystemInterface::GetElapsedTime()
+{
+    static const auto start = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+bool HeadlessSystemInterface::LogMessage(Rml::Log::Type type, const Rml::String& message)
+{
+    LogLevel level = LogLevel::Info;
+    switch (type)
+    {
+    case Rml::Log::LT_ERROR:
+    case Rml::Log::LT_ASSERT:  level = LogLevel::Error; break;
+    case Rml::Log::LT_WARNING: level = LogLevel::Warn;  break;
+    case Rml::Log::LT_DEBUG:   level = LogLevel::Debug; break;
+    default: break;
+    }
+    Logger::Get().Write(level, "RmlUi", message);
+    return true;
+}
+
+// --- Renderer ---
+
+bool HeadlessRenderer::Init(void* /*hwnd*/, int width, int height)
+{
+    StartupTimeline::Get().Mark("d3d"); // no device; keeps the timeline's shape
+
+    Rml::SetRenderInterface(&m_rmlRender);
+    Rml::SetSystemInterface(&m_rmlSystem);
+    if (!Rml::Initialise())
+        return false;
+    StartupTimeline::Get().Mark("rml_init");
+
+    // Segoe UI is not available off Windows; any sans face gives comparable
+    // layout and glyph counts. Icons fall back to the text face.
+    {
+        using Rml::Style::FontWeight;
+        static constexpr struct { const char* regular; const char* bold; } Faces[] = {
+            { "dejavu/DejaVuSans.ttf", "dejavu/DejaVuSans-Bold.ttf" },
+            { "DejaVuSans.ttf", "DejaVuSans-Bold.ttf" },
+            { "liberation/LiberationSans-Regular.ttf", "liberation/LiberationSans-Bold.ttf" },
+            { "LiberationSans-Regular.ttf", "LiberationSans-Bold.ttf" },
+        };
+        const std::string base = m_fontDir.empty() ? std::string() : m_fontDir + "/";
+        for (const auto& face : Faces)
+        {
+            if (!LoadMappedFontFace(base + face.regular, "Segoe UI", FontWeight::Normal, true))
+                continue;
+            LoadMappedFontFace(base + face.bold, "Segoe UI", FontWeight::Bold, false);
+            break;
+        }
+        if (m_fontFiles.empty())
+            LOG_WARN("headless", "No font found under '%s'; text will not be laid out", m_fontDir.c_str());
+    }
+    StartupTimeline::Get().Mark("fonts");
+
+    m_rmlRender.SetViewport(width, height);
+    if (m_rasterize)
+        m_rmlRender.EnableRasterizer(width, height);
+    m_rmlContext = Rml::CreateContext("main", Rml::Vector2i(width, height));
+    return m_rmlContext != nullptr;
+}
+
+bool HeadlessRenderer::LoadMappedFontFace(const std::string& path, const char* family,
+                                          Rml::Style::FontWeight weight, bool fallback)
+{
+    MappedFile file;
+    if (!file.Open(path))
+        return false;
+    Rml::Span<const Rml::byte> data(file.Data(), file.Size());
+    if (!Rml::LoadFontFace(data, family, Rml::Style::FontStyle::Normal, weight, fallback))
+        return false;
+    m_fontFiles.push_back(std::move(file));
+    return true;
+}
+
+void HeadlessRenderer::Shutdown()
+{
+    if (m_rmlContext)
+    {
+        Rml::RemoveContext("main");
+        m_rmlContext = nullptr;
+    }
+    Rml::Shutdown();
+    m_fontFiles.clear();
+}
+
+void HeadlessRenderer::Render()
+{
+    if (m_rmlContext)
+    {
+        m_rmlContext->Render();
+        m_frameChanged = m_rmlRender.Flush();
+        if (m_frameChanged)
+            m_rmlRender.Submit();
+    }
+}
+
+void HeadlessRenderer::Present()
+{
+    m_rmlRender.EndFrame();
+    m_presents++;
+    if (!m_frameChanged)
+        m_skippedPresents++;
+}
+
+bool HeadlessRenderer::WriteScreenshot(const std::string& path) const
+{
+    const SoftwareRasterizer* raster = GetRasterizer();
+    return raster && raster->WritePpm(path);
+}
+
+Rml::ElementDocument* HeadlessRenderer::LoadOverlayDocument()
+{
+    if (!m_rmlContext) return nullptr;
+    std::string_view rml = GetOverlayDocument();
+    auto* doc = m_rmlContext->LoadDocumentFromMemory(Rml::String(rml));
+    if (doc)
+        doc->Show();
+    return doc;
+}
+
+void HeadlessRenderer::WarmGlyphs(const std::string& rml)
+{
+    if (!m_rmlContext) return;
+    Rml::ElementDocument* doc = m_rmlContext->LoadDocumentFromMemory(rml);
+    if (!doc) return;
+    doc->Show(Rml::ModalFlag::None, Rml::FocusFlag::None);
+    m_rmlContext->Update();
+    m_rmlContext->Render();
+    m_rmlRender.DiscardFrame();
+    doc->Close();
+    m_rmlContext->Update();
+}
+
+// --- Preview ---
+
+// Decodes just enough base64 for the PNG signature and IHDR chunk, or all
+// of it when the renderer is rasterizing
+void NullPreviewRenderer::UpdateFromBase64(HeadlessRenderer& renderer, const std::string& base64Data)
+{
+    Release();
+    const size_t HeaderSize = 24;
+    std::string_view encoded(base64Data);
+    if (!renderer.Rasterizing())
+        encoded = encoded.substr(0, HeaderSize / 3 * 4);
+    if (!Base64::Decode(encoded, m_png))
+        return;
+    const std::vector<unsigned char>& png = m_png;
+    static constexpr unsigned char Signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    if (png.size() < HeaderSize || std::memcmp(png.data(), Signature, sizeof(Signature)) != 0)
+        return;
+    auto be32 = [&](int at) {
+        return static_cast<int>((png[at] << 24) | (png[at + 1] << 16) | (png[at + 2] << 8) | png[at + 3]);
+    };
+    m_width = be32(16);
+    m_height = be32(20);
+    if (m_width <= 0 || m_height <= 0)
+    {
+        m_width = m_height = 0;
+        return;
+    }
+    if (!renderer.Rasterizing())
+        return;
+
+    // Uploaded as decoded, like PreviewRenderer
+    int w = 0, h = 0, channels = 0;
+    unsigned char* pixels = stbi_load_from_memory(png.data(), static_cast<int>(png.size()), &w, &h, &channels, 4);
+    if (!pixels)
+    {
+        m_width = m_height = 0;
+        return;
+    }
+    m_image.width = m_width = w;
+    m_image.height = m_height = h;
+    m_image.texels.resize(static_cast<size_t>(w) * h);
+    std::memcpy(m_image.texels.data(), pixels, m_image.texels.size() * 4);
+    stbi_image_free(pixels);
+}
@@ -0,0 +1,126 @@
+#pragma once
+#include <RmlUi/Core.h>
+#include <RmlUi/Core/SystemInterface.h>
+#include "NullRenderInterface.h"
+#include "MappedFile.h"
+#include <string>
+#include <vector>
+
+namespace Rml { class ElementDocument; }
+
+// RmlUi system interface for the headless build: steady clock, log to the
+// async logger, process-local clipboard
+class HeadlessSystemInterface : public Rml::SystemInterface
+{
+public:
+    double GetElapsedTime() override;
+    bool LogMessage(Rml::Log::Type type, const Rml::String& message) override;
+    void SetClipboardText(const Rml::String& text) override { m_clipboard = text; }
+    void GetClipboardText(Rml::String& text) override { text = m_clipboard; }
+
+private:
+    Rml::String m_clipboard;
+};
+
+// Stand-in for DxRenderer when built with OVERLAY_HEADLESS: runs RmlUi
+// (layout, data bindings, geometry generation) on top of
+// NullRenderInterface, so the whole frame except the GPU work executes and
+// can be measured on a machine without Win32 or D3D11.
+class HeadlessRenderer
+{
+public:
+    // Directory searched for the text fonts (DejaVu / Liberation Sans), which
+    // stand in for Segoe UI. Call before Init().
+    void SetFontDirectory(const std::string& dir) { m_fontDir = dir; }
+
+    // Also draws each rendered frame on the CPU (SoftwareRasterizer) and
+    // decodes preview frames, for screenshots. Call before Init().
+    void EnableRasterizer() { m_rasterize = true; }
+    bool Rasterizing() const { return m_rasterize; }
+
+    bool Init(void* hwnd, int width, int height);
+    void Shutdown();
+
+    void BeginFrame(float = 0.0f, float = 0.0f, float = 0.0f, float = 0.0f) {}
+    void Render();   // replays only if the UI's command list changed
+    void Present();  // counted as skipped after an unchanged frame
+
+    // As DxRenderer: the layer covers only this part of the UI
+    void SetSurfaceBounds(int x, int y, int width, int height)
+    {
+        if (width > 0 && height > 0)
+            m_rmlRender.SetViewport(width, height, x, y);
+    }
+
+    Rml::Context* GetRmlContext() const { return m_rmlContext; }
+    Rml::ElementDocument* LoadOverlayDocument();
+    void WarmGlyphs(const std::string& rml);
+
+    // The preview "texture" is NullPreviewRenderer's image (empty unless
+    // rasterizing)
+    void SetPreviewTexture(const void* texture, int w, int h)
+    {
+        m_previewWidth = w;
+        m_previewHeight = h;
+        m_rmlRender.UpdatePreviewTexture(static_cast<const SoftwareRasterizer::Image*>(texture));
+    }
+    void ClearPreviewTexture()
+    {
+        m_previewWidth = m_previewHeight = 0;
+        m_rmlRender.UpdatePreviewTexture();
+    }
+    size_t GetUiTextureBytes() const { return m_rmlRender.GetTextureBytes(); }
+    size_t GetLastDrawCalls() const { return m_rmlRender.LastFrame().batches; }
+    size_t GetLastStateChanges() const { return m_rmlRender.LastFrame().stateChanges; }
+    size_t GetLastSubmittedDraws() const { return m_rmlRender.LastFrame().drawCalls; }
+
+    const NullRenderInterface& GetRenderInterface() const { return m_rmlRender; }
+    uint64_t Presents() const { return m_presents; }          // Present() calls
+    uint64_t SkippedPresents() const { return m_skippedPresents; }
+    bool LastFrameChanged() const { return m_frameChanged; }
+    size_t LoadedFontFaces() const { return m_fontFiles.size(); }
+
+    // Null unless EnableRasterizer() was called
+    const SoftwareRasterizer* GetRasterizer() const { return m_rmlRender.GetRasterizer(); }
+    bool WriteScreenshot(const std::string& path) const;
+
+private:
+    bool LoadMappedFontFace(const std::string& path, const char* family,
+                            Rml::Style::FontWeight weight, bool fallback);
+
+    NullRenderInterface m_rmlRender;
+    HeadlessSystemInterface m_rmlSystem;
+    std::vector<MappedFile> m_fontFiles;
+    Rml::Context* m_rmlContext = nullptr;
+    std::string m_fontDir = "/usr/share/fonts/truetype";
+    uint64_t m_presents = 0;
+    uint64_t m_skippedPresents = 0;
+    bool m_frameChanged = true;
+    bool m_rasterize = false;
+    int m_previewWidth = 0;
+    int m_previewHeight = 0;
+};
+
+// Stand-in for PreviewRenderer: reads the frame size from the PNG header
+// and keeps no pixels, unless the renderer is rasterizing; then the PNG is
+// decoded and the image is the "texture"
+class NullPreviewRenderer
+{
+public:
+    void UpdateFromBase64(HeadlessRenderer& renderer, const std::string& base64Data);
+    void Release()
+    {
+        m_width = m_height = 0;
+        m_image = {};
+    }
+
+    const void* GetTexture() const { return m_width > 0 ? &m_image : nullptr; }
+    int GetWidth()  const { return m_width; }
+    int GetHeight() const { return m_height; }
+
+private:
+    int m_width  = 0;
+    int m_height = 0;
+    SoftwareRasterizer::Image m_image;
+    std::vector<unsigned char> m_png; // decoded payload, reused across frames
+};
@@ -0,0 +1,127 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "IpcMessage.h"
+
+// Host traffic for headless runs: a deterministic stand-in for the WPF host
+// that the driver feeds through LoopbackIpc, one batch per main-loop tick.
+//
+//   tick 0         config_update, full state_update, show_overlay
+//   every 6 ticks  state_update with moving volumes and one toggled source
+//   every 60       stats_response
+//   every 240      show_notification
+//
+// Tab switches (every TabInterval ticks, cycling TabOrder) are not IPC; the
+// driver applies them through the data model.
+
+namespace HeadlessScript
+{
+    struct Options
+    {
+        int sources = 24; // scene items, also used for the audio mixer
+        int scenes = 12;
+    };
+
+    inline constexpr int StateInterval = 6;
+    inline constexpr int StatsInterval = 60;
+    inline constexpr int NotificationInterval = 240;
+    inline constexpr int TabInterval = 300;
+    inline constexpr const char* TabOrder[] = {
+        "main", "sources", "audio", "filters", "transitions", "stats", "settings",
+    };
+
+    // Tab the driver should select at 'tick', or nullptr
+    inline const char* TabForTick(uint64_t tick)
+    {
+        if (tick == 0 || tick % TabInterval != 0) return nullptr;
+        constexpr uint64_t count = sizeof(TabOrder) / sizeof(TabOrder[0]);
+        return TabOrder[(tick / TabInterval) % count];
+    }
+
+    inline nlohmann::json FullState(const Options& options)
+    {
+        nlohmann::json scenes = nlohmann::json::array();
+        for (int i = 0; i < options.scenes; i++) scenes.push_back("Scene " + std::to_string(i + 1));
+
+        nlohmann::json sources = nlohmann::json::array();
+        nlohmann::json audio = nlohmann::json::array();
+        for (int i = 0; i < options.sources; i++)
+        {
+            std::string name = "Source " + std::to_string(i + 1);
+            sources.push_back({
+                {"id", i + 1}, {"name", name}, {"isVisible", i % 3 != 0},
+                {"isLocked", i % 5 == 0}, {"sourceKind", i % 2 ? "image_source" : "game_capture"},
+            });
+            audio.push_back({{"name", name}, {"volumeMul", 1.0}, {"isMuted", false}});
+        }
+
+        return {
+            {"connected", true},
+            {"currentScene", "Scene 1"},
+            {"isStreaming", false},
+            {"isRecording", false},
+            {"isRecordingPaused", false},
+            {"isBufferActive", true},
+            {"isVirtualCamActive", false},
+            {"scenes", scenes},
+            {"sources", sources},
+            {"audio", audio},
+            {"currentTransition", "Fade"},
+            {"transitionDuration", 300},
+            {"transitions", {"Cut", "Fade", "Swipe", "Slide"}},
+            {"currentProfile", "Default"},
+            {"profiles", {"Default", "Streaming"}},
+            {"currentSceneCollection", "Default"},
+            {"sceneCollections", {"Default"}},
+        };
+    }
+
+    // The periodic delta: volumes drift, one source's visibility flips
+    inline nlohmann::json StateDelta(uint64_t tick, const Options& options)
+    {
+        nlohmann::json state = FullState(options);
+        double phase = static_cast<double>(tick) * 0.05;
+        for (size_t i = 0; i < state["audio"].size(); i++)
+            state["audio"][i]["volumeMul"] = 0.5 + 0.5 * std::sin(phase + static_cast<double>(i));
+        if (options.sources > 0)
+        {
+            size_t flip = static_cast<size_t>(tick / StateInterval) % static_cast<size_t>(options.sources);
+            auto& item = state["sources"][flip];
+            item["isVisible"] = !item["isVisible"].get<bool>();
+        }
+        return state;
+    }
+
+    inline std::vector<IpcMessage> MessagesForTick(uint64_t tick, const Options& options)
+    {
+        std::vector<IpcMessage> out;
+        if (tick == 0)
+        {
+            out.push_back({"config_update", {
+                {"showRecIndicator", true}, {"recIndicatorPosition", "top-right"},
+                {"showNotifications", true}, {"notificationDuration", 2.0},
+            }});
+            out.push_back({"state_update", FullState(options)});
+            out.push_back({"show_overlay", {}});
+            return out;
+        }
+        if (tick % StateInterval == 0)
+            out.push_back({"state_update", StateDelta(tick, options)});
+        if (tick % StatsInterval == 0)
+        {
+            double t = static_cast<double>(tick);
+            out.push_back({"stats_response", {
+                {"cpuUsage", 12.0 + std::fmod(t, 7.0)}, {"memoryUsage", 512.0},
+                {"availableDiskSpace", 120000.0}, {"activeFps", 60.0},
+                {"averageFrameRenderTime", 1.5}, {"renderSkippedFrames", 0},
+                {"renderTotalFrames", static_cast<int>(tick)},
+                {"outputSkippedFrames", 0}, {"outputTotalFrames", static_cast<int>(tick)},
+            }});
+        }
+        if (tick % NotificationInterval == 0)
+            out.push_back({"show_notification", {{"text", "Replay saved"}}});
+        return out;
+    }
+}
@@ -1,7 +1,9 @@
 #include "IpcClient.h"
-#include <vector>
+#include "TraceRecorder.h"
+#include <cstring>
 
 static constexpr uint32_t MaxIpcMessageBytes = 10 * 1024 * 1024; // 10MB safety limit
+static constexpr DWORD ReadChunkBytes = 64 * 1024;
 
 bool IpcClient::Connect(const std::string& pipeName)
 {
@@ -9,13 +11,14 @@ bool IpcClient::Connect(const std::string& pipeName)
 
     std::string fullName = "\\\\.\\pipe\\" + pipeName;
 
+    // Overlapped so reads can be waited on alongside window messages
     m_pipe = CreateFileA(
         fullName.c_str(),
         GENERIC_READ | GENERIC_WRITE,
         0,
         nullptr,
         OPEN_EXISTING,
-        0,
+        FILE_FLAG_OVERLAPPED,
         nullptr);
 
     if (m_pipe == INVALID_HANDLE_VALUE)
@@ -28,7 +31,7 @@ bool IpcClient::Connect(const std::string& pipeName)
                 m_pipe = CreateFileA(
                     fullName.c_str(),
                     GENERIC_READ | GENERIC_WRITE,
-                    0, nullptr, OPEN_EXISTING, 0, nullptr);
+                    0, nullptr, OPEN_EXISTING, FILE_FLAG_OVERLAPPED, nullptr);
             }
         }
     }
@@ -40,6 +43,26 @@ bool IpcClient::Connect(const std::string& pipeName)
     DWORD mode = PIPE_READMODE_BYTE;
     SetNamedPipeHandleState(m_pipe, &mode, nullptr, nullptr);
 
+    // Manual-reset events: ReadFile/WriteFile reset them when I/O starts
+    m_readEvent = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+    m_writeEvent = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+    if (!m_readEvent || !m_writeEvent)
+    {
+        Disconnect();
+        return false;
+    }
+
+    m_chunk.resize(ReadChunkBytes);
+    m_rx.clear();
+    m_rxHead = 0;
+
+    // Start the first read so the event tracks incoming data from now on
+    if (!PumpReads())
+    {
+        Disconnect();
+        return false;
+    }
+
     return true;
 }
 
@@ -47,9 +70,29 @@ void IpcClient::Disconnect()
 {
     if (m_pipe != INVALID_HANDLE_VALUE)
     {
+        if (m_readPending)
+        {
+            // The read still targets m_chunk; wait for the cancel to land
+            DWORD ignored = 0;
+            CancelIoEx(m_pipe, &m_readOv);
+            GetOverlappedResult(m_pipe, &m_readOv, &ignored, TRUE);
+            m_readPending = false;
+        }
         CloseHandle(m_pipe);
         m_pipe = INVALID_HANDLE_VALUE;
     }
+    if (m_readEvent)
+    {
+        CloseHandle(m_readEvent);
+        m_readEvent = nullptr;
+    }
+    if (m_writeEvent)
+    {
+        CloseHandle(m_writeEvent);
+        m_writeEvent = nullptr;
+    }
+    m_rx.clear();
+    m_rxHead = 0;
 }
 
 bool IpcClient::SendMessage(const IpcMessage& msg)
@@ -84,46 +127,92 @@ bool IpcClient::SendMessage(const IpcMessage& msg)
     }
 }
 
-std::optional<IpcMessage> IpcClient::ReadMessage()
+bool IpcClient::HasBufferedFrame() const
 {
-    if (!IsConnected()) return std::nullopt;
+    size_t avail = m_rx.size() - m_rxHead;
+    if (avail < 4) return false;
+    uint32_t length = 0;
+    memcpy(&length, m_rx.data() + m_rxHead, sizeof(length));
+    // Oversized lengths count as "ready" so ReadMessage() can reject them
+    return length == 0 || length > MaxIpcMessageBytes || avail >= 4 + static_cast<size_t>(length);
+}
 
-    // Check if data is available (non-blocking peek)
-    DWORD available = 0;
-    if (!PeekNamedPipe(m_pipe, nullptr, 0, nullptr, &available, nullptr))
+bool IpcClient::HasPendingData() const
+{
+    return IsConnected() && (HasBufferedFrame() || !m_readPending);
+}
+
+bool IpcClient::PumpReads()
+{
+    for (;;)
     {
-        Disconnect();
-        return std::nullopt;
+        DWORD read = 0;
+        if (m_readPending)
+        {
+            if (!GetOverlappedResult(m_pipe, &m_readOv, &read, FALSE))
+                return GetLastError() == ERROR_IO_INCOMPLETE; // else pipe broken
+            m_readPending = false;
+            m_rx.insert(m_rx.end(), m_chunk.data(), m_chunk.data() + read);
+        }
+
+        // Leave the next read for later once a whole frame is waiting; the
+        // caller drains it and comes back here
+        if (HasBufferedFrame())
+            return true;
+
+        // Drop consumed bytes before growing the buffer
+        if (m_rxHead > 0)
+        {
+            m_rx.erase(m_rx.begin(), m_rx.begin() + m_rxHead);
+            m_rxHead = 0;
+        }
+
+        m_readOv = {};
+        m_readOv.hEvent = m_readEvent;
+        if (ReadFile(m_pipe, m_chunk.data(), ReadChunkBytes, &read, &m_readOv))
+        {
+            // Completed immediately: data was already in the pipe
+            m_rx.insert(m_rx.end(), m_chunk.data(), m_chunk.data() + read);
+            continue;
+        }
+        if (GetLastError() != ERROR_IO_PENDING)
+            return false;
+        m_readPending = true;
+        return true;
     }
+}
 
-    if (available < 4) return std::nullopt; // Not enough data for length prefix
+std::optional<IpcMessage> IpcClient::ReadMessage()
+{
+    if (!IsConnected()) return std::nullopt;
 
-    // Read 4-byte length prefix
-    uint32_t length = 0;
-    if (!ReadExact(&length, sizeof(length)))
     {
-        Disconnect();
-        return std::nullopt;
+        TRACE_SCOPE("ipc.read");
+        if (!PumpReads())
+        {
+            Disconnect();
+            return std::nullopt;
+        }
     }
 
+    if (!HasBufferedFrame()) return std::nullopt;
+
+    // 4-byte length prefix followed by the JSON body
+    uint32_t length = 0;
+    memcpy(&length, m_rx.data() + m_rxHead, sizeof(length));
     if (length == 0 || length > MaxIpcMessageBytes)
     {
         Disconnect();
         return std::nullopt;
     }
 
-    // Read JSON body
-    std::vector<char> buffer(length);
-    if (!ReadExact(buffer.data(), length))
-    {
-        Disconnect();
-        return std::nullopt;
-    }
+    const char* body = m_rx.data() + m_rxHead + 4;
+    m_rxHead += 4 + static_cast<size_t>(length);
 
     try
     {
-        std::string json(buffer.begin(), buffer.end());
-        auto j = nlohmann::json::parse(json);
+        TRACE_SCOPE("ipc.parse");
+        auto j = nlohmann::json::parse(body, body + length);
 
         IpcMessage msg;
         msg.type = j.value("type", "");
@@ -155,9 +244,16 @@ bool IpcClient::WriteExact(const void* data, DWORD size)
 
     while (remaining > 0)
     {
+        OVERLAPPED ov = {};
+        ov.hEvent = m_writeEvent;
         DWORD written = 0;
-        if (!WriteFile(m_pipe, ptr, remaining, &written, nullptr))
-            return false;
+        if (!WriteFile(m_pipe, ptr, remaining, &written, &ov))
+        {
+            if (GetLastError() != ERROR_IO_PENDING)
+                return false;
+            if (!GetOverlappedResult(m_pipe, &ov, &written, TRUE))
+                return false;
+        }
         ptr += written;
         remaining -= written;
     }
@@ -165,21 +261,3 @@ bool IpcClient::WriteExact(const void* data, DWORD size)
     FlushFileBuffers(m_pipe);
     return true;
 }
-
-bool IpcClient::ReadExact(void* data, DWORD size)
-{
-    char* ptr = static_cast<char*>(data);
-    DWORD remaining = size;
-
-    while (remaining > 0)
-    {
-        DWORD read = 0;
-        if (!ReadFile(m_pipe, ptr, remaining, &read, nullptr))
-            return false;
-        if (read == 0) return false; // pipe closed
-        ptr += read;
-        remaining -= read;
-    }
-
-    return true;
-}
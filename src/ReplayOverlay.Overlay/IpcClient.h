@@ -1,19 +1,16 @@
 #pragma once
 #include <string>
 #include <optional>
+#include <vector>
 #define WIN32_LEAN_AND_MEAN
 #include <Windows.h>
-#include <nlohmann/json.hpp>
-
-struct IpcMessage
-{
-    std::string type;
-    nlohmann::json payload;
-};
+#include "IpcMessage.h"
 
 class IpcClient
 {
 public:
+    ~IpcClient() { Disconnect(); }
+
     bool Connect(const std::string& pipeName);
     void Disconnect();
     bool IsConnected() const { return m_pipe != INVALID_HANDLE_VALUE; }
@@ -21,9 +18,29 @@ public:
     bool SendMessage(const IpcMessage& msg);
     std::optional<IpcMessage> ReadMessage(); // Non-blocking
 
+    // Signaled when the in-flight pipe read completes (data or disconnect).
+    // Null while disconnected. Lets the main loop sleep until IPC traffic.
+    HANDLE GetReadEvent() const { return m_readEvent; }
+
+    // True if ReadMessage() may return data without waiting on the event
+    // (a complete frame is buffered, or no read is in flight yet).
+    bool HasPendingData() const;
+
+    // Received bytes not yet returned by ReadMessage() (queue depth)
+    size_t BufferedBytes() const { return m_rx.size() - m_rxHead; }
+
 private:
+    bool PumpReads(); // Collect completed reads and keep one read in flight
+    bool HasBufferedFrame() const;
     bool WriteExact(const void* data, DWORD size);
-    bool ReadExact(void* data, DWORD size);
 
     HANDLE m_pipe = INVALID_HANDLE_VALUE;
+    HANDLE m_readEvent = nullptr;
+    HANDLE m_writeEvent = nullptr;
+    OVERLAPPED m_readOv = {};
+    bool m_readPending = false;
+
+    std::vector<char> m_chunk; // overlapped read target
+    std::vector<char> m_rx;    // received bytes; unparsed data starts at m_rxHead
+    size_t m_rxHead = 0;
 };
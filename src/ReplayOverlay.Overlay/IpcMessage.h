@@ -0,0 +1,10 @@
+#pragma once
+#include <string>
+#include <nlohmann/json.hpp>
+
+// One framed message on the host pipe: {"type": ..., "payload": {...}}
+struct IpcMessage
+{
+    std::string type;
+    nlohmann::json payload;
+};
@@ -0,0 +1,405 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+// Asynchronous, bounded logging.
+//
+// Callers (any thread) copy their message into slots of a fixed-size
+// lock-free MPSC ring (Vyukov bounded queue) and return; they never touch
+// the file system. A message longer than one record's TextBytes takes a run
+// of consecutive slots (up to MaxMessageBytes) that the writer joins back
+// into one entry. A background writer thread drains the ring in batches,
+// adds timestamps, writes each batch with one fwrite and rotates the file
+// when it exceeds Options::maxFileBytes (path.1 .. path.N). When the ring
+// is full new messages are dropped and counted, and the writer reports the
+// count in the log.
+//
+// The writer sleeps without a timeout while the ring is empty. The first
+// record after that wakes it (taking its mutex briefly, once per burst);
+// it then lingers up to WriterLinger so a burst goes out as one batch.
+// Errors, Flush() and Stop() cut the linger short.
+//
+// Records queued before Start() are kept and written once the writer runs.
+
+enum class LogLevel : uint8_t
+{
+    Debug = 0,
+    Info,
+    Warn,
+    Error,
+};
+
+class Logger
+{
+public:
+    static constexpr size_t TextBytes = 232;             // message bytes per record
+    static constexpr size_t MaxRecordsPerMessage = 64;   // longer messages are truncated
+    static constexpr size_t MaxMessageBytes = TextBytes * MaxRecordsPerMessage;
+
+    struct Options
+    {
+        std::string path;                  // active log file
+        size_t maxFileBytes = 1024 * 1024; // rotate beyond this size
+        int keepFiles = 3;                 // rotated files kept (path.1 .. path.N)
+        LogLevel minLevel = LogLevel::Info;
+    };
+
+    explicit Logger(size_t capacity = 1024)
+    {
+        size_t cap = 1;
+        while (cap < capacity) cap <<= 1;
+        m_mask = cap - 1;
+        m_records.reset(new Record[cap]);
+        for (size_t i = 0; i < cap; i++) m_records[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    ~Logger() { Stop(); }
+
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    // Process-wide logger
+    static Logger& Get()
+    {
+        static Logger logger;
+        return logger;
+    }
+
+    static const char* LevelName(LogLevel level)
+    {
+        static constexpr const char* Names[] = { "DEBUG", "INFO", "WARN", "ERROR" };
+        return Names[static_cast<int>(level)];
+    }
+
+    // Opens the file and starts the writer thread
+    bool Start(const Options& options)
+    {
+        Stop();
+        m_options = options;
+        SetLevel(options.minLevel);
+        m_file = fopen(options.path.c_str(), "ab");
+        if (!m_file) return false;
+        fseek(m_file, 0, SEEK_END);
+        long size = ftell(m_file);
+        m_fileBytes = size > 0 ? static_cast<size_t>(size) : 0;
+
+        m_stop = false;
+        m_writer = std::thread([this] { WriterLoop(); });
+        return true;
+    }
+
+    // Drains everything queued so far, then stops the writer and closes the file
+    void Stop()
+    {
+        if (!m_writer.joinable()) return;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_wake.notify_one();
+        m_writer.join();
+        if (m_file) fclose(m_file); // null if Rotate() could not reopen it
+        m_file = nullptr;
+    }
+
+    void SetLevel(LogLevel level) { m_minLevel.store(static_cast<uint8_t>(level), std::memory_order_relaxed); }
+    bool Enabled(LogLevel level) const
+    {
+        return static_cast<uint8_t>(level) >= m_minLevel.load(std::memory_order_relaxed);
+    }
+
+    // Queue one message. 'tag' must be a string literal. Never waits on the
+    // writer; returns false if the message was filtered or dropped.
+    bool Write(LogLevel level, const char* tag, std::string_view message)
+    {
+        if (!Enabled(level)) return false;
+        size_t count = message.empty() ? 1 : (message.size() + TextBytes - 1) / TextBytes;
+        count = std::min(count, std::min(MaxRecordsPerMessage, m_mask + 1));
+        uint64_t pos;
+        if (!Claim(count, pos)) return false;
+        for (size_t i = 0; i < count; i++)
+        {
+            std::string_view chunk = message.substr(std::min(message.size(), i * TextBytes), TextBytes);
+            memcpy(Slot(pos + i).text, chunk.data(), chunk.size());
+            Publish(pos + i, level, tag, chunk.size(), i + 1 < count);
+        }
+        Notify(level);
+        return true;
+    }
+
+    // printf-style variant. Messages that fit one record are formatted on
+    // the stack; longer ones are formatted again into a heap string.
+    bool Writef(LogLevel level, const char* tag, const char* fmt, ...)
+    {
+        if (!Enabled(level)) return false;
+        char text[TextBytes];
+        va_list args, again;
+        va_start(args, fmt);
+        va_copy(again, args);
+        int n = vsnprintf(text, sizeof(text), fmt, args);
+        va_end(args);
+        bool queued;
+        if (n < 0)
+            queued = Write(level, tag, {});
+        else if (static_cast<size_t>(n) < sizeof(text))
+            queued = Write(level, tag, std::string_view(text, static_cast<size_t>(n)));
+        else
+        {
+            std::string longText(std::min(static_cast<size_t>(n), MaxMessageBytes), '\0');
+            vsnprintf(&longText[0], longText.size() + 1, fmt, again);
+            queued = Write(level, tag, longText);
+        }
+        va_end(again);
+        return queued;
+    }
+
+    // Wait until everything queued before this call is on disk (crash
+    // handler, shutdown). Returns false on timeout or if not started.
+    bool Flush(int timeoutMs = 1000)
+    {
+        if (!m_writer.joinable()) return false;
+        uint64_t target = m_enqueuePos.load(std::memory_order_acquire);
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_flushRequested = true;
+        m_wake.notify_one();
+        return m_flushed.wait_for(lock, std::chrono::milliseconds(timeoutMs), [&] {
+            return m_written >= target;
+        });
+    }
+
+    uint64_t Dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+    struct Record
+    {
+        std::atomic<uint64_t> seq{ 0 };
+        int64_t timeMs = 0;
+        const char* tag = nullptr;
+        uint16_t length = 0;
+        LogLevel level = LogLevel::Info;
+        bool more = false; // the message continues in the next record
+        char text[TextBytes];
+    };
+
+    static constexpr auto WriterLinger = std::chrono::milliseconds(50);
+
+    Record& Slot(uint64_t pos) { return m_records[pos & m_mask]; }
+
+    // Claims 'count' consecutive slots starting at 'pos'
+    bool Claim(size_t count, uint64_t& pos)
+    {
+        pos = m_enqueuePos.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            // The writer frees slots in order, so the run is free once its
+            // last slot is
+            const uint64_t last = pos + count - 1;
+            uint64_t seq = Slot(last).seq.load(std::memory_order_acquire);
+            int64_t diff = static_cast<int64_t>(seq) - static_cast<int64_t>(last);
+            if (diff == 0)
+            {
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed))
+                {
+                    Slot(pos).timeMs = NowMs();
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                m_dropped.fetch_add(1, std::memory_order_relaxed); // full
+                return false;
+            }
+            else
+            {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void Publish(uint64_t pos, LogLevel level, const char* tag, size_t length, bool more)
+    {
+        Record& r = Slot(pos);
+        r.level = level;
+        r.tag = tag;
+        r.length = static_cast<uint16_t>(length);
+        r.more = more;
+        r.seq.store(pos + 1, std::memory_order_release);
+    }
+
+    void Notify(LogLevel level)
+    {
+        // Get errors out promptly rather than after the linger
+        if (level == LogLevel::Error)
+            m_urgent.store(true, std::memory_order_relaxed);
+        // Pairs with the fence in WriterLoop(): either the writer sees the
+        // published records before it sleeps, or we see it asleep
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (level == LogLevel::Error || m_writerIdle.load(std::memory_order_relaxed))
+        {
+            // Empty critical section: the writer is either before its
+            // predicate check (and sees our records) or waiting
+            { std::lock_guard<std::mutex> lock(m_mutex); }
+            m_wake.notify_one();
+        }
+    }
+
+    static int64_t NowMs()
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    void WriterLoop()
+    {
+        std::string batch;
+        batch.reserve(64 * 1024);
+        uint64_t droppedReported = 0;
+        for (;;)
+        {
+            bool stop;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_writerIdle.store(true, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                m_wake.wait(lock, [&] { return m_stop || m_flushRequested || HasPublished(); });
+                m_writerIdle.store(false, std::memory_order_relaxed);
+                m_wake.wait_for(lock, WriterLinger, [&] {
+                    return m_stop || m_flushRequested || m_urgent.load(std::memory_order_relaxed);
+                });
+                m_urgent.store(false, std::memory_order_relaxed);
+                m_flushRequested = false;
+                stop = m_stop;
+            }
+
+            uint64_t dropped = Dropped();
+            if (dropped != droppedReported && !m_midMessage)
+            {
+                char line[96];
+                snprintf(line, sizeof(line), "%llu log messages dropped (queue full)",
+                         static_cast<unsigned long long>(dropped - droppedReported));
+                AppendLine(batch, NowMs(), LogLevel::Warn, "log", line, strlen(line));
+                droppedReported = dropped;
+            }
+
+            uint64_t drained = Drain(batch);
+            WriteBatch(batch);
+            batch.clear();
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_written = drained;
+            }
+            m_flushed.notify_all();
+            if (stop) return;
+        }
+    }
+
+    bool HasPublished() { return Slot(m_dequeuePos).seq.load(std::memory_order_acquire) == m_dequeuePos + 1; }
+
+    // Moves every published record into 'batch'; returns the dequeue position
+    uint64_t Drain(std::string& batch)
+    {
+        while (HasPublished())
+        {
+            Record& r = Slot(m_dequeuePos);
+            if (m_midMessage)
+                batch.append(r.text, r.length);
+            else
+                AppendLine(batch, r.timeMs, r.level, r.tag, r.text, r.length, !r.more);
+            if (m_midMessage && !r.more) batch += '\n';
+            m_midMessage = r.more;
+            r.seq.store(m_dequeuePos + m_mask + 1, std::memory_order_release);
+            m_dequeuePos++;
+        }
+        return m_dequeuePos;
+    }
+
+    static void AppendLine(std::string& out, int64_t timeMs, LogLevel level, const char* tag,
+                           const char* text, size_t length, bool endLine = true)
+    {
+        time_t secs = static_cast<time_t>(timeMs / 1000);
+        tm local = {};
+#if defined(_WIN32)
+        localtime_s(&local, &secs);
+#else
+        localtime_r(&secs, &local);
+#endif
+        char prefix[80];
+        size_t n = strftime(prefix, sizeof(prefix), "[%Y-%m-%d %H:%M:%S", &local);
+        snprintf(prefix + n, sizeof(prefix) - n, ".%03d] [%s] ", static_cast<int>(timeMs % 1000), LevelName(level));
+        out += prefix;
+        if (tag && *tag)
+        {
+            out += '[';
+            out += tag;
+            out += "] ";
+        }
+        out.append(text, length);
+        if (endLine) out += '\n';
+    }
+
+    void WriteBatch(const std::string& batch)
+    {
+        if (batch.empty() || !m_file) return;
+        if (m_fileBytes > 0 && m_fileBytes + batch.size() > m_options.maxFileBytes)
+            Rotate();
+        if (!m_file) return;
+        fwrite(batch.data(), 1, batch.size(), m_file);
+        fflush(m_file);
+        m_fileBytes += batch.size();
+    }
+
+    void Rotate()
+    {
+        fclose(m_file);
+        const std::string& base = m_options.path;
+        std::remove((base + "." + std::to_string(m_options.keepFiles)).c_str());
+        for (int i = m_options.keepFiles - 1; i >= 1; i--)
+            std::rename((base + "." + std::to_string(i)).c_str(), (base + "." + std::to_string(i + 1)).c_str());
+        if (m_options.keepFiles > 0)
+            std::rename(base.c_str(), (base + ".1").c_str());
+        else
+            std::remove(base.c_str());
+        m_file = fopen(base.c_str(), "wb");
+        m_fileBytes = 0;
+    }
+
+    std::unique_ptr<Record[]> m_records;
+    size_t m_mask = 0;
+    alignas(64) std::atomic<uint64_t> m_enqueuePos{ 0 };
+    alignas(64) uint64_t m_dequeuePos = 0; // writer thread only
+    bool m_midMessage = false;             // writer thread only: last record had 'more'
+    std::atomic<uint64_t> m_dropped{ 0 };
+    std::atomic<uint8_t> m_minLevel{ static_cast<uint8_t>(LogLevel::Info) };
+
+    Options m_options;
+    FILE* m_file = nullptr;
+    size_t m_fileBytes = 0;
+
+    std::thread m_writer;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_flushed;
+    bool m_stop = false;
+    bool m_flushRequested = false;
+    std::atomic<bool> m_urgent{ false };
+    std::atomic<bool> m_writerIdle{ false }; // writer waits for a first record
+    uint64_t m_written = 0;
+};
+
+#define LOG_DEBUG(tag, ...) Logger::Get().Writef(LogLevel::Debug, tag, __VA_ARGS__)
+#define LOG_INFO(tag, ...)  Logger::Get().Writef(LogLevel::Info, tag, __VA_ARGS__)
+#define LOG_WARN(tag, ...)  Logger::Get().Writef(LogLevel::Warn, tag, __VA_ARGS__)
+#define LOG_ERROR(tag, ...) Logger::Get().Writef(LogLevel::Error, tag, __VA_ARGS__)
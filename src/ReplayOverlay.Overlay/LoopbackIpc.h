@@ -0,0 +1,84 @@
+#pragma once
+#include <deque>
+#include <optional>
+#include <string>
+#include <vector>
+#include "IpcMessage.h"
+
+// In-process stand-in for IpcClient used by the headless build. The driver
+// plays the host: Inject() queues messages for ReadMessage(), and whatever
+// the overlay sends is collected for TakeSent(). Payloads are accounted at
+// their serialized size so BufferedBytes() reads like the pipe's queue depth.
+
+class LoopbackIpc
+{
+public:
+    bool Connect(const std::string& pipeName)
+    {
+        m_name = pipeName;
+        m_connected = true;
+        return true;
+    }
+
+    void Disconnect()
+    {
+        m_connected = false;
+        m_inbox.clear();
+        m_inboxBytes = 0;
+    }
+
+    bool IsConnected() const { return m_connected; }
+
+    bool SendMessage(const IpcMessage& msg)
+    {
+        if (!m_connected) return false;
+        m_sent.push_back(msg);
+        return true;
+    }
+
+    std::optional<IpcMessage> ReadMessage()
+    {
+        if (!m_connected || m_inbox.empty()) return std::nullopt;
+        Queued next = std::move(m_inbox.front());
+        m_inbox.pop_front();
+        m_inboxBytes -= next.bytes;
+        return std::move(next.msg);
+    }
+
+    // Nothing to wait on; the driver decides when messages arrive
+    std::nullptr_t GetReadEvent() const { return nullptr; }
+    bool HasPendingData() const { return m_connected && !m_inbox.empty(); }
+    size_t BufferedBytes() const { return m_inboxBytes; }
+
+    // --- Host side ---
+
+    void Inject(IpcMessage msg)
+    {
+        size_t bytes = msg.type.size() + msg.payload.dump().size();
+        m_inboxBytes += bytes;
+        m_inbox.push_back(Queued{ std::move(msg), bytes });
+    }
+
+    // Messages sent by the overlay since the last call, oldest first
+    std::vector<IpcMessage> TakeSent()
+    {
+        std::vector<IpcMessage> out;
+        out.swap(m_sent);
+        return out;
+    }
+
+    const std::string& PipeName() const { return m_name; }
+
+private:
+    struct Queued
+    {
+        IpcMessage msg;
+        size_t bytes = 0;
+    };
+
+    std::deque<Queued> m_inbox;
+    std::vector<IpcMessage> m_sent;
+    size_t m_inboxBytes = 0;
+    std::string m_name;
+    bool m_connected = false;
+};
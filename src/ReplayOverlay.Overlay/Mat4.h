@@ -0,0 +1,67 @@
+#pragma once
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define MAT4_SSE 1
+#include <xmmintrin.h>
+#endif
+
+// Column-major 4x4 float matrices, as RmlUi and the HLSL constant buffer
+// store them (element [col * 4 + row]).
+//
+// The UI renderer needs two: the orthographic projection, which only
+// changes with the viewport, and projection * transform, which only changes
+// when an RmlUi transform does. Neither is rebuilt per draw.
+
+namespace Mat4
+{
+    // Maps [left, left + width] x [top, top + height] (y down) to clip space
+    inline void Ortho(float* out, float width, float height, float left = 0.0f, float top = 0.0f)
+    {
+        for (int i = 0; i < 16; i++) out[i] = 0.0f;
+        out[0]  = 2.0f / width;
+        out[5]  = -2.0f / height;
+        out[10] = 1.0f;
+        out[12] = -1.0f - 2.0f * left / width;
+        out[13] = 1.0f + 2.0f * top / height;
+        out[15] = 1.0f;
+    }
+
+    // out = a * b. 'out' must not alias 'a' or 'b'.
+    inline void MultiplyScalar(const float* a, const float* b, float* out)
+    {
+        // Same summation order as the SSE path, so both round identically
+        for (int c = 0; c < 4; c++)
+        {
+            const float* bc = b + c * 4;
+            for (int r = 0; r < 4; r++)
+            {
+                float sum = a[r] * bc[0];
+                sum += a[4 + r] * bc[1];
+                sum += a[8 + r] * bc[2];
+                sum += a[12 + r] * bc[3];
+                out[c * 4 + r] = sum;
+            }
+        }
+    }
+
+    // out = a * b: each output column is a linear combination of a's columns
+    inline void Multiply(const float* a, const float* b, float* out)
+    {
+#if defined(MAT4_SSE)
+        const __m128 a0 = _mm_loadu_ps(a);
+        const __m128 a1 = _mm_loadu_ps(a + 4);
+        const __m128 a2 = _mm_loadu_ps(a + 8);
+        const __m128 a3 = _mm_loadu_ps(a + 12);
+        for (int c = 0; c < 4; c++)
+        {
+            const __m128 bc = _mm_loadu_ps(b + c * 4);
+            __m128 col = _mm_mul_ps(a0, _mm_shuffle_ps(bc, bc, _MM_SHUFFLE(0, 0, 0, 0)));
+            col = _mm_add_ps(col, _mm_mul_ps(a1, _mm_shuffle_ps(bc, bc, _MM_SHUFFLE(1, 1, 1, 1))));
+            col = _mm_add_ps(col, _mm_mul_ps(a2, _mm_shuffle_ps(bc, bc, _MM_SHUFFLE(2, 2, 2, 2))));
+            col = _mm_add_ps(col, _mm_mul_ps(a3, _mm_shuffle_ps(bc, bc, _MM_SHUFFLE(3, 3, 3, 3))));
+            _mm_storeu_ps(out + c * 4, col);
+        }
+#else
+        MultiplyScalar(a, b, out);
+#endif
+    }
+}
@@ -0,0 +1,373 @@
+#pragma once
+#include <RmlUi/Core/RenderInterface.h>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+#include "DirtyRectTracker.h"
+#include "GeometryArena.h"
+#include "GeometryBatcher.h"
+#include "RenderCommandList.h"
+#include "RenderStateCache.h"
+#include "SlotMap.h"
+#include "SoftwareRasterizer.h"
+#include "TextureAtlas.h"
+
+// RmlUi render interface for the headless build: tracks what a frame would
+// have cost the GPU path (draw calls, geometry and texture bytes) without
+// drawing anything. Geometry goes through the same GeometryBatcher as the
+// D3D11 backend, so the batching CPU cost and the resulting draw count are
+// measured; the batched stream is then dropped. Draws also go through the
+// backend's RenderStateCache, so the state changes a frame would issue are
+// counted too, and small generated textures are placed in the same
+// TextureAtlas, so texture bytes count atlas pages. Frames are recorded into
+// the same RenderCommandList, and one identical to the last is not replayed.
+// A drawn frame goes through the same retained layer logic: only the draws
+// overlapping DirtyRectTracker's dirty rect are replayed, plus one
+// composite draw.
+// With EnableRasterizer() the texels are kept too and each drawn frame is
+// also rendered by a SoftwareRasterizer, for screenshots.
+
+class NullRenderInterface : public Rml::RenderInterface
+{
+public:
+    struct FrameCounts
+    {
+        uint64_t geometries = 0;    // RenderGeometry calls
+        uint64_t batches = 0;       // draws after batching
+        uint64_t drawCalls = 0;     // draws submitted: layer redraws plus the composite
+        uint64_t dirtyPixels = 0;   // layer area redrawn (0 if only composited)
+        uint64_t verticesDrawn = 0;
+        uint64_t indicesDrawn = 0;
+        uint64_t scissorChanges = 0;
+        uint64_t transformChanges = 0;
+        uint64_t stateChanges = 0;  // GPU state calls that survive RenderStateCache
+    };
+
+    struct Totals
+    {
+        uint64_t frames = 0;
+        uint64_t unchangedFrames = 0;   // identical to the previous frame: not drawn
+        uint64_t compositeOnlyFrames = 0; // drawn, but the layer needed no redraw
+        uint64_t drawCalls = 0;
+        uint64_t geometryCompiled = 0;  // CompileGeometry calls
+        uint64_t vertexBytesCompiled = 0;
+        uint64_t indexBytesCompiled = 0;
+        uint64_t texturesGenerated = 0;
+    };
+
+    // Closes the frame's command list; false if it matches the last drawn
+    // frame (as in the D3D11 backend, nothing is then drawn or presented)
+    bool Flush()
+    {
+        m_batcher.Flush(m_commands.Recording());
+        return m_commands.EndFrame();
+    }
+
+    // Sizes and places the retained layer (everything is redrawn next)
+    void SetViewport(int width, int height, int x = 0, int y = 0)
+    {
+        m_dirty.SetTarget({ x, y, x + width, y + height });
+        m_commands.Invalidate();
+    }
+
+    // Replays the frame closed by Flush() through the state cache: the
+    // layer's dirty part, then the composite (and the whole frame through
+    // the rasterizer, if enabled)
+    void Submit()
+    {
+        m_state.BeginFrame();
+        const RenderCommandList& frame = m_commands.Last();
+        m_frame.batches = frame.Draws();
+        m_redraw = m_dirty.Update(frame);
+        m_frame.dirtyPixels = DirtyRectTracker::Area(m_redraw);
+        if (m_frame.dirtyPixels)
+        {
+            m_drawIndex = 0;
+            frame.Replay(*this);
+        }
+        else
+        {
+            m_totals.compositeOnlyFrames++;
+        }
+        m_state.BindStream(&m_dirty, &m_dirty); // the layer's quad
+        m_state.SetTransform(nullptr);
+        m_state.BindTexture(&m_dirty);          // the layer
+        m_state.SetScissor(false, {});
+        m_state.Draw(6, 0);
+
+        if (m_raster)
+            m_raster->Render(m_commands.Last());
+        m_submitted = true;
+    }
+
+    // Keeps texture contents from now on and draws every submitted frame
+    // into a width x height image. Call before any texture is generated.
+    void EnableRasterizer(int width, int height)
+    {
+        m_raster = std::make_unique<SoftwareRasterizer>();
+        m_raster->Resize(width, height);
+        m_raster->SetTextureLookup([this](uintptr_t handle) -> const SoftwareRasterizer::Image* {
+            if (handle && handle == m_previewHandle)
+                return m_previewImage;
+            const Texture* t = m_textures.Get(handle);
+            return t && !t->image.Empty() ? &t->image : nullptr;
+        });
+    }
+    const SoftwareRasterizer* GetRasterizer() const { return m_raster.get(); }
+
+    // Closes the current frame's counts (call once per rendered frame)
+    void EndFrame()
+    {
+        m_frame.stateChanges = m_submitted ? m_state.CurrentFrame().StateChanges() : 0;
+        m_lastFrame = m_frame;
+        m_frame = {};
+        m_submitted = false;
+        m_totals.frames++;
+        m_totals.unchangedFrames = m_commands.UnchangedFrames();
+    }
+
+    // Drops the counts of a render that is never presented (glyph warm-up)
+    void DiscardFrame()
+    {
+        m_batcher.Reset();
+        m_commands.DiscardFrame();
+        m_frame = {};
+    }
+
+    const RenderCommandList& LastCommands() const { return m_commands.Last(); }
+
+    const FrameCounts& LastFrame() const { return m_lastFrame; }
+    const Totals& GetTotals() const { return m_totals; }
+
+    // Geometry and textures currently alive
+    size_t LiveGeometry() const { return m_geometry.size(); }
+    size_t LiveGeometryBytes() const { return m_geometryBytes; }
+    const GeometryArena<BatchVertex>& GetGeometryArena() const { return m_arena; }
+    size_t GetTextureBytes() const { return m_textureBytes; }
+    const TextureAtlas& GetAtlas() const { return m_atlas; }
+
+    // --- Rml::RenderInterface overrides ---
+
+    Rml::CompiledGeometryHandle CompileGeometry(Rml::Span<const Rml::Vertex> vertices,
+                                                 Rml::Span<const int> indices) override
+    {
+        static_assert(sizeof(Rml::Vertex) == sizeof(BatchVertex), "BatchVertex must mirror Rml::Vertex");
+        Geometry g;
+        g.mesh = m_arena.Allocate(reinterpret_cast<const BatchVertex*>(vertices.data()), vertices.size(),
+                                  indices.data(), indices.size());
+        g.bytes = vertices.size() * sizeof(Rml::Vertex) + indices.size() * sizeof(int);
+        m_totals.geometryCompiled++;
+        m_totals.vertexBytesCompiled += vertices.size() * sizeof(Rml::Vertex);
+        m_totals.indexBytesCompiled += indices.size() * sizeof(int);
+        m_geometryBytes += g.bytes;
+        Rml::CompiledGeometryHandle handle = m_geometry.Insert(g);
+        m_commands.Recording().CompileGeometry(handle, vertices.size(), indices.size());
+        return handle;
+    }
+
+    void RenderGeometry(Rml::CompiledGeometryHandle handle, Rml::Vector2f translation,
+                        Rml::TextureHandle texture) override
+    {
+        const Geometry* found = m_geometry.Get(handle);
+        if (!found) return;
+        const Geometry& g = *found;
+        const UvTransform* uv = nullptr;
+        if (const Texture* t = texture ? m_textures.Get(texture) : nullptr)
+        {
+            if (t->atlasPage)
+            {
+                texture = t->atlasPage;
+                uv = &t->uv;
+            }
+        }
+        m_batcher.Add(m_arena.Vertices(g.mesh), g.mesh.vertexCount, m_arena.Indices(g.mesh), g.mesh.indexCount,
+                      translation.x, translation.y, texture, uv);
+        m_frame.geometries++;
+        m_frame.verticesDrawn += g.mesh.vertexCount;
+        m_frame.indicesDrawn += g.mesh.indexCount;
+    }
+
+    void ReleaseGeometry(Rml::CompiledGeometryHandle handle) override
+    {
+        const Geometry* g = m_geometry.Get(handle);
+        if (!g) return;
+        m_geometryBytes -= g->bytes;
+        m_arena.Free(g->mesh);
+        m_geometry.Erase(handle);
+        m_commands.Recording().ReleaseGeometry(handle);
+    }
+
+    // No image loading: file textures (and the live preview) report 1x1
+    Rml::TextureHandle LoadTexture(Rml::Vector2i& dimensions, const Rml::String& source) override
+    {
+        dimensions = Rml::Vector2i(1, 1);
+        Rml::TextureHandle handle = TrackTexture(0);
+        if (source.find("__preview__") != Rml::String::npos)
+            m_previewHandle = handle;
+        return handle;
+    }
+
+    // A new preview frame replaced the preview texture's contents; 'image'
+    // is what the rasterizer samples for it (null: untextured)
+    void UpdatePreviewTexture(const SoftwareRasterizer::Image* image = nullptr)
+    {
+        m_previewImage = image;
+        if (m_textures.Contains(m_previewHandle))
+            m_commands.Recording().UpdateTexture(m_previewHandle);
+    }
+
+    Rml::TextureHandle GenerateTexture(Rml::Span<const Rml::byte> source, Rml::Vector2i dimensions) override
+    {
+        m_totals.texturesGenerated++;
+        if (m_atlas.Fits(dimensions.x, dimensions.y))
+        {
+            bool newPage = false;
+            Texture entry;
+            entry.placement = m_atlas.Insert(dimensions.x, dimensions.y, &newPage);
+            if (newPage)
+                m_atlasPages.push_back(TrackTexture(static_cast<size_t>(m_atlas.PageSize()) * m_atlas.PageSize() * 4));
+            entry.atlasPage = m_atlasPages[entry.placement.page];
+            entry.uv = m_atlas.UvFor(entry.placement);
+            if (m_raster)
+                BlitToPage(entry, source.data(), dimensions.x, dimensions.y);
+            Rml::TextureHandle handle = m_textures.Insert(entry);
+            m_commands.Recording().GenerateTexture(handle, dimensions.x, dimensions.y);
+            return handle;
+        }
+        Rml::TextureHandle handle = TrackTexture(source.size());
+        if (m_raster)
+        {
+            SoftwareRasterizer::Image& image = m_textures.Get(handle)->image;
+            image.width = dimensions.x;
+            image.height = dimensions.y;
+            image.texels.resize(static_cast<size_t>(dimensions.x) * dimensions.y);
+            std::memcpy(image.texels.data(), source.data(), image.texels.size() * 4);
+        }
+        m_commands.Recording().GenerateTexture(handle, dimensions.x, dimensions.y);
+        return handle;
+    }
+
+    void ReleaseTexture(Rml::TextureHandle handle) override
+    {
+        const Texture* t = m_textures.Get(handle);
+        if (!t) return;
+        if (t->atlasPage) m_atlas.Release(t->placement);
+        m_textureBytes -= t->bytes;
+        m_textures.Erase(handle);
+        m_commands.Recording().ReleaseTexture(handle);
+    }
+
+    void EnableScissorRegion(bool enable) override
+    {
+        m_batcher.EnableScissor(enable);
+        m_frame.scissorChanges++;
+    }
+    void SetScissorRegion(Rml::Rectanglei region) override
+    {
+        m_batcher.SetScissor({ region.Left(), region.Top(), region.Right(), region.Bottom() });
+        m_frame.scissorChanges++;
+    }
+    void SetTransform(const Rml::Matrix4f* transform) override
+    {
+        m_batcher.SetTransform(transform ? transform->data() : nullptr);
+        m_frame.transformChanges++;
+    }
+
+private:
+    friend class RenderCommandList;                       // calls Upload() / Draw()
+    friend class RenderStateCache<NullRenderInterface>;   // calls the context methods
+
+    struct Geometry
+    {
+        GeometryArena<BatchVertex>::Mesh mesh;
+        size_t bytes = 0;
+    };
+
+    struct Texture
+    {
+        size_t bytes = 0;
+        uintptr_t atlasPage = 0;    // atlas entries draw from their page
+        TextureAtlas::Placement placement;
+        UvTransform uv;
+        SoftwareRasterizer::Image image; // kept only when rasterizing
+    };
+
+    // Replay backend: the stream lives in one (imaginary) buffer pair
+    bool Upload(const BatchVertex*, size_t, const uint32_t*, size_t)
+    {
+        m_state.BindStream(&m_geometry, &m_textures);
+        return true;
+    }
+    void Draw(const GeometryBatcher::Batch& batch, const float* transform)
+    {
+        // Layer pass, as in D3D11: draws outside the dirty rect are skipped
+        if (!DirtyRectTracker::Overlaps(m_dirty.DrawBounds(m_drawIndex++), m_redraw))
+            return;
+        m_state.SetTransform(transform);
+        m_state.BindTexture(reinterpret_cast<const void*>(batch.texture));
+        m_state.SetScissor(true, batch.scissorEnabled ? DirtyRectTracker::Intersect(batch.scissor, m_redraw) : m_redraw);
+        m_state.Draw(batch.indexCount, batch.firstIndex);
+    }
+
+    // RenderStateCache context: counts only
+    void BindInvariantState() {}
+    void BindStream(const void*, const void*) {}
+    void BindTexture(const void*) {}
+    void SetRasterizer(bool) {}
+    void SetScissorRect(const GeometryBatcher::Scissor&) {}
+    void WriteConstants(const float*) {}
+    void DrawIndexed(uint32_t, uint32_t)
+    {
+        m_frame.drawCalls++;
+        m_totals.drawCalls++;
+    }
+
+    Rml::TextureHandle TrackTexture(size_t bytes)
+    {
+        m_textureBytes += bytes;
+        Texture t;
+        t.bytes = bytes;
+        return m_textures.Insert(t);
+    }
+
+    // Copies an atlas entry's texels (and border) into its page's image
+    void BlitToPage(const Texture& entry, const Rml::byte* source, int width, int height)
+    {
+        SoftwareRasterizer::Image& page = m_textures.Get(entry.atlasPage)->image;
+        if (page.Empty())
+        {
+            page.width = page.height = m_atlas.PageSize();
+            page.texels.assign(static_cast<size_t>(page.width) * page.height, 0);
+        }
+        const int b = TextureAtlas::Border;
+        const int w = width + 2 * b, h = height + 2 * b;
+        std::vector<uint8_t> texels(static_cast<size_t>(w) * h * 4);
+        TextureAtlas::CopyWithBorder(source, width, height, texels.data());
+        for (int y = 0; y < h; y++)
+            std::memcpy(&page.texels[static_cast<size_t>(entry.placement.y - b + y) * page.width + entry.placement.x - b],
+                        &texels[static_cast<size_t>(y) * w * 4], static_cast<size_t>(w) * 4);
+    }
+
+    SlotMap<Geometry> m_geometry;
+    GeometryArena<BatchVertex> m_arena;
+    SlotMap<Texture> m_textures;
+    TextureAtlas m_atlas;
+    std::vector<uintptr_t> m_atlasPages; // per page, its m_textures handle
+    GeometryBatcher m_batcher;
+    RenderCommandHistory m_commands;
+    RenderStateCache<NullRenderInterface> m_state{ *this };
+    DirtyRectTracker m_dirty;
+    DirtyRectTracker::Rect m_redraw;
+    size_t m_drawIndex = 0;
+    bool m_submitted = false;
+    size_t m_geometryBytes = 0;
+    size_t m_textureBytes = 0;
+    uintptr_t m_previewHandle = 0;
+    const SoftwareRasterizer::Image* m_previewImage = nullptr;
+    std::unique_ptr<SoftwareRasterizer> m_raster;
+
+    FrameCounts m_frame;
+    FrameCounts m_lastFrame;
+    Totals m_totals;
+};
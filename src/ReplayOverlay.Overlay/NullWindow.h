@@ -0,0 +1,64 @@
+#pragma once
+
+namespace Rml { class Context; }
+
+// Window stand-in for the headless build: a fixed-size surface that never
+// receives input. Mirrors the parts of WindowManager that OverlayApp uses.
+
+class NullWindow
+{
+public:
+    static constexpr int DefaultWidth = 1920;
+    static constexpr int DefaultHeight = 1080;
+
+    bool Init(int width, int height, const wchar_t* /*title*/)
+    {
+        m_width = width > 0 ? width : DefaultWidth;
+        m_height = height > 0 ? height : DefaultHeight;
+        return true;
+    }
+    void Shutdown() {}
+
+    void* GetHwnd() const { return nullptr; }
+    int  GetWidth() const { return m_width; }
+    int  GetHeight() const { return m_height; }
+
+    void SetVisible(bool visible) { m_visible = visible; }
+    bool IsVisible() const { return m_visible; }
+    void SetPosition(int, int) {}
+    void SetBounds(int x, int y, int w, int h)
+    {
+        m_boundsX = x;
+        m_boundsY = y;
+        m_boundsW = w;
+        m_boundsH = h;
+    }
+    bool ProcessMessages() { return true; }
+    bool ConsumeInputEvent() { return false; }
+
+    void SetPanelRect(int x, int y, int w, int h)
+    {
+        m_panelX = x;
+        m_panelY = y;
+        m_panelW = w;
+        m_panelH = h;
+    }
+    void UpdateClickThrough() {}
+    void SetTopmost(bool) {}
+    void SetRmlContext(Rml::Context*) {}
+
+    // Last rect reported by SetPanelRect (layout check for the driver)
+    int PanelWidth() const { return m_panelW; }
+    int PanelHeight() const { return m_panelH; }
+
+    // Last window bounds set (the surface size, 0 until placed)
+    int BoundsWidth() const { return m_boundsW; }
+    int BoundsHeight() const { return m_boundsH; }
+
+private:
+    int  m_width = DefaultWidth;
+    int  m_height = DefaultHeight;
+    bool m_visible = false;
+    int  m_panelX = 0, m_panelY = 0, m_panelW = 0, m_panelH = 0;
+    int  m_boundsX = 0, m_boundsY = 0, m_boundsW = 0, m_boundsH = 0;
+};
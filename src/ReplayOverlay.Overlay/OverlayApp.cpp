@@ -1,32 +1,58 @@
 #include "OverlayApp.h"
-#include <fstream>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include "Logger.h"
+#include "OverlayAssets.h"
+#include "FontWarmup.h"
+
+static void DebugLog(const char* msg, LogLevel level = LogLevel::Info)
+{
+    Logger::Get().Write(level, "IPC", msg);
+}
 
-static void DebugLog(const char* msg)
+// Default location for flush_trace: %LOCALAPPDATA%\ReplayOverlay\overlay_trace_<time>.json
+// (the working directory where LOCALAPPDATA is not set, e.g. headless runs)
+static std::string DefaultTracePath()
 {
-    char path[MAX_PATH];
-    if (GetEnvironmentVariableA("LOCALAPPDATA", path, MAX_PATH) > 0)
-    {
-        std::string logPath = std::string(path) + "\\ReplayOverlay\\overlay_crash.log";
-        std::ofstream f(logPath, std::ios::app);
-        if (f.is_open())
-            f << "  [IPC] " << msg << std::endl;
-    }
+    time_t t = time(nullptr);
+    tm local = {};
+#if defined(_WIN32)
+    localtime_s(&local, &t);
+#else
+    localtime_r(&t, &local);
+#endif
+    char name[64];
+    strftime(name, sizeof(name), "overlay_trace_%Y%m%d_%H%M%S.json", &local);
+    const char* appData = std::getenv("LOCALAPPDATA");
+    if (!appData || !*appData)
+        return name;
+    return std::string(appData) + "\\ReplayOverlay\\" + name;
 }
 
+// REC indicator position classes, matching .rec-indicator.pos-* in the RCSS
+static constexpr struct { const char* cls; const char* position; } RecPositionClasses[] = {
+    { "pos-tl", "top-left" },
+    { "pos-tc", "top-center" },
+    { "pos-tr", "top-right" },
+    { "pos-bl", "bottom-left" },
+    { "pos-bc", "bottom-center" },
+    { "pos-br", "bottom-right" },
+};
+
 bool OverlayApp::Init(const std::string& pipeName)
 {
     m_pipeName = pipeName;
 
-    // Init QPC timer
-    LARGE_INTEGER freq, counter;
-    QueryPerformanceFrequency(&freq);
-    QueryPerformanceCounter(&counter);
-    m_timerFrequency = static_cast<double>(freq.QuadPart);
-    m_lastFrameTime = counter.QuadPart;
+    m_startTime = std::chrono::steady_clock::now();
+    m_lastFrameTime = 0.0;
 
-    // Create full-screen transparent overlay window
+    // Create the transparent overlay window (full-screen until the first
+    // rendered frame fits it to the visible UI)
     if (!m_window.Init(0, 0, L"Replay Overlay"))
         return false;
+    StartupTimeline::Get().Mark("window");
 
     // Init DirectX + RmlUi
     if (!m_renderer.Init(m_window.GetHwnd(), m_window.GetWidth(), m_window.GetHeight()))
@@ -35,12 +61,18 @@ bool OverlayApp::Init(const std::string& pipeName)
     // Wire RmlUi context to WindowManager for input forwarding
     m_window.SetRmlContext(m_renderer.GetRmlContext());
 
+    // The window is shrunk to the visible UI from the first frame on
+    m_surface.SetScreen(m_window.GetWidth(), m_window.GetHeight());
+
     // Initialize data model (must be before loading document)
     if (!m_dataModel.Init(m_renderer.GetRmlContext(), &m_state, &m_pendingActions))
         return false;
+    StartupTimeline::Get().Mark("data_model");
 
     // Load the overlay document (uses data-model="overlay")
-    m_renderer.LoadOverlayDocument();
+    Rml::ElementDocument* doc = m_renderer.LoadOverlayDocument();
+    m_tabHost.SetContainer(doc ? doc->GetElementById("tab-content") : nullptr);
+    StartupTimeline::Get().Mark("document");
 
     // Panel starts hidden until host sends show_overlay
     SetPanelHidden(true);
@@ -51,6 +83,7 @@ bool OverlayApp::Init(const std::string& pipeName)
         // Send ready signal
         m_ipc.SendMessage({"ready", {}});
     }
+    StartupTimeline::Get().Mark("ipc_connect");
 
     return true;
 }
@@ -66,25 +99,31 @@ void OverlayApp::Shutdown()
 
 double OverlayApp::GetElapsedTime() const
 {
-    LARGE_INTEGER counter;
-    QueryPerformanceCounter(&counter);
-    return static_cast<double>(counter.QuadPart) / m_timerFrequency;
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - m_startTime).count() +
+           m_skippedTime;
 }
 
 bool OverlayApp::Tick()
 {
     // Calculate delta time
-    LARGE_INTEGER counter;
-    QueryPerformanceCounter(&counter);
-    m_deltaTime = static_cast<float>(
-        static_cast<double>(counter.QuadPart - m_lastFrameTime) / m_timerFrequency);
-    m_lastFrameTime = counter.QuadPart;
-
     double elapsed = GetElapsedTime();
+    m_deltaTime = static_cast<float>(elapsed - m_lastFrameTime);
+    m_lastFrameTime = elapsed;
+
+    const uint64_t frameStart = FrameProfiler::NowNs();
+    m_frameProfiler.Rotate(elapsed);
+
+    // Dirty marks from input callbacks onward are attributed to the next
+    // rendered frame's Update(), however many iterations skip until then
+    auto& profiler = m_dataModel.GetProfiler();
+    profiler.BeginFrame(elapsed);
 
     // Process Win32 messages
-    if (!m_window.ProcessMessages())
-        return false;
+    {
+        ScopedPhase phase(m_frameProfiler, FramePhase::Pump);
+        if (!m_window.ProcessMessages())
+            return false;
+    }
 
     if (m_shouldExit)
         return false;
@@ -108,60 +147,121 @@ bool OverlayApp::Tick()
     }
 
     // Process incoming IPC messages
-    ProcessIpcMessages();
+    {
+        ScopedPhase phase(m_frameProfiler, FramePhase::Ipc);
+        TRACE_SCOPE("ipc.process");
+        ProcessIpcMessages();
+    }
 
-    // Sync data model from state (pushes changes to RmlUi bindings)
-    m_dataModel.SetElapsedTime(elapsed);
-    m_dataModel.SyncFromState();
+    {
+        ScopedPhase phase(m_frameProfiler, FramePhase::Sync);
+        TRACE_SCOPE("model.sync");
 
-    // Update notification/REC indicator animations
-    m_dataModel.UpdateNotification(m_deltaTime);
-    m_dataModel.UpdateRecIndicator(m_deltaTime);
+        // Sync data model from state (pushes changes to RmlUi bindings)
+        m_dataModel.SetElapsedTime(elapsed);
+        m_dataModel.SyncFromState();
+
+        // Update notification/REC indicator animations
+        m_dataModel.UpdateNotification(m_deltaTime);
+        m_dataModel.UpdateRecIndicator(m_deltaTime);
+    }
 
     // Send any actions queued by the data model
     SendPendingActions();
 
+    // Pick the frame rate from what is visible and whether the user is
+    // interacting, then decide whether anything visible changed; skipped
+    // frames bypass the RmlUi update, render and present entirely
+    bool input = m_window.ConsumeInputEvent();
+    if (input) m_governor.NoteInput(elapsed);
+    FrameGovernor::Signals signals;
+    signals.panelVisible = m_state.overlayVisible;
+    signals.indicatorVisible = m_dataModel.IsIndicatorVisible();
+    signals.animating = m_dataModel.IsAnimating();
+    m_governor.Update(elapsed, signals);
+    m_scheduler.SetPacing(m_governor.IntervalS(), m_governor.IsPeriodic());
+    if (m_dataModel.ConsumeInvalidation() || input)
+        m_scheduler.Invalidate();
+    double animDelay = m_dataModel.GetNextAnimationDelay();
+    if (animDelay >= 0.0)
+        m_scheduler.RequestWakeAt(elapsed + animDelay);
+    if (!m_ipc.IsConnected())
+        m_scheduler.RequestWakeAt(elapsed + (ReconnectIntervalS - m_reconnectTimer));
+    else if (m_ipc.HasPendingData())
+        m_scheduler.RequestWakeAt(elapsed); // more messages already buffered
+
+    // A delayed surface shrink happens in a rendered frame
+    const double shrinkAt = m_surface.ShrinkAt();
+    if (shrinkAt >= 0.0)
+    {
+        if (elapsed >= shrinkAt)
+            m_scheduler.Invalidate();
+        else
+            m_scheduler.RequestWakeAt(shrinkAt);
+    }
+
+    if (!m_scheduler.ShouldRender(elapsed))
+    {
+        ScopedPhase phase(m_frameProfiler, FramePhase::ClickThrough);
+        m_window.UpdateClickThrough();
+        return true;
+    }
+    m_governor.NoteFrame();
+
+    // Tab clicks arrive during the message pump; show (or build) the pane
+    SyncActiveTab();
+
     // Process data model changes (data-if element creation/destruction, layout)
     // Must happen BEFORE direct element manipulation so GetElementById returns
-    // freshly (re)created elements from data-if tab switches.
+    // freshly (re)created elements.
     auto* ctx = m_renderer.GetRmlContext();
-    if (ctx) ctx->Update();
+    if (ctx)
+    {
+        TRACE_SCOPE("rml.update");
+        uint64_t updateStart = FrameProfiler::NowNs();
+        ctx->Update();
+        uint64_t updateNs = FrameProfiler::NowNs() - updateStart;
+        m_frameProfiler.Record(FramePhase::Update, updateNs);
+        profiler.EndFrame(updateNs / 1e6);
+    }
 
-    // Update element state directly (bypasses unreliable data-class-* bindings)
+    // Update element state directly (bypasses unreliable data-class-* bindings).
+    // Handles are cached across frames and the setters only touch the DOM
+    // when a value changed, so steady-state frames write nothing and skip
+    // the second Update() pass.
     if (ctx)
     {
         auto* body = ctx->GetRootElement();
         if (body)
         {
-            // REC indicator: toggle hidden class + set position properties
-            auto* recEl = body->GetElementById("rec-indicator");
-            if (recEl)
+            uint64_t domStart = FrameProfiler::NowNs();
+            const uint32_t gen = StructureGeneration();
+            bool domChanged = false;
+
+            // REC indicator: toggle hidden class + position classes
+            if (m_recEl.Resolve(body, gen))
             {
                 bool active = m_dataModel.IsRecActive();
-                std::string pos = m_dataModel.GetRecPosition();
+                const std::string& pos = m_dataModel.GetRecPosition();
 
-                recEl->SetClass("hidden", !active);
+                domChanged |= m_recEl.SetClass("hidden", !active);
 
                 // Position via CSS classes -- removing a class cleanly
                 // removes its properties from the cascade.
-                recEl->SetClass("pos-tl", active && pos == "top-left");
-                recEl->SetClass("pos-tc", active && pos == "top-center");
-                recEl->SetClass("pos-tr", active && pos == "top-right");
-                recEl->SetClass("pos-bl", active && pos == "bottom-left");
-                recEl->SetClass("pos-bc", active && pos == "bottom-center");
-                recEl->SetClass("pos-br", active && pos == "bottom-right");
+                for (const auto& p : RecPositionClasses)
+                    domChanged |= m_recEl.SetClass(p.cls, active && pos == p.position);
             }
 
             // Preview: toggle image/placeholder visibility via SetProperty
-            // Elements live inside data-if tab block; null when tab != 'main'
-            auto* previewImg = body->GetElementById("preview-img");
-            auto* previewPlaceholder = body->GetElementById("preview-placeholder");
+            // Elements live in the main tab pane; null until it is built
+            auto* previewImg = m_previewImgEl.Resolve(body, gen);
+            auto* previewPlaceholder = m_previewPlaceholderEl.Resolve(body, gen);
             if (previewImg && previewPlaceholder)
             {
                 if (m_dataModel.HasPreview())
                 {
-                    previewImg->SetProperty("display", "block");
-                    previewPlaceholder->SetProperty("display", "none");
+                    domChanged |= m_previewImgEl.SetProperty("display", "block");
+                    domChanged |= m_previewPlaceholderEl.SetProperty("display", "none");
 
                     // Compute width from actual video aspect ratio to avoid
                     // RmlUi's cached 1x1 placeholder intrinsic dimensions.
@@ -172,29 +272,40 @@ bool OverlayApp::Tick()
                         // Fill container height (140dp), compute matching width
                         constexpr int containerH = 140;
                         int w = containerH * pw / ph;
-                        previewImg->SetProperty("height", std::to_string(containerH) + "dp");
-                        previewImg->SetProperty("width", std::to_string(w) + "dp");
+                        char buf[16];
+                        snprintf(buf, sizeof(buf), "%ddp", containerH);
+                        domChanged |= m_previewImgEl.SetProperty("height", buf);
+                        snprintf(buf, sizeof(buf), "%ddp", w);
+                        domChanged |= m_previewImgEl.SetProperty("width", buf);
                     }
                     else
                     {
-                        previewImg->SetProperty("width", "100%");
-                        previewImg->SetProperty("height", "100%");
+                        domChanged |= m_previewImgEl.SetProperty("width", "100%");
+                        domChanged |= m_previewImgEl.SetProperty("height", "100%");
                     }
                 }
                 else
                 {
-                    previewImg->SetProperty("display", "none");
-                    previewPlaceholder->RemoveProperty("display");
+                    domChanged |= m_previewImgEl.SetProperty("display", "none");
+                    domChanged |= m_previewPlaceholderEl.RemoveProperty("display");
                 }
             }
 
             // Second Update() processes style/attribute changes made above
             // (display toggles, src changes) so layout is correct this frame.
-            ctx->Update();
+            uint64_t domNs = FrameProfiler::NowNs() - domStart;
+            if (domChanged)
+            {
+                ScopedPhase phase(m_frameProfiler, FramePhase::Update2);
+                TRACE_SCOPE("rml.update2");
+                ctx->Update();
+            }
 
             // Update panel rect for click-through based on document element
-            auto* panel = body->GetElementById("panel");
-            if (!panel)
+            domStart = FrameProfiler::NowNs();
+            uint64_t lookups = m_panelEl.Lookups();
+            auto* panel = m_panelEl.Resolve(body, gen);
+            if (!panel && m_panelEl.Lookups() != lookups)
             {
                 for (int i = 0; i < body->GetNumChildren(); i++)
                 {
@@ -205,6 +316,10 @@ bool OverlayApp::Tick()
                         break;
                     }
                 }
+                if (panel)
+                    m_panelEl.Rebind(panel);
+                else
+                    m_panelEl.Invalidate(); // not laid out yet; retry next frame
             }
             if (panel)
             {
@@ -217,19 +332,184 @@ bool OverlayApp::Tick()
                         static_cast<int>(size.x), static_cast<int>(size.y));
                 }
             }
+            PlaceSurface(panel, elapsed);
+            m_frameProfiler.Record(FramePhase::DomSync, domNs + (FrameProfiler::NowNs() - domStart));
         }
     }
 
     // Render frame
-    m_renderer.BeginFrame(0.0f, 0.0f, 0.0f, 0.0f);
-    m_renderer.EndFrame();
+    {
+        ScopedPhase phase(m_frameProfiler, FramePhase::Render);
+        TRACE_SCOPE("rml.render");
+        m_renderer.BeginFrame(0.0f, 0.0f, 0.0f, 0.0f);
+        m_renderer.Render();
+    }
+    {
+        ScopedPhase phase(m_frameProfiler, FramePhase::Present);
+        TRACE_SCOPE("present");
+        m_renderer.Present();
+    }
+
+    if (m_tabSwitchStart)
+    {
+        uint64_t ns = FrameProfiler::NowNs() - m_tabSwitchStart;
+        (m_tabSwitchBuilt ? m_tabSwitchCold : m_tabSwitchWarm).Record(ns);
+        m_tabSwitchStart = 0;
+    }
+
+    // The first presented frame closes the startup timeline
+    if (!StartupTimeline::Get().IsFinished())
+    {
+        StartupTimeline::Get().Finish("first_frame");
+        DebugLog(StartupTimeline::Get().FormatLine().c_str());
+    }
 
     // Toggle WS_EX_TRANSPARENT based on mouse position vs panel rect
-    m_window.UpdateClickThrough();
+    {
+        ScopedPhase phase(m_frameProfiler, FramePhase::ClickThrough);
+        m_window.UpdateClickThrough();
+    }
+
+    m_frameProfiler.Record(FramePhase::Frame, FrameProfiler::NowNs() - frameStart);
+    if (TraceRecorder::Get().IsEnabled())
+    {
+        TraceRecorder::Get().Complete("frame", frameStart, FrameProfiler::NowNs());
+        TRACE_COUNTER("ipc_rx_bytes", m_ipc.BufferedBytes());
+        TRACE_COUNTER("texture_bytes", m_renderer.GetUiTextureBytes() +
+            static_cast<size_t>(m_preview.GetWidth()) * m_preview.GetHeight() * 4);
+        TRACE_COUNTER("draw_calls", m_renderer.GetLastDrawCalls());
+        TRACE_COUNTER("draws_submitted", m_renderer.GetLastSubmittedDraws());
+        TRACE_COUNTER("state_changes", m_renderer.GetLastStateChanges());
+        TRACE_COUNTER("frame_changed", m_renderer.LastFrameChanged() ? 1 : 0);
+    }
+
+    // Periodic phase summary (the first check only arms the interval)
+    if (elapsed >= m_nextPhaseLog)
+    {
+        if (m_nextPhaseLog > 0.0)
+            DebugLog(m_frameProfiler.FormatLine().c_str());
+        m_nextPhaseLog = elapsed + PhaseLogIntervalS;
+    }
+
+    // Warm the glyph cache, then prebuild the remaining tab panes one per
+    // frame, while the user is not interacting (right after startup the
+    // panel is still hidden)
+    if (StartupTimeline::Get().IsFinished() && m_governor.State() != GovernorState::Interactive)
+    {
+        static const std::vector<std::string> order = [] {
+            std::vector<std::string> names;
+            for (const auto& tab : OverlayAssetData::Tabs) names.push_back(tab.name);
+            return names;
+        }();
+        if (!m_glyphsWarmed)
+        {
+            WarmGlyphs();
+            m_scheduler.Invalidate();
+        }
+        else
+        {
+            TRACE_SCOPE("tab.prebuild");
+            if (m_tabs.Prebuild(order))
+                m_scheduler.Invalidate(); // next idle frame builds the next one
+        }
+    }
 
     return true;
 }
 
+void OverlayApp::WarmGlyphs()
+{
+    TRACE_SCOPE("fonts.warm");
+    uint64_t start = FrameProfiler::NowNs();
+    std::set<uint32_t> codepoints;
+    std::string sizeSource(GetOverlayDocument()); // theme RCSS is inlined here
+    FontWarmup::CollectCodepoints(GetOverlayDocument(), codepoints);
+    for (const auto& tab : OverlayAssetData::Tabs)
+    {
+        std::string_view rml = GetTabFragment(tab.name);
+        FontWarmup::CollectCodepoints(rml, codepoints);
+        sizeSource += rml;
+    }
+    std::vector<int> sizes = FontWarmup::CollectFontSizes(sizeSource);
+    m_renderer.WarmGlyphs(FontWarmup::BuildDocument(sizes, codepoints, "Segoe UI", "Segoe MDL2 Assets"));
+    m_glyphsWarmed = true;
+    LOG_INFO("fonts", "Glyph warm-up: %zu sizes, %zu codepoints, %.1f ms", sizes.size(), codepoints.size(),
+             (FrameProfiler::NowNs() - start) / 1e6);
+}
+
+void OverlayApp::SyncActiveTab()
+{
+    const Rml::String& tab = m_dataModel.GetActiveTab();
+    if (tab == m_tabs.Active() || tab == m_failedTab) return;
+
+    TRACE_SCOPE("tab.switch", m_traceTabNames.Get(tab));
+    uint64_t start = FrameProfiler::NowNs();
+    auto result = m_tabs.Activate(tab);
+    if (result == TabCache<RmlTabHost>::Result::Failed)
+    {
+        LOG_WARN("tabs", "No pane for tab '%s'", tab.c_str());
+        m_failedTab = tab;
+        return;
+    }
+    m_failedTab.clear();
+    m_tabSwitchStart = start;
+    m_tabSwitchBuilt = result == TabCache<RmlTabHost>::Result::Cold;
+}
+
+// --- Tab panes ---
+
+Rml::Element* RmlTabHost::FindPane(const std::string& name) const
+{
+    if (!m_container) return nullptr;
+    const std::string id = "tab-" + name;
+    for (int i = 0; i < m_container->GetNumChildren(); i++)
+    {
+        Rml::Element* child = m_container->GetChild(i);
+        if (child->GetId() == id) return child;
+    }
+    return nullptr;
+}
+
+static size_t CountElements(Rml::Element* el)
+{
+    size_t n = 1;
+    for (int i = 0; i < el->GetNumChildren(); i++)
+        n += CountElements(el->GetChild(i));
+    return n;
+}
+
+size_t RmlTabHost::BuildTab(const std::string& name)
+{
+    std::string_view rml = GetTabFragment(name);
+    if (!m_container || rml.empty()) return 0;
+
+    Rml::ElementPtr pane = m_container->GetOwnerDocument()->CreateElement("div");
+    pane->SetId("tab-" + name);
+    pane->SetClass("hidden", true);
+    // Attach before parsing so the fragment's bindings find the data model
+    Rml::Element* el = m_container->AppendChild(std::move(pane));
+    el->SetInnerRML(Rml::String(rml));
+    return CountElements(el);
+}
+
+size_t RmlTabHost::TabCost(const std::string& name)
+{
+    Rml::Element* el = FindPane(name);
+    return el ? CountElements(el) : 0;
+}
+
+void RmlTabHost::ShowTab(const std::string& name, bool visible)
+{
+    if (Rml::Element* el = FindPane(name))
+        el->SetClass("hidden", !visible);
+}
+
+void RmlTabHost::DestroyTab(const std::string& name)
+{
+    if (Rml::Element* el = FindPane(name))
+        m_container->RemoveChild(el);
+}
+
 void OverlayApp::ProcessIpcMessages()
 {
     for (int i = 0; i < 100; i++)
@@ -238,6 +518,7 @@ void OverlayApp::ProcessIpcMessages()
         if (!msg) break;
 
         const auto& type = msg->type;
+        TRACE_SCOPE("ipc.handle", m_traceIpcTypes.Get(type));
 
         try
         {
@@ -261,6 +542,7 @@ void OverlayApp::ProcessIpcMessages()
                     auto base64 = msg->payload["base64"].get<std::string>();
                     m_renderer.ClearPreviewTexture(); // detach before old SRV is freed
                     m_preview.UpdateFromBase64(m_renderer, base64);
+                    m_scheduler.Invalidate();
                     if (m_preview.GetTexture())
                     {
                         m_renderer.SetPreviewTexture(
@@ -277,6 +559,7 @@ void OverlayApp::ProcessIpcMessages()
             {
                 m_state.UpdateFromConfigJson(msg->payload);
                 m_configReceived = true;
+                m_scheduler.Invalidate(); // REC position may have moved
                 // Update REC indicator from config (now has correct position)
                 m_dataModel.SetRecIndicator(
                     m_state.showRecIndicator && m_state.isBufferActive,
@@ -324,7 +607,7 @@ void OverlayApp::ProcessIpcMessages()
             }
             else if (type == "stats_response")
             {
-                m_state.UpdateFromStatsJson(msg->payload);
+                m_state.UpdateFromStatsJson(msg->payload, GetElapsedTime());
             }
             else if (type == "hotkeys_response")
             {
@@ -347,6 +630,55 @@ void OverlayApp::ProcessIpcMessages()
                 std::string pos = msg->payload.value("position", m_state.recIndicatorPosition);
                 if (m_state.showRecIndicator)
                     m_dataModel.SetRecIndicator(active, pos);
+                m_scheduler.Invalidate();
+            }
+            else if (type == "get_overlay_metrics")
+            {
+                nlohmann::json bindings = m_dataModel.GetProfiler().Report();
+                DebugLog(BindingProfiler::FormatReport(bindings).c_str());
+
+                nlohmann::json frameRate = m_governor.Metrics();
+                frameRate["rendered_frames"] = m_scheduler.RenderedFrames();
+                frameRate["skipped_frames"] = m_scheduler.SkippedFrames();
+                frameRate["wakeups"] = m_scheduler.Wakeups();
+                DebugLog(("frame rate: " + frameRate.dump()).c_str());
+
+                nlohmann::json phases = m_frameProfiler.Report();
+                DebugLog(m_frameProfiler.FormatLine().c_str());
+
+                nlohmann::json tabs = {
+                    {"resident", m_tabs.Resident()},
+                    {"cost_elements", m_tabs.Cost()},
+                    {"budget_elements", m_tabs.Budget()},
+                    {"builds", m_tabs.Builds()},
+                    {"prebuilt", m_tabs.Prebuilt()},
+                    {"hits", m_tabs.Hits()},
+                    {"evictions", m_tabs.Evictions()},
+                    {"switch_cold", FrameProfiler::ToJson(FrameProfiler::Summarize(m_tabSwitchCold))},
+                    {"switch_warm", FrameProfiler::ToJson(FrameProfiler::Summarize(m_tabSwitchWarm))},
+                };
+
+                m_ipc.SendMessage({"overlay_metrics", {
+                    {"bindings", bindings},
+                    {"frame_rate", frameRate},
+                    {"phases", phases},
+                    {"startup", StartupTimeline::Get().Report()},
+                    {"tabs", tabs},
+                }});
+            }
+            else if (type == "set_tracing")
+            {
+                bool enabled = msg->payload.value("enabled", false);
+                TraceRecorder::Get().SetEnabled(enabled);
+                DebugLog(enabled ? "Tracing enabled" : "Tracing disabled");
+            }
+            else if (type == "flush_trace")
+            {
+                std::string path = msg->payload.value("path", "");
+                if (path.empty()) path = DefaultTracePath();
+                long long events = TraceRecorder::Get().Flush(path);
+                DebugLog(("Trace flushed to " + path + " (" + std::to_string(events) + " events)").c_str());
+                m_ipc.SendMessage({"trace_flushed", {{"path", path}, {"events", events}}});
             }
             else if (type == "shutdown")
             {
@@ -355,13 +687,61 @@ void OverlayApp::ProcessIpcMessages()
         }
         catch (const std::exception& ex)
         {
-            DebugLog((std::string("Exception handling '") + type + "': " + ex.what()).c_str());
+            DebugLog((std::string("Exception handling '") + type + "': " + ex.what()).c_str(), LogLevel::Error);
         }
         catch (...)
         {
-            DebugLog((std::string("Unknown exception handling '") + type + "'").c_str());
+            DebugLog((std::string("Unknown exception handling '") + type + "'").c_str(), LogLevel::Error);
+        }
+    }
+}
+
+// Fits the window and swap chain around what this frame shows: the panel,
+// an open dropdown, the notification and the REC indicator (border boxes;
+// SurfaceLayout's slack covers their shadows). Call after layout.
+void OverlayApp::PlaceSurface(Rml::Element* panel, double now)
+{
+    auto* ctx = m_renderer.GetRmlContext();
+    auto* body = ctx ? ctx->GetRootElement() : nullptr;
+    if (!body) return;
+
+    m_surface.BeginFrame();
+    auto add = [this](Rml::Element* el) {
+        if (!el || !el->IsVisible(true)) return;
+        auto pos = el->GetAbsoluteOffset(Rml::BoxArea::Border);
+        auto size = el->GetBox().GetSize(Rml::BoxArea::Border);
+        m_surface.Add({ static_cast<int>(std::floor(pos.x)), static_cast<int>(std::floor(pos.y)),
+                        static_cast<int>(std::ceil(pos.x + size.x)), static_cast<int>(std::ceil(pos.y + size.y)) });
+    };
+
+    if (m_state.overlayVisible)
+        add(panel);
+
+    // The selectbox of an open <select> is a non-DOM child positioned
+    // below it, possibly outside the panel
+    if (auto* focus = ctx->GetFocusElement(); focus && focus->GetTagName() == "select")
+    {
+        for (int i = 0; i < focus->GetNumChildren(true); i++)
+        {
+            auto* child = focus->GetChild(i);
+            if (child && child->GetTagName() == "selectbox")
+                add(child);
         }
     }
+
+    // The notification is created by data-if: look it up while it is
+    // active and the handle has nothing
+    if (m_dataModel.IsNotificationActive() && !m_notificationEl.Get())
+        m_notificationEl.Invalidate();
+    add(m_notificationEl.Resolve(body, StructureGeneration()));
+    add(m_recEl.Resolve(body, StructureGeneration()));
+
+    if (m_surface.Update(now))
+    {
+        const SurfaceLayout::Rect& r = m_surface.Placement();
+        m_window.SetBounds(r.left, r.top, r.Width(), r.Height());
+        m_renderer.SetSurfaceBounds(r.left, r.top, r.Width(), r.Height());
+    }
 }
 
 void OverlayApp::SetPanelHidden(bool hidden)
@@ -370,10 +750,11 @@ void OverlayApp::SetPanelHidden(bool hidden)
     if (!ctx) return;
     auto* body = ctx->GetRootElement();
     if (!body) return;
-    auto* panel = body->GetElementById("panel");
+    auto* panel = m_panelEl.Resolve(body, StructureGeneration());
     if (panel)
     {
-        panel->SetClass("hidden", hidden);
+        m_panelEl.SetClass("hidden", hidden);
+        m_scheduler.Invalidate(); // hiding needs one frame to clear the panel
         if (!hidden)
         {
             // Force margin recalculation after display:none -> display:flex
@@ -383,8 +764,28 @@ void OverlayApp::SetPanelHidden(bool hidden)
     }
 }
 
+void OverlayApp::WaitForWork()
+{
+    double timeout = m_scheduler.WaitTimeout(GetElapsedTime());
+    if (timeout == 0.0) return;
+
+#if defined(OVERLAY_HEADLESS)
+    // Nothing to block on: skip ahead on the clock instead of sleeping. An
+    // indefinite wait returns to the driver, which is the only event source.
+    if (timeout > 0.0 && !m_ipc.HasPendingData())
+        m_skippedTime += timeout;
+#else
+    DWORD ms = timeout < 0.0 ? INFINITE : static_cast<DWORD>(std::ceil(timeout * 1000.0));
+    HANDLE ipcEvent = m_ipc.GetReadEvent();
+    MsgWaitForMultipleObjectsEx(ipcEvent ? 1 : 0, ipcEvent ? &ipcEvent : nullptr,
+                                ms, QS_ALLINPUT, MWMO_INPUTAVAILABLE);
+#endif
+    m_scheduler.NoteWakeup();
+}
+
 void OverlayApp::SendPendingActions()
 {
+    TRACE_COUNTER("pending_actions", m_pendingActions.size());
     for (const auto& action : m_pendingActions)
         m_ipc.SendMessage(action);
     m_pendingActions.clear();
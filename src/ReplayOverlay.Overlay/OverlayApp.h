@@ -1,11 +1,59 @@
 #pragma once
+#include <chrono>
 #include <string>
+#if defined(OVERLAY_HEADLESS)
+#include "NullWindow.h"
+#include "HeadlessRenderer.h"
+#include "LoopbackIpc.h"
+#else
 #include "WindowManager.h"
 #include "DxRenderer.h"
 #include "IpcClient.h"
-#include "OverlayState.h"
 #include "PreviewRenderer.h"
+#endif
+#include "OverlayState.h"
 #include "OverlayDataModel.h"
+#include "ElementCache.h"
+#include "FrameGovernor.h"
+#include "FrameProfiler.h"
+#include "FrameScheduler.h"
+#include "StartupTimeline.h"
+#include "SurfaceLayout.h"
+#include "TabCache.h"
+#include "TraceRecorder.h"
+
+// Builds tab panes from the embedded fragments (assets/tabs/*.rml) as
+// children of #tab-content; used by TabCache
+class RmlTabHost
+{
+public:
+    void SetContainer(Rml::Element* container) { m_container = container; }
+
+    size_t BuildTab(const std::string& name);
+    size_t TabCost(const std::string& name);
+    void ShowTab(const std::string& name, bool visible);
+    void DestroyTab(const std::string& name);
+
+private:
+    Rml::Element* FindPane(const std::string& name) const;
+
+    Rml::Element* m_container = nullptr;
+};
+
+// Platform layer. The headless build (OVERLAY_HEADLESS) swaps in a null
+// window, a RmlUi renderer that only counts draws and an in-process IPC
+// queue, so everything from IPC parsing to RmlUi layout runs off Windows.
+#if defined(OVERLAY_HEADLESS)
+using OverlayWindow   = NullWindow;
+using OverlayRenderer = HeadlessRenderer;
+using OverlayIpc      = LoopbackIpc;
+using OverlayPreview  = NullPreviewRenderer;
+#else
+using OverlayWindow   = WindowManager;
+using OverlayRenderer = DxRenderer;
+using OverlayIpc      = IpcClient;
+using OverlayPreview  = PreviewRenderer;
+#endif
 
 class OverlayApp
 {
@@ -14,18 +62,68 @@ public:
     void Shutdown();
     bool Tick(); // Returns false when app should exit
 
+    // Block until window input, IPC data or the next scheduled wakeup.
+    // Returns immediately while the panel is interactive or a frame is due.
+    void WaitForWork();
+
+#if defined(OVERLAY_HEADLESS)
+    // Driver access for the headless harness (HeadlessMain.cpp)
+    LoopbackIpc&           GetIpc() { return m_ipc; }
+    HeadlessRenderer&      GetRenderer() { return m_renderer; }
+    OverlayDataModel&      GetDataModel() { return m_dataModel; }
+    const NullWindow&      GetWindow() const { return m_window; }
+    const FrameScheduler&  GetScheduler() const { return m_scheduler; }
+    const FrameProfiler&   GetFrameProfiler() const { return m_frameProfiler; }
+    const SurfaceLayout&   GetSurfaceLayout() const { return m_surface; }
+
+    // Moves the app clock forward as if WaitForWork() had slept that long
+    // (an indefinite wait returns at once here)
+    void AdvanceClock(double seconds) { m_skippedTime += seconds; }
+#endif
+
 private:
     void ProcessIpcMessages();
     void SendPendingActions();
     void SetPanelHidden(bool hidden);
+    void PlaceSurface(Rml::Element* panel, double now);
+    void SyncActiveTab();
+    void WarmGlyphs();
+    uint32_t StructureGeneration() const { return m_tabs.Generation(); }
     double GetElapsedTime() const;
 
-    WindowManager         m_window;
-    DxRenderer            m_renderer;
-    IpcClient             m_ipc;
+    OverlayWindow         m_window;
+    OverlayRenderer       m_renderer;
+    OverlayIpc            m_ipc;
     OverlayState          m_state;
-    PreviewRenderer       m_preview;
+    OverlayPreview        m_preview;
     OverlayDataModel      m_dataModel;
+    FrameGovernor         m_governor;
+    FrameScheduler        m_scheduler;
+    FrameProfiler         m_frameProfiler;
+    SurfaceLayout         m_surface; // window / swap chain bounds around the visible UI
+    double                m_nextPhaseLog = 0.0;
+    static constexpr double PhaseLogIntervalS = 60.0;
+    TraceInternCache      m_traceIpcTypes; // "ipc.handle" / "tab.switch" details
+    TraceInternCache      m_traceTabNames;
+
+    // Elements updated directly every rendered frame
+    ElementHandle<Rml::Element> m_recEl{ "rec-indicator" };
+    ElementHandle<Rml::Element> m_previewImgEl{ "preview-img" };
+    ElementHandle<Rml::Element> m_previewPlaceholderEl{ "preview-placeholder" };
+    ElementHandle<Rml::Element> m_panelEl{ "panel" };
+    ElementHandle<Rml::Element> m_notificationEl{ "notification" };
+
+    // Tab panes are built on first use (or prebuilt while idle) and kept
+    // alive hidden; the budget is in elements across resident panes
+    RmlTabHost            m_tabHost;
+    TabCache<RmlTabHost>  m_tabs{ m_tabHost, TabElementBudget };
+    static constexpr size_t TabElementBudget = 4000;
+    LatencyHistogram      m_tabSwitchCold;  // switch that built its pane
+    LatencyHistogram      m_tabSwitchWarm;  // switch to a resident pane
+    uint64_t              m_tabSwitchStart = 0; // pending switch, closed at Present
+    bool                  m_tabSwitchBuilt = false;
+    std::string           m_failedTab; // active_tab with no pane; not retried until it changes
+    bool                  m_glyphsWarmed = false;
 
     std::string           m_pipeName;
     std::vector<IpcMessage> m_pendingActions;
@@ -34,8 +132,11 @@ private:
     float                 m_reconnectTimer = 0.0f;
     static constexpr float ReconnectIntervalS = 2.0f;
 
-    // QPC timer for delta time
-    double m_timerFrequency = 0.0;
-    long long m_lastFrameTime = 0;
+    // Monotonic clock for elapsed/delta time. The headless build adds the
+    // time WaitForWork() would have slept, so scripted runs keep real pacing
+    // without waiting for it.
+    std::chrono::steady_clock::time_point m_startTime;
+    double m_skippedTime = 0.0;
+    double m_lastFrameTime = 0.0;
     float m_deltaTime = 0.0f;
 };
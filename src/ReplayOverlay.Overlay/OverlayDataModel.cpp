@@ -108,18 +108,6 @@ static bool IsUselessHotkey(const std::string& raw, const std::string& display)
     return false;
 }
 
-static Rml::String FormatFloat(double val, int decimals)
-{
-    char buf[64];
-    if (decimals == 0)
-        snprintf(buf, sizeof(buf), "%.0f", val);
-    else if (decimals == 1)
-        snprintf(buf, sizeof(buf), "%.1f", val);
-    else
-        snprintf(buf, sizeof(buf), "%.2f", val);
-    return buf;
-}
-
 bool OverlayDataModel::Init(Rml::Context* ctx, OverlayState* state,
                              std::vector<IpcMessage>* outActions)
 {
@@ -210,6 +198,10 @@ bool OverlayDataModel::Init(Rml::Context* ctx, OverlayState* state,
     constructor.Bind("input_kinds", &m_inputKinds);
     constructor.Bind("filter_kinds", &m_filterKinds);
     constructor.Bind("hotkeys", &m_hotkeys);
+    for (const char* name : { "scenes", "sources", "audio_items", "profiles", "collections",
+                              "transitions_list", "filters", "filter_sources", "input_kinds",
+                              "filter_kinds", "hotkeys" })
+        m_profiler.SetKind(name, BindingProfiler::Kind::Array);
 
     // UI-only state
     constructor.Bind("selected_source_id", &m_selectedSourceId);
@@ -220,18 +212,8 @@ bool OverlayDataModel::Init(Rml::Context* ctx, OverlayState* state,
     constructor.Bind("hotkey_filter", &m_hotkeyFilter);
 
     // Stats
-    constructor.Bind("stat_fps", &m_statFps);
-    constructor.Bind("stat_cpu", &m_statCpu);
-    constructor.Bind("stat_memory", &m_statMemory);
-    constructor.Bind("stat_frame_time", &m_statFrameTime);
-    constructor.Bind("stat_disk", &m_statDisk);
-    constructor.Bind("stat_render_skip", &m_statRenderSkip);
-    constructor.Bind("stat_output_skip", &m_statOutputSkip);
-    constructor.Bind("fps_color", &m_fpsColor);
-    constructor.Bind("cpu_color", &m_cpuColor);
-    constructor.Bind("disk_color", &m_diskColor);
-    constructor.Bind("render_skip_color", &m_renderSkipColor);
-    constructor.Bind("output_skip_color", &m_outputSkipColor);
+    for (int f = 0; f < StatsPresenter::FieldCount; f++)
+        constructor.Bind(StatsPresenter::VariableName(f), &m_statsView.Text(f));
 
     // Audio advanced
     constructor.Bind("has_advanced", &m_hasAdvanced);
@@ -343,15 +325,20 @@ bool OverlayDataModel::Init(Rml::Context* ctx, OverlayState* state,
     return true;
 }
 
-bool OverlayDataModel::Debounce(const std::string& key, double interval)
+bool OverlayDataModel::Debounce(TimerWheel::Id& timer, double interval)
 {
-    auto it = m_debounceTimers.find(key);
-    if (it != m_debounceTimers.end() && (m_now - it->second) < interval)
+    if (m_timers.IsPending(timer))
         return false;
-    m_debounceTimers[key] = m_now;
+    Touch(timer, interval);
     return true;
 }
 
+void OverlayDataModel::Touch(TimerWheel::Id& timer, double interval)
+{
+    if (timer == TimerWheel::InvalidId) timer = m_timers.Create();
+    m_timers.Schedule(timer, interval);
+}
+
 void OverlayDataModel::SyncFromState()
 {
     if (!m_state || !m_handle) return;
@@ -359,15 +346,15 @@ void OverlayDataModel::SyncFromState()
     bool dirty = false;
 
     // Connection status
-    Rml::String newConn = m_state->connected ? "Connected" : "Disconnected";
-    if (m_connected != newConn) { m_connected = newConn; m_handle.DirtyVariable("connected"); }
+    const char* newConn = m_state->connected ? "Connected" : "Disconnected";
+    if (m_connected != newConn) { m_connected = newConn; MarkDirty("connected"); }
 
     // Simple scalars
     auto syncStr = [&](Rml::String& local, const std::string& src, const char* var) {
-        if (local != Rml::String(src.c_str())) { local = src.c_str(); m_handle.DirtyVariable(var); }
+        if (local != src.c_str()) { local = src.c_str(); MarkDirty(var); }
     };
     auto syncBool = [&](bool& local, bool src, const char* var) {
-        if (local != src) { local = src; m_handle.DirtyVariable(var); }
+        if (local != src) { local = src; MarkDirty(var); }
     };
 
     syncStr(m_currentScene, m_state->currentScene, "current_scene");
@@ -386,12 +373,12 @@ void OverlayDataModel::SyncFromState()
     syncStr(m_saveHotkey, m_state->saveHotkey, "save_hotkey");
 
     // Transition duration (with debounce)
-    if ((m_now - m_lastDurChange) >= SliderDebounceS)
+    if (!InDebounce(m_durTimer))
     {
         if (m_transitionDurMs != m_state->transitionDurationMs)
         {
             m_transitionDurMs = m_state->transitionDurationMs;
-            m_handle.DirtyVariable("transition_dur_ms");
+            MarkDirty("transition_dur_ms");
         }
     }
 
@@ -401,14 +388,14 @@ void OverlayDataModel::SyncFromState()
         if (!changed)
         {
             for (size_t i = 0; i < m_scenes.size(); i++)
-                if (m_scenes[i].name != Rml::String(m_state->scenes[i].c_str())) { changed = true; break; }
+                if (m_scenes[i].name != m_state->scenes[i].c_str()) { changed = true; break; }
         }
         if (changed)
         {
             m_scenes.clear();
             for (auto& s : m_state->scenes)
                 m_scenes.push_back({s.c_str()});
-            m_handle.DirtyVariable("scenes");
+            MarkDirty("scenes");
         }
     }
 
@@ -421,7 +408,7 @@ void OverlayDataModel::SyncFromState()
             {
                 auto& a = m_sources[i];
                 auto& b = m_state->sources[i];
-                if (a.id != b.id || a.name != Rml::String(b.name.c_str()) ||
+                if (a.id != b.id || a.name != b.name.c_str() ||
                     a.visible != b.isVisible || a.locked != b.isLocked)
                 { changed = true; break; }
             }
@@ -432,7 +419,7 @@ void OverlayDataModel::SyncFromState()
             for (auto& s : m_state->sources)
                 m_sources.push_back({s.id, s.name.c_str(), s.isVisible, s.isLocked,
                     HumanizeKindName(s.sourceKind).c_str()});
-            m_handle.DirtyVariable("sources");
+            MarkDirty("sources");
         }
     }
 
@@ -447,13 +434,13 @@ void OverlayDataModel::SyncFromState()
                 auto& b = m_state->audio[i];
                 int serverFader = MulToFader(b.volumeMul);
                 // Check debounce
-                auto dit = m_audioDebounce.find(std::string(a.name.c_str()));
+                auto dit = m_audioDebounce.find(b.name);
                 bool inDebounce = (dit != m_audioDebounce.end() &&
                                    dit->second.userFaderVal >= 0 &&
-                                   (m_now - dit->second.lastChange) < SliderDebounceS);
+                                   InDebounce(dit->second.timer));
                 int displayFader = inDebounce ? dit->second.userFaderVal : serverFader;
 
-                if (a.name != Rml::String(b.name.c_str()) ||
+                if (a.name != b.name.c_str() ||
                     a.muted != b.isMuted ||
                     a.faderVal != displayFader)
                 { changed = true; break; }
@@ -467,11 +454,11 @@ void OverlayDataModel::SyncFromState()
                 int fader = MulToFader(a.volumeMul);
                 auto dit = m_audioDebounce.find(a.name);
                 if (dit != m_audioDebounce.end() && dit->second.userFaderVal >= 0 &&
-                    (m_now - dit->second.lastChange) < SliderDebounceS)
+                    InDebounce(dit->second.timer))
                     fader = dit->second.userFaderVal;
                 m_audioItems.push_back({a.name.c_str(), a.volumeMul, a.isMuted, fader});
             }
-            m_handle.DirtyVariable("audio_items");
+            MarkDirty("audio_items");
         }
     }
 
@@ -480,12 +467,12 @@ void OverlayDataModel::SyncFromState()
         bool changed = m_profiles.size() != m_state->profiles.size();
         if (!changed)
             for (size_t i = 0; i < m_profiles.size(); i++)
-                if (m_profiles[i] != Rml::String(m_state->profiles[i].c_str())) { changed = true; break; }
+                if (m_profiles[i] != m_state->profiles[i].c_str()) { changed = true; break; }
         if (changed)
         {
             m_profiles.clear();
             for (auto& p : m_state->profiles) m_profiles.push_back(p.c_str());
-            m_handle.DirtyVariable("profiles");
+            MarkDirty("profiles");
         }
     }
 
@@ -494,12 +481,12 @@ void OverlayDataModel::SyncFromState()
         bool changed = m_collections.size() != m_state->sceneCollections.size();
         if (!changed)
             for (size_t i = 0; i < m_collections.size(); i++)
-                if (m_collections[i] != Rml::String(m_state->sceneCollections[i].c_str())) { changed = true; break; }
+                if (m_collections[i] != m_state->sceneCollections[i].c_str()) { changed = true; break; }
         if (changed)
         {
             m_collections.clear();
             for (auto& c : m_state->sceneCollections) m_collections.push_back(c.c_str());
-            m_handle.DirtyVariable("collections");
+            MarkDirty("collections");
         }
     }
 
@@ -508,12 +495,12 @@ void OverlayDataModel::SyncFromState()
         bool changed = m_transitions.size() != m_state->transitions.size();
         if (!changed)
             for (size_t i = 0; i < m_transitions.size(); i++)
-                if (m_transitions[i] != Rml::String(m_state->transitions[i].c_str())) { changed = true; break; }
+                if (m_transitions[i] != m_state->transitions[i].c_str()) { changed = true; break; }
         if (changed)
         {
             m_transitions.clear();
             for (auto& t : m_state->transitions) m_transitions.push_back(t.c_str());
-            m_handle.DirtyVariable("transitions_list");
+            MarkDirty("transitions_list");
         }
     }
 
@@ -524,27 +511,24 @@ void OverlayDataModel::SyncFromState()
             for (size_t i = 0; i < m_filters.size(); i++)
             {
                 auto& a = m_filters[i]; auto& b = m_state->filters[i];
-                if (a.name != Rml::String(b.name.c_str()) || a.enabled != b.enabled) { changed = true; break; }
+                if (a.name != b.name.c_str() || a.enabled != b.enabled) { changed = true; break; }
             }
         if (changed)
         {
             m_filters.clear();
             for (auto& f : m_state->filters)
                 m_filters.push_back({f.name.c_str(), HumanizeKindName(f.kind).c_str(), f.enabled});
-            m_handle.DirtyVariable("filters");
+            MarkDirty("filters");
         }
     }
 
     // Filter sources (combine sources + scenes)
+    if (m_filterSources.size() != m_state->sources.size() + m_state->scenes.size())
     {
-        Rml::Vector<Rml::String> newFilterSources;
-        for (auto& src : m_state->sources) newFilterSources.push_back(src.name.c_str());
-        for (auto& sc : m_state->scenes) newFilterSources.push_back(sc.c_str());
-        if (newFilterSources.size() != m_filterSources.size())
-        {
-            m_filterSources = newFilterSources;
-            m_handle.DirtyVariable("filter_sources");
-        }
+        m_filterSources.clear();
+        for (auto& src : m_state->sources) m_filterSources.push_back(src.name.c_str());
+        for (auto& sc : m_state->scenes) m_filterSources.push_back(sc.c_str());
+        MarkDirty("filter_sources");
     }
 
     // Input kinds
@@ -553,7 +537,7 @@ void OverlayDataModel::SyncFromState()
         m_inputKinds.clear();
         for (auto& k : m_state->inputKinds)
             m_inputKinds.push_back({k.c_str(), HumanizeKindName(k).c_str()});
-        m_handle.DirtyVariable("input_kinds");
+        MarkDirty("input_kinds");
     }
 
     // Filter kinds
@@ -562,11 +546,13 @@ void OverlayDataModel::SyncFromState()
         m_filterKinds.clear();
         for (auto& k : m_state->filterKinds)
             m_filterKinds.push_back({k.c_str(), HumanizeKindName(k).c_str()});
-        m_handle.DirtyVariable("filter_kinds");
+        MarkDirty("filter_kinds");
     }
 
-    // Hotkeys (filtered and deduplicated)
+    // Hotkeys (filtered and deduplicated), rebuilt only on a new hotkeys_response
+    if (m_state->hotkeysGeneration != m_hotkeysGenSeen)
     {
+        m_hotkeysGenSeen = m_state->hotkeysGeneration;
         std::set<std::string> seen;
         Rml::Vector<HotkeyItem> filtered;
         for (auto& h : m_state->hotkeys)
@@ -576,56 +562,22 @@ void OverlayDataModel::SyncFromState()
             if (!seen.insert(display).second) continue; // deduplicate
             filtered.push_back({h.c_str(), display.c_str()});
         }
-        if (filtered.size() != m_hotkeys.size() || m_hotkeys.empty())
-        {
-            m_hotkeys = std::move(filtered);
-            m_handle.DirtyVariable("hotkeys");
-        }
+        m_hotkeys = std::move(filtered);
+        MarkDirty("hotkeys");
     }
 
-    // Stats
+    // Stats: formatted only when a new stats_response arrived
+    if (m_state->statsGeneration != m_statsGenSeen)
     {
-        auto& s = m_state->stats;
-        auto newFps = FormatFloat(s.activeFps, 1);
-        if (m_statFps != newFps) { m_statFps = newFps; m_handle.DirtyVariable("stat_fps"); }
-
-        auto newCpu = FormatFloat(s.cpuUsage, 1) + "%";
-        if (m_statCpu != newCpu) { m_statCpu = newCpu; m_handle.DirtyVariable("stat_cpu"); }
-
-        auto newMem = FormatFloat(s.memoryUsage, 0) + " MB";
-        if (m_statMemory != newMem) { m_statMemory = newMem; m_handle.DirtyVariable("stat_memory"); }
-
-        auto newFt = FormatFloat(s.averageFrameRenderTime, 2) + " ms";
-        if (m_statFrameTime != newFt) { m_statFrameTime = newFt; m_handle.DirtyVariable("stat_frame_time"); }
-
-        double diskGb = s.availableDiskSpace / 1024.0;
-        auto newDisk = FormatFloat(diskGb, 1) + " GB";
-        if (m_statDisk != newDisk) { m_statDisk = newDisk; m_handle.DirtyVariable("stat_disk"); }
-
-        char buf[64];
-        snprintf(buf, sizeof(buf), "%d/%d", s.renderSkippedFrames, s.renderTotalFrames);
-        Rml::String newRS = buf;
-        if (m_statRenderSkip != newRS) { m_statRenderSkip = newRS; m_handle.DirtyVariable("stat_render_skip"); }
-
-        snprintf(buf, sizeof(buf), "%d/%d", s.outputSkippedFrames, s.outputTotalFrames);
-        Rml::String newOS = buf;
-        if (m_statOutputSkip != newOS) { m_statOutputSkip = newOS; m_handle.DirtyVariable("stat_output_skip"); }
-
-        // Color coding
-        Rml::String fc = s.activeFps > 55 ? "#4ecca3" : (s.activeFps > 30 ? "#f0c040" : "#e94560");
-        if (m_fpsColor != fc) { m_fpsColor = fc; m_handle.DirtyVariable("fps_color"); }
-
-        Rml::String cc = s.cpuUsage < 50 ? "#4ecca3" : (s.cpuUsage < 80 ? "#f0c040" : "#e94560");
-        if (m_cpuColor != cc) { m_cpuColor = cc; m_handle.DirtyVariable("cpu_color"); }
-
-        Rml::String dc = diskGb < 1.0 ? "#e94560" : (diskGb < 5.0 ? "#f0c040" : "#eaeaea");
-        if (m_diskColor != dc) { m_diskColor = dc; m_handle.DirtyVariable("disk_color"); }
-
-        Rml::String rsc = s.renderSkippedFrames > 0 ? "#e94560" : "#eaeaea";
-        if (m_renderSkipColor != rsc) { m_renderSkipColor = rsc; m_handle.DirtyVariable("render_skip_color"); }
-
-        Rml::String osc = s.outputSkippedFrames > 0 ? "#e94560" : "#eaeaea";
-        if (m_outputSkipColor != osc) { m_outputSkipColor = osc; m_handle.DirtyVariable("output_skip_color"); }
+        m_statsGenSeen = m_state->statsGeneration;
+        uint32_t changed = m_statsView.SyncStats(m_state->stats);
+        if (m_state->statsHistory.Sequence() != m_trendSeq)
+        {
+            m_trendSeq = m_state->statsHistory.Sequence();
+            changed |= m_statsView.SyncTrends(m_state->statsHistory);
+        }
+        for (int f = 0; f < StatsPresenter::FieldCount; f++)
+            if (changed & (1u << f)) MarkDirty(StatsPresenter::VariableName(f));
     }
 
     // Load settings on first sync
@@ -642,20 +594,19 @@ void OverlayDataModel::SyncFromState()
             if (m_state->recIndicatorPosition == positions[i]) { m_settingsRecPosIdx = i; break; }
 
         m_settingsLoaded = true;
-        m_handle.DirtyVariable("settings_show_notif");
-        m_handle.DirtyVariable("settings_notif_msg");
-        m_handle.DirtyVariable("settings_notif_dur");
-        m_handle.DirtyVariable("settings_show_rec");
-        m_handle.DirtyVariable("settings_rec_pos_idx");
+        MarkDirty("settings_show_notif");
+        MarkDirty("settings_notif_msg");
+        MarkDirty("settings_notif_dur");
+        MarkDirty("settings_show_rec");
+        MarkDirty("settings_rec_pos_idx");
     }
 
     // Auto-request stats when on stats tab
     if (m_activeTab == "stats")
     {
-        if (!m_state->statsPending && (m_now - m_state->statsRequestTime) > 1.0)
+        if (!m_state->statsPending && Debounce(m_statsPollTimer, StatsPollS))
         {
             m_state->statsPending = true;
-            m_state->statsRequestTime = m_now;
             m_actions->push_back({"get_stats", {}});
         }
         if (m_state->hotkeys.empty() && !m_state->hotkeysPending)
@@ -668,17 +619,12 @@ void OverlayDataModel::SyncFromState()
     // Auto-request audio advanced when on audio tab
     if (m_activeTab == "audio")
     {
-        if (m_state->audioAdvanced.empty() && !m_state->audioAdvancedPending && !m_state->audio.empty())
-        {
-            m_state->audioAdvancedPending = true;
-            m_state->audioAdvancedRequestTime = m_now;
-            m_actions->push_back({"get_audio_advanced", {}});
-        }
+        // First fetch immediately, then refresh every AudioAdvancedPollS
         if (!m_state->audioAdvancedPending && !m_state->audio.empty() &&
-            (m_now - m_state->audioAdvancedRequestTime) > 5.0)
+            (m_state->audioAdvanced.empty() || !InDebounce(m_audioAdvPollTimer)))
         {
             m_state->audioAdvancedPending = true;
-            m_state->audioAdvancedRequestTime = m_now;
+            Touch(m_audioAdvPollTimer, AudioAdvancedPollS);
             m_actions->push_back({"get_audio_advanced", {}});
         }
 
@@ -691,23 +637,23 @@ void OverlayDataModel::SyncFromState()
 
             bool hadAdv = m_hasAdvanced;
             m_hasAdvanced = (adv != nullptr);
-            if (m_hasAdvanced != hadAdv) m_handle.DirtyVariable("has_advanced");
+            if (m_hasAdvanced != hadAdv) MarkDirty("has_advanced");
 
             if (adv)
             {
                 auto& db = m_advAudioDebounce[std::string(m_expandedAudioSource.c_str())];
-                bool syncInDb = (m_now - db.lastSyncChange) < SliderDebounceS;
-                bool balInDb = (m_now - db.lastBalChange) < SliderDebounceS;
+                bool syncInDb = InDebounce(db.syncTimer);
+                bool balInDb = InDebounce(db.balTimer);
 
                 int syncVal = syncInDb ? db.userSyncMs : adv->syncOffsetMs;
                 float balVal = static_cast<float>(balInDb ? db.userBalance : adv->balance);
                 int monVal = adv->monitorType;
 
-                if (m_advSyncMs != syncVal) { m_advSyncMs = syncVal; m_handle.DirtyVariable("adv_sync_ms"); }
-                if (m_advBalance != balVal) { m_advBalance = balVal; m_handle.DirtyVariable("adv_balance"); }
-                if (m_advMonitorType != monVal) { m_advMonitorType = monVal; m_handle.DirtyVariable("adv_monitor_type"); }
+                if (m_advSyncMs != syncVal) { m_advSyncMs = syncVal; MarkDirty("adv_sync_ms"); }
+                if (m_advBalance != balVal) { m_advBalance = balVal; MarkDirty("adv_balance"); }
+                if (m_advMonitorType != monVal) { m_advMonitorType = monVal; MarkDirty("adv_monitor_type"); }
 
-                bool trackInDb = (m_now - db.lastTrackChange) < SliderDebounceS;
+                bool trackInDb = InDebounce(db.trackTimer);
                 for (int t = 0; t < 6; t++)
                 {
                     bool val = trackInDb ? db.userTracks[t] : adv->tracks[t];
@@ -716,14 +662,14 @@ void OverlayDataModel::SyncFromState()
                         m_advTracks[t] = val;
                         char varName[16];
                         snprintf(varName, sizeof(varName), "adv_track_%d", t);
-                        m_handle.DirtyVariable(varName);
+                        MarkDirty(varName);
                     }
                 }
             }
         }
         else
         {
-            if (m_hasAdvanced) { m_hasAdvanced = false; m_handle.DirtyVariable("has_advanced"); }
+            if (m_hasAdvanced) { m_hasAdvanced = false; MarkDirty("has_advanced"); }
         }
     }
 
@@ -752,16 +698,25 @@ void OverlayDataModel::ShowNotification(const std::string& text, const std::stri
     m_notifAlpha = 1.0f;
     m_notifTimer = 0.0f;
     m_notifDuration = duration;
-    m_handle.DirtyVariable("notif_active");
-    m_handle.DirtyVariable("notif_text");
-    m_handle.DirtyVariable("notif_color");
-    m_handle.DirtyVariable("notif_alpha");
+    m_notifJustShown = true;
+    MarkDirty("notif_active");
+    MarkDirty("notif_text");
+    MarkDirty("notif_color");
+    MarkDirty("notif_alpha");
 }
 
 void OverlayDataModel::UpdateNotification(float dt)
 {
     if (!m_notifActive) return;
 
+    // Shown by this tick's IPC: dt covers the wait before it arrived, which
+    // after an idle sleep is longer than the whole notification
+    if (m_notifJustShown)
+    {
+        m_notifJustShown = false;
+        return;
+    }
+
     m_notifTimer += dt;
     float fadeStart = m_notifDuration * 0.7f;
 
@@ -769,15 +724,38 @@ void OverlayDataModel::UpdateNotification(float dt)
     {
         m_notifActive = false;
         m_notifAlpha = 0.0f;
-        m_handle.DirtyVariable("notif_active");
-        m_handle.DirtyVariable("notif_alpha");
+        MarkDirty("notif_active");
+        MarkDirty("notif_alpha");
     }
     else if (m_notifTimer > fadeStart)
     {
         float fadeProgress = (m_notifTimer - fadeStart) / (m_notifDuration - fadeStart);
         m_notifAlpha = 1.0f - fadeProgress;
-        m_handle.DirtyVariable("notif_alpha");
+        MarkDirty("notif_alpha");
+    }
+}
+
+double OverlayDataModel::GetNextAnimationDelay() const
+{
+    double delay = -1.0;
+    if (m_notifActive)
+    {
+        // Static until the fade starts, then every frame
+        double fadeStart = m_notifDuration * 0.7;
+        delay = m_notifTimer < fadeStart ? fadeStart - m_notifTimer : 0.0;
     }
+    if (m_recActive)
+    {
+        double blink = RecBlinkInterval - m_recBlinkTimer;
+        if (blink < 0.0) blink = 0.0;
+        if (delay < 0.0 || blink < delay) delay = blink;
+    }
+    return delay;
+}
+
+bool OverlayDataModel::IsAnimating() const
+{
+    return m_notifActive && m_notifTimer >= m_notifDuration * 0.7;
 }
 
 // --- Preview ---
@@ -796,7 +774,7 @@ void OverlayDataModel::SetRecIndicator(bool active, const std::string& position)
         m_recActive = active;
         m_recBlinkTimer = 0.0f;
         m_recDotVisible = true;
-        m_handle.DirtyVariable("rec_dot_visible");
+        MarkDirty("rec_dot_visible");
     }
     m_recPosition = position.c_str();
     // Visibility and position classes are set directly on the element
@@ -811,9 +789,10 @@ void OverlayDataModel::UpdateRecIndicator(float dt)
     m_recBlinkTimer += dt;
     if (m_recBlinkTimer >= RecBlinkInterval)
     {
-        m_recBlinkTimer -= RecBlinkInterval;
+        // fmod: after an idle sleep dt can span several intervals
+        m_recBlinkTimer = std::fmod(m_recBlinkTimer, RecBlinkInterval);
         m_recDotVisible = !m_recDotVisible;
-        m_handle.DirtyVariable("rec_dot_visible");
+        MarkDirty("rec_dot_visible");
     }
 }
 
@@ -822,44 +801,49 @@ void OverlayDataModel::UpdateRecIndicator(float dt)
 void OverlayDataModel::OnSwitchTab(Rml::DataModelHandle handle, Rml::Event& ev, const Rml::VariantList& args)
 {
     if (args.empty()) return;
-    m_activeTab = args[0].Get<Rml::String>();
-    handle.DirtyVariable("active_tab");
+    SelectTab(args[0].Get<Rml::String>());
+}
+
+void OverlayDataModel::SelectTab(const Rml::String& tab)
+{
+    m_activeTab = tab;
+    MarkDirty("active_tab");
 
     // Default filter source when entering filters tab
     if (m_activeTab == "filters" && m_filterSelectedSource.empty() && !m_filterSources.empty())
     {
         m_filterSelectedSource = m_filterSources[0];
-        handle.DirtyVariable("filter_selected_source");
+        MarkDirty("filter_selected_source");
     }
 }
 
 void OverlayDataModel::OnToggleStream(Rml::DataModelHandle, Rml::Event&, const Rml::VariantList&)
 {
-    if (!Debounce("stream", ButtonDebounceS)) return;
+    if (!Debounce(m_buttonTimers[BtnStream], ButtonDebounceS)) return;
     m_actions->push_back({"toggle_stream", {}});
 }
 
 void OverlayDataModel::OnToggleRecord(Rml::DataModelHandle, Rml::Event&, const Rml::VariantList&)
 {
-    if (!Debounce("record", ButtonDebounceS)) return;
+    if (!Debounce(m_buttonTimers[BtnRecord], ButtonDebounceS)) return;
     m_actions->push_back({"toggle_record", {}});
 }
 
 void OverlayDataModel::OnToggleBuffer(Rml::DataModelHandle, Rml::Event&, const Rml::VariantList&)
 {
-    if (!Debounce("buffer", ButtonDebounceS)) return;
+    if (!Debounce(m_buttonTimers[BtnBuffer], ButtonDebounceS)) return;
     m_actions->push_back({"toggle_buffer", {}});
 }
 
 void OverlayDataModel::OnSaveReplay(Rml::DataModelHandle, Rml::Event&, const Rml::VariantList&)
 {
-    if (!Debounce("save", ButtonDebounceS)) return;
+    if (!Debounce(m_buttonTimers[BtnSave], ButtonDebounceS)) return;
     m_actions->push_back({"save_replay", {}});
 }
 
 void OverlayDataModel::OnTogglePause(Rml::DataModelHandle, Rml::Event&, const Rml::VariantList&)
 {
-    if (!Debounce("pause", ButtonDebounceS)) return;
+    if (!Debounce(m_buttonTimers[BtnPause], ButtonDebounceS)) return;
     m_actions->push_back({"toggle_record_pause", {}});
 }
 
@@ -920,13 +904,15 @@ void OverlayDataModel::OnSetVolume(Rml::DataModelHandle handle, Rml::Event&, con
     std::string name = args[0].Get<Rml::String>().c_str();
     int faderVal = args[1].Get<int>();
 
-    m_audioDebounce[name] = {m_now, faderVal};
+    auto& db = m_audioDebounce[name];
+    db.userFaderVal = faderVal;
+    Touch(db.timer, SliderDebounceS);
     double mul = FaderToMul(faderVal);
     nlohmann::json payload;
     payload["name"] = name;
     payload["volumeMul"] = mul;
     m_actions->push_back({"set_volume", payload});
-    handle.DirtyVariable("audio_items");
+    MarkDirty("audio_items");
 }
 
 void OverlayDataModel::OnExpandAudio(Rml::DataModelHandle handle, Rml::Event&, const Rml::VariantList& args)
@@ -957,25 +943,25 @@ void OverlayDataModel::OnExpandAudio(Rml::DataModelHandle handle, Rml::Event&, c
                 // Use debounced track values if user recently changed them
                 auto dbIt = m_advAudioDebounce.find(nameStr);
                 bool trackInDb = dbIt != m_advAudioDebounce.end() &&
-                    (m_now - dbIt->second.lastTrackChange) < SliderDebounceS;
+                    InDebounce(dbIt->second.trackTimer);
                 for (int t = 0; t < 6; t++)
                     m_advTracks[t] = trackInDb ? dbIt->second.userTracks[t] : adv.tracks[t];
 
-                handle.DirtyVariable("adv_sync_ms");
-                handle.DirtyVariable("adv_balance");
-                handle.DirtyVariable("adv_monitor_type");
+                MarkDirty("adv_sync_ms");
+                MarkDirty("adv_balance");
+                MarkDirty("adv_monitor_type");
                 for (int t = 0; t < 6; t++)
                 {
                     char vn[16];
                     snprintf(vn, sizeof(vn), "adv_track_%d", t);
-                    handle.DirtyVariable(vn);
+                    MarkDirty(vn);
                 }
                 break;
             }
         }
     }
-    handle.DirtyVariable("expanded_audio");
-    handle.DirtyVariable("has_advanced");
+    MarkDirty("expanded_audio");
+    MarkDirty("has_advanced");
 }
 
 void OverlayDataModel::OnSetSyncOffset(Rml::DataModelHandle handle, Rml::Event&, const Rml::VariantList& args)
@@ -983,8 +969,9 @@ void OverlayDataModel::OnSetSyncOffset(Rml::DataModelHandle handle, Rml::Event&,
     if (args.size() < 2) return;
     std::string name = args[0].Get<Rml::String>().c_str();
     int syncMs = args[1].Get<int>();
-    m_advAudioDebounce[name].lastSyncChange = m_now;
-    m_advAudioDebounce[name].userSyncMs = syncMs;
+    auto& db = m_advAudioDebounce[name];
+    Touch(db.syncTimer, SliderDebounceS);
+    db.userSyncMs = syncMs;
     nlohmann::json payload;
     payload["name"] = name;
     payload["offsetMs"] = syncMs;
@@ -996,8 +983,9 @@ void OverlayDataModel::OnSetBalance(Rml::DataModelHandle handle, Rml::Event&, co
     if (args.size() < 2) return;
     std::string name = args[0].Get<Rml::String>().c_str();
     double bal = args[1].Get<double>();
-    m_advAudioDebounce[name].lastBalChange = m_now;
-    m_advAudioDebounce[name].userBalance = bal;
+    auto& db = m_advAudioDebounce[name];
+    Touch(db.balTimer, SliderDebounceS);
+    db.userBalance = bal;
     nlohmann::json payload;
     payload["name"] = name;
     payload["balance"] = bal;
@@ -1031,11 +1019,11 @@ void OverlayDataModel::OnSetTracks(Rml::DataModelHandle, Rml::Event&, const Rml:
             m_advTracks[trackIdx] = !val;
             char varName[16];
             snprintf(varName, sizeof(varName), "adv_track_%d", trackIdx);
-            m_handle.DirtyVariable(varName);
+            MarkDirty(varName);
 
             // Debounce: store user's track state to survive server refreshes
             auto& db = m_advAudioDebounce[name];
-            db.lastTrackChange = m_now;
+            Touch(db.trackTimer, SliderDebounceS);
             for (int i = 0; i < 6; i++) db.userTracks[i] = adv.tracks[i];
 
             nlohmann::json payload;
@@ -1066,8 +1054,8 @@ void OverlayDataModel::OnSelectSource(Rml::DataModelHandle handle, Rml::Event&,
         for (auto& s : m_state->sources)
             if (s.id == id) { m_selectedSourceName = s.name.c_str(); break; }
     }
-    handle.DirtyVariable("selected_source_id");
-    handle.DirtyVariable("selected_source_name");
+    MarkDirty("selected_source_id");
+    MarkDirty("selected_source_name");
 }
 
 void OverlayDataModel::OnSourceUp(Rml::DataModelHandle, Rml::Event&, const Rml::VariantList&)
@@ -1129,8 +1117,8 @@ void OverlayDataModel::OnSourceDelete(Rml::DataModelHandle handle, Rml::Event&,
     m_actions->push_back({"remove_source", payload});
     m_selectedSourceId = -1;
     m_selectedSourceName = "";
-    handle.DirtyVariable("selected_source_id");
-    handle.DirtyVariable("selected_source_name");
+    MarkDirty("selected_source_id");
+    MarkDirty("selected_source_name");
 }
 
 void OverlayDataModel::OnSourceCreate(Rml::DataModelHandle, Rml::Event&, const Rml::VariantList& args)
@@ -1166,8 +1154,8 @@ void OverlayDataModel::OnSelectFilterSource(Rml::DataModelHandle handle, Rml::Ev
     if (args.empty()) return;
     m_filterSelectedSource = args[0].Get<Rml::String>();
     m_filterSelectedIdx = -1;
-    handle.DirtyVariable("filter_selected_source");
-    handle.DirtyVariable("filter_selected_idx");
+    MarkDirty("filter_selected_source");
+    MarkDirty("filter_selected_idx");
 
     m_state->filtersPending = true;
     m_state->filtersSource = std::string(m_filterSelectedSource.c_str());
@@ -1181,7 +1169,7 @@ void OverlayDataModel::OnSelectFilter(Rml::DataModelHandle handle, Rml::Event&,
     if (args.empty()) return;
     int idx = args[0].Get<int>();
     m_filterSelectedIdx = (m_filterSelectedIdx == idx) ? -1 : idx;
-    handle.DirtyVariable("filter_selected_idx");
+    MarkDirty("filter_selected_idx");
 }
 
 void OverlayDataModel::OnToggleFilter(Rml::DataModelHandle handle, Rml::Event&, const Rml::VariantList& args)
@@ -1206,7 +1194,7 @@ void OverlayDataModel::OnFilterUp(Rml::DataModelHandle handle, Rml::Event&, cons
     payload["index"] = m_filterSelectedIdx - 1;
     m_actions->push_back({"set_filter_index", payload});
     m_filterSelectedIdx--;
-    handle.DirtyVariable("filter_selected_idx");
+    MarkDirty("filter_selected_idx");
 }
 
 void OverlayDataModel::OnFilterDown(Rml::DataModelHandle handle, Rml::Event&, const Rml::VariantList&)
@@ -1219,7 +1207,7 @@ void OverlayDataModel::OnFilterDown(Rml::DataModelHandle handle, Rml::Event&, co
     payload["index"] = m_filterSelectedIdx + 1;
     m_actions->push_back({"set_filter_index", payload});
     m_filterSelectedIdx++;
-    handle.DirtyVariable("filter_selected_idx");
+    MarkDirty("filter_selected_idx");
 }
 
 void OverlayDataModel::OnFilterDelete(Rml::DataModelHandle handle, Rml::Event&, const Rml::VariantList&)
@@ -1231,7 +1219,7 @@ void OverlayDataModel::OnFilterDelete(Rml::DataModelHandle handle, Rml::Event&,
     payload["filter"] = sel.name;
     m_actions->push_back({"remove_filter", payload});
     m_filterSelectedIdx = -1;
-    handle.DirtyVariable("filter_selected_idx");
+    MarkDirty("filter_selected_idx");
 
     // Re-request filters
     m_state->filtersPending = true;
@@ -1277,10 +1265,10 @@ void OverlayDataModel::OnSetTransitionDuration(Rml::DataModelHandle handle, Rml:
 {
     if (args.empty()) return;
     int durMs = args[0].Get<int>();
-    m_lastDurChange = m_now;
+    Touch(m_durTimer, SliderDebounceS);
     m_userDurMs = durMs;
     m_transitionDurMs = durMs;
-    handle.DirtyVariable("transition_dur_ms");
+    MarkDirty("transition_dur_ms");
     nlohmann::json payload;
     payload["duration"] = durMs;
     m_actions->push_back({"set_transition_duration", payload});
@@ -1380,7 +1368,7 @@ void OverlayDataModel::OnDeleteScene(Rml::DataModelHandle, Rml::Event&, const Rm
 
 void OverlayDataModel::OnToggleVirtualCam(Rml::DataModelHandle, Rml::Event&, const Rml::VariantList&)
 {
-    if (!Debounce("vcam", ButtonDebounceS)) return;
+    if (!Debounce(m_buttonTimers[BtnVirtualCam], ButtonDebounceS)) return;
     m_actions->push_back({"toggle_virtual_cam", {}});
 }
 
@@ -1401,9 +1389,9 @@ void OverlayDataModel::OnToggleSceneForm(Rml::DataModelHandle handle, Rml::Event
         m_formName = (mode == "rename_scene") ? m_currentScene : Rml::String("");
         m_formKind = "";
     }
-    handle.DirtyVariable("form_mode");
-    handle.DirtyVariable("form_name");
-    handle.DirtyVariable("form_kind");
+    MarkDirty("form_mode");
+    MarkDirty("form_name");
+    MarkDirty("form_kind");
 }
 
 void OverlayDataModel::OnConfirmSceneForm(Rml::DataModelHandle handle, Rml::Event&, const Rml::VariantList&)
@@ -1427,8 +1415,8 @@ void OverlayDataModel::OnConfirmSceneForm(Rml::DataModelHandle handle, Rml::Even
 
     m_formMode = "";
     m_formName = "";
-    handle.DirtyVariable("form_mode");
-    handle.DirtyVariable("form_name");
+    MarkDirty("form_mode");
+    MarkDirty("form_name");
 }
 
 void OverlayDataModel::OnToggleSourceForm(Rml::DataModelHandle handle, Rml::Event&, const Rml::VariantList& args)
@@ -1450,9 +1438,9 @@ void OverlayDataModel::OnToggleSourceForm(Rml::DataModelHandle handle, Rml::Even
             m_actions->push_back({"get_input_kinds", {}});
         }
     }
-    handle.DirtyVariable("form_mode");
-    handle.DirtyVariable("form_name");
-    handle.DirtyVariable("form_kind");
+    MarkDirty("form_mode");
+    MarkDirty("form_name");
+    MarkDirty("form_kind");
 }
 
 void OverlayDataModel::OnConfirmSourceForm(Rml::DataModelHandle handle, Rml::Event&, const Rml::VariantList&)
@@ -1480,9 +1468,9 @@ void OverlayDataModel::OnConfirmSourceForm(Rml::DataModelHandle handle, Rml::Eve
     m_formMode = "";
     m_formName = "";
     m_formKind = "";
-    handle.DirtyVariable("form_mode");
-    handle.DirtyVariable("form_name");
-    handle.DirtyVariable("form_kind");
+    MarkDirty("form_mode");
+    MarkDirty("form_name");
+    MarkDirty("form_kind");
 }
 
 void OverlayDataModel::OnToggleFilterForm(Rml::DataModelHandle handle, Rml::Event&, const Rml::VariantList& args)
@@ -1509,9 +1497,9 @@ void OverlayDataModel::OnToggleFilterForm(Rml::DataModelHandle handle, Rml::Even
             m_actions->push_back({"get_filter_kinds", {}});
         }
     }
-    handle.DirtyVariable("form_mode");
-    handle.DirtyVariable("form_name");
-    handle.DirtyVariable("form_kind");
+    MarkDirty("form_mode");
+    MarkDirty("form_name");
+    MarkDirty("form_kind");
 }
 
 void OverlayDataModel::OnConfirmFilterForm(Rml::DataModelHandle handle, Rml::Event&, const Rml::VariantList&)
@@ -1548,9 +1536,9 @@ void OverlayDataModel::OnConfirmFilterForm(Rml::DataModelHandle handle, Rml::Eve
     m_formMode = "";
     m_formName = "";
     m_formKind = "";
-    handle.DirtyVariable("form_mode");
-    handle.DirtyVariable("form_name");
-    handle.DirtyVariable("form_kind");
+    MarkDirty("form_mode");
+    MarkDirty("form_name");
+    MarkDirty("form_kind");
 }
 
 void OverlayDataModel::OnRenameFilter(Rml::DataModelHandle, Rml::Event&, const Rml::VariantList& args)
@@ -1,7 +1,10 @@
 #pragma once
 #include <RmlUi/Core.h>
 #include "OverlayState.h"
-#include "IpcClient.h"
+#include "IpcMessage.h"
+#include "StatsFormat.h"
+#include "TimerWheel.h"
+#include "BindingProfiler.h"
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -16,8 +19,8 @@ public:
     // Push changes from OverlayState into the data model (call after IPC updates)
     void SyncFromState();
 
-    // Provide elapsed time for debounce logic
-    void SetElapsedTime(double t) { m_now = t; }
+    // Provide elapsed time for debounce logic; advances the timer wheel
+    void SetElapsedTime(double t) { m_timers.AdvanceTo(t); }
 
     // Notification system
     void ShowNotification(const std::string& text, const std::string& colorHex, float duration);
@@ -27,7 +30,7 @@ public:
     void SetRecIndicator(bool active, const std::string& position);
     void UpdateRecIndicator(float dt);
     bool IsRecActive() const { return m_recActive; }
-    std::string GetRecPosition() const { return std::string(m_recPosition.c_str()); }
+    const std::string& GetRecPosition() const { return m_recPosition; }
 
     // Audio track state (for direct DOM manipulation in render loop)
     bool IsAudioAdvancedVisible() const { return m_hasAdvanced && !m_expandedAudioSource.empty(); }
@@ -37,6 +40,29 @@ public:
     void SetHasPreview(bool v);
     bool HasPreview() const { return m_hasPreview; }
 
+    // Dirty-variable counts and ctx->Update() cost attribution
+    BindingProfiler& GetProfiler() { return m_profiler; }
+
+    // Tab selected in the tab bar; OverlayApp shows the matching pane
+    const Rml::String& GetActiveTab() const { return m_activeTab; }
+
+    // Same as clicking a tab in the tab bar (headless driver, tests)
+    void SelectTab(const Rml::String& tab);
+
+    // True (once) if any bound variable was dirtied since the last call
+    bool ConsumeInvalidation() { bool v = m_invalidated; m_invalidated = false; return v; }
+
+    // Seconds until notification/REC animations next need an update:
+    // 0 while a fade is running, negative if nothing is animating
+    double GetNextAnimationDelay() const;
+
+    // REC dot or a notification is on screen
+    bool IsIndicatorVisible() const { return m_recActive || m_notifActive; }
+    bool IsNotificationActive() const { return m_notifActive; }
+
+    // A notification fade is running and needs every frame
+    bool IsAnimating() const;
+
 private:
     // Event callbacks (called from RML data-event-click)
     void OnSwitchTab(Rml::DataModelHandle handle, Rml::Event& ev, const Rml::VariantList& args);
@@ -109,13 +135,24 @@ private:
     void OnConfirmFilterForm(Rml::DataModelHandle handle, Rml::Event& ev, const Rml::VariantList& args);
     void OnRenameFilter(Rml::DataModelHandle handle, Rml::Event& ev, const Rml::VariantList& args);
 
-    // Debounce helper
-    bool Debounce(const std::string& key, double interval = 2.0);
+    // Debounce helpers: a debounce is "pending" while its timer is armed
+    bool Debounce(TimerWheel::Id& timer, double interval = 2.0);
+    void Touch(TimerWheel::Id& timer, double interval);
+    bool InDebounce(TimerWheel::Id timer) const { return m_timers.IsPending(timer); }
+
+    // DirtyVariable() on the model handle, counted by the profiler
+    void MarkDirty(const char* var)
+    {
+        m_profiler.MarkDirty(var);
+        m_handle.DirtyVariable(var);
+        m_invalidated = true;
+    }
 
     Rml::DataModelHandle m_handle;
+    BindingProfiler m_profiler;
+    bool m_invalidated = false;
     OverlayState* m_state = nullptr;
     std::vector<IpcMessage>* m_actions = nullptr;
-    double m_now = 0.0;
 
     // UI-only state (not in OverlayState)
     Rml::String m_activeTab = "main";
@@ -133,6 +170,7 @@ private:
     float m_notifAlpha = 0.0f;
     float m_notifTimer = 0.0f;
     float m_notifDuration = 3.0f;
+    bool m_notifJustShown = false; // the tick's dt predates it (may span an idle sleep)
 
     // Preview state
     bool m_hasPreview = false;
@@ -152,30 +190,37 @@ private:
     int m_settingsRecPosIdx = 0;
     bool m_settingsLoaded = false;
 
-    // Debounce tracking
-    std::unordered_map<std::string, double> m_debounceTimers;
+    // Timers (debounces and auto-request intervals), driven by SetElapsedTime
+    TimerWheel m_timers;
     static constexpr double ButtonDebounceS = 2.0;
     static constexpr double SliderDebounceS = 2.0;
+    static constexpr double StatsPollS = 1.0;
+    static constexpr double AudioAdvancedPollS = 5.0;
+
+    enum ButtonTimer { BtnStream = 0, BtnRecord, BtnBuffer, BtnSave, BtnPause, BtnVirtualCam, BtnCount };
+    TimerWheel::Id m_buttonTimers[BtnCount] = {};
+    TimerWheel::Id m_statsPollTimer = TimerWheel::InvalidId;
+    TimerWheel::Id m_audioAdvPollTimer = TimerWheel::InvalidId;
 
-    // Audio debounce
+    // Audio debounce (keyed by source name; timers created on first use)
     struct AudioDebounce {
-        double lastChange = 0.0;
+        TimerWheel::Id timer = TimerWheel::InvalidId;
         int userFaderVal = -1;
     };
     std::unordered_map<std::string, AudioDebounce> m_audioDebounce;
 
     struct AdvAudioDebounce {
-        double lastSyncChange = 0.0;
+        TimerWheel::Id syncTimer = TimerWheel::InvalidId;
         int userSyncMs = 0;
-        double lastBalChange = 0.0;
+        TimerWheel::Id balTimer = TimerWheel::InvalidId;
         double userBalance = 0.5;
-        double lastTrackChange = 0.0;
+        TimerWheel::Id trackTimer = TimerWheel::InvalidId;
         bool userTracks[6] = {};
     };
     std::unordered_map<std::string, AdvAudioDebounce> m_advAudioDebounce;
 
     // Transition duration debounce
-    double m_lastDurChange = 0.0;
+    TimerWheel::Id m_durTimer = TimerWheel::InvalidId;
     int m_userDurMs = 300;
 
     // Bound data (copies of OverlayState for RmlUi binding)
@@ -217,19 +262,11 @@ private:
     Rml::Vector<KindItem> m_filterKinds;
     Rml::Vector<HotkeyItem> m_hotkeys;
 
-    // Stats
-    Rml::String m_statFps;
-    Rml::String m_statCpu;
-    Rml::String m_statMemory;
-    Rml::String m_statFrameTime;
-    Rml::String m_statDisk;
-    Rml::String m_statRenderSkip;
-    Rml::String m_statOutputSkip;
-    Rml::String m_fpsColor;
-    Rml::String m_cpuColor;
-    Rml::String m_diskColor;
-    Rml::String m_renderSkipColor;
-    Rml::String m_outputSkipColor;
+    // Stats (display strings live in the presenter; gated on statsGeneration)
+    StatsPresenter m_statsView;
+    uint32_t m_statsGenSeen = UINT32_MAX; // forces the first sync to format defaults
+    uint32_t m_trendSeq = UINT32_MAX;
+    uint32_t m_hotkeysGenSeen = 0;
 
     // Audio advanced for expanded source
     bool m_hasAdvanced = false;
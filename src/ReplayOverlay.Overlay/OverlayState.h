@@ -4,6 +4,7 @@
 #include <optional>
 #include <mutex>
 #include <nlohmann/json.hpp>
+#include "StatsHistory.h"
 
 struct SceneItemState
 {
@@ -82,7 +83,6 @@ struct OverlayState
     // Advanced audio (on-demand)
     std::vector<AudioAdvancedState> audioAdvanced;
     bool audioAdvancedPending = false;
-    double audioAdvancedRequestTime = 0.0;
 
     // Source management (on-demand)
     std::vector<std::string> inputKinds;
@@ -97,9 +97,11 @@ struct OverlayState
 
     // Stats (on-demand)
     StatsState stats;
+    StatsHistory statsHistory; // rolling 1 min / 10 min trends of 'stats'
+    uint32_t statsGeneration = 0; // bumped on every stats_response
     bool statsPending = false;
-    double statsRequestTime = 0.0;
     std::vector<std::string> hotkeys;
+    uint32_t hotkeysGeneration = 0; // bumped on every hotkeys_response
     bool hotkeysPending = false;
 
     // Config from host
@@ -263,9 +265,14 @@ struct OverlayState
             if (k.is_string()) filterKinds.push_back(k.get<std::string>());
     }
 
-    void UpdateFromStatsJson(const nlohmann::json& j)
+    // 'now' timestamps the sample in statsHistory (seconds, monotonic). The
+    // skip counters are totals since OBS started, so the first response only
+    // sets their baseline; history starts with the second.
+    void UpdateFromStatsJson(const nlohmann::json& j, double now)
     {
         statsPending = false;
+        statsGeneration++;
+        StatsState prev = stats;
         stats.cpuUsage = j.value("cpuUsage", 0.0);
         stats.memoryUsage = j.value("memoryUsage", 0.0);
         stats.availableDiskSpace = j.value("availableDiskSpace", 0.0);
@@ -275,12 +282,26 @@ struct OverlayState
         stats.renderTotalFrames = j.value("renderTotalFrames", 0);
         stats.outputSkippedFrames = j.value("outputSkippedFrames", 0);
         stats.outputTotalFrames = j.value("outputTotalFrames", 0);
+
+        if (statsGeneration == 1) return;
+
+        float sample[StatsHistory::MetricCount];
+        sample[static_cast<int>(StatsMetric::Fps)] = static_cast<float>(stats.activeFps);
+        sample[static_cast<int>(StatsMetric::Cpu)] = static_cast<float>(stats.cpuUsage);
+        sample[static_cast<int>(StatsMetric::MemoryMb)] = static_cast<float>(stats.memoryUsage);
+        sample[static_cast<int>(StatsMetric::FrameTimeMs)] = static_cast<float>(stats.averageFrameRenderTime);
+        sample[static_cast<int>(StatsMetric::RenderSkipPct)] = StatsHistory::IntervalPercent(
+            stats.renderSkippedFrames, stats.renderTotalFrames, prev.renderSkippedFrames, prev.renderTotalFrames);
+        sample[static_cast<int>(StatsMetric::OutputSkipPct)] = StatsHistory::IntervalPercent(
+            stats.outputSkippedFrames, stats.outputTotalFrames, prev.outputSkippedFrames, prev.outputTotalFrames);
+        statsHistory.Push(now, sample);
     }
 
     void UpdateFromHotkeysJson(const nlohmann::json& j)
     {
         hotkeys.clear();
         hotkeysPending = false;
+        hotkeysGeneration++;
         if (!j.is_array()) return;
         for (auto& h : j)
             if (h.is_string()) hotkeys.push_back(h.get<std::string>());
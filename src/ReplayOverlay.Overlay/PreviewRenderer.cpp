@@ -1,5 +1,7 @@
 #include "PreviewRenderer.h"
+#include "Base64.h"
 #include "DxRenderer.h"
+#include "TraceRecorder.h"
 #define WIN32_LEAN_AND_MEAN
 #include <Windows.h>
 #include <vector>
@@ -10,49 +12,32 @@
 #define STBI_ONLY_PNG
 #include "stb_image.h"
 
-// Simple base64 decoder
-static const std::string base64_chars =
-    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-
-static std::vector<unsigned char> Base64Decode(const std::string& encoded)
-{
-    std::vector<unsigned char> decoded;
-    decoded.reserve(encoded.size() * 3 / 4);
-
-    int val = 0, valb = -8;
-    for (unsigned char c : encoded)
-    {
-        if (c == '=' || c == '\n' || c == '\r') continue;
-        auto pos = base64_chars.find(c);
-        if (pos == std::string::npos) continue;
-        val = (val << 6) + static_cast<int>(pos);
-        valb += 6;
-        if (valb >= 0)
-        {
-            decoded.push_back(static_cast<unsigned char>((val >> valb) & 0xFF));
-            valb -= 8;
-        }
-    }
-    return decoded;
-}
-
 void PreviewRenderer::UpdateFromBase64(DxRenderer& dx, const std::string& base64Data)
 {
     if (base64Data.empty()) return;
+    TRACE_SCOPE("preview.decode");
 
-    // Decode base64 to PNG bytes
-    auto pngData = Base64Decode(base64Data);
-    if (pngData.empty())
+    // Decode base64 to PNG bytes (into the buffer kept from the last frame)
+    bool decoded;
     {
-        OutputDebugStringA("[PreviewRenderer] Base64 decode returned empty result\n");
+        TRACE_SCOPE("preview.base64");
+        decoded = Base64::Decode(base64Data, m_png);
+    }
+    if (!decoded || m_png.empty())
+    {
+        OutputDebugStringA("[PreviewRenderer] Base64 decode failed\n");
         return;
     }
 
     // Decode PNG to RGBA pixels
     int w = 0, h = 0, channels = 0;
-    unsigned char* pixels = stbi_load_from_memory(
-        pngData.data(), static_cast<int>(pngData.size()),
-        &w, &h, &channels, 4); // Force RGBA
+    unsigned char* pixels = nullptr;
+    {
+        TRACE_SCOPE("preview.png");
+        pixels = stbi_load_from_memory(
+            m_png.data(), static_cast<int>(m_png.size()),
+            &w, &h, &channels, 4); // Force RGBA
+    }
 
     if (!pixels)
     {
@@ -64,7 +49,10 @@ void PreviewRenderer::UpdateFromBase64(DxRenderer& dx, const std::string& base64
     Release();
 
     // Create D3D11 texture
-    m_srv = dx.CreateTextureFromRGBA(pixels, w, h);
+    {
+        TRACE_SCOPE("preview.upload");
+        m_srv = dx.CreateTextureFromRGBA(pixels, w, h);
+    }
     if (!m_srv)
         OutputDebugStringA("[PreviewRenderer] CreateTextureFromRGBA returned nullptr\n");
     m_width  = w;
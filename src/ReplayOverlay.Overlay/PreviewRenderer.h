@@ -1,5 +1,6 @@
 #pragma once
 #include <string>
+#include <vector>
 #include <d3d11.h>
 
 class DxRenderer;
@@ -16,6 +17,7 @@ public:
 
 private:
     ID3D11ShaderResourceView* m_srv = nullptr;
+    std::vector<unsigned char> m_png; // decoded payload, reused across frames
     int m_width  = 0;
     int m_height = 0;
 };
@@ -0,0 +1,485 @@
+#pragma once
+#include <algorithm>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+#include "GeometryBatcher.h"
+
+// One frame of UI rendering as data, independent of the graphics API.
+//
+// The render interfaces record everything RmlUi asks of them into a list:
+// resource operations (geometry compiled or released, textures generated,
+// updated or released) as they happen, and at the end of the frame the
+// batched stream with its scissor, transform and draw commands, recorded as
+// GeometryBatcher's backend. A backend then consumes the list through
+// Replay(). Resource operations are carried out when they are recorded
+// (RmlUi needs their handles immediately), so Replay() skips them; they are
+// in the list so that a dump shows them, and so that a frame which changed
+// a texture's contents is always drawn.
+//
+// A frame without resource operations whose draws match the last drawn
+// frame's would put the same pixels on screen, so it need not be drawn.
+// Serialize() / Deserialize() dump a frame for replay elsewhere, Describe()
+// prints it one command per line, and Diff() names the first difference.
+
+class RenderCommandList
+{
+public:
+    enum class Op : uint8_t
+    {
+        CompileGeometry,   // handle; first = vertices, count = indices
+        ReleaseGeometry,   // handle
+        GenerateTexture,   // handle; first = width, count = height
+        UpdateTexture,     // handle (contents replaced, e.g. the live preview)
+        ReleaseTexture,    // handle
+        SetScissor,        // scissorEnabled, scissor
+        SetTransform,      // first = matrix index, or NoTransform
+        Draw,              // handle = texture (0: untextured); first, count = indices
+    };
+
+    struct Command
+    {
+        Op op = Op::Draw;
+        bool scissorEnabled = false;
+        GeometryBatcher::Scissor scissor;
+        uint64_t handle = 0;
+        uint32_t first = 0;
+        uint32_t count = 0;
+
+        bool operator==(const Command& o) const
+        {
+            return op == o.op && scissorEnabled == o.scissorEnabled && scissor == o.scissor &&
+                   handle == o.handle && first == o.first && count == o.count;
+        }
+        bool operator!=(const Command& o) const { return !(*this == o); }
+    };
+
+    static constexpr uint32_t NoTransform = 0xFFFFFFFFu;
+
+    // --- Resource operations (recorded by the render interface) ---
+
+    void CompileGeometry(uint64_t handle, size_t vertices, size_t indices)
+    {
+        Push(Op::CompileGeometry, handle, static_cast<uint32_t>(vertices), static_cast<uint32_t>(indices));
+    }
+    void ReleaseGeometry(uint64_t handle) { Push(Op::ReleaseGeometry, handle); }
+    void GenerateTexture(uint64_t handle, int width, int height)
+    {
+        Push(Op::GenerateTexture, handle, static_cast<uint32_t>(width), static_cast<uint32_t>(height));
+    }
+    void UpdateTexture(uint64_t handle) { Push(Op::UpdateTexture, handle); }
+    void ReleaseTexture(uint64_t handle) { Push(Op::ReleaseTexture, handle); }
+
+    // --- GeometryBatcher backend: the frame's stream and draws ---
+
+    bool Upload(const BatchVertex* vertices, size_t vertexCount, const uint32_t* indices, size_t indexCount)
+    {
+        m_vertices.assign(vertices, vertices + vertexCount);
+        m_indices.assign(indices, indices + indexCount);
+        return true;
+    }
+
+    // Scissor and transform are recorded only when they change
+    void Draw(const GeometryBatcher::Batch& batch, const float* transform)
+    {
+        if (!m_stateKnown || batch.scissorEnabled != m_scissorEnabled ||
+            (batch.scissorEnabled && batch.scissor != m_scissor))
+        {
+            Command c;
+            c.op = Op::SetScissor;
+            c.scissorEnabled = batch.scissorEnabled;
+            c.scissor = batch.scissorEnabled ? batch.scissor : GeometryBatcher::Scissor{};
+            m_commands.push_back(c);
+            m_scissorEnabled = c.scissorEnabled;
+            m_scissor = c.scissor;
+        }
+        if (!m_stateKnown || !SameTransform(transform))
+        {
+            uint32_t index = NoTransform;
+            if (transform)
+            {
+                index = static_cast<uint32_t>(m_matrices.size() / 16);
+                m_matrices.insert(m_matrices.end(), transform, transform + 16);
+            }
+            Push(Op::SetTransform, 0, index);
+            m_transform = index;
+        }
+        m_stateKnown = true;
+        Push(Op::Draw, batch.texture, batch.firstIndex, batch.indexCount);
+        m_draws++;
+    }
+
+    // --- Consuming ---
+
+    // Feeds the stream and draws to a GeometryBatcher-style backend
+    // (Upload() once, then Draw() per batch). Returns the draws issued.
+    template <typename Backend>
+    size_t Replay(Backend& backend) const
+    {
+        if (m_draws == 0 ||
+            !backend.Upload(m_vertices.data(), m_vertices.size(), m_indices.data(), m_indices.size()))
+            return 0;
+
+        GeometryBatcher::Batch batch;
+        const float* matrix = nullptr;
+        size_t draws = 0;
+        for (const Command& c : m_commands)
+        {
+            switch (c.op)
+            {
+            case Op::SetScissor:
+                batch.scissorEnabled = c.scissorEnabled;
+                batch.scissor = c.scissor;
+                break;
+            case Op::SetTransform:
+                matrix = c.first == NoTransform ? nullptr : &m_matrices[static_cast<size_t>(c.first) * 16];
+                break;
+            case Op::Draw:
+                batch.texture = static_cast<uintptr_t>(c.handle);
+                batch.firstIndex = c.first;
+                batch.indexCount = c.count;
+                backend.Draw(batch, matrix);
+                draws++;
+                break;
+            default: // resource operations already happened
+                break;
+            }
+        }
+        return draws;
+    }
+
+    void Clear()
+    {
+        m_commands.clear();
+        m_vertices.clear();
+        m_indices.clear();
+        m_matrices.clear();
+        m_stateKnown = false;
+        m_draws = 0;
+        m_resourceOps = 0;
+    }
+
+    bool Empty() const { return m_commands.empty(); }
+    size_t Draws() const { return m_draws; }
+    size_t ResourceOps() const { return m_resourceOps; }
+    const std::vector<Command>& Commands() const { return m_commands; }
+    const std::vector<BatchVertex>& Vertices() const { return m_vertices; }
+    const std::vector<uint32_t>& Indices() const { return m_indices; }
+
+    bool operator==(const RenderCommandList& o) const
+    {
+        return m_commands == o.m_commands && SameBytes(m_vertices, o.m_vertices) &&
+               SameBytes(m_indices, o.m_indices) && SameBytes(m_matrices, o.m_matrices);
+    }
+    bool operator!=(const RenderCommandList& o) const { return !(*this == o); }
+
+    // Whether both frames issue the same draws, ignoring resource operations
+    bool DrawsSameAs(const RenderCommandList& o) const
+    {
+        if (m_draws != o.m_draws || !SameBytes(m_vertices, o.m_vertices) ||
+            !SameBytes(m_indices, o.m_indices) || !SameBytes(m_matrices, o.m_matrices))
+            return false;
+        size_t i = 0, j = 0;
+        for (;;)
+        {
+            while (i < m_commands.size() && IsResourceOp(m_commands[i].op)) i++;
+            while (j < o.m_commands.size() && IsResourceOp(o.m_commands[j].op)) j++;
+            if (i == m_commands.size() || j == o.m_commands.size())
+                return i == m_commands.size() && j == o.m_commands.size();
+            if (m_commands[i++] != o.m_commands[j++]) return false;
+        }
+    }
+
+    // --- Dumps ---
+
+    // Binary dump in host byte order (read back on the same kind of machine)
+    std::vector<uint8_t> Serialize() const
+    {
+        std::vector<uint8_t> out;
+        Put(out, Magic, 4);
+        PutU32(out, static_cast<uint32_t>(m_commands.size()));
+        PutU32(out, static_cast<uint32_t>(m_vertices.size()));
+        PutU32(out, static_cast<uint32_t>(m_indices.size()));
+        PutU32(out, static_cast<uint32_t>(m_matrices.size()));
+        for (const Command& c : m_commands)
+        {
+            const uint8_t head[4] = { static_cast<uint8_t>(c.op), static_cast<uint8_t>(c.scissorEnabled), 0, 0 };
+            Put(out, head, sizeof(head));
+            const int32_t rect[4] = { c.scissor.left, c.scissor.top, c.scissor.right, c.scissor.bottom };
+            Put(out, rect, sizeof(rect));
+            Put(out, &c.handle, sizeof(c.handle));
+            PutU32(out, c.first);
+            PutU32(out, c.count);
+        }
+        Put(out, m_vertices.data(), m_vertices.size() * sizeof(BatchVertex));
+        Put(out, m_indices.data(), m_indices.size() * sizeof(uint32_t));
+        Put(out, m_matrices.data(), m_matrices.size() * sizeof(float));
+        return out;
+    }
+
+    // Replaces the list with a dump; false (and an empty list) if malformed
+    bool Deserialize(const uint8_t* data, size_t size)
+    {
+        Clear();
+        Reader in{ data, size };
+        uint32_t commands = 0, vertices = 0, indices = 0, floats = 0;
+        if (size < 4 || std::memcmp(data, Magic, 4) != 0) return false;
+        in.at = 4;
+        if (!in.U32(commands) || !in.U32(vertices) || !in.U32(indices) || !in.U32(floats))
+            return false;
+        if (floats % 16 != 0 ||
+            in.Remaining() != static_cast<uint64_t>(commands) * CommandBytes + static_cast<uint64_t>(vertices) * sizeof(BatchVertex) +
+                              static_cast<uint64_t>(indices) * sizeof(uint32_t) + static_cast<uint64_t>(floats) * sizeof(float))
+            return false;
+
+        m_commands.resize(commands);
+        for (Command& c : m_commands)
+        {
+            uint8_t head[4];
+            int32_t rect[4];
+            in.Read(head, sizeof(head));
+            in.Read(rect, sizeof(rect));
+            in.Read(&c.handle, sizeof(c.handle));
+            in.U32(c.first);
+            in.U32(c.count);
+            if (head[0] > static_cast<uint8_t>(Op::Draw) ||
+                (static_cast<Op>(head[0]) == Op::SetTransform && c.first != NoTransform && c.first >= floats / 16) ||
+                (static_cast<Op>(head[0]) == Op::Draw && static_cast<uint64_t>(c.first) + c.count > indices))
+            {
+                Clear();
+                return false;
+            }
+            c.op = static_cast<Op>(head[0]);
+            c.scissorEnabled = head[1] != 0;
+            c.scissor = { rect[0], rect[1], rect[2], rect[3] };
+            if (c.op == Op::Draw) m_draws++;
+            if (IsResourceOp(c.op)) m_resourceOps++;
+        }
+        m_vertices.resize(vertices);
+        in.Read(m_vertices.data(), vertices * sizeof(BatchVertex));
+        m_indices.resize(indices);
+        in.Read(m_indices.data(), indices * sizeof(uint32_t));
+        m_matrices.resize(floats);
+        in.Read(m_matrices.data(), floats * sizeof(float));
+        return true;
+    }
+
+    static std::string Describe(const Command& c)
+    {
+        char line[128];
+        switch (c.op)
+        {
+        case Op::CompileGeometry:
+            snprintf(line, sizeof(line), "compile_geometry %#" PRIx64 " vertices=%u indices=%u", c.handle, c.first, c.count);
+            break;
+        case Op::ReleaseGeometry:
+            snprintf(line, sizeof(line), "release_geometry %#" PRIx64, c.handle);
+            break;
+        case Op::GenerateTexture:
+            snprintf(line, sizeof(line), "generate_texture %#" PRIx64 " %ux%u", c.handle, c.first, c.count);
+            break;
+        case Op::UpdateTexture:
+            snprintf(line, sizeof(line), "update_texture %#" PRIx64, c.handle);
+            break;
+        case Op::ReleaseTexture:
+            snprintf(line, sizeof(line), "release_texture %#" PRIx64, c.handle);
+            break;
+        case Op::SetScissor:
+            if (c.scissorEnabled)
+                snprintf(line, sizeof(line), "scissor %d,%d,%d,%d",
+                         c.scissor.left, c.scissor.top, c.scissor.right, c.scissor.bottom);
+            else
+                snprintf(line, sizeof(line), "scissor off");
+            break;
+        case Op::SetTransform:
+            if (c.first == NoTransform)
+                snprintf(line, sizeof(line), "transform none");
+            else
+                snprintf(line, sizeof(line), "transform #%u", c.first);
+            break;
+        case Op::Draw:
+            snprintf(line, sizeof(line), "draw texture=%#" PRIx64 " first=%u count=%u", c.handle, c.first, c.count);
+            break;
+        }
+        return line;
+    }
+
+    // The whole frame, one command per line
+    std::string Describe() const
+    {
+        std::string out;
+        char header[96];
+        snprintf(header, sizeof(header), "frame: %zu commands, %zu vertices, %zu indices, %zu transforms\n",
+                 m_commands.size(), m_vertices.size(), m_indices.size(), m_matrices.size() / 16);
+        out += header;
+        for (const Command& c : m_commands)
+        {
+            out += Describe(c);
+            out += '\n';
+        }
+        return out;
+    }
+
+    // The first difference between two frames; empty if they are equal
+    static std::string Diff(const RenderCommandList& a, const RenderCommandList& b)
+    {
+        char line[320];
+        const size_t common = std::min(a.m_commands.size(), b.m_commands.size());
+        for (size_t i = 0; i < common; i++)
+        {
+            if (a.m_commands[i] != b.m_commands[i])
+            {
+                snprintf(line, sizeof(line), "command %zu: %s -> %s", i,
+                         Describe(a.m_commands[i]).c_str(), Describe(b.m_commands[i]).c_str());
+                return line;
+            }
+        }
+        if (a.m_commands.size() != b.m_commands.size())
+        {
+            const RenderCommandList& longer = a.m_commands.size() > b.m_commands.size() ? a : b;
+            snprintf(line, sizeof(line), "commands: %zu -> %zu (first extra: %s)",
+                     a.m_commands.size(), b.m_commands.size(), Describe(longer.m_commands[common]).c_str());
+            return line;
+        }
+        if (std::string d = DiffArray("vertex", a.m_vertices, b.m_vertices); !d.empty()) return d;
+        if (std::string d = DiffArray("index", a.m_indices, b.m_indices); !d.empty()) return d;
+        if (std::string d = DiffArray("matrix float", a.m_matrices, b.m_matrices); !d.empty()) return d;
+        return {};
+    }
+
+private:
+    static constexpr char Magic[4] = { 'R', 'C', 'L', '1' };
+    static constexpr size_t CommandBytes = 4 + 16 + 8 + 4 + 4;
+
+    struct Reader
+    {
+        const uint8_t* data;
+        size_t size;
+        size_t at = 0;
+
+        uint64_t Remaining() const { return size - at; }
+        bool Read(void* dst, size_t n)
+        {
+            if (n > size - at) return false;
+            if (n) std::memcpy(dst, data + at, n);
+            at += n;
+            return true;
+        }
+        bool U32(uint32_t& v) { return Read(&v, sizeof(v)); }
+    };
+
+    static void Put(std::vector<uint8_t>& out, const void* src, size_t n)
+    {
+        const uint8_t* p = static_cast<const uint8_t*>(src);
+        out.insert(out.end(), p, p + n);
+    }
+    static void PutU32(std::vector<uint8_t>& out, uint32_t v) { Put(out, &v, sizeof(v)); }
+
+    template <typename T>
+    static bool SameBytes(const std::vector<T>& a, const std::vector<T>& b)
+    {
+        return a.size() == b.size() && (a.empty() || std::memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0);
+    }
+
+    template <typename T>
+    static std::string DiffArray(const char* what, const std::vector<T>& a, const std::vector<T>& b)
+    {
+        char line[96];
+        if (a.size() != b.size())
+        {
+            snprintf(line, sizeof(line), "%s count: %zu -> %zu", what, a.size(), b.size());
+            return line;
+        }
+        for (size_t i = 0; i < a.size(); i++)
+        {
+            if (std::memcmp(&a[i], &b[i], sizeof(T)) != 0)
+            {
+                snprintf(line, sizeof(line), "%s %zu differs", what, i);
+                return line;
+            }
+        }
+        return {};
+    }
+
+    bool SameTransform(const float* transform) const
+    {
+        if (m_transform == NoTransform || !transform)
+            return m_transform == NoTransform && !transform;
+        return std::memcmp(&m_matrices[static_cast<size_t>(m_transform) * 16], transform, 16 * sizeof(float)) == 0;
+    }
+
+    static bool IsResourceOp(Op op) { return op < Op::SetScissor; }
+
+    void Push(Op op, uint64_t handle, uint32_t first = 0, uint32_t count = 0)
+    {
+        if (IsResourceOp(op)) m_resourceOps++;
+        Command c;
+        c.op = op;
+        c.handle = handle;
+        c.first = first;
+        c.count = count;
+        m_commands.push_back(c);
+    }
+
+    std::vector<Command> m_commands;
+    std::vector<BatchVertex> m_vertices;
+    std::vector<uint32_t> m_indices;
+    std::vector<float> m_matrices;  // 16 floats per SetTransform
+
+    // Last recorded scissor and transform (Draw() records changes only)
+    bool m_stateKnown = false;
+    bool m_scissorEnabled = false;
+    GeometryBatcher::Scissor m_scissor;
+    uint32_t m_transform = NoTransform;
+    size_t m_draws = 0;
+    size_t m_resourceOps = 0;
+};
+
+// The frame being recorded and the last one that was drawn.
+//
+// EndFrame() closes the recording and reports whether it must be drawn:
+// it changed a resource or its draws differ from the last drawn frame's.
+// The caller then replays Last() and presents, or skips both. Invalidate() forces the next frame to count as changed (the target
+// was resized or drawn over).
+class RenderCommandHistory
+{
+public:
+    RenderCommandList& Recording() { return m_recording; }
+    const RenderCommandList& Last() const { return m_last; }
+
+    bool EndFrame()
+    {
+        const bool changed = !m_lastValid || m_recording.ResourceOps() != 0 ||
+                             !m_recording.DrawsSameAs(m_last);
+        std::swap(m_recording, m_last);
+        m_recording.Clear();
+        m_lastValid = true;
+        m_frames++;
+        if (!changed) m_unchanged++;
+        return changed;
+    }
+
+    // Drops the recording, e.g. a frame rendered only to warm caches.
+    // Its resource operations happened, so the next frame must redraw.
+    void DiscardFrame()
+    {
+        m_recording.Clear();
+        m_lastValid = false;
+    }
+
+    void Invalidate() { m_lastValid = false; }
+
+    uint64_t Frames() const { return m_frames; }
+    uint64_t UnchangedFrames() const { return m_unchanged; }
+
+private:
+    RenderCommandList m_recording;
+    RenderCommandList m_last;
+    bool m_lastValid = false;
+    uint64_t m_frames = 0;
+    uint64_t m_unchanged = 0;
+};
@@ -0,0 +1,170 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include "GeometryBatcher.h"
+
+// Shadow copy of the GPU state the UI renderer binds, so only real changes
+// reach the device context.
+//
+// Shaders, input layout, sampler, blend, depth state, topology and viewport
+// never change while the UI draws; BeginFrame() binds them once. Between
+// draws only the stream buffers, texture, rasterizer (scissor on/off),
+// scissor rect and constants (transform) can differ, and each is re-issued
+// only when it differs from what the last draw used. Calls that reach the
+// context are counted per frame.
+//
+// Context provides:
+//   void BindInvariantState();
+//   void BindStream(const void* vertices, const void* indices);
+//   void BindTexture(const void* texture);
+//   void SetRasterizer(bool scissor);
+//   void SetScissorRect(const GeometryBatcher::Scissor& rect);
+//   void WriteConstants(const float* transform);   // null = no transform
+//   void DrawIndexed(uint32_t indexCount, uint32_t firstIndex);
+// Templated on the context so it can be tested with a mock.
+
+template <typename Context>
+class RenderStateCache
+{
+public:
+    struct Counters
+    {
+        uint32_t invariant = 0;    // BindInvariantState calls
+        uint32_t streams = 0;
+        uint32_t textures = 0;
+        uint32_t rasterizer = 0;
+        uint32_t scissorRects = 0;
+        uint32_t constants = 0;
+        uint32_t draws = 0;
+
+        // State-changing calls, excluding draws
+        uint32_t StateChanges() const
+        {
+            return invariant + streams + textures + rasterizer + scissorRects + constants;
+        }
+    };
+
+    explicit RenderStateCache(Context& context) : m_context(context) {}
+
+    // Starts a frame: closes the previous frame's counters, forgets the
+    // shadow state (other code may have used the context) and binds the
+    // invariant pipeline state
+    void BeginFrame()
+    {
+        m_last = m_current;
+        m_current = {};
+        Invalidate();
+        EnsureInvariant();
+    }
+
+    // Everything must be re-issued before the next draw
+    void Invalidate()
+    {
+        m_invariantBound = false;
+        m_vertices = m_indices = nullptr;
+        m_streamBound = false;
+        m_texture = nullptr;
+        m_textureBound = false;
+        m_rasterizer = Unknown;
+        m_rectBound = false;
+        m_constantsBound = false;
+    }
+
+    // Invariant state depends on the viewport: rebind it before the next draw
+    void InvalidateInvariant()
+    {
+        m_invariantBound = false;
+        m_constantsBound = false; // projection depends on the viewport too
+    }
+
+    void BindStream(const void* vertices, const void* indices)
+    {
+        EnsureInvariant();
+        if (m_streamBound && vertices == m_vertices && indices == m_indices) return;
+        m_context.BindStream(vertices, indices);
+        m_vertices = vertices;
+        m_indices = indices;
+        m_streamBound = true;
+        m_current.streams++;
+    }
+
+    void BindTexture(const void* texture)
+    {
+        if (m_textureBound && texture == m_texture) return;
+        m_context.BindTexture(texture);
+        m_texture = texture;
+        m_textureBound = true;
+        m_current.textures++;
+    }
+
+    void SetScissor(bool enabled, const GeometryBatcher::Scissor& rect)
+    {
+        const int state = enabled ? On : Off;
+        if (state != m_rasterizer)
+        {
+            m_context.SetRasterizer(enabled);
+            m_rasterizer = state;
+            m_current.rasterizer++;
+        }
+        if (enabled && (!m_rectBound || rect != m_rect))
+        {
+            m_context.SetScissorRect(rect);
+            m_rect = rect;
+            m_rectBound = true;
+            m_current.scissorRects++;
+        }
+    }
+
+    // Column-major 4x4 or null; compared by value
+    void SetTransform(const float* transform)
+    {
+        const bool has = transform != nullptr;
+        if (m_constantsBound && has == m_hasTransform &&
+            (!has || std::memcmp(transform, m_transform, sizeof(m_transform)) == 0))
+            return;
+        m_context.WriteConstants(transform);
+        m_hasTransform = has;
+        if (has) std::memcpy(m_transform, transform, sizeof(m_transform));
+        m_constantsBound = true;
+        m_current.constants++;
+    }
+
+    void Draw(uint32_t indexCount, uint32_t firstIndex)
+    {
+        EnsureInvariant();
+        m_context.DrawIndexed(indexCount, firstIndex);
+        m_current.draws++;
+    }
+
+    const Counters& CurrentFrame() const { return m_current; }
+    const Counters& LastFrame() const { return m_last; }
+
+private:
+    enum : int { Unknown = -1, Off = 0, On = 1 };
+
+    void EnsureInvariant()
+    {
+        if (m_invariantBound) return;
+        m_context.BindInvariantState();
+        m_invariantBound = true;
+        m_current.invariant++;
+    }
+
+    Context& m_context;
+
+    bool m_invariantBound = false;
+    const void* m_vertices = nullptr;
+    const void* m_indices = nullptr;
+    bool m_streamBound = false;
+    const void* m_texture = nullptr;
+    bool m_textureBound = false;
+    int m_rasterizer = Unknown;
+    GeometryBatcher::Scissor m_rect;
+    bool m_rectBound = false;
+    bool m_constantsBound = false;
+    bool m_hasTransform = false;
+    float m_transform[16] = {};
+
+    Counters m_current;
+    Counters m_last;
+};
@@ -1,18 +1,19 @@
 #include "RmlRenderInterface_DX11.h"
+#include "Mat4.h"
+#include <algorithm>
 #include <cstring>
 #include <vector>
-#include <unordered_map>
 
 #pragma comment(lib, "d3dcompiler.lib")
 
 // --- Embedded HLSL shaders ---
 
 static const char* s_vertexShaderSrc = R"hlsl(
+// Projection, or projection * RmlUi transform. Geometry translation is
+// baked into the vertices by GeometryBatcher.
 cbuffer Constants : register(b0)
 {
     float4x4 transform;
-    float2 translation;
-    float2 padding;
 };
 
 struct VS_IN
@@ -32,8 +33,7 @@ struct VS_OUT
 VS_OUT main(VS_IN input)
 {
     VS_OUT output;
-    float2 p = input.pos + translation;
-    output.pos = mul(transform, float4(p, 0.0f, 1.0f));
+    output.pos = mul(transform, float4(input.pos, 0.0f, 1.0f));
     // RmlUi 6.0 already premultiplies vertex colors on the CPU side
     output.color = input.color;
     output.uv = input.uv;
@@ -67,6 +67,9 @@ bool RmlRenderInterface_DX11::Init(ID3D11Device* device, ID3D11DeviceContext* co
 {
     m_device = device;
     m_context = context;
+    if (FAILED(m_context->QueryInterface(IID_PPV_ARGS(&m_context1))))
+        m_context1 = nullptr; // layer redraws then clear the whole layer
+    m_dirty.Resize(m_viewportWidth, m_viewportHeight);
 
     if (!CreateShaders()) return false;
     if (!CreatePipelineState()) return false;
@@ -79,20 +82,27 @@ bool RmlRenderInterface_DX11::Init(ID3D11Device* device, ID3D11DeviceContext* co
 
 void RmlRenderInterface_DX11::Shutdown()
 {
-    // Release all compiled geometries
-    for (auto& [id, geo] : m_geometries)
-    {
-        if (geo.vertexBuffer) geo.vertexBuffer->Release();
-        if (geo.indexBuffer) geo.indexBuffer->Release();
-    }
-    m_geometries.clear();
+    m_geometries.Clear();
+    m_geometryArena.Reset();
+    m_batcher.Reset();
+    m_commands.DiscardFrame();
+    if (m_streamVertices) { m_streamVertices->Release(); m_streamVertices = nullptr; }
+    if (m_streamIndices) { m_streamIndices->Release(); m_streamIndices = nullptr; }
+    m_streamVertexCapacity = m_streamIndexCapacity = 0;
+    ReleaseLayer();
 
     // Release all textures (except external)
-    for (auto& [id, tex] : m_textures)
+    for (auto& tex : m_textures)
     {
         if (tex.srv && !tex.external) tex.srv->Release();
     }
-    m_textures.clear();
+    m_textures.Clear();
+    m_previewHandle = 0;
+    for (ID3D11Texture2D* page : m_atlasTextures) page->Release();
+    m_atlasTextures.clear();
+    m_atlasPages.clear();
+    m_atlas.Clear();
+    m_textureBytes = 0;
 
     if (m_whiteTexture) { m_whiteTexture->Release(); m_whiteTexture = nullptr; }
     if (m_vertexShader) { m_vertexShader->Release(); m_vertexShader = nullptr; }
@@ -104,6 +114,7 @@ void RmlRenderInterface_DX11::Shutdown()
     if (m_rasterizerStateScissor) { m_rasterizerStateScissor->Release(); m_rasterizerStateScissor = nullptr; }
     if (m_sampler) { m_sampler->Release(); m_sampler = nullptr; }
     if (m_depthStencilState) { m_depthStencilState->Release(); m_depthStencilState = nullptr; }
+    if (m_context1) { m_context1->Release(); m_context1 = nullptr; }
 }
 
 // --- Setup helpers ---
@@ -270,129 +281,265 @@ void RmlRenderInterface_DX11::PreMultiplyAlpha(unsigned char* pixels, int w, int
     }
 }
 
-void RmlRenderInterface_DX11::SetViewport(int width, int height)
+void RmlRenderInterface_DX11::SetViewport(int width, int height, int x, int y)
 {
+    m_viewportX = x;
+    m_viewportY = y;
     m_viewportWidth = width;
     m_viewportHeight = height;
+    Mat4::Ortho(m_projection, static_cast<float>(width), static_cast<float>(height),
+                static_cast<float>(x), static_cast<float>(y));
+    m_state.InvalidateInvariant(); // viewport and projection
+    m_commands.Invalidate();       // the resized target must be redrawn
+    ReleaseLayer();                // recreated at the new size
+    m_dirty.SetTarget({ x, y, x + width, y + height });
 }
 
 Rml::TextureHandle RmlRenderInterface_DX11::RegisterExternalTexture(ID3D11ShaderResourceView* srv)
 {
-    uintptr_t handle = m_nextTextureHandle++;
-    m_textures[handle] = { srv, true };
+    uintptr_t handle = static_cast<uintptr_t>(m_textures.Insert({ srv, true }));
+    m_commands.Recording().UpdateTexture(handle);
     return static_cast<Rml::TextureHandle>(handle);
 }
 
 // --- Geometry ---
 
+static_assert(sizeof(Rml::Vertex) == sizeof(BatchVertex), "BatchVertex must mirror Rml::Vertex");
+
 Rml::CompiledGeometryHandle RmlRenderInterface_DX11::CompileGeometry(
     Rml::Span<const Rml::Vertex> vertices, Rml::Span<const int> indices)
 {
-    CompiledGeometry geo = {};
-    geo.indexCount = static_cast<int>(indices.size());
+    CompiledGeometry geo = m_geometryArena.Allocate(
+        reinterpret_cast<const BatchVertex*>(vertices.data()), vertices.size(),
+        indices.data(), indices.size());
 
-    // Vertex buffer
-    {
-        D3D11_BUFFER_DESC bd = {};
-        bd.ByteWidth = static_cast<UINT>(vertices.size() * sizeof(Rml::Vertex));
-        bd.Usage = D3D11_USAGE_IMMUTABLE;
-        bd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-
-        D3D11_SUBRESOURCE_DATA data = {};
-        data.pSysMem = vertices.data();
+    uintptr_t handle = static_cast<uintptr_t>(m_geometries.Insert(geo));
+    m_commands.Recording().CompileGeometry(handle, vertices.size(), indices.size());
+    return static_cast<Rml::CompiledGeometryHandle>(handle);
+}
 
-        if (FAILED(m_device->CreateBuffer(&bd, &data, &geo.vertexBuffer)))
-            return {};
-    }
+void RmlRenderInterface_DX11::RenderGeometry(Rml::CompiledGeometryHandle handle,
+                                              Rml::Vector2f translation,
+                                              Rml::TextureHandle texture)
+{
+    const CompiledGeometry* geo = m_geometries.Get(static_cast<uintptr_t>(handle));
+    if (!geo) return;
 
-    // Index buffer
+    // Atlas entries are drawn as their page, so they batch with each other
+    uintptr_t tex = static_cast<uintptr_t>(texture);
+    const UvTransform* uv = nullptr;
+    if (const TextureData* data = tex ? m_textures.Get(tex) : nullptr)
     {
-        D3D11_BUFFER_DESC bd = {};
-        bd.ByteWidth = static_cast<UINT>(indices.size() * sizeof(int));
-        bd.Usage = D3D11_USAGE_IMMUTABLE;
-        bd.BindFlags = D3D11_BIND_INDEX_BUFFER;
-
-        D3D11_SUBRESOURCE_DATA data = {};
-        data.pSysMem = indices.data();
-
-        if (FAILED(m_device->CreateBuffer(&bd, &data, &geo.indexBuffer)))
+        if (data->atlasPage)
         {
-            geo.vertexBuffer->Release();
-            return {};
+            tex = data->atlasPage;
+            uv = &data->uv;
         }
     }
 
-    uintptr_t handle = m_nextGeometryHandle++;
-    m_geometries[handle] = geo;
-    return static_cast<Rml::CompiledGeometryHandle>(handle);
+    // Queued; drawn by Flush() together with neighbours sharing its state
+    m_batcher.Add(m_geometryArena.Vertices(*geo), geo->vertexCount,
+                  m_geometryArena.Indices(*geo), geo->indexCount,
+                  translation.x, translation.y, tex, uv);
 }
 
-void RmlRenderInterface_DX11::RenderGeometry(Rml::CompiledGeometryHandle handle,
-                                              Rml::Vector2f translation,
-                                              Rml::TextureHandle texture)
+void RmlRenderInterface_DX11::ReleaseGeometry(Rml::CompiledGeometryHandle handle)
 {
-    auto it = m_geometries.find(static_cast<uintptr_t>(handle));
-    if (it == m_geometries.end()) return;
+    const CompiledGeometry* geo = m_geometries.Get(static_cast<uintptr_t>(handle));
+    if (!geo) return;
+    m_geometryArena.Free(*geo);
+    m_geometries.Erase(static_cast<uintptr_t>(handle));
+    m_commands.Recording().ReleaseGeometry(static_cast<uintptr_t>(handle));
+}
 
-    auto& geo = it->second;
+// The batched frame goes into the command list rather than to the device;
+// an unchanged frame is never uploaded or drawn
+bool RmlRenderInterface_DX11::Flush()
+{
+    m_batcher.Flush(m_commands.Recording());
+    return m_commands.EndFrame();
+}
 
-    // Update constant buffer with orthographic projection + translation
+void RmlRenderInterface_DX11::Submit(ID3D11RenderTargetView* target)
+{
+    m_state.BeginFrame(); // invariant UI pipeline state, once per frame
+    const RenderCommandList& frame = m_commands.Last();
+    if (!EnsureLayer())
     {
-        D3D11_MAPPED_SUBRESOURCE mapped;
-        m_context->Map(m_constantBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped);
-        auto* cb = static_cast<ConstantBuffer*>(mapped.pData);
+        m_context->OMSetRenderTargets(1, &target, nullptr);
+        frame.Replay(*this);
+        return;
+    }
 
-        // Orthographic projection: [0, viewportW] x [0, viewportH] -> [-1, 1] x [-1, 1]
-        // Column-major storage for HLSL mul(matrix, vector)
-        if (m_hasTransform)
+    // Redraw what changed: clear the dirty rect, then replay only the draws
+    // that overlap it, scissored to it
+    m_redraw = m_dirty.Update(frame);
+    if (!DirtyRectTracker::Empty(m_redraw))
+    {
+        ID3D11ShaderResourceView* none = nullptr;
+        m_context->PSSetShaderResources(0, 1, &none); // the layer may still be bound from the last composite
+        m_context->OMSetRenderTargets(1, &m_layerRtv, nullptr);
+        const float transparent[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+        if (!m_context1)
+            m_redraw = m_dirty.Target();
+        if (m_redraw == m_dirty.Target())
         {
-            // Apply custom transform, then orthographic projection
-            // Build ortho matrix
-            float ortho[16] = {};
-            ortho[0]  = 2.0f / m_viewportWidth;
-            ortho[5]  = -2.0f / m_viewportHeight;
-            ortho[10] = 1.0f;
-            ortho[12] = -1.0f;
-            ortho[13] = 1.0f;
-            ortho[15] = 1.0f;
-
-            // Multiply: ortho * m_transformMatrix (both column-major)
-            for (int c = 0; c < 4; c++)
-            {
-                for (int r = 0; r < 4; r++)
-                {
-                    float sum = 0.0f;
-                    for (int k = 0; k < 4; k++)
-                        sum += ortho[k * 4 + r] * m_transformMatrix[c * 4 + k];
-                    cb->transform[c * 4 + r] = sum;
-                }
-            }
+            m_context->ClearRenderTargetView(m_layerRtv, transparent);
         }
         else
         {
-            // Simple orthographic projection (column-major)
-            memset(cb->transform, 0, sizeof(cb->transform));
-            cb->transform[0]  = 2.0f / m_viewportWidth;   // [0][0]
-            cb->transform[5]  = -2.0f / m_viewportHeight;  // [1][1]
-            cb->transform[10] = 1.0f;                       // [2][2]
-            cb->transform[12] = -1.0f;                      // [3][0]
-            cb->transform[13] = 1.0f;                       // [3][1]
-            cb->transform[15] = 1.0f;                       // [3][3]
+            D3D11_RECT r = { m_redraw.left - m_viewportX, m_redraw.top - m_viewportY,
+                             m_redraw.right - m_viewportX, m_redraw.bottom - m_viewportY };
+            m_context1->ClearView(m_layerRtv, transparent, &r, 1);
         }
+        m_layerPass = true;
+        m_drawIndex = 0;
+        if (frame.Draws() && !frame.Replay(*this))
+            m_dirty.Invalidate(); // upload failed: the layer is incomplete
+        m_layerPass = false;
+    }
 
-        cb->translation[0] = translation.x;
-        cb->translation[1] = translation.y;
-        cb->padding[0] = 0.0f;
-        cb->padding[1] = 0.0f;
+    // Composite: one premultiplied quad over the target
+    m_context->OMSetRenderTargets(1, &target, nullptr);
+    m_state.BindStream(m_layerQuadVertices, m_layerQuadIndices);
+    m_state.SetTransform(nullptr);
+    m_state.BindTexture(m_layerSrv);
+    m_state.SetScissor(false, {});
+    m_state.Draw(6, 0);
+}
 
-        m_context->Unmap(m_constantBuffer, 0);
+bool RmlRenderInterface_DX11::EnsureLayer()
+{
+    if (m_layerSrv) return true;
+    if (m_viewportWidth <= 0 || m_viewportHeight <= 0) return false;
+
+    D3D11_TEXTURE2D_DESC td = {};
+    td.Width = static_cast<UINT>(m_viewportWidth);
+    td.Height = static_cast<UINT>(m_viewportHeight);
+    td.MipLevels = 1;
+    td.ArraySize = 1;
+    td.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+    td.SampleDesc.Count = 1;
+    td.Usage = D3D11_USAGE_DEFAULT;
+    td.BindFlags = D3D11_BIND_RENDER_TARGET | D3D11_BIND_SHADER_RESOURCE;
+
+    // The quad covers the viewport in UI coordinates, like the draws
+    const float x0 = static_cast<float>(m_viewportX), y0 = static_cast<float>(m_viewportY);
+    const float x1 = x0 + m_viewportWidth, y1 = y0 + m_viewportHeight;
+    const BatchVertex quad[4] = {
+        { x0, y0, 0xFFFFFFFFu, 0.0f, 0.0f }, { x1, y0, 0xFFFFFFFFu, 1.0f, 0.0f },
+        { x1, y1, 0xFFFFFFFFu, 1.0f, 1.0f }, { x0, y1, 0xFFFFFFFFu, 0.0f, 1.0f } };
+    const uint32_t indices[6] = { 0, 1, 2, 0, 2, 3 };
+    auto createBuffer = [this](const void* data, UINT bytes, UINT bind, ID3D11Buffer** buffer) {
+        D3D11_BUFFER_DESC bd = {};
+        bd.ByteWidth = bytes;
+        bd.Usage = D3D11_USAGE_IMMUTABLE;
+        bd.BindFlags = bind;
+        D3D11_SUBRESOURCE_DATA init = {};
+        init.pSysMem = data;
+        return SUCCEEDED(m_device->CreateBuffer(&bd, &init, buffer));
+    };
+
+    if (FAILED(m_device->CreateTexture2D(&td, nullptr, &m_layer)) ||
+        FAILED(m_device->CreateRenderTargetView(m_layer, nullptr, &m_layerRtv)) ||
+        FAILED(m_device->CreateShaderResourceView(m_layer, nullptr, &m_layerSrv)) ||
+        !createBuffer(quad, sizeof(quad), D3D11_BIND_VERTEX_BUFFER, &m_layerQuadVertices) ||
+        !createBuffer(indices, sizeof(indices), D3D11_BIND_INDEX_BUFFER, &m_layerQuadIndices))
+    {
+        ReleaseLayer();
+        return false;
     }
+    m_dirty.Invalidate(); // new layer: contents undefined
+    return true;
+}
 
-    // Bind pipeline state
-    UINT stride = sizeof(Rml::Vertex);
-    UINT offset = 0;
-    m_context->IASetVertexBuffers(0, 1, &geo.vertexBuffer, &stride, &offset);
-    m_context->IASetIndexBuffer(geo.indexBuffer, DXGI_FORMAT_R32_UINT, 0);
+void RmlRenderInterface_DX11::ReleaseLayer()
+{
+    if (m_layerSrv) { m_layerSrv->Release(); m_layerSrv = nullptr; }
+    if (m_layerRtv) { m_layerRtv->Release(); m_layerRtv = nullptr; }
+    if (m_layer) { m_layer->Release(); m_layer = nullptr; }
+    if (m_layerQuadVertices) { m_layerQuadVertices->Release(); m_layerQuadVertices = nullptr; }
+    if (m_layerQuadIndices) { m_layerQuadIndices->Release(); m_layerQuadIndices = nullptr; }
+    m_dirty.Invalidate();
+}
+
+bool RmlRenderInterface_DX11::EnsureStreamCapacity(size_t vertexCount, size_t indexCount)
+{
+    auto grow = [this](ID3D11Buffer*& buffer, size_t& capacity, size_t needed, size_t stride, UINT bind) {
+        if (needed <= capacity) return true;
+        size_t cap = capacity ? capacity : 4096;
+        while (cap < needed) cap *= 2;
+        if (buffer) { buffer->Release(); buffer = nullptr; }
+        capacity = 0;
+
+        D3D11_BUFFER_DESC bd = {};
+        bd.ByteWidth = static_cast<UINT>(cap * stride);
+        bd.Usage = D3D11_USAGE_DYNAMIC;
+        bd.BindFlags = bind;
+        bd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+        if (FAILED(m_device->CreateBuffer(&bd, nullptr, &buffer)))
+            return false;
+        capacity = cap;
+        return true;
+    };
+    return grow(m_streamVertices, m_streamVertexCapacity, vertexCount, sizeof(BatchVertex), D3D11_BIND_VERTEX_BUFFER) &&
+           grow(m_streamIndices, m_streamIndexCapacity, indexCount, sizeof(uint32_t), D3D11_BIND_INDEX_BUFFER);
+}
+
+// Writes the frame's vertex/index stream. WRITE_DISCARD renames the
+// buffers, so they stay bound across frames unless they had to grow.
+bool RmlRenderInterface_DX11::Upload(const BatchVertex* vertices, size_t vertexCount,
+                                     const uint32_t* indices, size_t indexCount)
+{
+    if (!EnsureStreamCapacity(vertexCount, indexCount))
+        return false;
+
+    D3D11_MAPPED_SUBRESOURCE mapped;
+    if (FAILED(m_context->Map(m_streamVertices, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped)))
+        return false;
+    memcpy(mapped.pData, vertices, vertexCount * sizeof(BatchVertex));
+    m_context->Unmap(m_streamVertices, 0);
+
+    if (FAILED(m_context->Map(m_streamIndices, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped)))
+        return false;
+    memcpy(mapped.pData, indices, indexCount * sizeof(uint32_t));
+    m_context->Unmap(m_streamIndices, 0);
+
+    m_state.BindStream(m_streamVertices, m_streamIndices);
+    return true;
+}
+
+void RmlRenderInterface_DX11::Draw(const GeometryBatcher::Batch& batch, const float* transform)
+{
+    // Layer pass: skip draws outside the dirty rect, clip the rest to it
+    bool scissorEnabled = batch.scissorEnabled;
+    GeometryBatcher::Scissor scissor = batch.scissor;
+    if (m_layerPass)
+    {
+        if (!DirtyRectTracker::Overlaps(m_dirty.DrawBounds(m_drawIndex++), m_redraw))
+            return;
+        scissor = scissorEnabled ? DirtyRectTracker::Intersect(scissor, m_redraw) : m_redraw;
+        scissorEnabled = true;
+    }
+
+    ID3D11ShaderResourceView* srv = m_whiteTexture;
+    if (batch.texture)
+    {
+        const TextureData* tex = m_textures.Get(batch.texture);
+        if (tex && tex->srv)
+            srv = tex->srv;
+    }
+
+    m_state.SetTransform(transform);
+    m_state.BindTexture(srv);
+    m_state.SetScissor(scissorEnabled, scissor);
+    m_state.Draw(batch.indexCount, batch.firstIndex);
+}
+
+// --- Device context (through RenderStateCache) ---
+
+void RmlRenderInterface_DX11::BindInvariantState()
+{
     m_context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
     m_context->IASetInputLayout(m_inputLayout);
 
@@ -401,41 +548,66 @@ void RmlRenderInterface_DX11::RenderGeometry(Rml::CompiledGeometryHandle handle,
     m_context->PSSetShader(m_pixelShader, nullptr, 0);
     m_context->PSSetSamplers(0, 1, &m_sampler);
 
-    // Bind texture
-    ID3D11ShaderResourceView* srv = m_whiteTexture;
-    if (texture)
-    {
-        auto texIt = m_textures.find(static_cast<uintptr_t>(texture));
-        if (texIt != m_textures.end() && texIt->second.srv)
-            srv = texIt->second.srv;
-    }
-    m_context->PSSetShaderResources(0, 1, &srv);
-
-    // State
     float blendFactor[4] = { 0, 0, 0, 0 };
     m_context->OMSetBlendState(m_blendState, blendFactor, 0xFFFFFFFF);
     m_context->OMSetDepthStencilState(m_depthStencilState, 0);
-    m_context->RSSetState(m_scissorEnabled ? m_rasterizerStateScissor : m_rasterizerState);
 
-    // Viewport
     D3D11_VIEWPORT vp = {};
     vp.Width = static_cast<float>(m_viewportWidth);
     vp.Height = static_cast<float>(m_viewportHeight);
     vp.MaxDepth = 1.0f;
     m_context->RSSetViewports(1, &vp);
+}
 
-    // Draw
-    m_context->DrawIndexed(geo.indexCount, 0, 0);
+void RmlRenderInterface_DX11::BindStream(const void* vertices, const void* indices)
+{
+    auto* vb = static_cast<ID3D11Buffer*>(const_cast<void*>(vertices));
+    auto* ib = static_cast<ID3D11Buffer*>(const_cast<void*>(indices));
+    UINT stride = sizeof(BatchVertex);
+    UINT offset = 0;
+    m_context->IASetVertexBuffers(0, 1, &vb, &stride, &offset);
+    m_context->IASetIndexBuffer(ib, DXGI_FORMAT_R32_UINT, 0);
 }
 
-void RmlRenderInterface_DX11::ReleaseGeometry(Rml::CompiledGeometryHandle handle)
+void RmlRenderInterface_DX11::BindTexture(const void* srv)
 {
-    auto it = m_geometries.find(static_cast<uintptr_t>(handle));
-    if (it == m_geometries.end()) return;
+    auto* view = static_cast<ID3D11ShaderResourceView*>(const_cast<void*>(srv));
+    m_context->PSSetShaderResources(0, 1, &view);
+}
 
-    if (it->second.vertexBuffer) it->second.vertexBuffer->Release();
-    if (it->second.indexBuffer) it->second.indexBuffer->Release();
-    m_geometries.erase(it);
+void RmlRenderInterface_DX11::SetRasterizer(bool scissor)
+{
+    m_context->RSSetState(scissor ? m_rasterizerStateScissor : m_rasterizerState);
+}
+
+void RmlRenderInterface_DX11::SetScissorRect(const GeometryBatcher::Scissor& rect)
+{
+    // UI coordinates to target pixels
+    D3D11_RECT r = { std::max(rect.left - m_viewportX, 0), std::max(rect.top - m_viewportY, 0),
+                     std::max(rect.right - m_viewportX, 0), std::max(rect.bottom - m_viewportY, 0) };
+    m_context->RSSetScissorRects(1, &r);
+}
+
+void RmlRenderInterface_DX11::DrawIndexed(uint32_t indexCount, uint32_t firstIndex)
+{
+    m_context->DrawIndexed(indexCount, firstIndex, 0);
+}
+
+// Orthographic projection of the viewport's part of the UI -> clip space,
+// times the RmlUi transform if any. Translation is baked into the vertices.
+// Called by RenderStateCache only when the transform (or the viewport)
+// changed, so the multiply runs once per distinct transform, not per draw
+void RmlRenderInterface_DX11::WriteConstants(const float* transform)
+{
+    D3D11_MAPPED_SUBRESOURCE mapped;
+    if (FAILED(m_context->Map(m_constantBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped)))
+        return;
+    auto* cb = static_cast<ConstantBuffer*>(mapped.pData);
+    if (transform)
+        Mat4::Multiply(m_projection, transform, cb->transform);
+    else
+        memcpy(cb->transform, m_projection, sizeof(m_projection));
+    m_context->Unmap(m_constantBuffer, 0);
 }
 
 // --- Textures ---
@@ -449,21 +621,22 @@ Rml::TextureHandle RmlRenderInterface_DX11::LoadTexture(Rml::Vector2i& dimension
     // updates the texture map entry when a real frame arrives.
     if (source.find("__preview__") != Rml::String::npos)
     {
-        if (m_previewHandle == 0)
-            m_previewHandle = m_nextTextureHandle++;
+        // Re-registered if RmlUi released it (the old handle stays stale)
+        if (!m_textures.Contains(m_previewHandle))
+            m_previewHandle = static_cast<uintptr_t>(m_textures.Insert({ nullptr, true }));
 
         if (m_previewSrv)
         {
             dimensions.x = m_previewWidth;
             dimensions.y = m_previewHeight;
-            m_textures[m_previewHandle] = { m_previewSrv, true };
         }
         else
         {
             dimensions.x = 1;
             dimensions.y = 1;
-            m_textures[m_previewHandle] = { m_whiteTexture, true };
         }
+        m_textures.Get(m_previewHandle)->srv = m_previewSrv ? m_previewSrv : m_whiteTexture;
+        m_commands.Recording().UpdateTexture(m_previewHandle);
         return static_cast<Rml::TextureHandle>(m_previewHandle);
     }
     return {};
@@ -475,8 +648,11 @@ void RmlRenderInterface_DX11::SetPreviewTexture(ID3D11ShaderResourceView* srv, i
     m_previewWidth = w;
     m_previewHeight = h;
     // Keep the texture map entry pointing to the latest SRV
-    if (m_previewHandle != 0)
-        m_textures[m_previewHandle] = { srv, true };
+    if (TextureData* tex = m_textures.Get(m_previewHandle))
+    {
+        tex->srv = srv;
+        m_commands.Recording().UpdateTexture(m_previewHandle);
+    }
 }
 
 void RmlRenderInterface_DX11::ClearPreviewTexture()
@@ -486,8 +662,11 @@ void RmlRenderInterface_DX11::ClearPreviewTexture()
     m_previewHeight = 0;
     // Preserve the handle -- RmlUi's FileTextureDatabase still references it.
     // Replace the SRV with the white placeholder so the old SRV can be safely freed.
-    if (m_previewHandle != 0)
-        m_textures[m_previewHandle] = { m_whiteTexture, true };
+    if (TextureData* tex = m_textures.Get(m_previewHandle))
+    {
+        tex->srv = m_whiteTexture;
+        m_commands.Recording().UpdateTexture(m_previewHandle);
+    }
 }
 
 Rml::TextureHandle RmlRenderInterface_DX11::GenerateTexture(
@@ -496,6 +675,15 @@ Rml::TextureHandle RmlRenderInterface_DX11::GenerateTexture(
     int w = dimensions.x;
     int h = dimensions.y;
 
+    if (m_atlas.Fits(w, h))
+    {
+        if (Rml::TextureHandle handle = GenerateAtlasTexture(source.data(), w, h))
+        {
+            m_commands.Recording().GenerateTexture(static_cast<uintptr_t>(handle), w, h);
+            return handle;
+        }
+    }
+
     // RmlUi 6.0 already provides premultiplied pixel data -- upload as-is
     D3D11_TEXTURE2D_DESC td = {};
     td.Width = w;
@@ -520,50 +708,107 @@ Rml::TextureHandle RmlRenderInterface_DX11::GenerateTexture(
     tex->Release();
     if (FAILED(hr)) return {};
 
-    uintptr_t handle = m_nextTextureHandle++;
-    m_textures[handle] = { srv, false };
+    size_t bytes = static_cast<size_t>(w) * h * 4;
+    m_textureBytes += bytes;
+    uintptr_t handle = static_cast<uintptr_t>(m_textures.Insert({ srv, false, bytes }));
+    m_commands.Recording().GenerateTexture(handle, w, h);
     return static_cast<Rml::TextureHandle>(handle);
 }
 
 void RmlRenderInterface_DX11::ReleaseTexture(Rml::TextureHandle handle)
 {
-    auto it = m_textures.find(static_cast<uintptr_t>(handle));
-    if (it == m_textures.end()) return;
+    TextureData* tex = m_textures.Get(static_cast<uintptr_t>(handle));
+    if (!tex) return;
+
+    if (tex->atlasPage)
+        m_atlas.Release(tex->placement); // the page texture stays
+    else if (tex->srv && !tex->external)
+        tex->srv->Release();
+    m_textureBytes -= tex->bytes;
+    m_textures.Erase(static_cast<uintptr_t>(handle));
+    m_commands.Recording().ReleaseTexture(static_cast<uintptr_t>(handle));
+}
+
+// Places the texels on an atlas page; null if no page can take them
+Rml::TextureHandle RmlRenderInterface_DX11::GenerateAtlasTexture(const Rml::byte* source, int w, int h)
+{
+    bool newPage = false;
+    TextureAtlas::Placement placement = m_atlas.Insert(w, h, &newPage);
+    if (!placement.Valid()) return {};
+    if (newPage && !CreateAtlasPage())
+    {
+        m_atlas.RemoveLastPage();
+        return {};
+    }
 
-    if (it->second.srv && !it->second.external)
-        it->second.srv->Release();
-    m_textures.erase(it);
+    // Upload with the replicated border so bilinear filtering at the
+    // entry's edges stays inside it
+    const int b = TextureAtlas::Border;
+    std::vector<uint8_t> texels(static_cast<size_t>(w + 2 * b) * (h + 2 * b) * 4);
+    TextureAtlas::CopyWithBorder(source, w, h, texels.data());
+    D3D11_BOX box = {};
+    box.left = static_cast<UINT>(placement.x - b);
+    box.top = static_cast<UINT>(placement.y - b);
+    box.right = static_cast<UINT>(placement.x + w + b);
+    box.bottom = static_cast<UINT>(placement.y + h + b);
+    box.back = 1;
+    m_context->UpdateSubresource(m_atlasTextures[placement.page], 0, &box, texels.data(), (w + 2 * b) * 4, 0);
+
+    TextureData data;
+    data.atlasPage = m_atlasPages[placement.page];
+    data.placement = placement;
+    data.uv = m_atlas.UvFor(placement);
+    return static_cast<Rml::TextureHandle>(m_textures.Insert(data));
+}
+
+bool RmlRenderInterface_DX11::CreateAtlasPage()
+{
+    const int size = m_atlas.PageSize();
+    D3D11_TEXTURE2D_DESC td = {};
+    td.Width = size;
+    td.Height = size;
+    td.MipLevels = 1;
+    td.ArraySize = 1;
+    td.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+    td.SampleDesc.Count = 1;
+    td.Usage = D3D11_USAGE_DEFAULT;
+    td.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+    ID3D11Texture2D* tex = nullptr;
+    if (FAILED(m_device->CreateTexture2D(&td, nullptr, &tex)))
+        return false;
+    ID3D11ShaderResourceView* srv = nullptr;
+    if (FAILED(m_device->CreateShaderResourceView(tex, nullptr, &srv)))
+    {
+        tex->Release();
+        return false;
+    }
+
+    size_t bytes = static_cast<size_t>(size) * size * 4;
+    m_atlasTextures.push_back(tex);
+    m_atlasPages.push_back(static_cast<uintptr_t>(m_textures.Insert({ srv, false, bytes })));
+    m_textureBytes += bytes;
+    return true;
 }
 
 // --- Scissor ---
 
+// Recorded into the batcher; applied per batch when the frame is replayed
+
 void RmlRenderInterface_DX11::EnableScissorRegion(bool enable)
 {
-    m_scissorEnabled = enable;
+    m_batcher.EnableScissor(enable);
 }
 
 void RmlRenderInterface_DX11::SetScissorRegion(Rml::Rectanglei region)
 {
-    D3D11_RECT rect;
-    rect.left   = region.Left();
-    rect.top    = region.Top();
-    rect.right  = region.Right();
-    rect.bottom = region.Bottom();
-    m_context->RSSetScissorRects(1, &rect);
+    m_batcher.SetScissor({ region.Left(), region.Top(), region.Right(), region.Bottom() });
 }
 
 // --- Transform ---
 
 void RmlRenderInterface_DX11::SetTransform(const Rml::Matrix4f* transform)
 {
-    if (transform)
-    {
-        m_hasTransform = true;
-        // RmlUi Matrix4f is column-major, same as our storage
-        memcpy(m_transformMatrix, transform->data(), sizeof(m_transformMatrix));
-    }
-    else
-    {
-        m_hasTransform = false;
-    }
+    // RmlUi Matrix4f is column-major, same as our storage
+    m_batcher.SetTransform(transform ? transform->data() : nullptr);
 }
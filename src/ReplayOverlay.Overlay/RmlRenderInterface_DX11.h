@@ -1,7 +1,15 @@
 #pragma once
 #include <RmlUi/Core/RenderInterface.h>
-#include <d3d11.h>
+#include <d3d11_1.h>
 #include <d3dcompiler.h>
+#include <vector>
+#include "DirtyRectTracker.h"
+#include "GeometryArena.h"
+#include "GeometryBatcher.h"
+#include "RenderCommandList.h"
+#include "RenderStateCache.h"
+#include "SlotMap.h"
+#include "TextureAtlas.h"
 
 class RmlRenderInterface_DX11 : public Rml::RenderInterface
 {
@@ -9,8 +17,9 @@ public:
     bool Init(ID3D11Device* device, ID3D11DeviceContext* context);
     void Shutdown();
 
-    // Set viewport dimensions (call before rendering)
-    void SetViewport(int width, int height);
+    // Set viewport dimensions (call before rendering). 'x', 'y' place the
+    // target in UI coordinates when it covers only part of the context.
+    void SetViewport(int width, int height, int x = 0, int y = 0);
 
     // Register an externally-owned SRV as a texture handle
     Rml::TextureHandle RegisterExternalTexture(ID3D11ShaderResourceView* srv);
@@ -19,6 +28,34 @@ public:
     void SetPreviewTexture(ID3D11ShaderResourceView* srv, int w, int h);
     void ClearPreviewTexture();
 
+    // Bytes of texture memory created by GenerateTexture (font atlases etc.)
+    size_t GetTextureBytes() const { return m_textureBytes; }
+
+    // Closes the frame's command list (call after Context::Render). Returns
+    // false if it matches the last drawn frame, which is then still on screen.
+    bool Flush();
+
+    // Draws the frame closed by Flush() into 'target' (already cleared).
+    // The UI is kept in a retained layer: only the part DirtyRectTracker
+    // finds changed since the last submitted frame is redrawn into it, and
+    // the layer goes onto the target as one quad.
+    void Submit(ID3D11RenderTargetView* target);
+
+    // Forgets a frame rendered only to warm caches; the next one is drawn
+    void DiscardFrame() { m_batcher.Reset(); m_commands.DiscardFrame(); }
+
+    // The next frame is drawn even if its commands are unchanged
+    void InvalidateFrame() { m_commands.Invalidate(); }
+
+    const RenderCommandList& GetLastCommands() const { return m_commands.Last(); }
+    uint64_t GetUnchangedFrames() const { return m_commands.UnchangedFrames(); }
+    size_t GetLastDrawCalls() const { return m_batcher.LastDraws(); }
+    size_t GetLastGeometryCount() const { return m_batcher.LastGeometries(); }
+    const RenderStateCache<RmlRenderInterface_DX11>::Counters& GetLastStateChanges() const
+    { return m_state.LastFrame(); }
+    // Area of the layer the last Submit() redrew (empty: composite only)
+    const DirtyRectTracker::Rect& GetLastDirtyRect() const { return m_dirty.LastDirty(); }
+
     // --- Rml::RenderInterface overrides ---
 
     Rml::CompiledGeometryHandle CompileGeometry(Rml::Span<const Rml::Vertex> vertices,
@@ -39,26 +76,54 @@ public:
     void SetTransform(const Rml::Matrix4f* transform) override;
 
 private:
-    struct CompiledGeometry
-    {
-        ID3D11Buffer* vertexBuffer = nullptr;
-        ID3D11Buffer* indexBuffer = nullptr;
-        int indexCount = 0;
-    };
+    friend class RenderCommandList;                         // calls Upload() / Draw()
+    friend class RenderStateCache<RmlRenderInterface_DX11>; // calls the context methods
+
+    // Kept on the CPU in the geometry arena: RenderGeometry() copies it,
+    // translated, into the frame's batched stream
+    using CompiledGeometry = GeometryArena<BatchVertex>::Mesh;
 
     struct TextureData
     {
         ID3D11ShaderResourceView* srv = nullptr;
         bool external = false; // Don't release externally-owned textures
+        size_t bytes = 0;      // GPU memory owned by this entry (0 if external)
+
+        // Atlas entries have no texture of their own: they draw from their
+        // page (another entry of the map) with remapped UVs
+        uintptr_t atlasPage = 0;
+        TextureAtlas::Placement placement;
+        UvTransform uv;
     };
 
     struct alignas(16) ConstantBuffer
     {
         float transform[16]; // 4x4 column-major matrix
-        float translation[2];
-        float padding[2];
     };
 
+    // Backend the frame's command list is replayed into
+    bool Upload(const BatchVertex* vertices, size_t vertexCount, const uint32_t* indices, size_t indexCount);
+    void Draw(const GeometryBatcher::Batch& batch, const float* transform);
+    bool EnsureStreamCapacity(size_t vertexCount, size_t indexCount);
+
+    // Retained UI layer: viewport-sized, premultiplied, with the quad that
+    // composites it. Created on first use, released on resize.
+    bool EnsureLayer();
+    void ReleaseLayer();
+
+    // RenderStateCache context: the only places that touch m_context while
+    // drawing UI geometry
+    void BindInvariantState();
+    void BindStream(const void* vertices, const void* indices);
+    void BindTexture(const void* srv);
+    void SetRasterizer(bool scissor);
+    void SetScissorRect(const GeometryBatcher::Scissor& rect);
+    void WriteConstants(const float* transform);
+    void DrawIndexed(uint32_t indexCount, uint32_t firstIndex);
+
+    Rml::TextureHandle GenerateAtlasTexture(const Rml::byte* source, int w, int h);
+    bool CreateAtlasPage();
+
     bool CreateShaders();
     bool CreatePipelineState();
     ID3D11ShaderResourceView* CreateWhiteTexture();
@@ -66,6 +131,7 @@ private:
 
     ID3D11Device*           m_device = nullptr;
     ID3D11DeviceContext*    m_context = nullptr;
+    ID3D11DeviceContext1*   m_context1 = nullptr; // ClearView for partial layer clears (D3D11.1)
 
     // Pipeline state
     ID3D11VertexShader*     m_vertexShader = nullptr;
@@ -81,26 +147,50 @@ private:
     // White 1x1 texture for untextured geometry
     ID3D11ShaderResourceView* m_whiteTexture = nullptr;
 
-    // State
-    bool m_scissorEnabled = false;
+    // Per-frame dynamic stream the batches draw from (grown, never shrunk)
+    ID3D11Buffer*           m_streamVertices = nullptr;
+    ID3D11Buffer*           m_streamIndices = nullptr;
+    size_t                  m_streamVertexCapacity = 0;
+    size_t                  m_streamIndexCapacity = 0;
+
+    // Retained layer
+    ID3D11Texture2D*          m_layer = nullptr;
+    ID3D11RenderTargetView*   m_layerRtv = nullptr;
+    ID3D11ShaderResourceView* m_layerSrv = nullptr;
+    ID3D11Buffer*             m_layerQuadVertices = nullptr;
+    ID3D11Buffer*             m_layerQuadIndices = nullptr;
+    DirtyRectTracker          m_dirty;
+    DirtyRectTracker::Rect    m_redraw;         // while redrawing the layer: the dirty rect
+    bool                      m_layerPass = false;
+    size_t                    m_drawIndex = 0;  // draws replayed in the layer pass
+
+    GeometryBatcher m_batcher;
+    RenderCommandHistory m_commands; // recorded frame and the last drawn one
+    RenderStateCache<RmlRenderInterface_DX11> m_state{ *this };
+
+    int m_viewportX = 0;
+    int m_viewportY = 0;
     int m_viewportWidth = 1920;
     int m_viewportHeight = 1080;
+    float m_projection[16] = {};  // Mat4::Ortho of the viewport, set by SetViewport
 
-    // Current transform (identity by default)
-    bool m_hasTransform = false;
-    float m_transformMatrix[16] = {};
+    size_t m_textureBytes = 0;
 
-    // Handle counters
-    uintptr_t m_nextGeometryHandle = 1;
-    uintptr_t m_nextTextureHandle = 1;
+    // Handle maps: RmlUi handles are SlotMap handles, so stale ones are
+    // rejected instead of resolving to a newer object
+    static_assert(sizeof(uintptr_t) >= sizeof(SlotMap<int>::Handle), "handles need a 64-bit build");
+    SlotMap<CompiledGeometry> m_geometries;
+    GeometryArena<BatchVertex> m_geometryArena;
+    SlotMap<TextureData> m_textures;
 
-    // Handle maps
-    std::unordered_map<uintptr_t, CompiledGeometry> m_geometries;
-    std::unordered_map<uintptr_t, TextureData> m_textures;
+    // Small generated textures (glyph pages, icons) share atlas pages
+    TextureAtlas m_atlas;
+    std::vector<ID3D11Texture2D*> m_atlasTextures; // per page, for uploads
+    std::vector<uintptr_t> m_atlasPages;           // per page, its m_textures handle
 
     // Live preview texture (SRV updated in-place each frame)
     ID3D11ShaderResourceView* m_previewSrv = nullptr;
     int m_previewWidth = 0;
     int m_previewHeight = 0;
-    uintptr_t m_previewHandle = 0;
+    uintptr_t m_previewHandle = 0; // 0 until RmlUi first loads "__preview__"
 };
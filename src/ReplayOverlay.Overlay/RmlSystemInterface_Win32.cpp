@@ -1,7 +1,7 @@
 #include "RmlSystemInterface_Win32.h"
 #define WIN32_LEAN_AND_MEAN
 #include <Windows.h>
-#include <fstream>
+#include "Logger.h"
 #include <string>
 
 double RmlSystemInterface_Win32::GetElapsedTime()
@@ -23,25 +23,19 @@ double RmlSystemInterface_Win32::GetElapsedTime()
 
 bool RmlSystemInterface_Win32::LogMessage(Rml::Log::Type type, const Rml::String& message)
 {
-    const char* typeStr = "";
+    LogLevel level = LogLevel::Info;
     switch (type)
     {
-    case Rml::Log::LT_ERROR:   typeStr = "ERROR"; break;
-    case Rml::Log::LT_WARNING: typeStr = "WARN";  break;
-    case Rml::Log::LT_INFO:    typeStr = "INFO";  break;
-    case Rml::Log::LT_DEBUG:   typeStr = "DEBUG"; break;
-    default: typeStr = "LOG"; break;
+    case Rml::Log::LT_ERROR:
+    case Rml::Log::LT_ASSERT:  level = LogLevel::Error; break;
+    case Rml::Log::LT_WARNING: level = LogLevel::Warn;  break;
+    case Rml::Log::LT_DEBUG:   level = LogLevel::Debug; break;
+    default: break;
     }
+    const char* typeStr = Logger::LevelName(level);
 
-    // Write to debug log file
-    char path[MAX_PATH];
-    if (GetEnvironmentVariableA("LOCALAPPDATA", path, MAX_PATH) > 0)
-    {
-        std::string logPath = std::string(path) + "\\ReplayOverlay\\rmlui.log";
-        std::ofstream f(logPath, std::ios::app);
-        if (f.is_open())
-            f << "[" << typeStr << "] " << message << std::endl;
-    }
+    // Queued for the background writer; never blocks the render thread
+    Logger::Get().Write(level, "RmlUi", message);
 
     OutputDebugStringA("[RmlUi ");
     OutputDebugStringA(typeStr);
@@ -0,0 +1,127 @@
+#pragma once
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Generational slot map: stable 64-bit handles over densely packed values.
+//
+// A handle is (generation << 32) | slot. Lookup indexes the slot array and
+// compares generations, so it costs two array reads instead of a hash, and
+// a handle whose value was erased (or whose slot was since reused) is
+// rejected rather than aliasing the new value. Values live contiguously;
+// Erase() moves the last value into the hole, so iteration order is not
+// insertion order. Handle 0 is never issued, matching RmlUi's "no handle".
+
+template <typename T>
+class SlotMap
+{
+public:
+    using Handle = uint64_t;
+    static constexpr Handle Null = 0;
+
+    template <typename... Args>
+    Handle Emplace(Args&&... args)
+    {
+        uint32_t slot;
+        if (m_freeHead != NoSlot)
+        {
+            slot = m_freeHead;
+            m_freeHead = m_slots[slot].index;
+        }
+        else
+        {
+            slot = static_cast<uint32_t>(m_slots.size());
+            m_slots.push_back({ 0, 1 });
+        }
+        m_slots[slot].index = static_cast<uint32_t>(m_values.size());
+        m_values.emplace_back(std::forward<Args>(args)...);
+        m_valueSlots.push_back(slot);
+        return MakeHandle(slot, m_slots[slot].generation);
+    }
+
+    Handle Insert(const T& value) { return Emplace(value); }
+    Handle Insert(T&& value) { return Emplace(std::move(value)); }
+
+    // Null for a stale, foreign or null handle
+    T* Get(Handle handle)
+    {
+        const uint32_t slot = SlotOf(handle);
+        if (slot >= m_slots.size() || m_slots[slot].generation != GenerationOf(handle))
+            return nullptr;
+        // A free slot already carries its next generation: reject handles
+        // that were never issued for it
+        const uint32_t index = m_slots[slot].index;
+        if (index >= m_values.size() || m_valueSlots[index] != slot)
+            return nullptr;
+        return &m_values[index];
+    }
+    const T* Get(Handle handle) const { return const_cast<SlotMap*>(this)->Get(handle); }
+
+    bool Contains(Handle handle) const { return Get(handle) != nullptr; }
+
+    // Returns false if the handle was already stale
+    bool Erase(Handle handle)
+    {
+        if (!Contains(handle)) return false;
+        const uint32_t slot = SlotOf(handle);
+        const uint32_t index = m_slots[slot].index;
+        const uint32_t last = static_cast<uint32_t>(m_values.size() - 1);
+        if (index != last)
+        {
+            m_values[index] = std::move(m_values[last]);
+            m_valueSlots[index] = m_valueSlots[last];
+            m_slots[m_valueSlots[index]].index = index;
+        }
+        m_values.pop_back();
+        m_valueSlots.pop_back();
+
+        // Retire the generation; 0 is skipped so no handle is ever Null
+        Slot& s = m_slots[slot];
+        if (++s.generation == 0) s.generation = 1;
+        s.index = m_freeHead;
+        m_freeHead = slot;
+        return true;
+    }
+
+    // Erases everything; all outstanding handles become stale
+    void Clear()
+    {
+        while (!m_valueSlots.empty())
+            Erase(MakeHandle(m_valueSlots.back(), m_slots[m_valueSlots.back()].generation));
+    }
+
+    size_t size() const { return m_values.size(); }
+    bool empty() const { return m_values.empty(); }
+
+    // Dense iteration over values, and the handle of the i-th value
+    typename std::vector<T>::iterator begin() { return m_values.begin(); }
+    typename std::vector<T>::iterator end() { return m_values.end(); }
+    typename std::vector<T>::const_iterator begin() const { return m_values.begin(); }
+    typename std::vector<T>::const_iterator end() const { return m_values.end(); }
+    Handle HandleAt(size_t i) const
+    {
+        const uint32_t slot = m_valueSlots[i];
+        return MakeHandle(slot, m_slots[slot].generation);
+    }
+
+private:
+    static constexpr uint32_t NoSlot = 0xFFFFFFFFu;
+
+    struct Slot
+    {
+        uint32_t index;       // into m_values when live, next free slot otherwise
+        uint32_t generation;
+    };
+
+    static Handle MakeHandle(uint32_t slot, uint32_t generation)
+    {
+        return (static_cast<Handle>(generation) << 32) | slot;
+    }
+    static uint32_t SlotOf(Handle h) { return static_cast<uint32_t>(h); }
+    static uint32_t GenerationOf(Handle h) { return static_cast<uint32_t>(h >> 32); }
+
+    std::vector<Slot> m_slots;
+    std::vector<T> m_values;
+    std::vector<uint32_t> m_valueSlots; // slot of each value
+    uint32_t m_freeHead = NoSlot;
+};
@@ -0,0 +1,500 @@
+#include "SoftwareRasterizer.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+#if defined(SOFTWARE_RASTERIZER_SSE2)
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+    struct Vec2 { float x, y; };
+
+    // Edge function of a -> b in the form a * x + b * y + c. Computed from
+    // the lexicographically smaller endpoint and negated if needed, so two
+    // triangles sharing an edge get bit-exact opposite values and every
+    // pixel centre on it is claimed by exactly one of them.
+    void EdgeFunction(Vec2 p, Vec2 q, float& a, float& b, float& c)
+    {
+        const bool swapped = q.x < p.x || (q.x == p.x && q.y < p.y);
+        const Vec2 s = swapped ? q : p;
+        const Vec2 e = swapped ? p : q;
+        a = s.y - e.y;
+        b = e.x - s.x;
+        c = -(a * s.x + b * s.y);
+        if (swapped)
+        {
+            a = -a;
+            b = -b;
+            c = -c;
+        }
+    }
+
+#if defined(SOFTWARE_RASTERIZER_SSE2)
+    __m128 Unpack(uint32_t texel)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        __m128i v = _mm_cvtsi32_si128(static_cast<int>(texel));
+        v = _mm_unpacklo_epi16(_mm_unpacklo_epi8(v, zero), zero);
+        return _mm_cvtepi32_ps(v);
+    }
+
+    uint32_t Pack(__m128 colour)
+    {
+        __m128i v = _mm_cvtps_epi32(colour); // round to nearest, like UNORM writes
+        v = _mm_packs_epi32(v, v);
+        v = _mm_packus_epi16(v, v);          // saturates to [0, 255]
+        return static_cast<uint32_t>(_mm_cvtsi128_si32(v));
+    }
+
+    // Bilinear, clamped, at texel centres (D3D11 MIN_MAG_MIP_LINEAR / CLAMP)
+    __m128 Sample(const SoftwareRasterizer::Image& image, float u, float v)
+    {
+        const float fx = u * image.width - 0.5f;
+        const float fy = v * image.height - 0.5f;
+        const float flx = std::floor(fx), fly = std::floor(fy);
+        const int x0 = static_cast<int>(flx), y0 = static_cast<int>(fly);
+        const __m128 wx = _mm_set1_ps(fx - flx);
+        const __m128 wy = _mm_set1_ps(fy - fly);
+        auto clampX = [&](int x) { return std::min(std::max(x, 0), image.width - 1); };
+        auto clampY = [&](int y) { return std::min(std::max(y, 0), image.height - 1); };
+        const uint32_t* r0 = &image.texels[static_cast<size_t>(clampY(y0)) * image.width];
+        const uint32_t* r1 = &image.texels[static_cast<size_t>(clampY(y0 + 1)) * image.width];
+        const int c0 = clampX(x0), c1 = clampX(x0 + 1);
+        const __m128 t00 = Unpack(r0[c0]), t01 = Unpack(r0[c1]);
+        const __m128 t10 = Unpack(r1[c0]), t11 = Unpack(r1[c1]);
+        const __m128 top = _mm_add_ps(t00, _mm_mul_ps(_mm_sub_ps(t01, t00), wx));
+        const __m128 bottom = _mm_add_ps(t10, _mm_mul_ps(_mm_sub_ps(t11, t10), wx));
+        return _mm_add_ps(top, _mm_mul_ps(_mm_sub_ps(bottom, top), wy));
+    }
+
+    // Vertex colour times texel, blended ONE / INV_SRC_ALPHA over dst
+    void ShadePixel(uint32_t& dst, const float* colour, float u, float v,
+                    const SoftwareRasterizer::Image* texture)
+    {
+        const __m128 inv255 = _mm_set1_ps(1.0f / 255.0f);
+        __m128 src = _mm_loadu_ps(colour);
+        if (texture)
+            src = _mm_mul_ps(src, _mm_mul_ps(Sample(*texture, u, v), inv255));
+        const __m128 alpha = _mm_shuffle_ps(src, src, _MM_SHUFFLE(3, 3, 3, 3));
+        const __m128 keep = _mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(alpha, inv255));
+        dst = Pack(_mm_add_ps(src, _mm_mul_ps(Unpack(dst), keep)));
+    }
+#else
+    void Unpack(uint32_t texel, float* out)
+    {
+        for (int i = 0; i < 4; i++) out[i] = static_cast<float>((texel >> (8 * i)) & 0xFF);
+    }
+
+    uint32_t Pack(const float* colour)
+    {
+        uint32_t out = 0;
+        for (int i = 0; i < 4; i++)
+        {
+            long v = std::lrint(colour[i]);
+            out |= static_cast<uint32_t>(std::min(std::max(v, 0L), 255L)) << (8 * i);
+        }
+        return out;
+    }
+
+    void Sample(const SoftwareRasterizer::Image& image, float u, float v, float* out)
+    {
+        const float fx = u * image.width - 0.5f;
+        const float fy = v * image.height - 0.5f;
+        const float flx = std::floor(fx), fly = std::floor(fy);
+        const int x0 = static_cast<int>(flx), y0 = static_cast<int>(fly);
+        const float wx = fx - flx, wy = fy - fly;
+        auto clampX = [&](int x) { return std::min(std::max(x, 0), image.width - 1); };
+        auto clampY = [&](int y) { return std::min(std::max(y, 0), image.height - 1); };
+        const uint32_t* r0 = &image.texels[static_cast<size_t>(clampY(y0)) * image.width];
+        const uint32_t* r1 = &image.texels[static_cast<size_t>(clampY(y0 + 1)) * image.width];
+        const int c0 = clampX(x0), c1 = clampX(x0 + 1);
+        float t00[4], t01[4], t10[4], t11[4];
+        Unpack(r0[c0], t00); Unpack(r0[c1], t01);
+        Unpack(r1[c0], t10); Unpack(r1[c1], t11);
+        for (int i = 0; i < 4; i++)
+        {
+            const float top = t00[i] + (t01[i] - t00[i]) * wx;
+            const float bottom = t10[i] + (t11[i] - t10[i]) * wx;
+            out[i] = top + (bottom - top) * wy;
+        }
+    }
+
+    void ShadePixel(uint32_t& dst, const float* colour, float u, float v,
+                    const SoftwareRasterizer::Image* texture)
+    {
+        float src[4] = { colour[0], colour[1], colour[2], colour[3] };
+        if (texture)
+        {
+            float texel[4];
+            Sample(*texture, u, v, texel);
+            for (int i = 0; i < 4; i++) src[i] *= texel[i] * (1.0f / 255.0f);
+        }
+        float d[4];
+        Unpack(dst, d);
+        const float keep = 1.0f - src[3] * (1.0f / 255.0f);
+        for (int i = 0; i < 4; i++) src[i] += d[i] * keep;
+        dst = Pack(src);
+    }
+#endif
+}
+
+void SoftwareRasterizer::Resize(int width, int height)
+{
+    m_width = std::max(width, 0);
+    m_height = std::max(height, 0);
+    m_tilesX = (m_width + TileSize - 1) / TileSize;
+    m_tilesY = (m_height + TileSize - 1) / TileSize;
+    m_pixels.assign(static_cast<size_t>(m_width) * m_height, 0);
+    m_bins.assign(static_cast<size_t>(m_tilesX) * m_tilesY, {});
+}
+
+void SoftwareRasterizer::Render(const RenderCommandList& frame, uint32_t clear)
+{
+    const auto start = std::chrono::steady_clock::now();
+    m_last = {};
+    m_triangles.clear();
+    for (auto& bin : m_bins) bin.clear();
+
+    frame.Replay(*this);
+    m_vertices = nullptr;
+    m_indices = nullptr;
+
+    // Tiles are independent: each is cleared and shaded by one thread
+    const int tiles = m_tilesX * m_tilesY;
+    unsigned threads = m_threads ? m_threads : std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min<unsigned>(threads, static_cast<unsigned>(std::max(tiles, 1)));
+    if (m_workers.size() != threads - 1)
+    {
+        StopWorkers();
+        StartWorkers(threads - 1);
+    }
+
+    m_tileCount = tiles;
+    m_clear = clear;
+    m_nextTile = 0;
+    m_fragments = 0;
+    if (!m_workers.empty())
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_poolMutex);
+            m_job++;
+            m_busy = m_workers.size();
+        }
+        m_poolWake.notify_all();
+    }
+    ShadeTiles();
+    if (!m_workers.empty())
+    {
+        std::unique_lock<std::mutex> lock(m_poolMutex);
+        m_poolDone.wait(lock, [&] { return m_busy == 0; });
+    }
+
+    m_last.triangles = m_triangles.size();
+    m_last.fragments = m_fragments;
+    m_last.ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count());
+    m_totals.frames++;
+    m_totals.pixels += static_cast<uint64_t>(m_width) * m_height;
+    m_totals.fragments += m_last.fragments;
+    m_totals.ns += m_last.ns;
+}
+
+SoftwareRasterizer::~SoftwareRasterizer()
+{
+    StopWorkers();
+}
+
+void SoftwareRasterizer::ShadeTiles()
+{
+    uint64_t shaded = 0;
+    for (int tile = m_nextTile++; tile < m_tileCount; tile = m_nextTile++)
+        shaded += ShadeTile(tile, m_clear);
+    m_fragments += shaded;
+}
+
+void SoftwareRasterizer::StartWorkers(unsigned count)
+{
+    m_poolStop = false;
+    m_workers.reserve(count);
+    // Each starts at the current job, so the next Render() is its first
+    for (unsigned i = 0; i < count; i++)
+        m_workers.emplace_back([this, job = m_job] { WorkerLoop(job); });
+}
+
+void SoftwareRasterizer::StopWorkers()
+{
+    if (m_workers.empty()) return;
+    {
+        std::lock_guard<std::mutex> lock(m_poolMutex);
+        m_poolStop = true;
+    }
+    m_poolWake.notify_all();
+    for (auto& t : m_workers) t.join();
+    m_workers.clear();
+}
+
+void SoftwareRasterizer::WorkerLoop(uint64_t job)
+{
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_poolMutex);
+            m_poolWake.wait(lock, [&] { return m_poolStop || m_job != job; });
+            if (m_poolStop) return;
+            job = m_job;
+        }
+        ShadeTiles();
+        std::lock_guard<std::mutex> lock(m_poolMutex);
+        if (--m_busy == 0) m_poolDone.notify_one();
+    }
+}
+
+bool SoftwareRasterizer::Upload(const BatchVertex* vertices, size_t vertexCount,
+                                const uint32_t* indices, size_t indexCount)
+{
+    m_vertices = vertices;
+    m_vertexCount = vertexCount;
+    m_indices = indices;
+    m_indexCount = indexCount;
+    return true;
+}
+
+void SoftwareRasterizer::Draw(const GeometryBatcher::Batch& batch, const float* transform)
+{
+    const Image* texture = nullptr;
+    if (batch.texture && m_lookup)
+    {
+        texture = m_lookup(batch.texture);
+        if (texture && (texture->Empty() || texture->width <= 0 || texture->height <= 0))
+            texture = nullptr;
+    }
+
+    const size_t end = std::min<size_t>(static_cast<size_t>(batch.firstIndex) + batch.indexCount, m_indexCount);
+    for (size_t i = batch.firstIndex; i + 3 <= end; i += 3)
+    {
+        const BatchVertex* v[3];
+        float pos[3][2];
+        bool valid = true;
+        for (int k = 0; k < 3; k++)
+        {
+            const uint32_t index = m_indices[i + k];
+            if (index >= m_vertexCount) { valid = false; break; }
+            v[k] = &m_vertices[index];
+            float x = v[k]->x, y = v[k]->y;
+            if (transform)
+            {
+                // Column-major: x' = m0 x + m4 y + m12, w' = m3 x + m7 y + m15
+                const float w = transform[3] * x + transform[7] * y + transform[15];
+                if (!(w > 1e-6f)) { valid = false; break; }
+                const float tx = transform[0] * x + transform[4] * y + transform[12];
+                const float ty = transform[1] * x + transform[5] * y + transform[13];
+                x = tx / w;
+                y = ty / w;
+            }
+            pos[k][0] = x;
+            pos[k][1] = y;
+        }
+        if (valid)
+            SetupTriangle(v, pos, batch, texture);
+    }
+}
+
+void SoftwareRasterizer::SetupTriangle(const BatchVertex* v[3], const float (*pos)[2],
+                                       const GeometryBatcher::Batch& batch, const Image* texture)
+{
+    Vec2 p[3] = { { pos[0][0], pos[0][1] }, { pos[1][0], pos[1][1] }, { pos[2][0], pos[2][1] } };
+    for (const Vec2& q : p)
+        if (!std::isfinite(q.x) || !std::isfinite(q.y)) return;
+
+    // Either winding is drawn (no culling): make it counter-clockwise
+    // in the positive-area sense the edge functions use
+    int order[3] = { 0, 1, 2 };
+    float area = (p[1].x - p[0].x) * (p[2].y - p[0].y) - (p[1].y - p[0].y) * (p[2].x - p[0].x);
+    if (area == 0.0f) return;
+    if (area < 0.0f)
+    {
+        std::swap(p[1], p[2]);
+        std::swap(order[1], order[2]);
+        area = -area;
+    }
+
+    // Pixel centres inside the bounds, clipped to target and scissor
+    int clipL = 0, clipT = 0, clipR = m_width, clipB = m_height;
+    if (batch.scissorEnabled)
+    {
+        clipL = std::max(clipL, batch.scissor.left);
+        clipT = std::max(clipT, batch.scissor.top);
+        clipR = std::min(clipR, batch.scissor.right);
+        clipB = std::min(clipB, batch.scissor.bottom);
+    }
+    const float minX = std::min({ p[0].x, p[1].x, p[2].x }), maxX = std::max({ p[0].x, p[1].x, p[2].x });
+    const float minY = std::min({ p[0].y, p[1].y, p[2].y }), maxY = std::max({ p[0].y, p[1].y, p[2].y });
+    Triangle t;
+    t.minX = std::max(clipL, static_cast<int>(std::ceil(std::max(minX - 0.5f, -1.0f))));
+    t.minY = std::max(clipT, static_cast<int>(std::ceil(std::max(minY - 0.5f, -1.0f))));
+    t.maxX = std::min(clipR - 1, static_cast<int>(std::floor(std::min(maxX - 0.5f, static_cast<float>(m_width)))));
+    t.maxY = std::min(clipB - 1, static_cast<int>(std::floor(std::min(maxY - 0.5f, static_cast<float>(m_height)))));
+    if (t.minX > t.maxX || t.minY > t.maxY) return;
+
+    // w0 is opposite vertex 0 (edge 1 -> 2), and so on
+    for (int e = 0; e < 3; e++)
+    {
+        EdgeFunction(p[(e + 1) % 3], p[(e + 2) % 3], t.a[e], t.b[e], t.c[e]);
+        t.topLeft[e] = t.a[e] > 0.0f || (t.a[e] == 0.0f && t.b[e] > 0.0f);
+    }
+    t.invArea = 1.0f / area;
+
+    float attr[3][AttributeCount];
+    for (int k = 0; k < 3; k++)
+    {
+        const BatchVertex& vx = *v[order[k]];
+        for (int c = 0; c < 4; c++)
+            attr[k][R + c] = static_cast<float>((vx.colour >> (8 * c)) & 0xFF);
+        attr[k][U] = vx.u;
+        attr[k][V] = vx.v;
+    }
+    for (int a = 0; a < AttributeCount; a++)
+    {
+        t.base[a] = attr[0][a];
+        t.d1[a] = attr[1][a] - attr[0][a];
+        t.d2[a] = attr[2][a] - attr[0][a];
+    }
+    t.texture = texture;
+
+    const uint32_t index = static_cast<uint32_t>(m_triangles.size());
+    m_triangles.push_back(t);
+    for (int ty = t.minY / TileSize; ty <= t.maxY / TileSize; ty++)
+        for (int tx = t.minX / TileSize; tx <= t.maxX / TileSize; tx++)
+            m_bins[static_cast<size_t>(ty) * m_tilesX + tx].push_back(index);
+}
+
+uint64_t SoftwareRasterizer::ShadeTile(int tile, uint32_t clear)
+{
+    const int x0 = (tile % m_tilesX) * TileSize;
+    const int y0 = (tile / m_tilesX) * TileSize;
+    const int x1 = std::min(x0 + TileSize, m_width);
+    const int y1 = std::min(y0 + TileSize, m_height);
+    for (int y = y0; y < y1; y++)
+        std::fill_n(&m_pixels[static_cast<size_t>(y) * m_width + x0], x1 - x0, clear);
+
+    uint64_t fragments = 0;
+    for (uint32_t index : m_bins[tile])
+    {
+        const Triangle& t = m_triangles[index];
+        const int left = std::max(t.minX, x0), right = std::min(t.maxX, x1 - 1);
+        const int top = std::max(t.minY, y0), bottom = std::min(t.maxY, y1 - 1);
+        for (int y = top; y <= bottom; y++)
+            ShadeSpan(t, y, left, right, &m_pixels[static_cast<size_t>(y) * m_width], fragments);
+    }
+    return fragments;
+}
+
+// Shades pixels x0..x1 (inclusive) of row y covered by the triangle
+void SoftwareRasterizer::ShadeSpan(const Triangle& t, int y, int x0, int x1, uint32_t* row,
+                                   uint64_t& fragments) const
+{
+    const float py = static_cast<float>(y) + 0.5f;
+    float rowW[3];
+    for (int e = 0; e < 3; e++) rowW[e] = t.b[e] * py + t.c[e];
+
+#if defined(SOFTWARE_RASTERIZER_SSE2)
+    // Four pixels per step: edge tests, then every attribute at once
+    const __m128 laneOffset = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+    const __m128 lastCentre = _mm_set1_ps(static_cast<float>(x1) + 0.5f);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 invArea = _mm_set1_ps(t.invArea);
+    __m128 ea[3], ew[3], tl[3];
+    for (int e = 0; e < 3; e++)
+    {
+        ea[e] = _mm_set1_ps(t.a[e]);
+        ew[e] = _mm_set1_ps(rowW[e]);
+        tl[e] = _mm_castsi128_ps(_mm_set1_epi32(t.topLeft[e] ? -1 : 0));
+    }
+    for (int x = x0; x <= x1; x += 4)
+    {
+        const __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), laneOffset);
+        __m128 inside = _mm_cmple_ps(px, lastCentre);
+        __m128 w[3];
+        for (int e = 0; e < 3; e++)
+        {
+            w[e] = _mm_add_ps(_mm_mul_ps(ea[e], px), ew[e]);
+            const __m128 on = _mm_and_ps(_mm_cmpeq_ps(w[e], zero), tl[e]);
+            inside = _mm_and_ps(inside, _mm_or_ps(_mm_cmpgt_ps(w[e], zero), on));
+        }
+        const int mask = _mm_movemask_ps(inside);
+        if (!mask) continue;
+
+        const __m128 l1 = _mm_mul_ps(w[1], invArea);
+        const __m128 l2 = _mm_mul_ps(w[2], invArea);
+        alignas(16) float attr[AttributeCount][4];
+        for (int a = 0; a < AttributeCount; a++)
+        {
+            const __m128 value = _mm_add_ps(_mm_set1_ps(t.base[a]),
+                _mm_add_ps(_mm_mul_ps(l1, _mm_set1_ps(t.d1[a])), _mm_mul_ps(l2, _mm_set1_ps(t.d2[a]))));
+            _mm_store_ps(attr[a], value);
+        }
+        for (int lane = 0; lane < 4; lane++)
+        {
+            if (!(mask & (1 << lane))) continue;
+            const float colour[4] = { attr[R][lane], attr[G][lane], attr[B][lane], attr[A][lane] };
+            ShadePixel(row[x + lane], colour, attr[U][lane], attr[V][lane], t.texture);
+            fragments++;
+        }
+    }
+#else
+    for (int x = x0; x <= x1; x++)
+    {
+        const float px = static_cast<float>(x) + 0.5f;
+        float w[3];
+        bool inside = true;
+        for (int e = 0; e < 3; e++)
+        {
+            w[e] = t.a[e] * px + rowW[e];
+            inside = inside && (w[e] > 0.0f || (w[e] == 0.0f && t.topLeft[e]));
+        }
+        if (!inside) continue;
+        const float l1 = w[1] * t.invArea, l2 = w[2] * t.invArea;
+        float attr[AttributeCount];
+        for (int a = 0; a < AttributeCount; a++)
+            attr[a] = t.base[a] + (l1 * t.d1[a] + l2 * t.d2[a]);
+        ShadePixel(row[x], attr, attr[U], attr[V], t.texture);
+        fragments++;
+    }
+#endif
+}
+
+uint64_t SoftwareRasterizer::Checksum() const
+{
+    uint64_t hash = 1469598103934665603ull;
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(m_pixels.data());
+    for (size_t i = 0; i < m_pixels.size() * 4; i++)
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+bool SoftwareRasterizer::WritePpm(const std::string& path) const
+{
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) return false;
+    std::fprintf(file, "P6\n%d %d\n255\n", m_width, m_height);
+    std::vector<uint8_t> row(static_cast<size_t>(m_width) * 3);
+    for (int y = 0; y < m_height; y++)
+    {
+        for (int x = 0; x < m_width; x++)
+        {
+            const uint32_t p = Pixel(x, y);
+            row[x * 3 + 0] = static_cast<uint8_t>(p);
+            row[x * 3 + 1] = static_cast<uint8_t>(p >> 8);
+            row[x * 3 + 2] = static_cast<uint8_t>(p >> 16);
+        }
+        std::fwrite(row.data(), 1, row.size(), file);
+    }
+    return std::fclose(file) == 0;
+}
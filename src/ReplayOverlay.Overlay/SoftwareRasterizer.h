@@ -0,0 +1,161 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "GeometryBatcher.h"
+#include "RenderCommandList.h"
+
+// CPU rasterizer for recorded UI frames: pixel-exact screenshots of overlay
+// states and a GPU-less throughput figure.
+//
+// Render() replays a RenderCommandList as its backend, following the D3D11
+// pipeline the overlay uses: no culling, scissor rects with exclusive
+// right/bottom, the top-left fill rule at pixel centres, bilinear clamped
+// sampling at texel centres, vertex colour times texel, and premultiplied
+// alpha blending (ONE, INV_SRC_ALPHA), all in 8-bit RGBA. Triangles are
+// binned into TileSize square tiles; tiles are shaded in parallel, each in
+// draw order, so the image does not depend on the thread count. The worker
+// threads persist across frames and sleep between them; the calling thread
+// shades tiles too. Edge tests and attribute interpolation run four pixels
+// at a time with SSE2.
+//
+// Attributes are interpolated linearly in screen space. That matches the
+// GPU for RmlUi's 2D transforms, not for perspective ones.
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SOFTWARE_RASTERIZER_SSE2 1
+#endif
+
+class SoftwareRasterizer
+{
+public:
+    // Premultiplied RGBA8, red in the low byte (as D3D11's R8G8B8A8 in memory)
+    struct Image
+    {
+        int width = 0, height = 0;
+        std::vector<uint32_t> texels;
+        bool Empty() const { return texels.empty(); }
+    };
+
+    // Resolves a draw's texture handle; null draws it untextured (white)
+    using TextureLookup = std::function<const Image*(uintptr_t)>;
+
+    struct Stats
+    {
+        uint64_t triangles = 0;     // after clipping to the target and scissor
+        uint64_t fragments = 0;     // pixels shaded, overdraw included
+        uint64_t ns = 0;            // wall time of Render()
+    };
+
+    struct Totals
+    {
+        uint64_t frames = 0;
+        uint64_t pixels = 0;        // target pixels produced
+        uint64_t fragments = 0;
+        uint64_t ns = 0;
+
+        double FramesPerSecond() const { return ns ? frames * 1e9 / static_cast<double>(ns) : 0.0; }
+        double MegapixelsPerSecond() const { return ns ? pixels * 1e3 / static_cast<double>(ns) : 0.0; }
+    };
+
+    static constexpr int TileSize = 64;
+
+    SoftwareRasterizer() = default;
+    ~SoftwareRasterizer();
+    SoftwareRasterizer(const SoftwareRasterizer&) = delete;
+    SoftwareRasterizer& operator=(const SoftwareRasterizer&) = delete;
+
+    void Resize(int width, int height);
+    int Width() const { return m_width; }
+    int Height() const { return m_height; }
+
+    // Threads shading tiles, the caller included; 0 uses every core. The
+    // workers are (re)started by the next Render().
+    void SetThreads(unsigned threads) { m_threads = threads; }
+    void SetTextureLookup(TextureLookup lookup) { m_lookup = std::move(lookup); }
+
+    // Draws a frame over the target cleared to 'clear'
+    void Render(const RenderCommandList& frame, uint32_t clear = 0);
+
+    const uint32_t* Pixels() const { return m_pixels.data(); }
+    uint32_t Pixel(int x, int y) const { return m_pixels[static_cast<size_t>(y) * m_width + x]; }
+
+    // FNV-1a of the pixels, for golden-image comparisons
+    uint64_t Checksum() const;
+
+    // Binary PPM of the colour channels; premultiplied, so that is the image
+    // composited over black
+    bool WritePpm(const std::string& path) const;
+
+    const Stats& LastFrame() const { return m_last; }
+    const Totals& GetTotals() const { return m_totals; }
+
+private:
+    friend class RenderCommandList; // calls Upload() / Draw()
+
+    enum Attribute { R, G, B, A, U, V, AttributeCount };
+
+    struct Triangle
+    {
+        // Edge functions w = a * x + b * y + c, positive inside; pixels
+        // exactly on an edge belong to it only if it is a top or left edge
+        float a[3], b[3], c[3];
+        bool topLeft[3];
+        float invArea;
+        // Attribute at vertex 0 and its change along barycentrics 1 and 2
+        float base[AttributeCount], d1[AttributeCount], d2[AttributeCount];
+        int minX, minY, maxX, maxY; // inclusive pixel bounds, clipped
+        const Image* texture;
+    };
+
+    // RenderCommandList backend: transforms, sets up and bins triangles
+    bool Upload(const BatchVertex* vertices, size_t vertexCount, const uint32_t* indices, size_t indexCount);
+    void Draw(const GeometryBatcher::Batch& batch, const float* transform);
+
+    void SetupTriangle(const BatchVertex* v[3], const float (*pos)[2], const GeometryBatcher::Batch& batch,
+                       const Image* texture);
+    uint64_t ShadeTile(int tile, uint32_t clear);
+    void ShadeTiles(); // claims tiles of the current frame until none are left
+
+    void StartWorkers(unsigned count);
+    void StopWorkers();
+    void WorkerLoop(uint64_t job);
+    void ShadeSpan(const Triangle& t, int y, int x0, int x1, uint32_t* row, uint64_t& fragments) const;
+
+    int m_width = 0;
+    int m_height = 0;
+    int m_tilesX = 0;
+    int m_tilesY = 0;
+    unsigned m_threads = 0;
+    std::vector<uint32_t> m_pixels;
+    TextureLookup m_lookup;
+
+    // Current frame
+    const BatchVertex* m_vertices = nullptr;
+    size_t m_vertexCount = 0;
+    const uint32_t* m_indices = nullptr;
+    size_t m_indexCount = 0;
+    std::vector<Triangle> m_triangles;
+    std::vector<std::vector<uint32_t>> m_bins; // triangle indices per tile, in draw order
+    int m_tileCount = 0;
+    uint32_t m_clear = 0;
+    std::atomic<int> m_nextTile{ 0 };
+    std::atomic<uint64_t> m_fragments{ 0 };
+
+    // Persistent tile workers; m_job is bumped once per frame
+    std::vector<std::thread> m_workers;
+    std::mutex m_poolMutex;
+    std::condition_variable m_poolWake;
+    std::condition_variable m_poolDone;
+    uint64_t m_job = 0;
+    size_t m_busy = 0; // workers still shading the current frame
+    bool m_poolStop = false;
+
+    Stats m_last;
+    Totals m_totals;
+};
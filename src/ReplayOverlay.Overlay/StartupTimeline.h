@@ -0,0 +1,105 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <nlohmann/json.hpp>
+
+// Named marks from process entry to the first presented frame.
+//
+// Start() sets the origin (top of WinMain); Mark() records the time since
+// then for each startup step, and Finish() records the last mark and closes
+// the timeline so later calls are ignored. Marks are kept in a fixed array;
+// names must be string literals.
+
+class StartupTimeline
+{
+public:
+    static constexpr int MaxMarks = 16;
+
+    struct Entry
+    {
+        const char* name;
+        uint64_t atNs; // since Start()
+    };
+
+    static StartupTimeline& Get()
+    {
+        static StartupTimeline timeline;
+        return timeline;
+    }
+
+    static uint64_t NowNs()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    void Start(uint64_t nowNs = NowNs())
+    {
+        m_originNs = nowNs;
+        m_count = 0;
+        m_started = true;
+        m_finished = false;
+    }
+
+    void Mark(const char* name, uint64_t nowNs = NowNs())
+    {
+        if (!m_started || m_finished || m_count == MaxMarks) return;
+        m_marks[m_count++] = { name, nowNs > m_originNs ? nowNs - m_originNs : 0 };
+    }
+
+    // Records the final mark; returns true only for the call that closed the timeline
+    bool Finish(const char* name, uint64_t nowNs = NowNs())
+    {
+        if (!m_started || m_finished) return false;
+        Mark(name, nowNs);
+        m_finished = true;
+        return true;
+    }
+
+    bool IsFinished() const { return m_finished; }
+    int Count() const { return m_count; }
+    const Entry& At(int i) const { return m_marks[i]; }
+    double TotalMs() const { return m_count ? m_marks[m_count - 1].atNs / 1e6 : 0.0; }
+
+    nlohmann::json Report() const
+    {
+        nlohmann::json marks = nlohmann::json::array();
+        uint64_t prev = 0;
+        for (int i = 0; i < m_count; i++)
+        {
+            marks.push_back({
+                {"name", m_marks[i].name},
+                {"at_ms", m_marks[i].atNs / 1e6},
+                {"step_ms", (m_marks[i].atNs - prev) / 1e6},
+            });
+            prev = m_marks[i].atNs;
+        }
+        return { {"marks", marks}, {"total_ms", TotalMs()}, {"complete", m_finished} };
+    }
+
+    // "startup (ms, step): window 3.1 renderer 85.0 ... = 120.4"
+    std::string FormatLine() const
+    {
+        std::string out = "startup (ms, step):";
+        char buf[64];
+        uint64_t prev = 0;
+        for (int i = 0; i < m_count; i++)
+        {
+            snprintf(buf, sizeof(buf), " %s %.1f", m_marks[i].name, (m_marks[i].atNs - prev) / 1e6);
+            out += buf;
+            prev = m_marks[i].atNs;
+        }
+        snprintf(buf, sizeof(buf), " = %.1f", TotalMs());
+        out += buf;
+        return out;
+    }
+
+private:
+    Entry m_marks[MaxMarks] = {};
+    int m_count = 0;
+    uint64_t m_originNs = 0;
+    bool m_started = false;
+    bool m_finished = false;
+};
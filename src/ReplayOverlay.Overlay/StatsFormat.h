@@ -0,0 +1,174 @@
+#pragma once
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include "OverlayState.h"
+
+// Allocation-free formatting of the stats tab.
+//
+// Values are rendered into fixed stack buffers with std::to_chars and only
+// copied into the bound strings when the text actually changed, so a sync
+// with unchanged stats performs no heap allocation. Colours come from a
+// precomputed table instead of being rebuilt as strings.
+
+enum class StatColor : uint8_t
+{
+    Good = 0,
+    Warn,
+    Bad,
+    Neutral,
+    Count
+};
+
+inline const char* StatColorHex(StatColor c)
+{
+    static constexpr const char* Table[] = { "#4ecca3", "#f0c040", "#e94560", "#eaeaea" };
+    return Table[static_cast<int>(c)];
+}
+
+inline StatColor FpsColor(double fps)       { return fps > 55 ? StatColor::Good : (fps > 30 ? StatColor::Warn : StatColor::Bad); }
+inline StatColor CpuColor(double cpu)       { return cpu < 50 ? StatColor::Good : (cpu < 80 ? StatColor::Warn : StatColor::Bad); }
+inline StatColor DiskColor(double diskGb)   { return diskGb < 1.0 ? StatColor::Bad : (diskGb < 5.0 ? StatColor::Warn : StatColor::Neutral); }
+inline StatColor SkipColor(int skipped)     { return skipped > 0 ? StatColor::Bad : StatColor::Neutral; }
+
+// Fixed-capacity text builder. Appends past capacity are truncated.
+class StatText
+{
+public:
+    static constexpr size_t Capacity = 128;
+
+    const char* data() const { return m_buf; }
+    size_t size() const { return m_len; }
+
+    StatText& Str(const char* s)
+    {
+        while (*s && m_len < Capacity) m_buf[m_len++] = *s++;
+        return *this;
+    }
+
+    StatText& Fixed(double v, int decimals)
+    {
+        auto r = std::to_chars(m_buf + m_len, m_buf + Capacity, v, std::chars_format::fixed, decimals);
+        if (r.ec == std::errc()) m_len = static_cast<size_t>(r.ptr - m_buf);
+        return *this;
+    }
+
+    StatText& Int(int v)
+    {
+        auto r = std::to_chars(m_buf + m_len, m_buf + Capacity, v);
+        if (r.ec == std::errc()) m_len = static_cast<size_t>(r.ptr - m_buf);
+        return *this;
+    }
+
+    // Copy into 'dst' only if the text differs; returns true when it changed
+    bool AssignIfChanged(std::string& dst) const
+    {
+        if (dst.size() == m_len && std::memcmp(dst.data(), m_buf, m_len) == 0)
+            return false;
+        dst.assign(m_buf, m_len);
+        return true;
+    }
+
+private:
+    char m_buf[Capacity];
+    size_t m_len = 0;
+};
+
+// Display strings for the stats tab. Each field is bound to a data-model
+// variable; Sync*() return a bitmask of fields whose text changed.
+class StatsPresenter
+{
+public:
+    enum Field : int
+    {
+        Fps = 0, Cpu, Memory, FrameTime, Disk, RenderSkip, OutputSkip,
+        FpsColorField, CpuColorField, DiskColorField, RenderSkipColorField, OutputSkipColorField,
+        TrendFps1m, TrendFps10m, TrendFrameTime1m, TrendFrameTime10m,
+        TrendCpu1m, TrendCpu10m, TrendRenderSkip1m, TrendRenderSkip10m,
+        FieldCount
+    };
+
+    // Data-model variable name for each field
+    static const char* VariableName(int field)
+    {
+        static constexpr const char* Names[FieldCount] = {
+            "stat_fps", "stat_cpu", "stat_memory", "stat_frame_time", "stat_disk",
+            "stat_render_skip", "stat_output_skip",
+            "fps_color", "cpu_color", "disk_color", "render_skip_color", "output_skip_color",
+            "trend_fps_1m", "trend_fps_10m", "trend_frame_time_1m", "trend_frame_time_10m",
+            "trend_cpu_1m", "trend_cpu_10m", "trend_render_skip_1m", "trend_render_skip_10m",
+        };
+        return Names[field];
+    }
+
+    std::string& Text(int field) { return m_text[field]; }
+    const std::string& Text(int field) const { return m_text[field]; }
+
+    uint32_t SyncStats(const StatsState& s)
+    {
+        uint32_t changed = 0;
+        const double diskGb = s.availableDiskSpace / 1024.0;
+
+        Set(changed, Fps, StatText().Fixed(s.activeFps, 1));
+        Set(changed, Cpu, StatText().Fixed(s.cpuUsage, 1).Str("%"));
+        Set(changed, Memory, StatText().Fixed(s.memoryUsage, 0).Str(" MB"));
+        Set(changed, FrameTime, StatText().Fixed(s.averageFrameRenderTime, 2).Str(" ms"));
+        Set(changed, Disk, StatText().Fixed(diskGb, 1).Str(" GB"));
+        Set(changed, RenderSkip, StatText().Int(s.renderSkippedFrames).Str("/").Int(s.renderTotalFrames));
+        Set(changed, OutputSkip, StatText().Int(s.outputSkippedFrames).Str("/").Int(s.outputTotalFrames));
+
+        SetColor(changed, FpsColorField, FpsColor(s.activeFps));
+        SetColor(changed, CpuColorField, CpuColor(s.cpuUsage));
+        SetColor(changed, DiskColorField, DiskColor(diskGb));
+        SetColor(changed, RenderSkipColorField, SkipColor(s.renderSkippedFrames));
+        SetColor(changed, OutputSkipColorField, SkipColor(s.outputSkippedFrames));
+        return changed;
+    }
+
+    uint32_t SyncTrends(const StatsHistory& h)
+    {
+        uint32_t changed = 0;
+        Set(changed, TrendFps1m, Trend(h.Summarize(StatsMetric::Fps, StatsHistory::Window1m), 1, ""));
+        Set(changed, TrendFps10m, Trend(h.Summarize(StatsMetric::Fps, StatsHistory::Window10m), 1, ""));
+        Set(changed, TrendFrameTime1m, Trend(h.Summarize(StatsMetric::FrameTimeMs, StatsHistory::Window1m), 2, " ms"));
+        Set(changed, TrendFrameTime10m, Trend(h.Summarize(StatsMetric::FrameTimeMs, StatsHistory::Window10m), 2, " ms"));
+        Set(changed, TrendCpu1m, Trend(h.Summarize(StatsMetric::Cpu, StatsHistory::Window1m), 1, "%"));
+        Set(changed, TrendCpu10m, Trend(h.Summarize(StatsMetric::Cpu, StatsHistory::Window10m), 1, "%"));
+        Set(changed, TrendRenderSkip1m, Trend(h.Summarize(StatsMetric::RenderSkipPct, StatsHistory::Window1m), 2, "%"));
+        Set(changed, TrendRenderSkip10m, Trend(h.Summarize(StatsMetric::RenderSkipPct, StatsHistory::Window10m), 2, "%"));
+        return changed;
+    }
+
+private:
+    // "avg 59.8  min 57.0  max 60.0  p95 60.0  p99 60.0"
+    static StatText Trend(const StatsSummary& s, int decimals, const char* unit)
+    {
+        StatText t;
+        if (s.count == 0) return t.Str("--");
+        t.Str("avg ").Fixed(s.mean, decimals).Str(unit);
+        t.Str("  min ").Fixed(s.min, decimals);
+        t.Str("  max ").Fixed(s.max, decimals);
+        t.Str("  p95 ").Fixed(s.p95, decimals);
+        t.Str("  p99 ").Fixed(s.p99, decimals);
+        return t;
+    }
+
+    void Set(uint32_t& changed, int field, const StatText& t)
+    {
+        if (t.AssignIfChanged(m_text[field])) changed |= 1u << field;
+    }
+
+    void SetColor(uint32_t& changed, int field, StatColor c)
+    {
+        int slot = field - FpsColorField;
+        if (m_colors[slot] == c) return;
+        m_colors[slot] = c;
+        m_text[field] = StatColorHex(c);
+        changed |= 1u << field;
+    }
+
+    std::string m_text[FieldCount];
+    StatColor m_colors[OutputSkipColorField - FpsColorField + 1] = {
+        StatColor::Count, StatColor::Count, StatColor::Count, StatColor::Count, StatColor::Count };
+};
@@ -0,0 +1,254 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cmath>
+#include <vector>
+
+// Rolling history of OBS stats samples (one per stats_response).
+//
+// Storage is struct-of-arrays: one contiguous ring per metric plus a shared
+// timestamp ring, so a window scan touches only the metric it needs. Each
+// window keeps incremental aggregates that are updated on insert/evict:
+//   - sum for the mean
+//   - monotonic index queues for min/max (amortized O(1))
+//   - a fixed-bin histogram for approximate percentiles
+// Push() cost therefore does not depend on how long the windows are.
+
+enum class StatsMetric : int
+{
+    Fps = 0,
+    Cpu,
+    MemoryMb,
+    FrameTimeMs,
+    RenderSkipPct, // skipped/total render frames since the previous sample
+    OutputSkipPct, // skipped/total output frames since the previous sample
+    Count
+};
+
+struct StatsSummary
+{
+    int   count = 0;
+    float min = 0.0f;
+    float max = 0.0f;
+    float mean = 0.0f;
+    float p95 = 0.0f;
+    float p99 = 0.0f;
+};
+
+class StatsHistory
+{
+public:
+    static constexpr int MetricCount = static_cast<int>(StatsMetric::Count);
+    static constexpr int Capacity = 1024; // power of two; ~17 min at the 1 Hz stats poll
+    static constexpr int HistogramBins = 128;
+    static_assert((Capacity & (Capacity - 1)) == 0, "ring slots are sequence & (Capacity - 1)");
+
+    enum Window : int { Window1m = 0, Window10m, WindowCount };
+
+    explicit StatsHistory(double shortWindowS = 60.0, double longWindowS = 600.0)
+        : m_times(Capacity, 0.0),
+          m_values(static_cast<size_t>(MetricCount) * Capacity, 0.0f),
+          m_bins(static_cast<size_t>(MetricCount) * Capacity, 0),
+          m_queues(static_cast<size_t>(MetricCount) * WindowCount * 2 * Capacity, 0),
+          m_hist(static_cast<size_t>(MetricCount) * WindowCount * HistogramBins, 0)
+    {
+        m_windowS[Window1m] = shortWindowS;
+        m_windowS[Window10m] = longWindowS;
+        Clear();
+    }
+
+    void Clear()
+    {
+        m_next = 0;
+        for (int w = 0; w < WindowCount; w++)
+        {
+            m_head[w] = 0;
+            for (int m = 0; m < MetricCount; m++)
+            {
+                m_sum[m][w] = 0.0;
+                for (int k = 0; k < 2; k++)
+                {
+                    m_qHead[m][w][k] = 0;
+                    m_qTail[m][w][k] = 0;
+                }
+            }
+        }
+        std::fill(m_hist.begin(), m_hist.end(), uint16_t(0));
+    }
+
+    // Append one sample taken at time t (seconds, monotonic).
+    void Push(double t, const float (&values)[MetricCount])
+    {
+        const uint32_t seq = m_next;
+        const uint32_t slot = seq & (Capacity - 1);
+
+        // Free the ring slot first if it still belongs to a window
+        for (int w = 0; w < WindowCount; w++)
+        {
+            while (m_head[w] != seq &&
+                   (seq - m_head[w] >= Capacity || m_times[m_head[w] & (Capacity - 1)] < t - m_windowS[w]))
+                Evict(w);
+        }
+
+        m_times[slot] = t;
+        for (int m = 0; m < MetricCount; m++)
+        {
+            float v = std::isfinite(values[m]) ? values[m] : 0.0f;
+            m_values[ValueIndex(m, slot)] = v;
+            uint8_t bin = BinFor(m, v);
+            m_bins[ValueIndex(m, slot)] = bin;
+
+            for (int w = 0; w < WindowCount; w++)
+            {
+                m_sum[m][w] += v;
+                m_hist[HistIndex(m, w, bin)]++;
+                PushQueue(m, w, QueueMin, seq, v);
+                PushQueue(m, w, QueueMax, seq, v);
+            }
+        }
+        m_next = seq + 1;
+    }
+
+    // Total samples ever pushed; changes whenever a new sample lands.
+    uint32_t Sequence() const { return m_next; }
+
+    int Count(Window w) const { return static_cast<int>(m_next - m_head[w]); }
+
+    StatsSummary Summarize(StatsMetric metric, Window w) const
+    {
+        StatsSummary s;
+        const int m = static_cast<int>(metric);
+        s.count = Count(w);
+        if (s.count == 0) return s;
+
+        s.min = m_values[ValueIndex(m, QueueFront(m, w, QueueMin) & (Capacity - 1))];
+        s.max = m_values[ValueIndex(m, QueueFront(m, w, QueueMax) & (Capacity - 1))];
+        s.mean = static_cast<float>(m_sum[m][w] / s.count);
+        s.p95 = Percentile(m, w, 0.95, s.min, s.max);
+        s.p99 = Percentile(m, w, 0.99, s.min, s.max);
+        return s;
+    }
+
+    // Convert a skipped/total counter pair into a per-interval percentage.
+    // Counter resets (OBS restart) and idle intervals report 0.
+    static float IntervalPercent(int skipped, int total, int prevSkipped, int prevTotal)
+    {
+        int dTotal = total - prevTotal;
+        int dSkipped = skipped - prevSkipped;
+        if (dTotal <= 0 || dSkipped < 0) return 0.0f;
+        return 100.0f * static_cast<float>(dSkipped) / static_cast<float>(dTotal);
+    }
+
+private:
+    enum QueueKind : int { QueueMin = 0, QueueMax = 1 };
+
+    // Histogram range per metric; values outside are clamped to the edge bins
+    static constexpr float BinRange[MetricCount] = {
+        240.0f,   // Fps
+        100.0f,   // Cpu (%)
+        32768.0f, // MemoryMb
+        50.0f,    // FrameTimeMs
+        100.0f,   // RenderSkipPct
+        100.0f,   // OutputSkipPct
+    };
+
+    static size_t ValueIndex(int m, uint32_t slot)
+    {
+        return static_cast<size_t>(m) * Capacity + slot;
+    }
+    static size_t HistIndex(int m, int w, int bin)
+    {
+        return (static_cast<size_t>(m) * WindowCount + w) * HistogramBins + bin;
+    }
+    static size_t QueueBase(int m, int w, int k)
+    {
+        return ((static_cast<size_t>(m) * WindowCount + w) * 2 + k) * Capacity;
+    }
+
+    static uint8_t BinFor(int m, float v)
+    {
+        float scaled = v / BinRange[m] * HistogramBins;
+        if (!(scaled > 0.0f)) return 0;
+        if (scaled >= HistogramBins - 1) return HistogramBins - 1;
+        return static_cast<uint8_t>(scaled);
+    }
+
+    uint32_t QueueFront(int m, int w, int k) const
+    {
+        return m_queues[QueueBase(m, w, k) + (m_qHead[m][w][k] & (Capacity - 1))];
+    }
+
+    void PushQueue(int m, int w, int k, uint32_t seq, float v)
+    {
+        // Drop entries the new value dominates; the front stays the extreme
+        const size_t base = QueueBase(m, w, k);
+        uint32_t& head = m_qHead[m][w][k];
+        uint32_t& tail = m_qTail[m][w][k];
+        while (tail != head)
+        {
+            uint32_t back = m_queues[base + ((tail - 1) & (Capacity - 1))];
+            float bv = m_values[ValueIndex(m, back & (Capacity - 1))];
+            if (k == QueueMin ? bv < v : bv > v) break;
+            tail--;
+        }
+        m_queues[base + (tail & (Capacity - 1))] = seq;
+        tail++;
+    }
+
+    void Evict(int w)
+    {
+        const uint32_t seq = m_head[w];
+        const uint32_t slot = seq & (Capacity - 1);
+        for (int m = 0; m < MetricCount; m++)
+        {
+            m_sum[m][w] -= m_values[ValueIndex(m, slot)];
+            m_hist[HistIndex(m, w, m_bins[ValueIndex(m, slot)])]--;
+            for (int k = 0; k < 2; k++)
+            {
+                if (m_qHead[m][w][k] != m_qTail[m][w][k] && QueueFront(m, w, k) == seq)
+                    m_qHead[m][w][k]++;
+            }
+        }
+        m_head[w] = seq + 1;
+        if (m_head[w] == m_next)
+        {
+            // Window emptied: reset the running sum to shed float drift
+            for (int m = 0; m < MetricCount; m++)
+                m_sum[m][w] = 0.0;
+        }
+    }
+
+    float Percentile(int m, int w, double q, float lo, float hi) const
+    {
+        const int count = Count(static_cast<Window>(w));
+        const int rank = static_cast<int>(std::ceil(q * count));
+        int cumulative = 0;
+        for (int b = 0; b < HistogramBins; b++)
+        {
+            cumulative += m_hist[HistIndex(m, w, b)];
+            if (cumulative >= rank)
+            {
+                float mid = (b + 0.5f) * BinRange[m] / HistogramBins;
+                return mid < lo ? lo : (mid > hi ? hi : mid);
+            }
+        }
+        return hi;
+    }
+
+    double m_windowS[WindowCount] = {};
+
+    // Sample ring (struct-of-arrays)
+    std::vector<double>   m_times;
+    std::vector<float>    m_values; // [metric][slot]
+    std::vector<uint8_t>  m_bins;   // cached histogram bin per value, for O(1) evict
+
+    // Per metric/window aggregates
+    std::vector<uint32_t> m_queues; // [metric][window][min|max][Capacity] sample sequence numbers
+    std::vector<uint16_t> m_hist;   // [metric][window][bin]
+    double   m_sum[MetricCount][WindowCount] = {};
+    uint32_t m_qHead[MetricCount][WindowCount][2] = {};
+    uint32_t m_qTail[MetricCount][WindowCount][2] = {};
+
+    uint32_t m_head[WindowCount] = {}; // oldest sample sequence still in each window
+    uint32_t m_next = 0;               // sequence number of the next sample
+};
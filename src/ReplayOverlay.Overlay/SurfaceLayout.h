@@ -0,0 +1,130 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+
+// Decides where the overlay window and its swap chain go. Rather than a
+// transparent surface over the whole screen, they cover only what is on it
+// - the panel, the notification, the REC indicator - so the back buffers,
+// the per-frame clear and the compositor's work scale with the content.
+//
+// Each rendered frame the visible rects (screen pixels) are Add()ed and
+// Update() places the surface. Every move or resize costs a ResizeBuffers
+// and a full redraw, so placement has hysteresis:
+//   - content not inside the surface regrows it at once (nothing may be
+//     clipped), to the content plus Slack on each side, so that small
+//     growth (a notification appearing, a row expanding) still fits;
+//   - a surface more than Slack larger than that on any side shrinks to it,
+//     but only once it has been oversized for ShrinkDelayS, so content that
+//     toggles on and off does not resize the swap chain each time.
+// With nothing visible the surface shrinks to MinSize at the screen origin.
+
+class SurfaceLayout
+{
+public:
+    struct Rect
+    {
+        int left = 0, top = 0, right = 0, bottom = 0; // right / bottom exclusive
+
+        int Width() const { return right - left; }
+        int Height() const { return bottom - top; }
+        bool Empty() const { return right <= left || bottom <= top; }
+        bool Contains(const Rect& r) const
+        {
+            return r.left >= left && r.top >= top && r.right <= right && r.bottom <= bottom;
+        }
+        bool operator==(const Rect& o) const
+        {
+            return left == o.left && top == o.top && right == o.right && bottom == o.bottom;
+        }
+        bool operator!=(const Rect& o) const { return !(*this == o); }
+    };
+
+    static constexpr int Slack = 32;
+    static constexpr int MinSize = 8;
+    static constexpr double ShrinkDelayS = 1.0;
+
+    static Rect Union(const Rect& a, const Rect& b)
+    {
+        if (a.Empty()) return b;
+        if (b.Empty()) return a;
+        return { std::min(a.left, b.left), std::min(a.top, b.top),
+                 std::max(a.right, b.right), std::max(a.bottom, b.bottom) };
+    }
+    static Rect Intersect(const Rect& a, const Rect& b)
+    {
+        Rect r = { std::max(a.left, b.left), std::max(a.top, b.top),
+                   std::min(a.right, b.right), std::min(a.bottom, b.bottom) };
+        return r.Empty() ? Rect{} : r;
+    }
+    static Rect Inflate(const Rect& r, int d) { return { r.left - d, r.top - d, r.right + d, r.bottom + d }; }
+
+    // Screen size; the next Update() places the surface without delay
+    void SetScreen(int width, int height)
+    {
+        m_screen = { 0, 0, std::max(width, 0), std::max(height, 0) };
+        m_placement = m_screen;
+        m_placed = false;
+        m_oversizedSince = -1.0;
+    }
+
+    // Collects this frame's visible content (clipped to the screen)
+    void BeginFrame() { m_content = {}; }
+    void Add(const Rect& rect) { m_content = Union(m_content, Intersect(rect, m_screen)); }
+    void Add(int x, int y, int w, int h) { Add(Rect{ x, y, x + w, y + h }); }
+
+    // Places the surface for the content added since BeginFrame(). Returns
+    // true if Placement() changed.
+    bool Update(double now)
+    {
+        const Rect& content = m_content;
+        const Rect target = content.Empty()
+            ? Intersect({ 0, 0, MinSize, MinSize }, m_screen)
+            : Intersect(Inflate(content, Slack), m_screen);
+
+        if (!m_placed || (!content.Empty() && !m_placement.Contains(content)))
+            return Place(target);
+
+        const bool oversized = content.Empty()
+            ? m_placement != target
+            : target.left - m_placement.left > Slack || target.top - m_placement.top > Slack ||
+              m_placement.right - target.right > Slack || m_placement.bottom - target.bottom > Slack;
+        if (!oversized)
+        {
+            m_oversizedSince = -1.0;
+            return false;
+        }
+        if (m_oversizedSince < 0.0)
+            m_oversizedSince = now;
+        if (now - m_oversizedSince < ShrinkDelayS)
+            return false;
+        return Place(target);
+    }
+
+    const Rect& Placement() const { return m_placement; }
+    const Rect& Content() const { return m_content; }
+
+    // When a pending shrink is due (negative: none). Nothing else renders
+    // a frame then, so the caller schedules one.
+    double ShrinkAt() const { return m_oversizedSince < 0.0 ? -1.0 : m_oversizedSince + ShrinkDelayS; }
+
+    // Placements made (each one a swap chain resize or move)
+    uint64_t Changes() const { return m_changes; }
+
+private:
+    bool Place(const Rect& target)
+    {
+        m_placed = true;
+        m_oversizedSince = -1.0;
+        if (target == m_placement) return false;
+        m_placement = target;
+        m_changes++;
+        return true;
+    }
+
+    Rect m_screen;
+    Rect m_content;
+    Rect m_placement;
+    bool m_placed = false;
+    double m_oversizedSince = -1.0;
+    uint64_t m_changes = 0;
+};
@@ -0,0 +1,217 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Keeps tab panes alive across tab switches.
+//
+// A pane is built from its fragment the first time its tab is opened (or
+// ahead of time by Prebuild() during idle frames) and is then only hidden
+// and shown. The summed cost of resident panes (element count, as reported
+// by the host) is held under a budget by destroying the least recently used
+// hidden pane; the active pane is never evicted. Prebuilding never evicts:
+// a tab that did not fit is skipped until its last measured cost fits
+// (after an eviction or a re-measure frees room), and only tabs whose
+// build failed are given up on.
+//
+// Host provides:
+//   size_t BuildTab(const std::string& name);   // create hidden; cost, 0 on failure
+//   size_t TabCost(const std::string& name);    // current cost of a built pane
+//   void ShowTab(const std::string& name, bool visible);
+//   void DestroyTab(const std::string& name);
+// Templated on the host so it can be tested without RmlUi.
+
+template <typename Host>
+class TabCache
+{
+public:
+    enum class Result : uint8_t
+    {
+        Unchanged, // already the active tab
+        Warm,      // pane was resident; shown
+        Cold,      // pane was built for this switch
+        Failed,    // unknown tab / build failed
+    };
+
+    TabCache(Host& host, size_t budget) : m_host(host), m_budget(budget) {}
+
+    // Shows 'name' and hides the previous pane
+    Result Activate(const std::string& name)
+    {
+        if (name == m_active && Find(name)) return Result::Unchanged;
+
+        Result result = Result::Warm;
+        Pane* pane = Find(name);
+        if (!pane)
+        {
+            pane = Build(name);
+            if (!pane) return Result::Failed;
+            result = Result::Cold;
+        }
+
+        if (Pane* previous = Find(m_active))
+        {
+            m_host.ShowTab(previous->name, false);
+            // Re-measure on the way out: data-for lists grow while a tab is open
+            Recost(*previous);
+        }
+        m_host.ShowTab(name, true);
+        m_active = name;
+        pane->lastUse = ++m_clock;
+
+        if (result == Result::Warm) m_hits++;
+        EvictOverBudget();
+        return result;
+    }
+
+    // Builds the first not-yet-resident tab of 'order' that fits the
+    // budget. Returns true if a pane was built (call again next idle frame).
+    bool Prebuild(const std::vector<std::string>& order)
+    {
+        for (const auto& name : order)
+        {
+            if (Find(name) || IsFailed(name)) continue;
+            if (m_cost >= m_budget) return false;
+            Unfit* unfit = FindUnfit(name);
+            if (unfit && m_cost + unfit->cost > m_budget) continue; // still no room
+
+            Pane* pane = Build(name);
+            if (!pane)
+            {
+                m_failed.push_back(name);
+                continue;
+            }
+            if (m_cost > m_budget)
+            {
+                // Didn't fit after all; prebuilding must not push others out
+                const size_t cost = pane->cost;
+                Destroy(name);
+                if (unfit) unfit->cost = cost;
+                else m_unfit.push_back(Unfit{ name, cost });
+                return false;
+            }
+            if (unfit) m_unfit.erase(m_unfit.begin() + (unfit - m_unfit.data()));
+            m_prebuilt++;
+            return true;
+        }
+        return false;
+    }
+
+    bool IsResident(const std::string& name) const { return Find(name) != nullptr; }
+    const std::string& Active() const { return m_active; }
+    size_t Resident() const { return m_panes.size(); }
+    size_t Cost() const { return m_cost; }
+    size_t Budget() const { return m_budget; }
+
+    // Bumped whenever a pane is built or destroyed (elements appear/vanish)
+    uint32_t Generation() const { return m_generation; }
+
+    // Counters for diagnostics and tests
+    uint64_t Builds() const { return m_builds; }
+    uint64_t Prebuilt() const { return m_prebuilt; }
+    uint64_t Hits() const { return m_hits; }
+    uint64_t Evictions() const { return m_evictions; }
+
+private:
+    struct Pane
+    {
+        std::string name;
+        size_t cost = 0;
+        uint64_t lastUse = 0;
+    };
+
+    struct Unfit
+    {
+        std::string name;
+        size_t cost = 0; // when it was last built
+    };
+
+    Pane* Find(const std::string& name)
+    {
+        for (auto& p : m_panes)
+            if (p.name == name) return &p;
+        return nullptr;
+    }
+    const Pane* Find(const std::string& name) const
+    {
+        for (const auto& p : m_panes)
+            if (p.name == name) return &p;
+        return nullptr;
+    }
+
+    Unfit* FindUnfit(const std::string& name)
+    {
+        for (auto& u : m_unfit)
+            if (u.name == name) return &u;
+        return nullptr;
+    }
+
+    bool IsFailed(const std::string& name) const
+    {
+        for (const auto& n : m_failed)
+            if (n == name) return true;
+        return false;
+    }
+
+    Pane* Build(const std::string& name)
+    {
+        size_t cost = m_host.BuildTab(name);
+        if (cost == 0) return nullptr;
+        m_panes.push_back(Pane{ name, cost, 0 });
+        m_cost += cost;
+        m_builds++;
+        m_generation++;
+        return &m_panes.back();
+    }
+
+    void Destroy(const std::string& name)
+    {
+        for (size_t i = 0; i < m_panes.size(); i++)
+        {
+            if (m_panes[i].name != name) continue;
+            m_host.DestroyTab(name);
+            m_cost -= m_panes[i].cost;
+            m_panes.erase(m_panes.begin() + static_cast<std::ptrdiff_t>(i));
+            m_generation++;
+            return;
+        }
+    }
+
+    void Recost(Pane& pane)
+    {
+        size_t cost = m_host.TabCost(pane.name);
+        m_cost = m_cost - pane.cost + cost;
+        pane.cost = cost;
+    }
+
+    void EvictOverBudget()
+    {
+        while (m_cost > m_budget)
+        {
+            const Pane* victim = nullptr;
+            for (const auto& p : m_panes)
+                if (p.name != m_active && (!victim || p.lastUse < victim->lastUse))
+                    victim = &p;
+            if (!victim) return; // only the active pane is left
+            std::string name = victim->name;
+            Destroy(name);
+            m_evictions++;
+        }
+    }
+
+    Host& m_host;
+    size_t m_budget;
+    std::vector<Pane> m_panes; // a handful of tabs; linear search
+    std::vector<std::string> m_failed; // build failed: never prebuilt again
+    std::vector<Unfit> m_unfit;        // over budget when last prebuilt
+    std::string m_active;
+    size_t m_cost = 0;
+    uint64_t m_clock = 0;
+    uint32_t m_generation = 0;
+
+    uint64_t m_builds = 0;
+    uint64_t m_prebuilt = 0;
+    uint64_t m_hits = 0;
+    uint64_t m_evictions = 0;
+};
@@ -0,0 +1,117 @@
+#include "TextureAtlas.h"
+#include <algorithm>
+#include <cstring>
+
+#define STB_RECT_PACK_IMPLEMENTATION
+#include "imgui/imstb_rectpack.h"
+
+TextureAtlas::TextureAtlas(int pageSize, int maxEntrySize)
+    : m_pageSize(pageSize),
+      m_maxEntrySize(std::min(maxEntrySize, pageSize - 2 * Border))
+{
+}
+
+TextureAtlas::~TextureAtlas() = default;
+
+void TextureAtlas::ResetPage(Page& page)
+{
+    // One node per column is enough for the skyline to never run out
+    page.nodes.resize(static_cast<size_t>(m_pageSize));
+    stbrp_init_target(&page.context, m_pageSize, m_pageSize, page.nodes.data(),
+                      static_cast<int>(page.nodes.size()));
+    page.entries = 0;
+    page.usedTexels = 0;
+}
+
+TextureAtlas::Placement TextureAtlas::Insert(int width, int height, bool* newPage)
+{
+    if (newPage) *newPage = false;
+    if (!Fits(width, height)) return {};
+
+    stbrp_rect rect = {};
+    rect.w = width + 2 * Border;
+    rect.h = height + 2 * Border;
+
+    uint32_t page = 0;
+    for (; page < m_pages.size(); page++)
+    {
+        stbrp_pack_rects(&m_pages[page]->context, &rect, 1);
+        if (rect.was_packed) break;
+    }
+    if (page == m_pages.size())
+    {
+        m_pages.push_back(std::make_unique<Page>());
+        ResetPage(*m_pages.back());
+        stbrp_pack_rects(&m_pages.back()->context, &rect, 1);
+        if (!rect.was_packed) // cannot happen: the entry fits an empty page
+        {
+            m_pages.pop_back();
+            return {};
+        }
+        if (newPage) *newPage = true;
+    }
+
+    Page& p = *m_pages[page];
+    p.entries++;
+    p.usedTexels += static_cast<size_t>(rect.w) * rect.h;
+
+    Placement placement;
+    placement.page = page;
+    placement.x = rect.x + Border;
+    placement.y = rect.y + Border;
+    placement.width = width;
+    placement.height = height;
+    return placement;
+}
+
+void TextureAtlas::Release(const Placement& placement)
+{
+    if (!placement.Valid() || placement.page >= m_pages.size()) return;
+    Page& page = *m_pages[placement.page];
+    if (page.entries == 0) return;
+    page.usedTexels -= static_cast<size_t>(placement.width + 2 * Border) * (placement.height + 2 * Border);
+    if (--page.entries == 0)
+        ResetPage(page);
+}
+
+UvTransform TextureAtlas::UvFor(const Placement& placement) const
+{
+    const float inv = 1.0f / static_cast<float>(m_pageSize);
+    UvTransform uv;
+    uv.offsetU = placement.x * inv;
+    uv.offsetV = placement.y * inv;
+    uv.scaleU = placement.width * inv;
+    uv.scaleV = placement.height * inv;
+    return uv;
+}
+
+void TextureAtlas::CopyWithBorder(const uint8_t* src, int width, int height, uint8_t* dst)
+{
+    const int outWidth = width + 2 * Border;
+    const int outHeight = height + 2 * Border;
+    for (int y = 0; y < outHeight; y++)
+    {
+        const int sy = std::min(std::max(y - Border, 0), height - 1);
+        const uint8_t* row = src + static_cast<size_t>(sy) * width * 4;
+        uint8_t* out = dst + static_cast<size_t>(y) * outWidth * 4;
+        for (int b = 0; b < Border; b++)
+        {
+            std::memcpy(out + b * 4, row, 4);
+            std::memcpy(out + (Border + width + b) * 4, row + (width - 1) * 4, 4);
+        }
+        std::memcpy(out + Border * 4, row, static_cast<size_t>(width) * 4);
+    }
+}
+
+TextureAtlas::Stats TextureAtlas::GetStats() const
+{
+    Stats s;
+    s.pages = m_pages.size();
+    for (const auto& page : m_pages)
+    {
+        s.entries += page->entries;
+        s.usedTexels += page->usedTexels;
+        s.pageTexels += static_cast<size_t>(m_pageSize) * m_pageSize;
+    }
+    return s;
+}
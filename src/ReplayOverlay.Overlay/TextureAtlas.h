@@ -0,0 +1,94 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "GeometryBatcher.h"
+#include "imgui/imstb_rectpack.h"
+
+// Packs small generated textures (glyph pages, icons, gradients) into
+// shared atlas pages.
+//
+// Every distinct texture splits a batch, and RmlUi generates many small
+// ones. Textures up to MaxEntrySize on both sides are placed on square
+// pages by a skyline packer (stb_rect_pack); larger ones should keep their
+// own texture. Each entry gets a border of replicated edge texels so
+// bilinear sampling at its edges never reads a neighbour.
+//
+// Skyline packing cannot return space piecemeal: a released entry's area
+// is reclaimed when every entry on its page has been released, at which
+// point the page starts empty again. The atlas only does placement; the
+// render interface owns the page textures and uploads the texels.
+
+class TextureAtlas
+{
+public:
+    struct Placement
+    {
+        uint32_t page = 0;
+        int x = 0, y = 0;           // content origin on the page (inside the border)
+        int width = 0, height = 0;
+        bool Valid() const { return width > 0 && height > 0; }
+    };
+
+    struct Stats
+    {
+        size_t pages = 0;
+        size_t entries = 0;
+        size_t usedTexels = 0;      // content plus borders of live entries
+        size_t pageTexels = 0;
+
+        double Occupancy() const
+        {
+            return pageTexels ? static_cast<double>(usedTexels) / static_cast<double>(pageTexels) : 0.0;
+        }
+    };
+
+    static constexpr int Border = 1;
+
+    explicit TextureAtlas(int pageSize = 1024, int maxEntrySize = 256);
+    ~TextureAtlas();
+
+    // Whether a texture of this size belongs in the atlas
+    bool Fits(int width, int height) const
+    {
+        return width > 0 && height > 0 && width <= m_maxEntrySize && height <= m_maxEntrySize;
+    }
+
+    // Places a texture; sets 'newPage' when a page had to be added (its
+    // index is the returned page). Invalid if the size does not fit.
+    Placement Insert(int width, int height, bool* newPage = nullptr);
+    void Release(const Placement& placement);
+
+    // Forgets every page and entry (the owner has released the textures)
+    void Clear() { m_pages.clear(); }
+
+    // Undoes a page added by Insert() when its texture could not be created
+    void RemoveLastPage() { if (!m_pages.empty()) m_pages.pop_back(); }
+
+    // UVs of the placement's content within its page
+    UvTransform UvFor(const Placement& placement) const;
+
+    // Writes src (width x height RGBA8) with a Border of replicated edge
+    // texels into dst, which is (width + 2 * Border) x (height + 2 * Border)
+    static void CopyWithBorder(const uint8_t* src, int width, int height, uint8_t* dst);
+
+    int PageSize() const { return m_pageSize; }
+    size_t PageCount() const { return m_pages.size(); }
+    Stats GetStats() const;
+
+private:
+    struct Page
+    {
+        stbrp_context context;
+        std::vector<stbrp_node> nodes;
+        size_t entries = 0;
+        size_t usedTexels = 0;
+    };
+
+    void ResetPage(Page& page);
+
+    int m_pageSize;
+    int m_maxEntrySize;
+    std::vector<std::unique_ptr<Page>> m_pages; // stable: contexts point at their nodes
+};
@@ -0,0 +1,319 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Hierarchical timer wheel for debounces and periodic requests.
+//
+// Time is quantized into ticks. Level 0 has one slot per tick; each higher
+// level has slots 64x wider. A timer is placed on the lowest level whose
+// rotation still contains its expiry and is cascaded down when the clock
+// reaches its slot, so schedule/cancel/reschedule are O(1) and AdvanceTo()
+// only touches slots that are actually occupied (found via per-level
+// bitmaps). Timers are addressed by generation-checked IDs; a stale ID is
+// simply reported as not pending.
+//
+// The wheel has no clock of its own: the owner feeds it with AdvanceTo(),
+// which makes it trivially deterministic under test.
+
+class TimerWheel
+{
+public:
+    using Id = uint64_t;
+    static constexpr Id InvalidId = 0;
+
+    static constexpr int SlotBits = 6;
+    static constexpr int SlotsPerLevel = 1 << SlotBits;
+    static constexpr int Levels = 6; // 2^36 ticks; far beyond any realistic delay
+
+    explicit TimerWheel(double tickS = 1.0 / 128.0)
+        : m_tickS(tickS)
+    {
+        for (auto& level : m_heads)
+            for (auto& head : level) head = Nil;
+    }
+
+    // Allocate an idle timer. The ID stays valid until Destroy().
+    Id Create()
+    {
+        uint32_t index;
+        if (m_freeHead != Nil)
+        {
+            index = m_freeHead;
+            m_freeHead = m_nodes[index].next;
+        }
+        else
+        {
+            index = static_cast<uint32_t>(m_nodes.size());
+            m_nodes.emplace_back();
+        }
+        Node& n = m_nodes[index];
+        n.alive = true;
+        n.linked = false;
+        n.prev = n.next = Nil;
+        n.periodTicks = 0;
+        return MakeId(index, n.generation);
+    }
+
+    void Destroy(Id id)
+    {
+        Node* n = Lookup(id);
+        if (!n) return;
+        if (n->linked) Unlink(*n);
+        n->alive = false;
+        n->generation++;
+        n->next = m_freeHead;
+        m_freeHead = IndexOf(id);
+    }
+
+    // Arm (or re-arm) a timer to expire 'delayS' after the current time.
+    // A non-zero 'periodS' makes it repeat until cancelled.
+    void Schedule(Id id, double delayS, double periodS = 0.0)
+    {
+        Node* n = Lookup(id);
+        if (!n) return;
+        const uint32_t index = IndexOf(id);
+        if (n->linked) Unlink(*n);
+
+        // Round up so a timer never fires before its delay has elapsed
+        double due = std::ceil((m_nowS + (delayS > 0.0 ? delayS : 0.0)) / m_tickS);
+        n->due = due < static_cast<double>(m_current) ? m_current : static_cast<uint64_t>(due);
+        n->periodTicks = periodS > 0.0
+            ? static_cast<uint64_t>(std::ceil(periodS / m_tickS))
+            : 0;
+        if (periodS > 0.0 && n->periodTicks == 0) n->periodTicks = 1;
+        Link(*n, index);
+    }
+
+    void Cancel(Id id)
+    {
+        Node* n = Lookup(id);
+        if (n && n->linked) Unlink(*n);
+    }
+
+    bool IsPending(Id id) const
+    {
+        const Node* n = Lookup(id);
+        return n && n->linked;
+    }
+
+    // Seconds until the timer fires, or a negative value if it is idle
+    double Remaining(Id id) const
+    {
+        const Node* n = Lookup(id);
+        if (!n || !n->linked) return -1.0;
+        double r = static_cast<double>(n->due) * m_tickS - m_nowS;
+        return r > 0.0 ? r : 0.0;
+    }
+
+    double Now() const { return m_nowS; }
+    int ActiveCount() const { return m_active; }
+
+    // Advance the clock to 't' (seconds, monotonic) and call onExpire(id)
+    // for every timer that came due, in expiry order. Callbacks may schedule,
+    // cancel or destroy timers. Returns the number of expirations.
+    template <typename F>
+    int AdvanceTo(double t, F&& onExpire)
+    {
+        if (t < m_nowS) return 0;
+        m_nowS = t;
+        const uint64_t target = static_cast<uint64_t>(std::floor(t / m_tickS));
+
+        int fired = 0;
+        while (m_active > 0)
+        {
+            uint64_t tick = 0;
+            if (!NextEvent(tick) || tick > target) break;
+            m_current = tick;
+
+            // Cascade from the top so timers land at their final level
+            for (int level = Levels - 1; level >= 1; level--)
+            {
+                const int shift = level * SlotBits;
+                if ((tick & ((uint64_t(1) << shift) - 1)) != 0) continue;
+                Cascade(level, static_cast<int>((tick >> shift) & (SlotsPerLevel - 1)));
+            }
+
+            // Everything still on level 0 at this slot is due now. Move the
+            // clock past it first so callbacks that re-arm land in a later slot.
+            m_current = tick + 1;
+            const int slot = static_cast<int>(tick & (SlotsPerLevel - 1));
+            uint32_t& head = m_heads[0][slot];
+            while (head != Nil)
+            {
+                const uint32_t index = head;
+                Node& n = m_nodes[index];
+                Unlink(n);
+                if (n.due > tick)
+                {
+                    // Clamped to the wheel span on insert; not actually due yet
+                    Link(n, index);
+                    continue;
+                }
+                if (n.periodTicks > 0)
+                {
+                    n.due = tick + n.periodTicks;
+                    Link(n, index);
+                }
+                fired++;
+                onExpire(MakeId(index, n.generation));
+            }
+        }
+
+        if (m_current <= target) m_current = target + 1;
+        return fired;
+    }
+
+    int AdvanceTo(double t)
+    {
+        return AdvanceTo(t, [](Id) {});
+    }
+
+private:
+    static constexpr uint32_t Nil = 0xFFFFFFFFu;
+
+    struct Node
+    {
+        uint64_t due = 0;          // expiry tick
+        uint64_t periodTicks = 0;  // 0 = one-shot
+        uint32_t prev = Nil;
+        uint32_t next = Nil;       // also the free-list link
+        uint32_t generation = 1;
+        uint8_t  level = 0;
+        uint8_t  slot = 0;
+        bool     alive = false;
+        bool     linked = false;
+    };
+
+    static Id MakeId(uint32_t index, uint32_t generation)
+    {
+        return (static_cast<uint64_t>(generation) << 32) | index;
+    }
+    static uint32_t IndexOf(Id id) { return static_cast<uint32_t>(id); }
+    static uint32_t GenerationOf(Id id) { return static_cast<uint32_t>(id >> 32); }
+
+    Node* Lookup(Id id)
+    {
+        uint32_t index = IndexOf(id);
+        if (index >= m_nodes.size()) return nullptr;
+        Node& n = m_nodes[index];
+        return (n.alive && n.generation == GenerationOf(id)) ? &n : nullptr;
+    }
+    const Node* Lookup(Id id) const
+    {
+        return const_cast<TimerWheel*>(this)->Lookup(id);
+    }
+
+    static int CountTrailingZeros(uint64_t v)
+    {
+#ifdef _MSC_VER
+        unsigned long idx;
+        _BitScanForward64(&idx, v);
+        return static_cast<int>(idx);
+#else
+        return __builtin_ctzll(v);
+#endif
+    }
+
+    static int HighestBit(uint64_t v)
+    {
+#ifdef _MSC_VER
+        unsigned long idx;
+        _BitScanReverse64(&idx, v);
+        return static_cast<int>(idx);
+#else
+        return 63 - __builtin_clzll(v);
+#endif
+    }
+
+    void Link(Node& n, uint32_t index)
+    {
+        // Level = highest base-64 digit in which the expiry differs from now.
+        // Expiries past the top rotation are parked at its last tick and
+        // re-linked when they get there.
+        const int spanBits = Levels * SlotBits;
+        uint64_t at = n.due < m_current ? m_current : n.due;
+        if ((at >> spanBits) != (m_current >> spanBits))
+            at = m_current | ((uint64_t(1) << spanBits) - 1);
+
+        const uint64_t diff = at ^ m_current;
+        const int level = diff == 0 ? 0 : HighestBit(diff) / SlotBits;
+        const int slot = static_cast<int>((at >> (level * SlotBits)) & (SlotsPerLevel - 1));
+
+        n.level = static_cast<uint8_t>(level);
+        n.slot = static_cast<uint8_t>(slot);
+        n.prev = Nil;
+        n.next = m_heads[level][slot];
+        if (n.next != Nil) m_nodes[n.next].prev = index;
+        m_heads[level][slot] = index;
+        m_occupied[level] |= uint64_t(1) << slot;
+        n.linked = true;
+        m_active++;
+    }
+
+    void Unlink(Node& n)
+    {
+        if (n.prev != Nil) m_nodes[n.prev].next = n.next;
+        else m_heads[n.level][n.slot] = n.next;
+        if (n.next != Nil) m_nodes[n.next].prev = n.prev;
+        if (m_heads[n.level][n.slot] == Nil)
+            m_occupied[n.level] &= ~(uint64_t(1) << n.slot);
+        n.prev = n.next = Nil;
+        n.linked = false;
+        m_active--;
+    }
+
+    void Cascade(int level, int slot)
+    {
+        uint32_t index = m_heads[level][slot];
+        while (index != Nil)
+        {
+            Node& n = m_nodes[index];
+            uint32_t next = n.next;
+            Unlink(n);
+            Link(n, index);
+            index = next;
+        }
+    }
+
+    // Earliest tick at which a slot needs processing: a level-0 expiry or the
+    // start of an occupied higher-level slot (a cascade). 'tick' is
+    // UINT64_MAX when nothing is pending.
+    bool NextEvent(uint64_t& tick) const
+    {
+        bool found = false;
+        tick = ~uint64_t(0);
+        for (int level = 0; level < Levels; level++)
+        {
+            const int shift = level * SlotBits;
+            const int cur = static_cast<int>((m_current >> shift) & (SlotsPerLevel - 1));
+            // The current slot is still pending if the clock sits exactly on
+            // its start (always true on level 0); otherwise it has been cascaded
+            const bool atStart = (m_current & ((uint64_t(1) << shift) - 1)) == 0;
+            const int from = atStart ? cur : cur + 1;
+            if (from >= SlotsPerLevel) continue;
+            const uint64_t mask = m_occupied[level] & (~uint64_t(0) << from);
+            if (!mask) continue;
+
+            const uint64_t rotation = m_current & ~((uint64_t(1) << (shift + SlotBits)) - 1);
+            const uint64_t start = rotation | (static_cast<uint64_t>(CountTrailingZeros(mask)) << shift);
+            if (start < tick) tick = start;
+            found = true;
+        }
+        return found;
+    }
+
+    double m_tickS;
+    double m_nowS = 0.0;
+    uint64_t m_current = 0; // next tick to process
+
+    std::vector<Node> m_nodes;
+    uint32_t m_freeHead = Nil;
+    uint32_t m_heads[Levels][SlotsPerLevel];
+    uint64_t m_occupied[Levels] = {};
+    int m_active = 0;
+};
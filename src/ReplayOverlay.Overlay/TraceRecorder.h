@@ -0,0 +1,360 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <set>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// Chrome trace-event recorder for loading overlay sessions into
+// chrome://tracing or Perfetto.
+//
+// Each thread that records gets its own preallocated ring of RingCapacity
+// events on first use; once full, the oldest events are overwritten, so a
+// long session keeps its most recent history. Recording is off by default
+// and costs one relaxed atomic load per call site while off. WriteJson()
+// pauses recording, waits for events already being written to land, then
+// reads the rings and emits the trace-event JSON format ("traceEvents"
+// array, microsecond timestamps).
+//
+// Event names must outlive the recorder: pass string literals, or Intern()
+// dynamic names such as IPC message types (TraceInternCache at call sites
+// that repeat the same few).
+
+class TraceRecorder
+{
+public:
+    static constexpr size_t RingCapacity = 1 << 16; // events per thread
+
+    enum class Phase : char
+    {
+        Begin = 'B',
+        End = 'E',
+        Complete = 'X',
+        Instant = 'i',
+        Counter = 'C',
+    };
+
+    struct Event
+    {
+        const char* name;
+        const char* detail; // optional "detail" arg, may be null
+        uint64_t tsNs;
+        int64_t value;      // Complete: duration (ns); Counter: value
+        Phase phase;
+    };
+
+    TraceRecorder() : m_id(NextInstanceId()), m_epochNs(NowNs()) {}
+    TraceRecorder(const TraceRecorder&) = delete;
+    TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+    // Process-wide recorder used by the TRACE_* macros
+    static TraceRecorder& Get()
+    {
+        static TraceRecorder recorder;
+        return recorder;
+    }
+
+    static uint64_t NowNs()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    // Turning recording on starts a fresh session (rings are emptied)
+    void SetEnabled(bool enabled)
+    {
+        if (enabled && !IsEnabled())
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (auto& ring : m_rings)
+            {
+                WaitForWriter(*ring);
+                ring->head.store(0, std::memory_order_relaxed);
+            }
+        }
+        m_enabled.store(enabled, std::memory_order_release);
+    }
+    bool IsEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+    void Begin(const char* name, const char* detail = nullptr)
+    {
+        if (IsEnabled()) Push({ name, detail, NowNs(), 0, Phase::Begin });
+    }
+    void End(const char* name)
+    {
+        if (IsEnabled()) Push({ name, nullptr, NowNs(), 0, Phase::End });
+    }
+    void Instant(const char* name, const char* detail = nullptr)
+    {
+        if (IsEnabled()) Push({ name, detail, NowNs(), 0, Phase::Instant });
+    }
+    void Counter(const char* name, int64_t value)
+    {
+        if (IsEnabled()) Push({ name, nullptr, NowNs(), value, Phase::Counter });
+    }
+    void Complete(const char* name, uint64_t startNs, uint64_t endNs, const char* detail = nullptr)
+    {
+        if (IsEnabled()) Push({ name, detail, startNs, static_cast<int64_t>(endNs - startNs), Phase::Complete });
+    }
+
+    // Name shown for the calling thread's track (string literal). Applies
+    // to rings created on this thread afterwards, so it allocates nothing.
+    static void SetThreadName(const char* name) { ThreadName() = name; }
+
+    // Stable copy of a dynamic string, valid for the recorder's lifetime
+    const char* Intern(std::string_view s)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_strings.find(s);
+        if (it == m_strings.end()) it = m_strings.emplace(s).first;
+        return it->c_str();
+    }
+
+    // Writes every buffered event as trace-event JSON; returns the count
+    size_t WriteJson(std::ostream& out)
+    {
+        bool wasEnabled = m_enabled.exchange(false);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& ring : m_rings) WaitForWriter(*ring);
+
+        size_t count = 0;
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        bool first = true;
+        char buf[96];
+        for (auto& ring : m_rings)
+        {
+            if (ring->threadName)
+            {
+                out << (first ? "" : ",") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << ring->tid
+                    << ",\"args\":{\"name\":";
+                WriteString(out, ring->threadName);
+                out << "}}";
+                first = false;
+            }
+
+            uint64_t head = ring->head.load(std::memory_order_acquire);
+            uint64_t start = head > RingCapacity ? head - RingCapacity : 0;
+            for (uint64_t i = start; i < head; i++)
+            {
+                const Event& e = ring->events[i % RingCapacity];
+                out << (first ? "" : ",") << "{\"name\":";
+                WriteString(out, e.name);
+                snprintf(buf, sizeof(buf), ",\"cat\":\"overlay\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":%u",
+                         static_cast<char>(e.phase), (static_cast<double>(e.tsNs) - m_epochNs) / 1000.0, ring->tid);
+                out << buf;
+                if (e.phase == Phase::Complete)
+                {
+                    snprintf(buf, sizeof(buf), ",\"dur\":%.3f", e.value / 1000.0);
+                    out << buf;
+                }
+                else if (e.phase == Phase::Instant)
+                {
+                    out << ",\"s\":\"t\"";
+                }
+
+                if (e.phase == Phase::Counter)
+                {
+                    out << ",\"args\":{\"value\":" << e.value << "}";
+                }
+                else if (e.detail)
+                {
+                    out << ",\"args\":{\"detail\":";
+                    WriteString(out, e.detail);
+                    out << "}";
+                }
+                out << "}";
+                first = false;
+                count++;
+            }
+        }
+        out << "]}\n";
+
+        m_enabled.store(wasEnabled, std::memory_order_release);
+        return count;
+    }
+
+    // WriteJson() to a file; returns the event count, or -1 if the file
+    // could not be written
+    long long Flush(const std::string& path)
+    {
+        std::ofstream f(path, std::ios::binary | std::ios::trunc);
+        if (!f.is_open()) return -1;
+        size_t count = WriteJson(f);
+        f.flush();
+        return f ? static_cast<long long>(count) : -1;
+    }
+
+    // Events currently held for the calling thread (for tests)
+    size_t BufferedOnThisThread()
+    {
+        uint64_t head = Ring().head.load(std::memory_order_relaxed);
+        return static_cast<size_t>(head > RingCapacity ? RingCapacity : head);
+    }
+
+private:
+    struct ThreadRing
+    {
+        std::vector<Event> events;
+        std::atomic<uint64_t> head{ 0 };
+        std::atomic<bool> writing{ false }; // owner thread is inside Push()
+        uint32_t tid = 0;
+        const char* threadName = nullptr;
+    };
+
+    static const char*& ThreadName()
+    {
+        thread_local const char* name = nullptr;
+        return name;
+    }
+
+    static uint64_t NextInstanceId()
+    {
+        static std::atomic<uint64_t> next{ 1 };
+        return next.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void Push(const Event& e)
+    {
+        // Callers checked IsEnabled() before getting here. Announce the write,
+        // then check again: WriteJson() disables first and then waits for
+        // announced writers, so either it sees this flag or we see it off.
+        ThreadRing& ring = Ring();
+        ring.writing.store(true);
+        if (m_enabled.load()) // seq_cst, paired with WriteJson()'s exchange
+        {
+            uint64_t head = ring.head.load(std::memory_order_relaxed);
+            ring.events[head % RingCapacity] = e;
+            ring.head.store(head + 1, std::memory_order_release);
+        }
+        ring.writing.store(false, std::memory_order_release);
+    }
+
+    static void WaitForWriter(const ThreadRing& ring)
+    {
+        // A writer holds the flag for one event copy
+        while (ring.writing.load())
+            std::this_thread::yield();
+    }
+
+    ThreadRing& Ring()
+    {
+        // Cached per thread; keyed by instance id so separate recorders
+        // (tests) never share or outlive each other's rings
+        thread_local uint64_t cachedId = 0;
+        thread_local ThreadRing* cached = nullptr;
+        if (cachedId == m_id) return *cached;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto ring = std::make_unique<ThreadRing>();
+        ring->events.resize(RingCapacity);
+        ring->tid = static_cast<uint32_t>(m_rings.size() + 1);
+        ring->threadName = ThreadName();
+        cached = ring.get();
+        cachedId = m_id;
+        m_rings.push_back(std::move(ring));
+        return *cached;
+    }
+
+    static void WriteString(std::ostream& out, const char* s)
+    {
+        out << '"';
+        for (; *s; s++)
+        {
+            unsigned char c = static_cast<unsigned char>(*s);
+            if (c == '"' || c == '\\') out << '\\' << *s;
+            else if (c < 0x20)
+            {
+                char esc[8];
+                snprintf(esc, sizeof(esc), "\\u%04x", c);
+                out << esc;
+            }
+            else out << *s;
+        }
+        out << '"';
+    }
+
+    const uint64_t m_id;
+    const uint64_t m_epochNs;
+    std::atomic<bool> m_enabled{ false };
+    std::mutex m_mutex;
+    std::vector<std::unique_ptr<ThreadRing>> m_rings;
+    std::set<std::string, std::less<>> m_strings;
+};
+
+// Records one complete ("X") event spanning the enclosing scope
+class TraceScope
+{
+public:
+    explicit TraceScope(const char* name, TraceRecorder& recorder = TraceRecorder::Get())
+        : m_recorder(recorder), m_name(name)
+    {
+        if (m_recorder.IsEnabled()) m_start = TraceRecorder::NowNs();
+    }
+
+    TraceScope(const char* name, std::string_view detail, TraceRecorder& recorder = TraceRecorder::Get())
+        : TraceScope(name, recorder)
+    {
+        if (m_start) m_detail = m_recorder.Intern(detail);
+    }
+
+    // 'detail' must outlive the recorder: a literal, Intern() or TraceInternCache
+    TraceScope(const char* name, const char* detail, TraceRecorder& recorder = TraceRecorder::Get())
+        : TraceScope(name, recorder)
+    {
+        if (m_start) m_detail = detail;
+    }
+
+    ~TraceScope()
+    {
+        if (m_start) m_recorder.Complete(m_name, m_start, TraceRecorder::NowNs(), m_detail);
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    TraceRecorder& m_recorder;
+    const char* m_name;
+    const char* m_detail = nullptr;
+    uint64_t m_start = 0;
+};
+
+// Remembers the interned copies of a call site's recent dynamic strings, so
+// repeats (IPC message types, tab names) skip Intern() and its lock. Not
+// thread-safe: one per call site and thread. Returns null while recording
+// is off, without interning.
+class TraceInternCache
+{
+public:
+    static constexpr size_t MaxEntries = 32;
+
+    explicit TraceInternCache(TraceRecorder& recorder = TraceRecorder::Get()) : m_recorder(recorder) {}
+
+    const char* Get(std::string_view s)
+    {
+        if (!m_recorder.IsEnabled()) return nullptr;
+        for (const char* interned : m_entries)
+            if (s == interned) return interned;
+        const char* interned = m_recorder.Intern(s);
+        if (m_entries.size() < MaxEntries) m_entries.push_back(interned);
+        return interned;
+    }
+
+private:
+    TraceRecorder& m_recorder;
+    std::vector<const char*> m_entries;
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(...) TraceScope TRACE_CONCAT(traceScope_, __LINE__)(__VA_ARGS__)
+#define TRACE_INSTANT(name) TraceRecorder::Get().Instant(name)
+#define TRACE_COUNTER(name, value) TraceRecorder::Get().Counter(name, static_cast<int64_t>(value))
@@ -87,6 +87,14 @@ void WindowManager::SetPosition(int x, int y)
         SetWindowPos(m_hwnd, nullptr, x, y, 0, 0, SWP_NOSIZE | SWP_NOZORDER | SWP_NOACTIVATE);
 }
 
+void WindowManager::SetBounds(int x, int y, int w, int h)
+{
+    m_originX = x;
+    m_originY = y;
+    if (m_hwnd)
+        SetWindowPos(m_hwnd, nullptr, x, y, w, h, SWP_NOZORDER | SWP_NOACTIVATE);
+}
+
 void WindowManager::SetPanelRect(int x, int y, int w, int h)
 {
     m_panelRect = { x, y, w, h };
@@ -160,6 +168,11 @@ LRESULT CALLBACK WindowManager::WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPAR
 {
     Rml::Context* ctx = s_instance ? s_instance->m_rmlContext : nullptr;
 
+    // Any input forwarded to RmlUi may change hover/focus state
+    if (ctx && s_instance && ((msg >= WM_MOUSEFIRST && msg <= WM_MOUSELAST) ||
+                              (msg >= WM_KEYFIRST && msg <= WM_KEYLAST) || msg == WM_MOUSELEAVE))
+        s_instance->m_inputSinceFrame = true;
+
     if (ctx)
     {
         switch (msg)
@@ -186,8 +199,8 @@ LRESULT CALLBACK WindowManager::WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPAR
             return 0;
         case WM_MOUSEMOVE:
             ctx->ProcessMouseMove(
-                static_cast<int>((short)LOWORD(lParam)),
-                static_cast<int>((short)HIWORD(lParam)),
+                static_cast<int>((short)LOWORD(lParam)) + s_instance->m_originX,
+                static_cast<int>((short)HIWORD(lParam)) + s_instance->m_originY,
                 GetKeyModifierState());
             return 0;
         case WM_MOUSEWHEEL:
@@ -15,13 +15,20 @@ public:
     void Shutdown();
 
     HWND GetHwnd() const { return m_hwnd; }
-    int  GetWidth() const { return m_width; }
+    int  GetWidth() const { return m_width; }   // screen size: the UI's coordinate space
     int  GetHeight() const { return m_height; }
 
     void SetVisible(bool visible);
     void SetPosition(int x, int y);
+
+    // Moves and sizes the window over part of the screen (the UI keeps
+    // screen coordinates; mouse input is translated back to them)
+    void SetBounds(int x, int y, int w, int h);
     bool ProcessMessages(); // Returns false if WM_QUIT received
 
+    // True (once) if input was forwarded to RmlUi since the last call
+    bool ConsumeInputEvent() { bool v = m_inputSinceFrame; m_inputSinceFrame = false; return v; }
+
     // Set the region where the overlay panel is drawn (for hit testing)
     void SetPanelRect(int x, int y, int w, int h);
 
@@ -44,12 +51,15 @@ private:
     HWND m_hwnd = nullptr;
     int  m_width = 340;
     int  m_height = 500;
+    int  m_originX = 0;   // window position on the screen (SetBounds)
+    int  m_originY = 0;
     bool m_visible = false;
 
     // Panel rect for click-through hit testing
     OverlayRect m_panelRect = {};
     bool m_panelVisible = false;
     bool m_isClickThrough = true; // Current WS_EX_TRANSPARENT state
+    bool m_inputSinceFrame = false;
 
     // RmlUi context for input and hover detection
     Rml::Context* m_rmlContext = nullptr;
@@ -0,0 +1,84 @@
+# Generates OverlayAssetData.h: the overlay document with the theme RCSS
+# already substituted for its __THEME__ placeholder, plus one fragment per
+# tab pane, each as a constexpr byte array. Emitted as brace lists rather
+# than string literals so MSVC's 16 KB per-literal limit does not apply.
+#
+# Usage: cmake -DDOCUMENT=<rml> -DTHEME=<rcss> -DTAB_DIR=<dir> -DTABS=<a,b,..>
+#              -DOUTPUT=<header> -P EmbedOverlayAssets.cmake
+# Tab fragments are read from <TAB_DIR>/<name>.rml, in TABS order.
+
+foreach(var DOCUMENT THEME TAB_DIR TABS OUTPUT)
+    if(NOT DEFINED ${var})
+        message(FATAL_ERROR "EmbedOverlayAssets: ${var} is not set")
+    endif()
+endforeach()
+
+# Sets <outBytes> to a NUL-terminated brace-list body (16 bytes per line)
+# and <outSize> to the byte count of <text>
+function(to_byte_list text outBytes outSize)
+    # Round-trip through a file to get the bytes as hex
+    set(staged "${OUTPUT}.staged")
+    file(WRITE "${staged}" "${text}")
+    file(READ "${staged}" hex HEX)
+    file(REMOVE "${staged}")
+    string(LENGTH "${hex}" hexLength)
+    math(EXPR size "${hexLength} / 2")
+
+    string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1," bytes "${hex}")
+    string(REPEAT "0x[0-9a-f][0-9a-f]," 16 row)
+    string(REGEX REPLACE "(${row})" "\\1\n    " bytes "${bytes}")
+    set(${outBytes} "${bytes}0x00" PARENT_SCOPE)
+    set(${outSize} ${size} PARENT_SCOPE)
+endfunction()
+
+file(READ "${DOCUMENT}" rml)
+file(READ "${THEME}" rcss)
+string(FIND "${rml}" "__THEME__" placeholder)
+if(placeholder EQUAL -1)
+    message(FATAL_ERROR "EmbedOverlayAssets: ${DOCUMENT} has no __THEME__ placeholder")
+endif()
+string(REPLACE "__THEME__" "${rcss}" rml "${rml}")
+to_byte_list("${rml}" documentBytes documentSize)
+
+string(REPLACE "," ";" tabList "${TABS}")
+set(tabArrays "")
+set(tabTable "")
+foreach(tab IN LISTS tabList)
+    file(READ "${TAB_DIR}/${tab}.rml" fragment)
+    to_byte_list("${fragment}" tabBytes tabSize)
+    string(APPEND tabArrays "
+    inline constexpr unsigned char Tab_${tab}[${tabSize} + 1] = {
+    ${tabBytes}
+    };
+")
+    string(APPEND tabTable "        { \"${tab}\", Tab_${tab}, ${tabSize} },\n")
+endforeach()
+
+get_filename_component(documentName "${DOCUMENT}" NAME)
+get_filename_component(themeName "${THEME}" NAME)
+set(content "#pragma once
+#include <cstddef>
+
+// Generated by cmake/EmbedOverlayAssets.cmake from assets/${documentName},
+// assets/${themeName} and assets/tabs/*.rml. Do not edit.
+
+namespace OverlayAssetData
+{
+    inline constexpr size_t DocumentSize = ${documentSize};
+    inline constexpr unsigned char Document[DocumentSize + 1] = {
+    ${documentBytes}
+    };
+${tabArrays}
+    struct Fragment
+    {
+        const char* name;
+        const unsigned char* data;
+        size_t size;
+    };
+
+    inline constexpr Fragment Tabs[] = {
+${tabTable}    };
+}
+")
+
+file(WRITE "${OUTPUT}" "${content}")
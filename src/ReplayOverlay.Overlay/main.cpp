@@ -1,41 +1,44 @@
 #include "OverlayApp.h"
+#include "Logger.h"
 #include <string>
-#include <fstream>
-#include <ctime>
 
 static void CrashLog(const char* msg)
+{
+    Logger::Get().Write(LogLevel::Info, "main", msg);
+}
+
+// Log file: %LOCALAPPDATA%\ReplayOverlay\overlay_crash.log (rotated at 1 MB)
+static void StartLogging()
 {
     char path[MAX_PATH];
-    if (GetEnvironmentVariableA("LOCALAPPDATA", path, MAX_PATH) > 0)
-    {
-        std::string dirPath = std::string(path) + "\\ReplayOverlay";
-        CreateDirectoryA(dirPath.c_str(), nullptr); // Ensure directory exists (no-op if already present)
-        std::string logPath = dirPath + "\\overlay_crash.log";
-        std::ofstream f(logPath, std::ios::app);
-        if (f.is_open())
-        {
-            time_t t = time(nullptr);
-            char timeBuf[64];
-            ctime_s(timeBuf, sizeof(timeBuf), &t);
-            timeBuf[strlen(timeBuf) - 1] = '\0'; // remove newline
-            f << "[" << timeBuf << "] " << msg << std::endl;
-        }
-    }
+    if (GetEnvironmentVariableA("LOCALAPPDATA", path, MAX_PATH) == 0)
+        return;
+    std::string dirPath = std::string(path) + "\\ReplayOverlay";
+    CreateDirectoryA(dirPath.c_str(), nullptr); // Ensure directory exists (no-op if already present)
+
+    Logger::Options options;
+    options.path = dirPath + "\\overlay_crash.log";
+#ifdef _DEBUG
+    options.minLevel = LogLevel::Debug;
+#endif
+    Logger::Get().Start(options);
 }
 
 static LONG WINAPI CrashHandler(EXCEPTION_POINTERS* ep)
 {
-    char buf[256];
-    snprintf(buf, sizeof(buf), "CRASH: code=0x%08X addr=%p",
+    LOG_ERROR("main", "CRASH: code=0x%08X addr=%p",
         ep->ExceptionRecord->ExceptionCode,
         ep->ExceptionRecord->ExceptionAddress);
-    CrashLog(buf);
+    Logger::Get().Flush(500); // The writer thread still runs; give it a moment
     return EXCEPTION_EXECUTE_HANDLER;
 }
 
 int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR lpCmdLine, int)
 {
+    StartupTimeline::Get().Start();
     SetUnhandledExceptionFilter(CrashHandler);
+    TraceRecorder::SetThreadName("main");
+    StartLogging();
     CrashLog("Overlay starting");
 
     // Parse command line for --pipe <name>
@@ -59,25 +62,27 @@ int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR lpCmdLine, int)
     if (!app.Init(pipeName))
     {
         CrashLog("Init failed");
+        Logger::Get().Stop();
         return 1;
     }
     CrashLog("Init complete, entering main loop");
 
-    // Main loop - renders at VSync rate (~60fps)
+    // Main loop - renders at VSync rate (~60fps) while the panel is open;
+    // otherwise sleeps until input, IPC traffic or an animation step
     int frameCount = 0;
     while (app.Tick())
     {
+        app.WaitForWork();
         frameCount++;
         if (frameCount == 1 || frameCount == 10 || frameCount == 60)
         {
-            char buf[64];
-            snprintf(buf, sizeof(buf), "Frame %d OK", frameCount);
-            CrashLog(buf);
+            LOG_INFO("main", "Frame %d OK", frameCount);
         }
     }
 
     CrashLog("Main loop ended, shutting down");
     app.Shutdown();
     CrashLog("Shutdown complete");
+    Logger::Get().Stop();
     return 0;
 }
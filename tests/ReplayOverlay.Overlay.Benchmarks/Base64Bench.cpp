@@ -0,0 +1,84 @@
+#include "Bench.h"
+#include "Base64.h"
+#include <string>
+#include <vector>
+
+namespace
+{
+    // The decoder PreviewRenderer used before Base64.h: a string::find over
+    // the alphabet per character and a push_back per byte
+    std::vector<unsigned char> FindDecode(const std::string& encoded)
+    {
+        static const std::string chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        std::vector<unsigned char> decoded;
+        decoded.reserve(encoded.size() * 3 / 4);
+        int val = 0, valb = -8;
+        for (unsigned char c : encoded)
+        {
+            if (c == '=' || c == '\n' || c == '\r') continue;
+            auto pos = chars.find(c);
+            if (pos == std::string::npos) continue;
+            val = (val << 6) + static_cast<int>(pos);
+            valb += 6;
+            if (valb >= 0)
+            {
+                decoded.push_back(static_cast<unsigned char>((val >> valb) & 0xFF));
+                valb -= 8;
+            }
+        }
+        return decoded;
+    }
+
+    // Base64 of 'bytes' pseudo-random bytes (PNG data is incompressible too)
+    std::string MakePayload(size_t bytes)
+    {
+        static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        std::string out;
+        uint32_t state = 12345;
+        for (size_t i = 0; i < bytes; i += 3)
+        {
+            state = state * 1664525u + 1013904223u;
+            const uint32_t v = state >> 8;
+            out += alphabet[(v >> 18) & 63];
+            out += alphabet[(v >> 12) & 63];
+            out += alphabet[(v >> 6) & 63];
+            out += alphabet[v & 63];
+        }
+        return out;
+    }
+
+    // One iteration = decoding one preview payload: 4 KB, 64 KB and the
+    // ~300 KB of a 480x270 PNG frame, with every implementation this CPU runs
+    const bool Registered = [] {
+        const std::pair<const char*, size_t> sizes[] = { { "4 KB", 4 << 10 }, { "64 KB", 64 << 10 }, { "300 KB", 300 << 10 } };
+        for (const auto& size : sizes)
+        {
+            const std::string label = std::string("Base64 decode ") + size.first;
+            const size_t bytes = size.second;
+            Bench::Registry().push_back({ label + " (string::find, old)", [bytes](long long iterations) {
+                const std::string payload = MakePayload(bytes);
+                for (long long i = 0; i < iterations; i++)
+                {
+                    std::vector<unsigned char> out = FindDecode(payload);
+                    Bench::DoNotOptimize(out.back());
+                }
+            } });
+            for (Base64::Isa isa : { Base64::Isa::Scalar, Base64::Isa::Ssse3, Base64::Isa::Avx2 })
+            {
+                if (!Base64::Supported(isa)) continue;
+                Bench::Registry().push_back({ label + " (" + Base64::IsaName(isa) + ")", [bytes, isa](long long iterations) {
+                    const std::string payload = MakePayload(bytes);
+                    std::vector<unsigned char> out(Base64::MaxDecodedSize(payload.size()));
+                    for (long long i = 0; i < iterations; i++)
+                    {
+                        size_t written = 0;
+                        Base64::DecodeWith(isa, payload.data(), payload.size(), out.data(), written);
+                        Bench::DoNotOptimize(written);
+                    }
+                    Bench::DoNotOptimize(out.back());
+                } });
+            }
+        }
+        return true;
+    }();
+}
@@ -0,0 +1,101 @@
+#pragma once
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Minimal micro-benchmark harness for the overlay's portable hot paths.
+// Each BENCH body receives an iteration count and must perform exactly that
+// many operations; the harness grows the count until a run takes >= 50 ms and
+// reports nanoseconds per operation (best of 5 runs). Setup a body repeats
+// between operations can be left out of the timing with a Bench::Untimed
+// scope.
+
+namespace Bench
+{
+    using Fn = std::function<void(long long iterations)>;
+
+    struct Case
+    {
+        std::string name;
+        Fn fn;
+    };
+
+    inline std::vector<Case>& Registry()
+    {
+        static std::vector<Case> cases;
+        return cases;
+    }
+
+    struct Registrar
+    {
+        Registrar(const char* name, Fn fn) { Registry().push_back({name, std::move(fn)}); }
+    };
+
+    // Nanoseconds spent in Untimed scopes during the current run
+    inline double& UntimedNs()
+    {
+        static double ns = 0.0;
+        return ns;
+    }
+
+    class Untimed
+    {
+    public:
+        Untimed() : m_start(std::chrono::steady_clock::now()) {}
+        ~Untimed()
+        {
+            UntimedNs() += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - m_start).count();
+        }
+        Untimed(const Untimed&) = delete;
+        Untimed& operator=(const Untimed&) = delete;
+
+    private:
+        std::chrono::steady_clock::time_point m_start;
+    };
+
+    // Keep the optimizer from discarding a computed value
+    template <typename T>
+    inline void DoNotOptimize(const T& value)
+    {
+        const volatile char* p = reinterpret_cast<const volatile char*>(&value);
+        (void)*p;
+    }
+
+    inline double Measure(const Fn& fn)
+    {
+        using Clock = std::chrono::steady_clock;
+        long long iters = 1;
+        double best = 1e300;
+        for (;;)
+        {
+            UntimedNs() = 0.0;
+            auto t0 = Clock::now();
+            fn(iters);
+            double ns = std::chrono::duration<double, std::nano>(Clock::now() - t0).count() - UntimedNs();
+            if (ns >= 50e6 || iters >= (1LL << 40))
+            {
+                best = ns / iters;
+                break;
+            }
+            iters *= 2;
+        }
+        for (int run = 0; run < 4; run++)
+        {
+            UntimedNs() = 0.0;
+            auto t0 = Clock::now();
+            fn(iters);
+            double ns = (std::chrono::duration<double, std::nano>(Clock::now() - t0).count() - UntimedNs()) / iters;
+            if (ns < best) best = ns;
+        }
+        return best;
+    }
+}
+
+#define BENCH_CONCAT_INNER(a, b) a##b
+#define BENCH_CONCAT(a, b) BENCH_CONCAT_INNER(a, b)
+#define BENCH(name) \
+    static void BENCH_CONCAT(BenchFn_, __LINE__)(long long iterations); \
+    static Bench::Registrar BENCH_CONCAT(BenchReg_, __LINE__)(name, BENCH_CONCAT(BenchFn_, __LINE__)); \
+    static void BENCH_CONCAT(BenchFn_, __LINE__)(long long iterations)
@@ -0,0 +1,17 @@
+#include "Bench.h"
+#include <cstring>
+
+// Usage: OverlayBenchmarks [filter]   (runs cases whose name contains filter)
+int main(int argc, char** argv)
+{
+    const char* filter = argc > 1 ? argv[1] : nullptr;
+    for (auto& c : Bench::Registry())
+    {
+        if (filter && c.name.find(filter) == std::string::npos)
+            continue;
+        double ns = Bench::Measure(c.fn);
+        std::printf("%-56s %12.1f ns/op\n", c.name.c_str(), ns);
+        std::fflush(stdout);
+    }
+    return 0;
+}
@@ -0,0 +1,124 @@
+#include "Bench.h"
+#include "ElementCache.h"
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+// One iteration = the direct DOM sync in OverlayApp::Tick for a steady-state
+// frame (REC indicator shown, preview visible, nothing changed). The fake
+// document is a flat list of ~300 elements searched linearly, like
+// GetElementById's depth-first walk; DOM writes cost a string compare and
+// mark the element dirty the way RmlUi's class/property setters do.
+namespace
+{
+    struct FakeElement;
+
+    struct FakeObserver
+    {
+        FakeElement* target = nullptr;
+        FakeElement* get() const { return target; }
+    };
+
+    struct FakeElement
+    {
+        std::string id;
+        std::string lastClass;
+        std::string lastProperty;
+        bool dirty = false;
+
+        FakeObserver GetObserverPtr() { return { this }; }
+        void SetClass(const std::string& name, bool) { lastClass = name; dirty = true; }
+        void SetProperty(const std::string& name, const std::string& value) { lastProperty = name + value; dirty = true; }
+        void RemoveProperty(const std::string& name) { lastProperty = name; dirty = true; }
+    };
+
+    struct FakeDocument
+    {
+        std::vector<std::unique_ptr<FakeElement>> elements;
+        int updates = 0;
+
+        FakeDocument()
+        {
+            for (int i = 0; i < 300; i++)
+            {
+                elements.push_back(std::make_unique<FakeElement>());
+                elements.back()->id = "element-" + std::to_string(i);
+            }
+            const char* ids[] = { "rec-indicator", "preview-img", "preview-placeholder", "panel" };
+            int at = 40;
+            for (const char* id : ids)
+            {
+                elements[at]->id = id;
+                at += 60;
+            }
+        }
+
+        FakeElement* GetElementById(const std::string& id)
+        {
+            for (auto& e : elements)
+                if (e->id == id) return e.get();
+            return nullptr;
+        }
+
+        // Stand-in for the second Context::Update(): walks the document
+        void Update()
+        {
+            for (auto& e : elements) e->dirty = false;
+            updates++;
+        }
+    };
+
+    const char* const PosClasses[] = { "pos-tl", "pos-tc", "pos-tr", "pos-bl", "pos-bc", "pos-br" };
+}
+
+BENCH("Tick DOM sync: lookup + unconditional writes (before)")
+{
+    FakeDocument doc;
+    const std::string pos = "top-right";
+    for (long long i = 0; i < iterations; i++)
+    {
+        auto* rec = doc.GetElementById("rec-indicator");
+        rec->SetClass("hidden", false);
+        for (const char* c : PosClasses) rec->SetClass(c, pos == "top-right");
+
+        auto* img = doc.GetElementById("preview-img");
+        auto* placeholder = doc.GetElementById("preview-placeholder");
+        img->SetProperty("display", "block");
+        placeholder->SetProperty("display", "none");
+        img->SetProperty("height", std::to_string(140) + "dp");
+        img->SetProperty("width", std::to_string(248) + "dp");
+
+        doc.Update();
+        Bench::DoNotOptimize(doc.GetElementById("panel"));
+    }
+}
+
+BENCH("Tick DOM sync: cached handles + write-through (after)")
+{
+    FakeDocument doc;
+    ElementHandle<FakeElement> rec("rec-indicator"), img("preview-img"),
+        placeholder("preview-placeholder"), panel("panel");
+    const std::string pos = "top-right";
+    for (long long i = 0; i < iterations; i++)
+    {
+        bool changed = false;
+        if (rec.Resolve(&doc, 0))
+        {
+            changed |= rec.SetClass("hidden", false);
+            for (const char* c : PosClasses) changed |= rec.SetClass(c, pos == "top-right");
+        }
+        if (img.Resolve(&doc, 0) && placeholder.Resolve(&doc, 0))
+        {
+            char buf[16];
+            changed |= img.SetProperty("display", "block");
+            changed |= placeholder.SetProperty("display", "none");
+            snprintf(buf, sizeof(buf), "%ddp", 140);
+            changed |= img.SetProperty("height", buf);
+            snprintf(buf, sizeof(buf), "%ddp", 248);
+            changed |= img.SetProperty("width", buf);
+        }
+        if (changed) doc.Update();
+        Bench::DoNotOptimize(panel.Resolve(&doc, 0));
+    }
+}
@@ -0,0 +1,35 @@
+#include "Bench.h"
+#include "FrameProfiler.h"
+
+// Instrumentation overhead: one iteration = one timed scope around an empty
+// body (two clock reads + histogram record). Must stay well under 1 us.
+BENCH("ScopedPhase empty scope")
+{
+    FrameProfiler p;
+    for (long long i = 0; i < iterations; i++)
+    {
+        ScopedPhase scope(p, FramePhase::DomSync);
+    }
+    Bench::DoNotOptimize(p.Summarize(FramePhase::DomSync).count);
+}
+
+BENCH("FrameProfiler::Record")
+{
+    FrameProfiler p;
+    uint64_t v = 12345;
+    for (long long i = 0; i < iterations; i++)
+    {
+        p.Record(FramePhase::Update, v);
+        v = v * 6364136223846793005ull + 1442695040888963407ull;
+        v >>= 40;
+    }
+    Bench::DoNotOptimize(p.Summarize(FramePhase::Update).count);
+}
+
+BENCH("FrameProfiler::NowNs")
+{
+    uint64_t sum = 0;
+    for (long long i = 0; i < iterations; i++)
+        sum += FrameProfiler::NowNs();
+    Bench::DoNotOptimize(sum);
+}
@@ -0,0 +1,76 @@
+#include "Bench.h"
+#include "GeometryArena.h"
+#include "GeometryBatcher.h"
+#include <vector>
+
+namespace
+{
+    // A stats refresh: 64 text runs of 4-40 glyphs recompiled
+    constexpr int Meshes = 64;
+
+    int GlyphsFor(int mesh) { return 4 + (mesh * 7) % 37; }
+
+    struct HeapMesh
+    {
+        std::vector<BatchVertex> vertices;
+        std::vector<int> indices;
+    };
+}
+
+// One iteration = releasing and recompiling 64 text meshes
+BENCH("GeometryArena churn 64 text meshes")
+{
+    std::vector<BatchVertex> verts(40 * 4);
+    std::vector<int> idx(40 * 6);
+    GeometryArena<BatchVertex> arena;
+    std::vector<GeometryArena<BatchVertex>::Mesh> meshes(Meshes);
+    for (int m = 0; m < Meshes; m++)
+        meshes[m] = arena.Allocate(verts.data(), GlyphsFor(m) * 4, idx.data(), GlyphsFor(m) * 6);
+
+    for (long long i = 0; i < iterations; i++)
+    {
+        for (int m = 0; m < Meshes; m++)
+        {
+            const int glyphs = GlyphsFor(m + static_cast<int>(i & 3));
+            arena.Free(meshes[m]);
+            meshes[m] = arena.Allocate(verts.data(), glyphs * 4, idx.data(), glyphs * 6);
+        }
+    }
+    Bench::DoNotOptimize(meshes[0]);
+}
+
+// Baseline: what CompileGeometry did before, two vectors per mesh
+BENCH("std::vector churn 64 text meshes")
+{
+    std::vector<BatchVertex> verts(40 * 4);
+    std::vector<int> idx(40 * 6);
+    std::vector<HeapMesh> meshes(Meshes);
+    for (long long i = 0; i < iterations; i++)
+    {
+        for (int m = 0; m < Meshes; m++)
+        {
+            const int glyphs = GlyphsFor(m + static_cast<int>(i & 3));
+            HeapMesh mesh;
+            mesh.vertices.assign(verts.begin(), verts.begin() + glyphs * 4);
+            mesh.indices.assign(idx.begin(), idx.begin() + glyphs * 6);
+            meshes[m] = std::move(mesh);
+        }
+    }
+    Bench::DoNotOptimize(meshes[0]);
+}
+
+// Allocator bookkeeping alone (no copies): one free + one allocate
+BENCH("ArenaAllocator free+allocate")
+{
+    ArenaAllocator arena(16 * 1024);
+    std::vector<ArenaAllocator::Allocation> live(Meshes);
+    for (int m = 0; m < Meshes; m++)
+        live[m] = arena.Allocate(GlyphsFor(m) * 4);
+    for (long long i = 0; i < iterations; i++)
+    {
+        const int m = static_cast<int>(i % Meshes);
+        arena.Free(live[m]);
+        live[m] = arena.Allocate(GlyphsFor(m + static_cast<int>(i & 3)) * 4);
+    }
+    Bench::DoNotOptimize(live[0]);
+}
@@ -0,0 +1,61 @@
+#include "Bench.h"
+#include "GeometryBatcher.h"
+#include <vector>
+
+namespace
+{
+    struct NullBackend
+    {
+        size_t draws = 0;
+        bool Upload(const BatchVertex*, size_t, const uint32_t*, size_t) { return true; }
+        void Draw(const GeometryBatcher::Batch&, const float*) { draws++; }
+    };
+
+    std::vector<BatchVertex> MakeVertices(size_t n)
+    {
+        std::vector<BatchVertex> v(n);
+        for (size_t i = 0; i < n; i++)
+            v[i] = { static_cast<float>(i % 37), static_cast<float>(i % 23), 0xFFFFFFFFu, 0.5f, 0.5f };
+        return v;
+    }
+}
+
+// One iteration = translating one 1024-vertex run (a long text block)
+BENCH("GeometryBatcher::BakeTranslation 1024 vertices (SIMD)")
+{
+    auto src = MakeVertices(1024);
+    std::vector<BatchVertex> dst(src.size());
+    for (long long i = 0; i < iterations; i++)
+    {
+        GeometryBatcher::BakeTranslation(src.data(), dst.data(), src.size(), static_cast<float>(i & 7), 3.0f);
+        Bench::DoNotOptimize(dst[static_cast<size_t>(i) & 1023]);
+    }
+}
+
+BENCH("GeometryBatcher::BakeTranslation 1024 vertices (scalar)")
+{
+    auto src = MakeVertices(1024);
+    std::vector<BatchVertex> dst(src.size());
+    for (long long i = 0; i < iterations; i++)
+    {
+        GeometryBatcher::BakeTranslationScalar(src.data(), dst.data(), src.size(), static_cast<float>(i & 7), 3.0f);
+        Bench::DoNotOptimize(dst[static_cast<size_t>(i) & 1023]);
+    }
+}
+
+// One iteration = one panel frame: 400 quads (boxes, icons) alternating
+// between untextured and the glyph atlas every 8 geometries
+BENCH("GeometryBatcher frame 400 quads")
+{
+    auto quad = MakeVertices(4);
+    const int idx[6] = { 0, 1, 2, 0, 2, 3 };
+    GeometryBatcher batcher;
+    NullBackend backend;
+    for (long long i = 0; i < iterations; i++)
+    {
+        for (int q = 0; q < 400; q++)
+            batcher.Add(quad.data(), 4, idx, 6, q * 2.0f, q * 0.5f, (q / 8) & 1 ? 7u : 0u);
+        batcher.Flush(backend);
+    }
+    Bench::DoNotOptimize(backend.draws);
+}
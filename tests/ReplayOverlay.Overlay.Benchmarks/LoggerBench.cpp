@@ -0,0 +1,98 @@
+#include "Bench.h"
+#include "Logger.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+// Per-call cost of logging on the calling (render) thread.
+namespace
+{
+    std::string BenchLogPath(const char* name)
+    {
+        return (std::filesystem::temp_directory_path() / name).string();
+    }
+}
+
+// Queue a formatted record: the calling thread's cost only. The ring never
+// fills, and the writer drains it in untimed Flush()es between chunks (in
+// use it sleeps until a burst arrives and lingers while it is written).
+BENCH("Logger::Writef")
+{
+    constexpr long long Chunk = 4096;
+    std::string path = BenchLogPath("overlay_bench_async.log");
+    std::remove(path.c_str());
+    Logger log(4 * Chunk);
+    Logger::Options opts;
+    opts.path = path;
+    opts.maxFileBytes = 64 * 1024 * 1024;
+    log.Start(opts);
+    for (long long i = 0; i < iterations; i++)
+    {
+        log.Writef(LogLevel::Warn, "RmlUi", "Failed to load '%s' (%lld)", "font.ttf", i);
+        if (i % Chunk == Chunk - 1)
+        {
+            Bench::Untimed untimed;
+            log.Flush();
+        }
+    }
+    {
+        Bench::Untimed untimed;
+        log.Stop();
+        std::remove(path.c_str());
+        for (int r = 1; r <= 3; r++) std::remove((path + "." + std::to_string(r)).c_str());
+    }
+    Bench::DoNotOptimize(log.Dropped());
+}
+
+// A multi-line diagnostic dump (binding profile) spanning several records
+BENCH("Logger::Write 1.5 KB message")
+{
+    constexpr long long Chunk = 512;
+    std::string path = BenchLogPath("overlay_bench_long.log");
+    std::remove(path.c_str());
+    const std::string message(1536, 'x');
+    Logger log(16 * Chunk);
+    Logger::Options opts;
+    opts.path = path;
+    opts.maxFileBytes = 64 * 1024 * 1024;
+    log.Start(opts);
+    for (long long i = 0; i < iterations; i++)
+    {
+        log.Write(LogLevel::Info, "IPC", message);
+        if (i % Chunk == Chunk - 1)
+        {
+            Bench::Untimed untimed;
+            log.Flush();
+        }
+    }
+    {
+        Bench::Untimed untimed;
+        log.Stop();
+        std::remove(path.c_str());
+        for (int r = 1; r <= 3; r++) std::remove((path + "." + std::to_string(r)).c_str());
+    }
+}
+
+BENCH("Logger::Writef below min level")
+{
+    Logger log(16);
+    int written = 0;
+    for (long long i = 0; i < iterations; i++)
+        written += log.Writef(LogLevel::Debug, "RmlUi", "value %lld", i);
+    Bench::DoNotOptimize(written);
+}
+
+// Reference: the old per-line helpers (open, append one line, close)
+BENCH("ofstream open/append/close per line (reference)")
+{
+    std::string path = BenchLogPath("overlay_bench_sync.log");
+    std::remove(path.c_str());
+    for (long long i = 0; i < iterations; i++)
+    {
+        std::ofstream f(path, std::ios::app);
+        if (f.is_open())
+            f << "[WARN] Failed to load 'font.ttf' (" << i << ")" << std::endl;
+    }
+    std::remove(path.c_str());
+}
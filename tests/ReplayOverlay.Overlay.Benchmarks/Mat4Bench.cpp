@@ -0,0 +1,50 @@
+#include "Bench.h"
+#include "Mat4.h"
+#include <cmath>
+#include <vector>
+
+namespace
+{
+    // 64 rotate+translate transforms, like a panel of animated elements
+    std::vector<float> MakeTransforms()
+    {
+        std::vector<float> m(64 * 16, 0.0f);
+        for (int t = 0; t < 64; t++)
+        {
+            float* d = &m[t * 16];
+            float c = std::cos(t * 0.1f), s = std::sin(t * 0.1f);
+            d[0] = c; d[1] = s; d[4] = -s; d[5] = c; d[10] = 1.0f;
+            d[12] = t * 10.0f; d[13] = t * 5.0f; d[15] = 1.0f;
+        }
+        return m;
+    }
+}
+
+// One iteration = combining the projection with one RmlUi transform
+BENCH("Mat4::Multiply (SIMD)")
+{
+    float ortho[16];
+    Mat4::Ortho(ortho, 1920.0f, 1080.0f);
+    auto transforms = MakeTransforms();
+    std::vector<float> out(transforms.size());
+    for (long long i = 0; i < iterations; i++)
+    {
+        size_t t = static_cast<size_t>(i & 63) * 16;
+        Mat4::Multiply(ortho, &transforms[t], &out[t]);
+    }
+    Bench::DoNotOptimize(out[13]);
+}
+
+BENCH("Mat4::Multiply (scalar)")
+{
+    float ortho[16];
+    Mat4::Ortho(ortho, 1920.0f, 1080.0f);
+    auto transforms = MakeTransforms();
+    std::vector<float> out(transforms.size());
+    for (long long i = 0; i < iterations; i++)
+    {
+        size_t t = static_cast<size_t>(i & 63) * 16;
+        Mat4::MultiplyScalar(ortho, &transforms[t], &out[t]);
+    }
+    Bench::DoNotOptimize(out[13]);
+}
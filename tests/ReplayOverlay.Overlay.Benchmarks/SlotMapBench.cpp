@@ -0,0 +1,70 @@
+#include "Bench.h"
+#include "SlotMap.h"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    // A frame's render pass: 400 geometries drawn with one of 40 textures
+    constexpr int Geometries = 400;
+    constexpr int Textures = 40;
+
+    struct Geometry { uint32_t vertexCount; uint32_t indexCount; };
+    struct Texture { void* srv; size_t bytes; };
+}
+
+// One iteration = 400 RenderGeometry calls (geometry + texture lookup each)
+BENCH("SlotMap render pass 400 lookups")
+{
+    SlotMap<Geometry> geometries;
+    SlotMap<Texture> textures;
+    std::vector<uint64_t> geo, tex;
+    // Churn first so slots are reused, as after some UI updates
+    for (int i = 0; i < Geometries * 2; i++) geo.push_back(geometries.Insert({ 4, 6 }));
+    for (int i = 0; i < Geometries; i++) geometries.Erase(geo[i * 2]);
+    std::vector<uint64_t> live;
+    for (int i = 0; i < Geometries; i++) live.push_back(geo[i * 2 + 1]);
+    for (int i = 0; i < Textures; i++) tex.push_back(textures.Insert({ nullptr, 4096 }));
+
+    for (long long i = 0; i < iterations; i++)
+    {
+        uint64_t sum = 0;
+        for (int g = 0; g < Geometries; g++)
+        {
+            if (const Geometry* gp = geometries.Get(live[g])) sum += gp->indexCount;
+            if (const Texture* tp = textures.Get(tex[g % Textures])) sum += tp->bytes;
+        }
+        Bench::DoNotOptimize(sum);
+    }
+}
+
+// Baseline: the unordered_map<uintptr_t, ...> the render interface used
+BENCH("unordered_map render pass 400 lookups")
+{
+    std::unordered_map<uintptr_t, Geometry> geometries;
+    std::unordered_map<uintptr_t, Texture> textures;
+    uintptr_t next = 1;
+    std::vector<uintptr_t> live, tex;
+    for (int i = 0; i < Geometries * 2; i++)
+    {
+        geometries[next] = { 4, 6 };
+        if (i & 1) live.push_back(next);
+        else geometries.erase(next);
+        next++;
+    }
+    for (int i = 0; i < Textures; i++) { textures[next] = { nullptr, 4096 }; tex.push_back(next++); }
+
+    for (long long i = 0; i < iterations; i++)
+    {
+        uint64_t sum = 0;
+        for (int g = 0; g < Geometries; g++)
+        {
+            auto gi = geometries.find(live[g]);
+            if (gi != geometries.end()) sum += gi->second.indexCount;
+            auto ti = textures.find(tex[g % Textures]);
+            if (ti != textures.end()) sum += ti->second.bytes;
+        }
+        Bench::DoNotOptimize(sum);
+    }
+}
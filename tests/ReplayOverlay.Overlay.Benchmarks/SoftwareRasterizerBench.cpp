@@ -0,0 +1,72 @@
+#include "Bench.h"
+#include "SoftwareRasterizer.h"
+#include <vector>
+
+namespace
+{
+    void AddQuad(GeometryBatcher& batcher, float x, float y, float w, float h, uint32_t colour, uintptr_t texture)
+    {
+        const BatchVertex v[4] = {
+            { 0.0f, 0.0f, colour, 0.0f, 0.0f }, { w, 0.0f, colour, 1.0f, 0.0f },
+            { w, h, colour, 1.0f, 1.0f }, { 0.0f, h, colour, 0.0f, 1.0f } };
+        const int i[6] = { 0, 1, 2, 0, 2, 3 };
+        batcher.Add(v, 4, i, 6, x, y, texture);
+    }
+
+    // A panel-like frame on a 1280x720 target: translucent backdrop, 40 rows
+    // of boxes and 24 glyph quads each, and a 480x270 textured preview
+    RenderCommandList MakeFrame()
+    {
+        GeometryBatcher batcher;
+        RenderCommandList frame;
+        AddQuad(batcher, 780.0f, 40.0f, 480.0f, 640.0f, 0xE0201A18u, 0);
+        AddQuad(batcher, 780.0f, 60.0f, 480.0f, 270.0f, 0xFFFFFFFFu, 2);
+        for (int row = 0; row < 40; row++)
+        {
+            const float y = 340.0f + row * 8.5f;
+            AddQuad(batcher, 790.0f, y, 460.0f, 8.0f, row & 1 ? 0x40FFFFFFu : 0x20FFFFFFu, 0);
+            for (int g = 0; g < 24; g++)
+                AddQuad(batcher, 800.0f + g * 7.0f, y + 1.0f, 6.0f, 7.0f, 0xFFFFFFFFu, 1);
+        }
+        batcher.Flush(frame);
+        return frame;
+    }
+
+    SoftwareRasterizer::Image MakeImage(int w, int h)
+    {
+        SoftwareRasterizer::Image image;
+        image.width = w;
+        image.height = h;
+        image.texels.resize(static_cast<size_t>(w) * h);
+        for (size_t i = 0; i < image.texels.size(); i++)
+            image.texels[i] = (i * 2654435761u) | 0xFF000000u;
+        return image;
+    }
+
+    void RunFrames(unsigned threads, long long iterations)
+    {
+        const RenderCommandList frame = MakeFrame();
+        const SoftwareRasterizer::Image glyphs = MakeImage(64, 64);
+        const SoftwareRasterizer::Image preview = MakeImage(480, 270);
+        SoftwareRasterizer raster;
+        raster.Resize(1280, 720);
+        raster.SetThreads(threads);
+        raster.SetTextureLookup([&](uintptr_t handle) { return handle == 1 ? &glyphs : &preview; });
+        for (long long i = 0; i < iterations; i++)
+        {
+            raster.Render(frame);
+            Bench::DoNotOptimize(raster.Pixels()[static_cast<size_t>(i) & 1023]);
+        }
+    }
+}
+
+// One iteration = one 1280x720 UI frame (~1000 quads)
+BENCH("SoftwareRasterizer 1280x720 UI frame (1 thread)")
+{
+    RunFrames(1, iterations);
+}
+
+BENCH("SoftwareRasterizer 1280x720 UI frame (all cores)")
+{
+    RunFrames(0, iterations);
+}
@@ -0,0 +1,46 @@
+#include "Bench.h"
+#include "StatsHistory.h"
+#include <algorithm>
+#include <deque>
+#include <memory>
+
+// Push cost must stay flat as the windows grow: every window is fully
+// populated (1 Hz samples well past the long window) before timing starts.
+static void RunPush(long long iterations, double shortWindowS, double longWindowS)
+{
+    auto h = std::make_unique<StatsHistory>(shortWindowS, longWindowS);
+    float sample[StatsHistory::MetricCount] = { 60.0f, 20.0f, 900.0f, 4.0f, 0.0f, 0.0f };
+    double t = 0.0;
+    for (int i = 0; i < StatsHistory::Capacity * 2; i++, t += 1.0)
+        h->Push(t, sample);
+
+    for (long long i = 0; i < iterations; i++, t += 1.0)
+    {
+        sample[0] = static_cast<float>(40 + (i * 7919) % 40);
+        h->Push(t, sample);
+    }
+    Bench::DoNotOptimize(h->Sequence());
+}
+
+BENCH("StatsHistory::Push window 10s/60s") { RunPush(iterations, 10.0, 60.0); }
+BENCH("StatsHistory::Push window 60s/600s") { RunPush(iterations, 60.0, 600.0); }
+BENCH("StatsHistory::Push window 600s/1000s") { RunPush(iterations, 600.0, 1000.0); }
+
+// Reference: recomputing min/max/mean by scanning the window on every
+// sample grows linearly with window length.
+static void RunNaive(long long iterations, size_t window)
+{
+    std::deque<float> samples(window, 60.0f);
+    for (long long i = 0; i < iterations; i++)
+    {
+        samples.pop_front();
+        samples.push_back(static_cast<float>(40 + (i * 7919) % 40));
+        float mn = samples.front(), mx = mn;
+        double sum = 0.0;
+        for (float v : samples) { mn = std::min(mn, v); mx = std::max(mx, v); sum += v; }
+        Bench::DoNotOptimize(mn + mx + static_cast<float>(sum));
+    }
+}
+
+BENCH("Naive rescan window 60") { RunNaive(iterations, 60); }
+BENCH("Naive rescan window 600") { RunNaive(iterations, 600); }
@@ -0,0 +1,52 @@
+#include "Bench.h"
+#include "TimerWheel.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// One iteration = one 60 Hz frame. N debounce timers stay armed throughout
+// (each is re-armed when it expires), so the wheel's per-frame cost should
+// track the expiry rate rather than N.
+static void RunWheel(long long iterations, int timers)
+{
+    TimerWheel w;
+    std::vector<TimerWheel::Id> ids;
+    for (int i = 0; i < timers; i++)
+    {
+        ids.push_back(w.Create());
+        w.Schedule(ids.back(), 2.0 + (i % 97) * 0.01);
+    }
+    double t = 0.0;
+    int fired = 0;
+    for (long long i = 0; i < iterations; i++)
+    {
+        t += 1.0 / 60.0;
+        fired += w.AdvanceTo(t, [&](TimerWheel::Id id) { w.Schedule(id, 2.0); });
+    }
+    Bench::DoNotOptimize(fired);
+}
+
+BENCH("TimerWheel::AdvanceTo 16 timers") { RunWheel(iterations, 16); }
+BENCH("TimerWheel::AdvanceTo 256 timers") { RunWheel(iterations, 256); }
+BENCH("TimerWheel::AdvanceTo 4096 timers") { RunWheel(iterations, 4096); }
+
+// Reference: the old string-keyed last-change map, checked every frame
+static void RunMapScan(long long iterations, int timers)
+{
+    std::unordered_map<std::string, double> lastChange;
+    for (int i = 0; i < timers; i++)
+        lastChange["source " + std::to_string(i)] = (i % 97) * 0.01;
+    double t = 0.0;
+    int expired = 0;
+    for (long long i = 0; i < iterations; i++)
+    {
+        t += 1.0 / 60.0;
+        for (auto& kv : lastChange)
+            if (t - kv.second >= 2.0) { kv.second = t; expired++; }
+    }
+    Bench::DoNotOptimize(expired);
+}
+
+BENCH("map scan (reference) 16 timers") { RunMapScan(iterations, 16); }
+BENCH("map scan (reference) 256 timers") { RunMapScan(iterations, 256); }
+BENCH("map scan (reference) 4096 timers") { RunMapScan(iterations, 4096); }
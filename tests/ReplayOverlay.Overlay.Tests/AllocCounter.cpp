@@ -0,0 +1,23 @@
+#include "AllocCounter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static thread_local bool s_countAllocs = false;
+static std::atomic<int> s_allocCount{0};
+
+void* operator new(std::size_t size)
+{
+    if (s_countAllocs) s_allocCount++;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) { return operator new(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+AllocScope::AllocScope() { s_allocCount = 0; s_countAllocs = true; }
+AllocScope::~AllocScope() { s_countAllocs = false; }
+int AllocScope::Count() const { return s_allocCount.load(); }
@@ -0,0 +1,12 @@
+#pragma once
+
+// Counts heap allocations made on the current thread inside a scope. The
+// replacement operator new is defined in AllocCounter.cpp, which is linked
+// only into the allocation test executables so the other suites keep the
+// default allocator.
+struct AllocScope
+{
+    AllocScope();
+    ~AllocScope();
+    int Count() const;
+};
@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+#include "Base64.h"
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const Base64::Isa AllIsas[] = { Base64::Isa::Scalar, Base64::Isa::Ssse3, Base64::Isa::Avx2 };
+
+    std::string Encode(const std::vector<unsigned char>& bytes)
+    {
+        static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        std::string out;
+        for (size_t i = 0; i < bytes.size(); i += 3)
+        {
+            const size_t n = std::min<size_t>(3, bytes.size() - i);
+            uint32_t v = bytes[i] << 16;
+            if (n > 1) v |= bytes[i + 1] << 8;
+            if (n > 2) v |= bytes[i + 2];
+            out += alphabet[(v >> 18) & 63];
+            out += alphabet[(v >> 12) & 63];
+            out += n > 1 ? alphabet[(v >> 6) & 63] : '=';
+            out += n > 2 ? alphabet[v & 63] : '=';
+        }
+        return out;
+    }
+
+    // Decodes with one implementation into a buffer one byte larger than
+    // needed, so overruns past MaxDecodedSize() would show
+    bool DecodeWith(Base64::Isa isa, const std::string& in, std::vector<unsigned char>& out)
+    {
+        out.assign(Base64::MaxDecodedSize(in.size()) + 1, 0xCD);
+        size_t written = 0;
+        const bool ok = Base64::DecodeWith(isa, in.data(), in.size(), out.data(), written);
+        out.resize(written);
+        return ok;
+    }
+
+    std::string AsString(const std::vector<unsigned char>& bytes) { return std::string(bytes.begin(), bytes.end()); }
+}
+
+TEST(Base64, DecodesRfc4648Vectors)
+{
+    const std::pair<const char*, const char*> vectors[] = {
+        { "", "" }, { "Zg==", "f" }, { "Zm8=", "fo" }, { "Zm9v", "foo" },
+        { "Zm9vYg==", "foob" }, { "Zm9vYmE=", "fooba" }, { "Zm9vYmFy", "foobar" } };
+    for (Base64::Isa isa : AllIsas)
+    {
+        for (const auto& v : vectors)
+        {
+            std::vector<unsigned char> out;
+            EXPECT_TRUE(DecodeWith(isa, v.first, out)) << Base64::IsaName(isa) << " " << v.first;
+            EXPECT_EQ(AsString(out), v.second) << Base64::IsaName(isa);
+        }
+    }
+}
+
+TEST(Base64, RejectsMalformedInput)
+{
+    const char* invalid[] = {
+        "Zg",        // not a multiple of four
+        "Zm9v\r\nZm", // whitespace
+        "Zm9 Zm9v",
+        "Zm-v",      // URL-safe alphabet
+        "Zg==Zm9v",  // padding before the end
+        "Z===",
+        "Zg=v",
+        "Zh==",      // non-zero bits under the padding
+        "Zm9=",
+    };
+    for (Base64::Isa isa : AllIsas)
+    {
+        for (const char* in : invalid)
+        {
+            std::vector<unsigned char> out;
+            EXPECT_FALSE(DecodeWith(isa, in, out)) << Base64::IsaName(isa) << " '" << in << "'";
+            EXPECT_TRUE(out.empty());
+        }
+    }
+}
+
+TEST(Base64, EveryImplementationMatchesAtEveryLength)
+{
+    // Lengths around the 16- and 32-character blocks and their tails
+    std::mt19937 rng(7);
+    for (size_t n = 0; n < 400; n++)
+    {
+        std::vector<unsigned char> bytes(n);
+        for (auto& b : bytes) b = static_cast<unsigned char>(rng());
+        const std::string encoded = Encode(bytes);
+        for (Base64::Isa isa : AllIsas)
+        {
+            std::vector<unsigned char> out;
+            ASSERT_TRUE(DecodeWith(isa, encoded, out)) << Base64::IsaName(isa) << " n=" << n;
+            ASSERT_EQ(out, bytes) << Base64::IsaName(isa) << " n=" << n;
+        }
+    }
+}
+
+TEST(Base64, BadCharacterIsFoundAnywhere)
+{
+    // Vector blocks, the block tail and the last group all validate
+    std::vector<unsigned char> bytes(150);
+    for (size_t i = 0; i < bytes.size(); i++) bytes[i] = static_cast<unsigned char>(i * 7);
+    const std::string encoded = Encode(bytes);
+    for (const char bad : { '!', '=', '\0', '\x80', '\xFF', ':' })
+    {
+        for (size_t at = 0; at < encoded.size(); at++)
+        {
+            if (bad == '=' && at + 2 >= encoded.size()) continue; // may be valid padding
+            std::string corrupt = encoded;
+            corrupt[at] = bad;
+            for (Base64::Isa isa : AllIsas)
+            {
+                std::vector<unsigned char> out;
+                EXPECT_FALSE(DecodeWith(isa, corrupt, out)) << Base64::IsaName(isa) << " at " << at;
+            }
+        }
+    }
+}
+
+TEST(Base64, DecodesIntoTheCallersBuffer)
+{
+    std::vector<unsigned char> buffer;
+    buffer.reserve(1024);
+    const unsigned char* storage = buffer.data();
+
+    ASSERT_TRUE(Base64::Decode("Zm9vYmFy", buffer));
+    EXPECT_EQ(AsString(buffer), "foobar");
+    ASSERT_TRUE(Base64::Decode("Zg==", buffer));
+    EXPECT_EQ(AsString(buffer), "f");
+    EXPECT_EQ(buffer.data(), storage); // no reallocation
+
+    EXPECT_FALSE(Base64::Decode("Zg", buffer));
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_TRUE(Base64::Supported(Base64::Isa::Scalar));
+    EXPECT_TRUE(Base64::Supported(Base64::BestIsa()));
+}
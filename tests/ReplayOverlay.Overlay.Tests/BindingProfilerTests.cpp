@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include "BindingProfiler.h"
+
+static const nlohmann::json* FindBinding(const nlohmann::json& report, const char* name)
+{
+    for (auto& b : report["bindings"])
+        if (b["name"] == name) return &b;
+    return nullptr;
+}
+
+TEST(BindingProfiler, CountsMarksPerVariable)
+{
+    BindingProfiler p;
+    p.BeginFrame(0.0);
+    p.MarkDirty("notif_alpha");
+    p.MarkDirty("notif_alpha");
+    p.MarkDirty("stat_fps");
+    p.EndFrame(1.0);
+
+    auto r = p.Report();
+    EXPECT_EQ(r["frames"], 1);
+    auto* alpha = FindBinding(r, "notif_alpha");
+    ASSERT_NE(alpha, nullptr);
+    EXPECT_EQ((*alpha)["marks"], 2);
+    EXPECT_EQ((*alpha)["dirty_frames"], 1);
+}
+
+TEST(BindingProfiler, SplitsUpdateCostAcrossDirtyVariables)
+{
+    BindingProfiler p;
+    p.BeginFrame(0.0);
+    p.MarkDirty("a");
+    p.MarkDirty("b");
+    p.EndFrame(4.0);
+    p.BeginFrame(0.016);
+    p.MarkDirty("a");
+    p.EndFrame(1.0);
+
+    auto r = p.Report();
+    EXPECT_DOUBLE_EQ((*FindBinding(r, "a"))["attributed_ms"].get<double>(), 3.0);
+    EXPECT_DOUBLE_EQ((*FindBinding(r, "b"))["attributed_ms"].get<double>(), 2.0);
+    // Sorted by attributed cost
+    EXPECT_EQ(r["bindings"][0]["name"], "a");
+}
+
+TEST(BindingProfiler, IdleFramesTrackedSeparately)
+{
+    BindingProfiler p;
+    p.BeginFrame(0.0);
+    p.EndFrame(0.5);
+    p.BeginFrame(0.1);
+    p.MarkDirty("a");
+    p.EndFrame(2.0);
+
+    auto r = p.Report();
+    EXPECT_EQ(r["idle_frames"], 1);
+    EXPECT_DOUBLE_EQ(r["idle_update_ms_avg"].get<double>(), 0.5);
+    EXPECT_DOUBLE_EQ(r["update_ms_max"].get<double>(), 2.0);
+}
+
+TEST(BindingProfiler, MarksFromSkippedIterationsReachTheNextUpdate)
+{
+    // The loop calls BeginFrame every iteration but renders only some
+    BindingProfiler p;
+    p.BeginFrame(0.0);
+    p.MarkDirty("a");
+    p.BeginFrame(0.1);
+    p.MarkDirty("b");
+    p.BeginFrame(0.2);
+    p.EndFrame(4.0);
+
+    auto r = p.Report();
+    EXPECT_EQ(r["frames"], 1);
+    EXPECT_EQ(r["idle_frames"], 0);
+    EXPECT_DOUBLE_EQ((*FindBinding(r, "a"))["attributed_ms"].get<double>(), 2.0);
+    EXPECT_DOUBLE_EQ((*FindBinding(r, "b"))["attributed_ms"].get<double>(), 2.0);
+    EXPECT_EQ((*FindBinding(r, "a"))["dirty_frames"], 1);
+}
+
+TEST(BindingProfiler, OldBucketsRollOff)
+{
+    BindingProfiler p;
+    p.BeginFrame(0.0);
+    p.MarkDirty("old");
+    p.EndFrame(1.0);
+
+    p.BeginFrame(BindingProfiler::WindowS + 0.5);
+    p.MarkDirty("new");
+    p.EndFrame(1.0);
+
+    auto r = p.Report();
+    EXPECT_EQ(r["frames"], 1);
+    EXPECT_EQ(FindBinding(r, "old"), nullptr);
+    EXPECT_NE(FindBinding(r, "new"), nullptr);
+}
+
+TEST(BindingProfiler, ArrayKindReported)
+{
+    BindingProfiler p;
+    p.SetKind("scenes", BindingProfiler::Kind::Array);
+    p.BeginFrame(0.0);
+    p.MarkDirty("scenes");
+    p.EndFrame(1.0);
+    EXPECT_EQ((*FindBinding(p.Report(), "scenes"))["kind"], "array");
+    EXPECT_NE(BindingProfiler::FormatReport(p.Report()).find("scenes"), std::string::npos);
+}
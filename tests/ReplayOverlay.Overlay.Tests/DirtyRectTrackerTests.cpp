@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include "DirtyRectTracker.h"
+
+namespace
+{
+    using Rect = DirtyRectTracker::Rect;
+
+    void AddQuad(GeometryBatcher& batcher, float x, float y, float w, float h, uintptr_t texture = 0,
+                 uint32_t colour = 0xFFFFFFFFu)
+    {
+        const BatchVertex v[4] = {
+            { 0.0f, 0.0f, colour, 0.0f, 0.0f }, { w, 0.0f, colour, 1.0f, 0.0f },
+            { w, h, colour, 1.0f, 1.0f }, { 0.0f, h, colour, 0.0f, 1.0f } };
+        const int i[6] = { 0, 1, 2, 0, 2, 3 };
+        batcher.Add(v, 4, i, 6, x, y, texture);
+    }
+
+    // A panel: backdrop, a label in the glyph texture, a preview image
+    RenderCommandList Panel(float labelWidth = 40.0f, uint32_t labelColour = 0xFFFFFFFFu)
+    {
+        GeometryBatcher batcher;
+        RenderCommandList frame;
+        AddQuad(batcher, 100.0f, 100.0f, 200.0f, 300.0f);
+        AddQuad(batcher, 110.0f, 110.0f, labelWidth, 10.0f, 1, labelColour);
+        AddQuad(batcher, 110.0f, 200.0f, 160.0f, 90.0f, 2);
+        batcher.Flush(frame);
+        return frame;
+    }
+}
+
+TEST(DirtyRectTracker, RectHelpers)
+{
+    const Rect a = { 0, 0, 10, 10 }, b = { 5, 5, 20, 8 };
+    EXPECT_TRUE(DirtyRectTracker::Union(a, b) == (Rect{ 0, 0, 20, 10 }));
+    EXPECT_TRUE(DirtyRectTracker::Intersect(a, b) == (Rect{ 5, 5, 10, 8 }));
+    EXPECT_TRUE(DirtyRectTracker::Empty(DirtyRectTracker::Intersect(a, { 10, 0, 20, 10 })));
+    EXPECT_TRUE(DirtyRectTracker::Union(Rect{}, b) == b);
+    EXPECT_EQ(DirtyRectTracker::Area(a), 100u);
+}
+
+TEST(DirtyRectTracker, FirstFrameIsFullyDirtyThenNothing)
+{
+    DirtyRectTracker tracker;
+    tracker.Resize(640, 480);
+    EXPECT_TRUE(tracker.Update(Panel()) == (Rect{ 0, 0, 640, 480 }));
+    EXPECT_EQ(tracker.Draws(), 3u);
+    EXPECT_TRUE(DirtyRectTracker::Empty(tracker.Update(Panel())));
+
+    tracker.Invalidate();
+    EXPECT_TRUE(tracker.Update(Panel()) == (Rect{ 0, 0, 640, 480 }));
+}
+
+TEST(DirtyRectTracker, ChangedDrawDirtiesOldAndNewBounds)
+{
+    DirtyRectTracker tracker;
+    tracker.Resize(640, 480);
+    tracker.Update(Panel(40.0f));
+
+    // Label widened: both extents, padded a pixel
+    Rect dirty = tracker.Update(Panel(60.0f));
+    EXPECT_TRUE(dirty == (Rect{ 109, 109, 171, 121 }));
+
+    // Same bounds, different colour: still dirty
+    dirty = tracker.Update(Panel(60.0f, 0xFF00FF00u));
+    EXPECT_TRUE(dirty == (Rect{ 109, 109, 171, 121 }));
+
+    // The backdrop behind it is not redrawn, only where it overlaps
+    EXPECT_TRUE(DirtyRectTracker::Overlaps(tracker.DrawBounds(0), dirty));
+    EXPECT_FALSE(DirtyRectTracker::Overlaps(tracker.DrawBounds(2), dirty));
+}
+
+TEST(DirtyRectTracker, GeometryMovedInTheStreamStillMatches)
+{
+    // A quad merged into the first batch shifts the second batch's indices;
+    // its content is unchanged, so only the first batch is dirty
+    DirtyRectTracker tracker;
+    tracker.Resize(640, 480);
+    GeometryBatcher batcher;
+    RenderCommandList a, b;
+    AddQuad(batcher, 0.0f, 0.0f, 10.0f, 10.0f, 5);
+    AddQuad(batcher, 100.0f, 100.0f, 20.0f, 20.0f);
+    batcher.Flush(a);
+    AddQuad(batcher, 0.0f, 0.0f, 10.0f, 10.0f, 5);
+    AddQuad(batcher, 500.0f, 400.0f, 4.0f, 4.0f, 5); // merges into the first batch
+    AddQuad(batcher, 100.0f, 100.0f, 20.0f, 20.0f);
+    batcher.Flush(b);
+
+    tracker.Update(a);
+    const Rect dirty = tracker.Update(b);
+    EXPECT_TRUE(dirty == (Rect{ 0, 0, 505, 405 }));
+    EXPECT_TRUE(tracker.DrawBounds(1) == (Rect{ 99, 99, 121, 121 }));
+}
+
+TEST(DirtyRectTracker, TextureUpdatesDirtyTheirDraws)
+{
+    DirtyRectTracker tracker;
+    tracker.Resize(640, 480);
+    tracker.Update(Panel());
+
+    RenderCommandList frame = Panel();
+    frame.UpdateTexture(2); // new preview frame
+    EXPECT_TRUE(tracker.Update(frame) == (Rect{ 109, 199, 271, 291 }));
+
+    frame = Panel();
+    frame.UpdateTexture(99); // not drawn
+    EXPECT_TRUE(DirtyRectTracker::Empty(tracker.Update(frame)));
+}
+
+TEST(DirtyRectTracker, BoundsFollowScissorAndTransform)
+{
+    DirtyRectTracker tracker;
+    tracker.Resize(640, 480);
+    GeometryBatcher batcher;
+    RenderCommandList frame;
+    batcher.EnableScissor(true);
+    batcher.SetScissor({ 0, 0, 50, 50 });
+    AddQuad(batcher, 10.0f, 10.0f, 100.0f, 100.0f);
+    batcher.EnableScissor(false);
+    const float scale2[16] = { 2, 0, 0, 0, 0, 2, 0, 0, 0, 0, 1, 0, 30, 0, 0, 1 };
+    batcher.SetTransform(scale2);
+    AddQuad(batcher, 100.0f, 100.0f, 10.0f, 10.0f);
+    batcher.Flush(frame);
+
+    tracker.Update(frame);
+    ASSERT_EQ(tracker.Draws(), 2u);
+    EXPECT_TRUE(tracker.DrawBounds(0) == (Rect{ 9, 9, 50, 50 }));
+    EXPECT_TRUE(tracker.DrawBounds(1) == (Rect{ 229, 199, 251, 221 }));
+}
+
+TEST(DirtyRectTracker, AddedRectsAreClippedToTheTarget)
+{
+    DirtyRectTracker tracker;
+    tracker.Resize(100, 100);
+    tracker.Update(Panel());
+    tracker.AddRect({ 90, 90, 200, 200 });
+    EXPECT_TRUE(tracker.Update(Panel()) == (Rect{ 90, 90, 100, 100 }));
+    EXPECT_TRUE(DirtyRectTracker::Empty(tracker.Update(Panel())));
+}
@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+#include "ElementCache.h"
+#include <map>
+#include <memory>
+#include <string>
+
+namespace
+{
+    // Minimal stand-in for Rml::Element: observer pointers go null when the
+    // element is destroyed, and every DOM write is counted
+    struct FakeElement;
+
+    struct FakeObserver
+    {
+        std::shared_ptr<FakeElement*> target;
+        FakeElement* get() const { return target ? *target : nullptr; }
+    };
+
+    struct FakeElement
+    {
+        std::shared_ptr<FakeElement*> self = std::make_shared<FakeElement*>(this);
+        std::map<std::string, bool> classes;
+        std::map<std::string, std::string> properties;
+        int writes = 0;
+
+        ~FakeElement() { *self = nullptr; }
+        FakeObserver GetObserverPtr() { return { self }; }
+        void SetClass(const std::string& name, bool on) { classes[name] = on; writes++; }
+        void SetProperty(const std::string& name, const std::string& value) { properties[name] = value; writes++; }
+        void RemoveProperty(const std::string& name) { properties.erase(name); writes++; }
+    };
+
+    struct FakeRoot
+    {
+        std::map<std::string, std::unique_ptr<FakeElement>> byId;
+        int lookups = 0;
+
+        FakeElement* GetElementById(const std::string& id)
+        {
+            lookups++;
+            auto it = byId.find(id);
+            return it != byId.end() ? it->second.get() : nullptr;
+        }
+        FakeElement* Add(const std::string& id)
+        {
+            return (byId[id] = std::make_unique<FakeElement>()).get();
+        }
+    };
+}
+
+TEST(ElementCache, ResolvesOncePerGeneration)
+{
+    FakeRoot root;
+    auto* el = root.Add("panel");
+    ElementHandle<FakeElement> h("panel");
+
+    for (int i = 0; i < 100; i++)
+        EXPECT_EQ(h.Resolve(&root, 0), el);
+    EXPECT_EQ(root.lookups, 1);
+
+    EXPECT_EQ(h.Resolve(&root, 1), el);
+    EXPECT_EQ(root.lookups, 2);
+}
+
+TEST(ElementCache, MissingElementIsNotSearchedEveryFrame)
+{
+    FakeRoot root;
+    ElementHandle<FakeElement> h("preview-img");
+    for (int i = 0; i < 10; i++)
+        EXPECT_EQ(h.Resolve(&root, 0), nullptr);
+    EXPECT_EQ(root.lookups, 1);
+
+    // Tab switch creates it and bumps the generation
+    auto* el = root.Add("preview-img");
+    EXPECT_EQ(h.Resolve(&root, 1), el);
+}
+
+TEST(ElementCache, DestroyedElementIsResolvedAgain)
+{
+    FakeRoot root;
+    root.Add("preview-img");
+    ElementHandle<FakeElement> h("preview-img");
+    h.Resolve(&root, 0);
+
+    auto* rebuilt = root.Add("preview-img"); // old element destroyed
+    EXPECT_EQ(h.Resolve(&root, 0), rebuilt);
+    EXPECT_EQ(root.lookups, 2);
+}
+
+TEST(ElementCache, SettersWriteOnlyOnChange)
+{
+    FakeRoot root;
+    auto* el = root.Add("rec-indicator");
+    ElementHandle<FakeElement> h("rec-indicator");
+    h.Resolve(&root, 0);
+
+    EXPECT_TRUE(h.SetClass("hidden", true));
+    EXPECT_FALSE(h.SetClass("hidden", true));
+    EXPECT_TRUE(h.SetClass("hidden", false));
+
+    EXPECT_TRUE(h.SetProperty("width", "120dp"));
+    EXPECT_FALSE(h.SetProperty("width", std::string("120dp")));
+    EXPECT_TRUE(h.SetProperty("width", "121dp"));
+
+    EXPECT_TRUE(h.RemoveProperty("display"));
+    EXPECT_FALSE(h.RemoveProperty("display"));
+    EXPECT_TRUE(h.SetProperty("display", "none"));
+
+    EXPECT_EQ(el->writes, 6);
+    EXPECT_EQ(h.DomWrites(), 6u);
+    EXPECT_FALSE(el->classes["hidden"]);
+    EXPECT_EQ(el->properties["width"], "121dp");
+}
+
+TEST(ElementCache, NewElementForgetsWrittenValues)
+{
+    FakeRoot root;
+    root.Add("preview-img");
+    ElementHandle<FakeElement> h("preview-img");
+    h.Resolve(&root, 0);
+    h.SetProperty("display", "block");
+
+    auto* rebuilt = root.Add("preview-img");
+    h.Resolve(&root, 0);
+    EXPECT_TRUE(h.SetProperty("display", "block"));
+    EXPECT_EQ(rebuilt->properties["display"], "block");
+}
+
+TEST(ElementCache, SettersAreNoOpsWithoutElement)
+{
+    FakeRoot root;
+    ElementHandle<FakeElement> h("panel");
+    h.Resolve(&root, 0);
+    EXPECT_FALSE(h.SetClass("hidden", true));
+    EXPECT_FALSE(h.SetProperty("margin", "0"));
+    EXPECT_EQ(h.DomWrites(), 0u);
+}
+
+TEST(ElementCache, RebindUsesFallbackElement)
+{
+    FakeRoot root;
+    auto* other = root.Add("something-else");
+    ElementHandle<FakeElement> h("panel");
+    EXPECT_EQ(h.Resolve(&root, 0), nullptr);
+    h.Rebind(other);
+    EXPECT_EQ(h.Resolve(&root, 0), other);
+    EXPECT_EQ(root.lookups, 1);
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include "FontWarmup.h"
+#include "MappedFile.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+TEST(FontWarmup, CollectsUtf8AndEntities)
+{
+    std::set<uint32_t> cps;
+    FontWarmup::CollectCodepoints("A\xC3\xA9<span>&#xE7B3;&#169;</span>", cps);
+    EXPECT_TRUE(cps.count('A'));
+    EXPECT_TRUE(cps.count(0xE9));   // e-acute (UTF-8)
+    EXPECT_TRUE(cps.count(0xE7B3)); // icon entity
+    EXPECT_TRUE(cps.count(169));    // decimal entity
+    EXPECT_FALSE(cps.count('#'));   // entity text itself is not collected
+}
+
+TEST(FontWarmup, MalformedEntitiesAreTreatedAsText)
+{
+    std::set<uint32_t> cps;
+    FontWarmup::CollectCodepoints("&#xZZ; &#;", cps);
+    EXPECT_TRUE(cps.count('&'));
+    EXPECT_TRUE(cps.count('Z'));
+}
+
+TEST(FontWarmup, CollectsDistinctDpFontSizes)
+{
+    auto sizes = FontWarmup::CollectFontSizes(
+        "body { font-size: 14dp; } .a { font-size:12dp; } .b { font-size: 14dp; } .c { font-size: 1.5em; }");
+    ASSERT_EQ(sizes.size(), 2u);
+    EXPECT_EQ(sizes[0], 12);
+    EXPECT_EQ(sizes[1], 14);
+}
+
+TEST(FontWarmup, AppendUtf8RoundTrips)
+{
+    for (uint32_t cp : { 0x41u, 0xE9u, 0xE7B3u, 0x1F600u })
+    {
+        std::string s;
+        FontWarmup::AppendUtf8(s, cp);
+        std::set<uint32_t> cps;
+        FontWarmup::CollectCodepoints(s, cps);
+        ASSERT_EQ(cps.size(), 1u);
+        EXPECT_EQ(*cps.begin(), cp);
+    }
+}
+
+TEST(FontWarmup, DocumentCoversSizesWeightsAndIcons)
+{
+    std::set<uint32_t> cps = { 'x', 0xE9, 0xE7B3 };
+    std::string doc = FontWarmup::BuildDocument({ 12, 16 }, cps, "Segoe UI", "Segoe MDL2 Assets");
+
+    EXPECT_NE(doc.find("font-size: 12dp"), std::string::npos);
+    EXPECT_NE(doc.find("font-size: 16dp"), std::string::npos);
+    EXPECT_NE(doc.find("font-family: Segoe MDL2 Assets"), std::string::npos);
+    EXPECT_NE(doc.find("class=\"b\""), std::string::npos);
+    // Markup characters are escaped and braces can't form a binding
+    EXPECT_NE(doc.find("&lt;"), std::string::npos);
+    EXPECT_NE(doc.find("&amp;"), std::string::npos);
+    EXPECT_EQ(doc.find("{{"), std::string::npos);
+
+    std::string icon;
+    FontWarmup::AppendUtf8(icon, 0xE7B3);
+    size_t iconPos = doc.find(icon);
+    ASSERT_NE(iconPos, std::string::npos);
+    EXPECT_LT(doc.rfind("class=\"i\"", iconPos), iconPos);
+}
+
+TEST(MappedFile, MapsWholeFileReadOnly)
+{
+    auto path = (std::filesystem::temp_directory_path() / "overlay_mapped_file_test.bin").string();
+    {
+        std::ofstream f(path, std::ios::binary);
+        f << "glyph data";
+    }
+    MappedFile file;
+    ASSERT_TRUE(file.Open(path));
+    ASSERT_EQ(file.Size(), 10u);
+    EXPECT_EQ(std::string(reinterpret_cast<const char*>(file.Data()), file.Size()), "glyph data");
+
+    MappedFile moved = std::move(file);
+    EXPECT_FALSE(file.IsOpen());
+    EXPECT_TRUE(moved.IsOpen());
+    moved.Close();
+    EXPECT_FALSE(moved.IsOpen());
+    std::remove(path.c_str());
+}
+
+TEST(MappedFile, MissingOrEmptyFilesFail)
+{
+    MappedFile file;
+    EXPECT_FALSE(file.Open("/nonexistent/overlay/font.ttf"));
+
+    auto path = (std::filesystem::temp_directory_path() / "overlay_mapped_empty.bin").string();
+    std::ofstream(path, std::ios::binary).close();
+    EXPECT_FALSE(file.Open(path));
+    std::remove(path.c_str());
+}
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include "FrameGovernor.h"
+
+namespace
+{
+    FrameGovernor::Signals Panel() { FrameGovernor::Signals s; s.panelVisible = true; return s; }
+    FrameGovernor::Signals Indicator() { FrameGovernor::Signals s; s.indicatorVisible = true; return s; }
+}
+
+TEST(FrameGovernor, StartsHidden)
+{
+    FrameGovernor g;
+    EXPECT_EQ(g.Update(0.0, {}), GovernorState::Hidden);
+    EXPECT_DOUBLE_EQ(g.IntervalS(), 0.0);
+    EXPECT_FALSE(g.IsPeriodic());
+}
+
+TEST(FrameGovernor, InputMakesPanelInteractiveThenPassive)
+{
+    FrameGovernor g;
+    g.NoteInput(1.0);
+    EXPECT_EQ(g.Update(1.0, Panel()), GovernorState::Interactive);
+    EXPECT_DOUBLE_EQ(g.IntervalS(), 0.0);
+    EXPECT_TRUE(g.IsPeriodic());
+
+    EXPECT_EQ(g.Update(1.0 + FrameGovernor::InputLingerS * 0.5, Panel()), GovernorState::Interactive);
+    EXPECT_EQ(g.Update(1.0 + FrameGovernor::InputLingerS, Panel()), GovernorState::Passive);
+    EXPECT_DOUBLE_EQ(g.IntervalS(), FrameGovernor::PassiveIntervalS);
+    EXPECT_TRUE(g.IsPeriodic());
+}
+
+TEST(FrameGovernor, InputWhileHiddenDoesNotWake)
+{
+    FrameGovernor g;
+    g.NoteInput(1.0);
+    EXPECT_EQ(g.Update(1.0, {}), GovernorState::Hidden);
+    EXPECT_EQ(g.Update(1.0, Indicator()), GovernorState::Indicator);
+}
+
+TEST(FrameGovernor, AnimationForcesFullRate)
+{
+    FrameGovernor g;
+    FrameGovernor::Signals fading = Indicator();
+    fading.animating = true;
+    EXPECT_EQ(g.Update(0.0, fading), GovernorState::Interactive);
+    EXPECT_EQ(g.Update(0.3, Indicator()), GovernorState::Indicator);
+    EXPECT_DOUBLE_EQ(g.IntervalS(), FrameGovernor::IndicatorIntervalS);
+    EXPECT_FALSE(g.IsPeriodic());
+}
+
+TEST(FrameGovernor, AccountsTimeInEachState)
+{
+    FrameGovernor g;
+    g.Update(0.0, {});         // hidden
+    g.NoteInput(2.0);
+    g.Update(2.0, Panel());    // interactive
+    g.Update(3.0, Panel());    // passive after the linger
+    g.Update(7.0, Indicator());
+    g.Update(8.0, {});
+
+    EXPECT_DOUBLE_EQ(g.TimeInState(GovernorState::Hidden), 2.0);
+    EXPECT_DOUBLE_EQ(g.TimeInState(GovernorState::Interactive), 1.0);
+    EXPECT_DOUBLE_EQ(g.TimeInState(GovernorState::Passive), 4.0);
+    EXPECT_DOUBLE_EQ(g.TimeInState(GovernorState::Indicator), 1.0);
+    EXPECT_EQ(g.Transitions(), 4);
+
+    auto m = g.Metrics();
+    EXPECT_EQ(m["state"], "hidden");
+    EXPECT_DOUBLE_EQ(m["time_in_state_s"]["passive"].get<double>(), 4.0);
+    EXPECT_EQ(m["transitions"], 4);
+}
+
+TEST(FrameGovernor, ReportsTargetAndMeasuredRate)
+{
+    FrameGovernor g;
+    g.Update(0.0, Panel());
+    EXPECT_DOUBLE_EQ(g.Metrics()["target_hz"].get<double>(), 10.0);
+
+    for (int i = 1; i <= 10; i++)
+    {
+        g.NoteFrame();
+        g.Update(i * 0.1, Panel());
+    }
+    EXPECT_NEAR(g.MeasuredHz(), 10.0, 1e-9);
+
+    g.Update(1.0, Indicator());
+    EXPECT_DOUBLE_EQ(g.Metrics()["target_hz"].get<double>(), 2.0);
+}
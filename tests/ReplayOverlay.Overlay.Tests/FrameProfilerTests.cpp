@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include "FrameProfiler.h"
+#include <thread>
+
+TEST(FrameProfiler, BucketsCoverValuesWithBoundedError)
+{
+    int prev = -1;
+    for (uint64_t v = 0; v < (1ull << 36); v = v < 64 ? v + 1 : v + v / 7)
+    {
+        int idx = LatencyHistogram::BucketIndex(v);
+        ASSERT_GE(idx, prev) << v;
+        ASSERT_LT(idx, LatencyHistogram::BucketCount);
+        ASSERT_LE(LatencyHistogram::BucketLow(idx), v);
+        ASSERT_GE(LatencyHistogram::BucketHigh(idx), v);
+        double width = static_cast<double>(LatencyHistogram::BucketHigh(idx) - LatencyHistogram::BucketLow(idx));
+        ASSERT_LE(width, v / 16.0) << v;
+        prev = idx;
+    }
+    EXPECT_EQ(LatencyHistogram::BucketIndex(~0ull), LatencyHistogram::BucketCount - 1);
+}
+
+TEST(FrameProfiler, PercentilesOfUniformDistribution)
+{
+    FrameProfiler p;
+    for (uint64_t us = 1; us <= 1000; us++)
+        p.Record(FramePhase::Update, us * 1000);
+
+    auto s = p.Summarize(FramePhase::Update);
+    EXPECT_EQ(s.count, 1000u);
+    EXPECT_NEAR(s.meanUs, 500.5, 1e-6);
+    EXPECT_NEAR(s.p50Us, 500.0, 500.0 * 0.07);
+    EXPECT_NEAR(s.p95Us, 950.0, 950.0 * 0.07);
+    EXPECT_NEAR(s.p99Us, 990.0, 990.0 * 0.07);
+    EXPECT_DOUBLE_EQ(s.maxUs, 1000.0);
+}
+
+TEST(FrameProfiler, TailIsVisibleInP99)
+{
+    FrameProfiler p;
+    for (int i = 0; i < 980; i++) p.Record(FramePhase::Present, 16'000'000);
+    for (int i = 0; i < 20; i++) p.Record(FramePhase::Present, 50'000'000);
+
+    auto s = p.Summarize(FramePhase::Present);
+    EXPECT_NEAR(s.p50Us, 16000.0, 16000.0 * 0.07);
+    EXPECT_NEAR(s.p95Us, 16000.0, 16000.0 * 0.07);
+    EXPECT_NEAR(s.p99Us, 50000.0, 50000.0 * 0.07);
+}
+
+TEST(FrameProfiler, RotationForgetsOldWindows)
+{
+    FrameProfiler p;
+    p.Rotate(0.0);
+    p.Record(FramePhase::Ipc, 5000);
+    p.Rotate(FrameProfiler::WindowS);       // previous window still reported
+    EXPECT_EQ(p.Summarize(FramePhase::Ipc).count, 1u);
+    p.Record(FramePhase::Ipc, 7000);
+    p.Rotate(FrameProfiler::WindowS * 2);   // first window dropped
+    auto s = p.Summarize(FramePhase::Ipc);
+    EXPECT_EQ(s.count, 1u);
+    EXPECT_DOUBLE_EQ(s.maxUs, 7.0);
+}
+
+TEST(FrameProfiler, ScopedPhaseRecordsElapsedTime)
+{
+    FrameProfiler p;
+    {
+        ScopedPhase scope(p, FramePhase::Render);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    auto s = p.Summarize(FramePhase::Render);
+    EXPECT_EQ(s.count, 1u);
+    EXPECT_GE(s.maxUs, 2000.0);
+    EXPECT_EQ(p.Summarize(FramePhase::Frame).count, 0u);
+}
+
+TEST(FrameProfiler, ReportListsEveryPhase)
+{
+    FrameProfiler p;
+    p.Record(FramePhase::DomSync, 1500);
+    auto r = p.Report();
+    EXPECT_EQ(r.size(), static_cast<size_t>(FrameProfiler::PhaseCount));
+    EXPECT_EQ(r["dom_sync"]["count"], 1);
+    EXPECT_EQ(r["pump"]["count"], 0);
+    EXPECT_NE(p.FormatLine().find("dom_sync"), std::string::npos);
+    EXPECT_EQ(p.FormatLine().find("pump"), std::string::npos);
+}
+
+TEST(FrameProfiler, SummarizesStandaloneHistogram)
+{
+    LatencyHistogram h;
+    for (int i = 1; i <= 100; i++) h.Record(static_cast<uint64_t>(i) * 1000);
+    auto s = FrameProfiler::Summarize(h);
+    EXPECT_EQ(s.count, 100u);
+    EXPECT_NEAR(s.p50Us, 50.0, 3.0);
+    EXPECT_NEAR(s.p99Us, 99.0, 6.0);
+    EXPECT_DOUBLE_EQ(s.maxUs, 100.0);
+    EXPECT_EQ(FrameProfiler::ToJson(s)["count"], 100u);
+}
@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+#include "FrameScheduler.h"
+
+// Drives the scheduler the way OverlayApp's main loop does, with a fake
+// clock that jumps straight to the end of each wait.
+struct FakeLoop
+{
+    FrameScheduler sched;
+    double now = 0.0;
+    int renders = 0;
+    int iterations = 0;
+
+    // One Tick() + WaitForWork(). 'event' simulates an OS/IPC event arriving
+    // at that absolute time (cuts an infinite or longer wait short).
+    void Step(double nextEvent = -1.0)
+    {
+        iterations++;
+        if (sched.ShouldRender(now)) renders++;
+        double timeout = sched.WaitTimeout(now);
+        if (timeout == 0.0) { now += 1.0 / 60.0; return; }
+        if (timeout == FrameScheduler::WaitForever)
+        {
+            ASSERT_GE(nextEvent, 0.0) << "loop would block forever";
+            now = nextEvent;
+        }
+        else
+        {
+            double wake = now + timeout;
+            now = (nextEvent >= 0.0 && nextEvent < wake) ? nextEvent : wake;
+        }
+    }
+};
+
+TEST(FrameScheduler, FirstFrameRenders)
+{
+    FrameScheduler s;
+    EXPECT_TRUE(s.ShouldRender(0.0));
+    EXPECT_EQ(s.WaitTimeout(0.0), FrameScheduler::WaitForever);
+}
+
+TEST(FrameScheduler, InteractiveRendersEveryFrameWithoutWaiting)
+{
+    FakeLoop loop;
+    loop.sched.SetInteractive(true);
+    for (int i = 0; i < 60; i++) loop.Step();
+    EXPECT_EQ(loop.renders, 60);
+    EXPECT_NEAR(loop.now, 1.0, 1e-9);
+}
+
+TEST(FrameScheduler, HiddenAndIdleBlocksUntilEvent)
+{
+    FakeLoop loop;
+    loop.Step(1.0); // initial frame
+    loop.Step(30.0);
+    EXPECT_EQ(loop.renders, 1);
+    EXPECT_DOUBLE_EQ(loop.now, 30.0);
+}
+
+TEST(FrameScheduler, HideRendersOneClearFrame)
+{
+    FakeLoop loop;
+    loop.sched.SetInteractive(true);
+    loop.Step();
+    loop.Step();
+    loop.sched.SetInteractive(false);
+    int before = loop.renders;
+    loop.Step(100.0);
+    loop.Step(200.0);
+    EXPECT_EQ(loop.renders, before + 1);
+}
+
+TEST(FrameScheduler, WakeDeadlinePacesAnimation)
+{
+    // REC dot blinking every 0.5 s while hidden: one wakeup and one frame
+    // per blink instead of 30 VSync frames
+    FakeLoop loop;
+    double nextBlink = 0.5;
+    for (int i = 0; i < 20; i++)
+    {
+        if (loop.now >= nextBlink)
+        {
+            loop.sched.Invalidate(); // UpdateRecIndicator dirtied the dot
+            nextBlink += 0.5;
+        }
+        loop.sched.RequestWakeAt(nextBlink);
+        loop.Step();
+    }
+    EXPECT_NEAR(loop.now, 10.0, 1e-9);
+    EXPECT_EQ(loop.iterations, 20);
+    EXPECT_EQ(loop.renders, 20); // initial frame + 19 blinks
+}
+
+TEST(FrameScheduler, WakeRequestsLastOneIteration)
+{
+    FrameScheduler s;
+    s.ShouldRender(0.0);
+    s.RequestWakeAt(5.0);
+    EXPECT_DOUBLE_EQ(s.WaitTimeout(1.0), 4.0);
+    EXPECT_EQ(s.WaitTimeout(1.0), FrameScheduler::WaitForever);
+}
+
+TEST(FrameScheduler, EarliestWakeWins)
+{
+    FrameScheduler s;
+    s.ShouldRender(0.0);
+    s.RequestWakeAt(5.0);
+    s.RequestWakeAt(2.0);
+    s.RequestWakeAt(3.0);
+    EXPECT_DOUBLE_EQ(s.WaitTimeout(1.0), 1.0);
+    s.RequestWakeAt(0.5); // already due
+    EXPECT_DOUBLE_EQ(s.WaitTimeout(1.0), 0.0);
+}
+
+TEST(FrameScheduler, InvalidationRendersOnceThenSleeps)
+{
+    FakeLoop loop;
+    loop.Step(1.0);
+    loop.sched.Invalidate();
+    loop.Step(2.0);
+    EXPECT_EQ(loop.renders, 2);
+    loop.Step(3.0);
+    EXPECT_EQ(loop.renders, 2);
+    EXPECT_EQ(loop.sched.SkippedFrames(), 1u);
+}
+
+TEST(FrameScheduler, PeriodicPacingRendersOnItsClock)
+{
+    // Passive panel: 10 Hz regardless of how often the loop wakes
+    FakeLoop loop;
+    loop.sched.SetPacing(0.1, true);
+    for (int i = 0; i < 10; i++) loop.Step();
+    EXPECT_NEAR(loop.now, 1.0, 1e-9);
+    EXPECT_EQ(loop.renders, 10);
+    EXPECT_EQ(loop.sched.SkippedFrames(), 0u);
+}
+
+TEST(FrameScheduler, PacingCapsInvalidations)
+{
+    // Indicator only: invalidations arriving faster than 2 Hz are coalesced
+    FrameScheduler s;
+    s.SetPacing(0.5, false);
+    EXPECT_TRUE(s.ShouldRender(0.0));
+    s.Invalidate();
+    EXPECT_FALSE(s.ShouldRender(0.1));
+    EXPECT_DOUBLE_EQ(s.WaitTimeout(0.1), 0.4);
+    s.Invalidate();
+    EXPECT_FALSE(s.ShouldRender(0.3));
+    EXPECT_TRUE(s.ShouldRender(0.5));
+    EXPECT_EQ(s.WaitTimeout(0.5), FrameScheduler::WaitForever);
+}
+
+TEST(FrameScheduler, PacingChangeRendersImmediately)
+{
+    FrameScheduler s;
+    s.SetPacing(0.5, false);
+    EXPECT_TRUE(s.ShouldRender(0.0));
+    s.SetPacing(0.1, true); // panel shown
+    EXPECT_DOUBLE_EQ(s.WaitTimeout(0.01), 0.0);
+    EXPECT_TRUE(s.ShouldRender(0.01));
+    EXPECT_FALSE(s.ShouldRender(0.05));
+}
@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+#include "GeometryArena.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace
+{
+    bool Overlaps(const ArenaAllocator::Allocation& a, const ArenaAllocator::Allocation& b)
+    {
+        return a.page == b.page && a.offset < b.offset + b.size && b.offset < a.offset + a.size;
+    }
+}
+
+TEST(ArenaAllocator, RoundsAndPacksIntoOnePage)
+{
+    ArenaAllocator arena(1024);
+    auto a = arena.Allocate(4);
+    auto b = arena.Allocate(17);
+    auto c = arena.Allocate(16);
+    EXPECT_EQ(a.size, 16u);
+    EXPECT_EQ(b.size, 32u);
+    EXPECT_EQ(arena.PageCount(), 1u);
+    EXPECT_FALSE(Overlaps(a, b));
+    EXPECT_FALSE(Overlaps(b, c));
+    EXPECT_FALSE(Overlaps(a, c));
+    EXPECT_EQ(arena.GetStats().used, 64u);
+    EXPECT_FALSE(arena.Allocate(0).Valid());
+}
+
+TEST(ArenaAllocator, FreedNeighboursCoalesce)
+{
+    ArenaAllocator arena(256);
+    auto a = arena.Allocate(64);
+    auto b = arena.Allocate(64);
+    auto c = arena.Allocate(64);
+    arena.Allocate(64); // page full
+
+    arena.Free(a);
+    arena.Free(c);
+    EXPECT_EQ(arena.GetStats().freeBlocks, 2u);
+    arena.Free(b); // bridges a and c
+    auto s = arena.GetStats();
+    EXPECT_EQ(s.freeBlocks, 1u);
+    EXPECT_EQ(s.largestFree, 192u);
+    EXPECT_DOUBLE_EQ(s.Fragmentation(), 0.0);
+
+    auto big = arena.Allocate(192);
+    EXPECT_EQ(big.page, 0u);
+    EXPECT_EQ(big.offset, 0u);
+    EXPECT_EQ(arena.PageCount(), 1u);
+}
+
+TEST(ArenaAllocator, BestFitReusesSmallestHole)
+{
+    ArenaAllocator arena(1024);
+    auto small = arena.Allocate(16);
+    arena.Allocate(16);
+    auto large = arena.Allocate(128);
+    arena.Allocate(16);
+    arena.Free(large);
+    arena.Free(small);
+
+    auto a = arena.Allocate(16);
+    EXPECT_EQ(a.offset, small.offset);
+    auto b = arena.Allocate(100);
+    EXPECT_EQ(b.offset, large.offset);
+}
+
+TEST(ArenaAllocator, GrowsPagesAndGivesOversizeItsOwn)
+{
+    ArenaAllocator arena(256);
+    arena.Allocate(200);
+    auto second = arena.Allocate(200);
+    EXPECT_EQ(second.page, 1u);
+    auto huge = arena.Allocate(1000);
+    EXPECT_EQ(huge.page, 2u);
+    EXPECT_EQ(arena.PageCapacity(2), 1008u);
+
+    arena.Reset();
+    EXPECT_EQ(arena.GetStats().used, 0u);
+    EXPECT_EQ(arena.GetStats().freeBlocks, 3u);
+    EXPECT_EQ(arena.PageCount(), 3u);
+}
+
+TEST(ArenaAllocator, ChurnKeepsRangesDisjointAndBounded)
+{
+    // Text-heavy UI: mostly small meshes, replaced in random order
+    ArenaAllocator arena(16 * 1024);
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> sizeDist(4, 400);
+    std::vector<ArenaAllocator::Allocation> live;
+    for (int step = 0; step < 20000; step++)
+    {
+        if (live.size() < 300 || (rng() & 1))
+        {
+            live.push_back(arena.Allocate(static_cast<uint32_t>(sizeDist(rng))));
+        }
+        else
+        {
+            size_t k = rng() % live.size();
+            arena.Free(live[k]);
+            live[k] = live.back();
+            live.pop_back();
+        }
+    }
+
+    std::sort(live.begin(), live.end(), [](const auto& a, const auto& b)
+    {
+        return a.page != b.page ? a.page < b.page : a.offset < b.offset;
+    });
+    size_t used = 0;
+    for (size_t i = 0; i < live.size(); i++)
+    {
+        used += live[i].size;
+        EXPECT_LE(live[i].offset + live[i].size, arena.PageCapacity(live[i].page));
+        if (i > 0)
+        {
+            ASSERT_FALSE(Overlaps(live[i - 1], live[i]));
+        }
+    }
+    auto s = arena.GetStats();
+    EXPECT_EQ(s.used, used);
+    // Roughly 300-500 live meshes of ~200 elements fit in a handful of pages
+    EXPECT_LE(s.pages, 8u);
+
+    for (const auto& a : live) arena.Free(a);
+    s = arena.GetStats();
+    EXPECT_EQ(s.used, 0u);
+    EXPECT_EQ(s.freeBlocks, s.pages); // everything coalesced back
+}
+
+TEST(GeometryArena, StoresAndReturnsMeshData)
+{
+    struct V { float x, y; };
+    GeometryArena<V> arena(64, 64);
+    const V verts[3] = { { 1, 2 }, { 3, 4 }, { 5, 6 } };
+    const int idx[3] = { 0, 1, 2 };
+    auto a = arena.Allocate(verts, 3, idx, 3);
+    auto b = arena.Allocate(verts, 2, idx, 2);
+
+    ASSERT_NE(arena.Vertices(a), nullptr);
+    EXPECT_EQ(arena.Vertices(a)[2].y, 6.0f);
+    EXPECT_EQ(arena.Indices(a)[1], 1);
+    EXPECT_NE(arena.Vertices(a), arena.Vertices(b));
+
+    arena.Free(a);
+    auto c = arena.Allocate(verts + 1, 2, idx, 3); // reuses a's range
+    EXPECT_EQ(arena.Vertices(c), arena.Vertices(a));
+    EXPECT_EQ(arena.Vertices(c)[0].x, 3.0f);
+
+    auto empty = arena.Allocate(verts, 0, idx, 0);
+    EXPECT_EQ(arena.Vertices(empty), nullptr);
+    arena.Free(empty);
+}
@@ -0,0 +1,283 @@
+#include <gtest/gtest.h>
+#include "GeometryBatcher.h"
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+    // Records what a GPU backend would have been asked to do
+    struct RecordingBackend
+    {
+        struct DrawCall
+        {
+            GeometryBatcher::Batch batch;
+            bool hasTransform = false;
+            float transform[16] = {};
+        };
+
+        std::vector<BatchVertex> vertices;
+        std::vector<uint32_t> indices;
+        std::vector<DrawCall> draws;
+        int uploads = 0;
+        bool failUpload = false;
+
+        bool Upload(const BatchVertex* v, size_t vn, const uint32_t* idx, size_t in)
+        {
+            uploads++;
+            if (failUpload) return false;
+            vertices.assign(v, v + vn);
+            indices.assign(idx, idx + in);
+            return true;
+        }
+
+        void Draw(const GeometryBatcher::Batch& batch, const float* transform)
+        {
+            DrawCall call;
+            call.batch = batch;
+            call.hasTransform = transform != nullptr;
+            if (transform) std::memcpy(call.transform, transform, sizeof(call.transform));
+            draws.push_back(call);
+        }
+    };
+
+    // Axis-aligned quad at the origin, two triangles
+    struct Quad
+    {
+        BatchVertex v[4];
+        int i[6] = { 0, 1, 2, 0, 2, 3 };
+
+        explicit Quad(float size = 10.0f, uint32_t colour = 0xFF00FF00u)
+        {
+            v[0] = { 0.0f, 0.0f, colour, 0.0f, 0.0f };
+            v[1] = { size, 0.0f, colour, 1.0f, 0.0f };
+            v[2] = { size, size, colour, 1.0f, 1.0f };
+            v[3] = { 0.0f, size, colour, 0.0f, 1.0f };
+        }
+    };
+
+    void AddQuad(GeometryBatcher& b, const Quad& q, float tx, float ty, uintptr_t texture)
+    {
+        b.Add(q.v, 4, q.i, 6, tx, ty, texture);
+    }
+}
+
+TEST(GeometryBatcher, MergesConsecutiveGeometryWithSameState)
+{
+    GeometryBatcher b;
+    Quad q;
+    for (int k = 0; k < 50; k++) AddQuad(b, q, k * 12.0f, 0.0f, 0);
+
+    RecordingBackend backend;
+    EXPECT_EQ(b.Flush(backend), 1u);
+    ASSERT_EQ(backend.draws.size(), 1u);
+    EXPECT_EQ(backend.draws[0].batch.indexCount, 300u);
+    EXPECT_EQ(backend.draws[0].batch.geometries, 50u);
+    EXPECT_EQ(backend.vertices.size(), 200u);
+    EXPECT_EQ(b.LastGeometries(), 50u);
+    EXPECT_EQ(b.LastDraws(), 1u);
+}
+
+TEST(GeometryBatcher, TextureChangeSplitsBatch)
+{
+    GeometryBatcher b;
+    Quad q;
+    AddQuad(b, q, 0, 0, 0);
+    AddQuad(b, q, 0, 0, 7);  // glyph atlas
+    AddQuad(b, q, 0, 0, 7);
+    AddQuad(b, q, 0, 0, 0);  // back to untextured: new batch, order kept
+
+    RecordingBackend backend;
+    b.Flush(backend);
+    ASSERT_EQ(backend.draws.size(), 3u);
+    EXPECT_EQ(backend.draws[0].batch.texture, 0u);
+    EXPECT_EQ(backend.draws[1].batch.texture, 7u);
+    EXPECT_EQ(backend.draws[1].batch.firstIndex, 6u);
+    EXPECT_EQ(backend.draws[1].batch.indexCount, 12u);
+    EXPECT_EQ(backend.draws[2].batch.firstIndex, 18u);
+}
+
+TEST(GeometryBatcher, ScissorSplitsOnlyWhenEnabledRegionDiffers)
+{
+    GeometryBatcher b;
+    Quad q;
+    b.SetScissor({ 0, 0, 100, 100 });
+    AddQuad(b, q, 0, 0, 0);
+    b.SetScissor({ 0, 0, 50, 50 }); // disabled: region is irrelevant
+    AddQuad(b, q, 0, 0, 0);
+
+    b.EnableScissor(true);
+    AddQuad(b, q, 0, 0, 0);
+    AddQuad(b, q, 0, 0, 0);
+    b.SetScissor({ 10, 10, 50, 50 });
+    AddQuad(b, q, 0, 0, 0);
+    b.EnableScissor(false);
+    AddQuad(b, q, 0, 0, 0);
+
+    RecordingBackend backend;
+    b.Flush(backend);
+    ASSERT_EQ(backend.draws.size(), 4u);
+    EXPECT_FALSE(backend.draws[0].batch.scissorEnabled);
+    EXPECT_EQ(backend.draws[0].batch.geometries, 2u);
+    EXPECT_TRUE(backend.draws[1].batch.scissorEnabled);
+    EXPECT_EQ(backend.draws[1].batch.scissor, (GeometryBatcher::Scissor{ 0, 0, 50, 50 }));
+    EXPECT_EQ(backend.draws[1].batch.geometries, 2u);
+    EXPECT_EQ(backend.draws[2].batch.scissor, (GeometryBatcher::Scissor{ 10, 10, 50, 50 }));
+    EXPECT_FALSE(backend.draws[3].batch.scissorEnabled);
+}
+
+TEST(GeometryBatcher, TransformSplitsAndRepeatsMerge)
+{
+    float rotate[16] = { 0, 1, 0, 0, -1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+    float scale[16] = { 2, 0, 0, 0, 0, 2, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+
+    GeometryBatcher b;
+    Quad q;
+    AddQuad(b, q, 0, 0, 0);
+    b.SetTransform(rotate);
+    AddQuad(b, q, 0, 0, 0);
+    b.SetTransform(rotate); // same matrix again: same batch
+    AddQuad(b, q, 0, 0, 0);
+    b.SetTransform(scale);
+    AddQuad(b, q, 0, 0, 0);
+    b.SetTransform(nullptr);
+    AddQuad(b, q, 0, 0, 0);
+
+    RecordingBackend backend;
+    b.Flush(backend);
+    ASSERT_EQ(backend.draws.size(), 4u);
+    EXPECT_FALSE(backend.draws[0].hasTransform);
+    ASSERT_TRUE(backend.draws[1].hasTransform);
+    EXPECT_EQ(backend.draws[1].batch.geometries, 2u);
+    EXPECT_EQ(std::memcmp(backend.draws[1].transform, rotate, sizeof(rotate)), 0);
+    ASSERT_TRUE(backend.draws[2].hasTransform);
+    EXPECT_EQ(std::memcmp(backend.draws[2].transform, scale, sizeof(scale)), 0);
+    EXPECT_FALSE(backend.draws[3].hasTransform);
+}
+
+TEST(GeometryBatcher, TransformCarriesIntoNextFrame)
+{
+    float scale[16] = { 2, 0, 0, 0, 0, 2, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+    GeometryBatcher b;
+    Quad q;
+    b.SetTransform(scale);
+    AddQuad(b, q, 0, 0, 0);
+    RecordingBackend first;
+    b.Flush(first);
+
+    AddQuad(b, q, 0, 0, 0);
+    RecordingBackend second;
+    b.Flush(second);
+    ASSERT_EQ(second.draws.size(), 1u);
+    ASSERT_TRUE(second.draws[0].hasTransform);
+    EXPECT_EQ(std::memcmp(second.draws[0].transform, scale, sizeof(scale)), 0);
+}
+
+TEST(GeometryBatcher, BakesTranslationAndRebasesIndices)
+{
+    GeometryBatcher b;
+    Quad q(10.0f, 0x80402010u);
+    AddQuad(b, q, 5.0f, 7.0f, 0);
+    AddQuad(b, q, -3.0f, 100.5f, 0);
+
+    RecordingBackend backend;
+    b.Flush(backend);
+    ASSERT_EQ(backend.vertices.size(), 8u);
+    for (int k = 0; k < 4; k++)
+    {
+        EXPECT_FLOAT_EQ(backend.vertices[k].x, q.v[k].x + 5.0f);
+        EXPECT_FLOAT_EQ(backend.vertices[k].y, q.v[k].y + 7.0f);
+        EXPECT_FLOAT_EQ(backend.vertices[4 + k].x, q.v[k].x - 3.0f);
+        EXPECT_FLOAT_EQ(backend.vertices[4 + k].y, q.v[k].y + 100.5f);
+        EXPECT_EQ(backend.vertices[4 + k].colour, 0x80402010u);
+        EXPECT_EQ(backend.vertices[4 + k].u, q.v[k].u);
+        EXPECT_EQ(backend.vertices[4 + k].v, q.v[k].v);
+    }
+    std::vector<uint32_t> expected = { 0, 1, 2, 0, 2, 3, 4, 5, 6, 4, 6, 7 };
+    EXPECT_EQ(backend.indices, expected);
+}
+
+TEST(GeometryBatcher, SimdBakeMatchesScalarAndKeepsColourBits)
+{
+    // Colours that are NaN / negative zero / denormal as floats must pass
+    // through bit-exact
+    const uint32_t colours[] = { 0x80000000u, 0x7F800001u, 0x00000001u, 0xFFFFFFFFu, 0x7FC00000u };
+    std::vector<BatchVertex> src;
+    for (int k = 0; k < 37; k++) // not a multiple of four: exercises the tail
+        src.push_back({ k * 1.5f, -k * 0.25f, colours[k % 5], k * 0.1f, 1.0f - k * 0.1f });
+
+    std::vector<BatchVertex> simd(src.size()), scalar(src.size());
+    GeometryBatcher::BakeTranslation(src.data(), simd.data(), src.size(), 12.25f, -3.5f);
+    GeometryBatcher::BakeTranslationScalar(src.data(), scalar.data(), src.size(), 12.25f, -3.5f);
+    EXPECT_EQ(std::memcmp(simd.data(), scalar.data(), src.size() * sizeof(BatchVertex)), 0);
+    for (size_t k = 0; k < src.size(); k++)
+    {
+        uint32_t u, su;
+        std::memcpy(&u, &simd[k].u, 4);
+        std::memcpy(&su, &src[k].u, 4);
+        EXPECT_EQ(simd[k].colour, src[k].colour);
+        EXPECT_EQ(u, su);
+    }
+}
+
+TEST(GeometryBatcher, RebaseIndicesHandlesTail)
+{
+    std::vector<int> src;
+    for (int k = 0; k < 11; k++) src.push_back(k * 3);
+    std::vector<uint32_t> dst(src.size());
+    GeometryBatcher::RebaseIndices(src.data(), dst.data(), src.size(), 1000);
+    for (size_t k = 0; k < src.size(); k++)
+        EXPECT_EQ(dst[k], static_cast<uint32_t>(src[k]) + 1000u);
+}
+
+TEST(GeometryBatcher, EmptyFrameAndFailedUploadDrawNothing)
+{
+    GeometryBatcher b;
+    RecordingBackend backend;
+    EXPECT_EQ(b.Flush(backend), 0u);
+    EXPECT_EQ(backend.uploads, 0);
+
+    Quad q;
+    AddQuad(b, q, 0, 0, 0);
+    backend.failUpload = true;
+    EXPECT_EQ(b.Flush(backend), 0u);
+    EXPECT_TRUE(backend.draws.empty());
+    EXPECT_TRUE(b.Batches().empty()); // frame is dropped either way
+
+    // Degenerate geometry is skipped
+    b.Add(q.v, 4, q.i, 0, 0, 0, 0);
+    EXPECT_TRUE(b.Vertices().empty());
+}
+
+TEST(GeometryBatcher, AtlasUvRemapMatchesScalarAndMergesEntries)
+{
+    const uint32_t colours[] = { 0x80000000u, 0x7F800001u, 0xFFFFFFFFu };
+    std::vector<BatchVertex> src;
+    for (int k = 0; k < 23; k++)
+        src.push_back({ k * 2.0f, k * 0.5f, colours[k % 3], (k % 5) * 0.25f, (k % 3) * 0.5f });
+    const UvTransform uv = { 0.25f, 0.5f, 0.125f, 0.0625f };
+
+    std::vector<BatchVertex> simd(src.size()), scalar(src.size());
+    GeometryBatcher::BakeTranslationUv(src.data(), simd.data(), src.size(), 3.0f, -1.0f, uv);
+    GeometryBatcher::BakeTranslationUvScalar(src.data(), scalar.data(), src.size(), 3.0f, -1.0f, uv);
+    for (size_t k = 0; k < src.size(); k++)
+    {
+        EXPECT_EQ(simd[k].colour, src[k].colour);
+        EXPECT_EQ(simd[k].x, scalar[k].x);
+        EXPECT_EQ(simd[k].y, scalar[k].y);
+        EXPECT_FLOAT_EQ(simd[k].u, scalar[k].u);
+        EXPECT_FLOAT_EQ(simd[k].v, scalar[k].v);
+        EXPECT_FLOAT_EQ(simd[k].u, 0.25f + src[k].u * 0.125f);
+    }
+
+    // Two atlas entries on the same page: one batch
+    GeometryBatcher b;
+    Quad q;
+    const UvTransform other = { 0.5f, 0.5f, 0.25f, 0.25f };
+    b.Add(q.v, 4, q.i, 6, 0, 0, 42, &uv);
+    b.Add(q.v, 4, q.i, 6, 0, 0, 42, &other);
+    RecordingBackend backend;
+    EXPECT_EQ(b.Flush(backend), 1u);
+    EXPECT_FLOAT_EQ(backend.vertices[2].u, 0.25f + 0.125f);
+    EXPECT_FLOAT_EQ(backend.vertices[6].u, 0.5f + 0.25f);
+}
@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include "HeadlessScript.h"
+#include "LoopbackIpc.h"
+#include "NullWindow.h"
+#include "OverlayState.h"
+#include <set>
+
+// --- LoopbackIpc ---
+
+TEST(LoopbackIpc, DisconnectedUntilConnect)
+{
+    LoopbackIpc ipc;
+    EXPECT_FALSE(ipc.IsConnected());
+    EXPECT_FALSE(ipc.SendMessage({"ready", {}}));
+    ipc.Inject({"state_update", {}});
+    EXPECT_FALSE(ipc.ReadMessage().has_value());
+
+    EXPECT_TRUE(ipc.Connect("loopback"));
+    EXPECT_TRUE(ipc.IsConnected());
+    EXPECT_EQ(ipc.PipeName(), "loopback");
+    EXPECT_TRUE(ipc.ReadMessage().has_value()); // queued before connecting
+}
+
+TEST(LoopbackIpc, ReadsInjectedMessagesInOrder)
+{
+    LoopbackIpc ipc;
+    ipc.Connect("loopback");
+    ipc.Inject({"config_update", {{"showRecIndicator", true}}});
+    ipc.Inject({"show_overlay", {}});
+    EXPECT_TRUE(ipc.HasPendingData());
+    EXPECT_GT(ipc.BufferedBytes(), 0u);
+
+    auto first = ipc.ReadMessage();
+    ASSERT_TRUE(first.has_value());
+    EXPECT_EQ(first->type, "config_update");
+    EXPECT_TRUE(first->payload["showRecIndicator"].get<bool>());
+    auto second = ipc.ReadMessage();
+    ASSERT_TRUE(second.has_value());
+    EXPECT_EQ(second->type, "show_overlay");
+
+    EXPECT_FALSE(ipc.ReadMessage().has_value());
+    EXPECT_FALSE(ipc.HasPendingData());
+    EXPECT_EQ(ipc.BufferedBytes(), 0u);
+}
+
+TEST(LoopbackIpc, CollectsSentMessages)
+{
+    LoopbackIpc ipc;
+    ipc.Connect("loopback");
+    EXPECT_TRUE(ipc.SendMessage({"ready", {}}));
+    EXPECT_TRUE(ipc.SendMessage({"toggle_stream", {}}));
+
+    auto sent = ipc.TakeSent();
+    ASSERT_EQ(sent.size(), 2u);
+    EXPECT_EQ(sent[0].type, "ready");
+    EXPECT_EQ(sent[1].type, "toggle_stream");
+    EXPECT_TRUE(ipc.TakeSent().empty());
+}
+
+TEST(LoopbackIpc, DisconnectDropsInbox)
+{
+    LoopbackIpc ipc;
+    ipc.Connect("loopback");
+    ipc.Inject({"state_update", {}});
+    ipc.Disconnect();
+    EXPECT_EQ(ipc.BufferedBytes(), 0u);
+    ipc.Connect("loopback");
+    EXPECT_FALSE(ipc.ReadMessage().has_value());
+}
+
+// --- NullWindow ---
+
+TEST(NullWindow, ZeroSizeMeansDefaultSurface)
+{
+    NullWindow window;
+    ASSERT_TRUE(window.Init(0, 0, L"test"));
+    EXPECT_EQ(window.GetWidth(), NullWindow::DefaultWidth);
+    EXPECT_EQ(window.GetHeight(), NullWindow::DefaultHeight);
+    EXPECT_TRUE(window.ProcessMessages());
+    EXPECT_FALSE(window.ConsumeInputEvent());
+
+    window.SetPanelRect(10, 20, 340, 500);
+    EXPECT_EQ(window.PanelWidth(), 340);
+    EXPECT_EQ(window.PanelHeight(), 500);
+}
+
+// --- HeadlessScript ---
+
+TEST(HeadlessScript, FirstTickConfiguresAndShows)
+{
+    HeadlessScript::Options options;
+    auto msgs = HeadlessScript::MessagesForTick(0, options);
+    ASSERT_EQ(msgs.size(), 3u);
+    EXPECT_EQ(msgs[0].type, "config_update");
+    EXPECT_EQ(msgs[1].type, "state_update");
+    EXPECT_EQ(msgs[2].type, "show_overlay");
+
+    OverlayState state;
+    state.UpdateFromConfigJson(msgs[0].payload);
+    state.UpdateFromStateJson(msgs[1].payload);
+    EXPECT_TRUE(state.showRecIndicator);
+    EXPECT_EQ(state.sources.size(), static_cast<size_t>(options.sources));
+    EXPECT_EQ(state.audio.size(), static_cast<size_t>(options.sources));
+    EXPECT_EQ(state.scenes.size(), static_cast<size_t>(options.scenes));
+}
+
+TEST(HeadlessScript, PeriodicTraffic)
+{
+    HeadlessScript::Options options;
+    EXPECT_TRUE(HeadlessScript::MessagesForTick(1, options).empty());
+
+    auto state = HeadlessScript::MessagesForTick(HeadlessScript::StateInterval, options);
+    ASSERT_EQ(state.size(), 1u);
+    EXPECT_EQ(state[0].type, "state_update");
+
+    std::set<std::string> types;
+    for (const auto& msg : HeadlessScript::MessagesForTick(HeadlessScript::NotificationInterval, options))
+        types.insert(msg.type);
+    EXPECT_EQ(types, (std::set<std::string>{ "state_update", "stats_response", "show_notification" }));
+}
+
+TEST(HeadlessScript, StateDeltaChangesOneSource)
+{
+    HeadlessScript::Options options;
+    nlohmann::json full = HeadlessScript::FullState(options);
+    nlohmann::json delta = HeadlessScript::StateDelta(HeadlessScript::StateInterval * 3, options);
+    int flipped = 0;
+    for (size_t i = 0; i < full["sources"].size(); i++)
+        flipped += full["sources"][i]["isVisible"] != delta["sources"][i]["isVisible"];
+    EXPECT_EQ(flipped, 1);
+    EXPECT_NE(full["audio"], delta["audio"]);
+}
+
+TEST(HeadlessScript, TabsCycle)
+{
+    EXPECT_EQ(HeadlessScript::TabForTick(0), nullptr);
+    EXPECT_EQ(HeadlessScript::TabForTick(1), nullptr);
+    EXPECT_STREQ(HeadlessScript::TabForTick(HeadlessScript::TabInterval), "sources");
+    EXPECT_STREQ(HeadlessScript::TabForTick(HeadlessScript::TabInterval * 7), "main");
+}
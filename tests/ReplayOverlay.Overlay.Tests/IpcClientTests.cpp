@@ -36,6 +36,13 @@ TEST(IpcClient, DisconnectWhenAlreadyDisconnected)
     EXPECT_FALSE(client.IsConnected());
 }
 
+TEST(IpcClient, NoReadEventWhenDisconnected)
+{
+    IpcClient client;
+    EXPECT_EQ(client.GetReadEvent(), nullptr);
+    EXPECT_FALSE(client.HasPendingData());
+}
+
 TEST(IpcMessage, ConstructWithTypeAndPayload)
 {
     IpcMessage msg;
@@ -0,0 +1,230 @@
+#include <gtest/gtest.h>
+#include "Logger.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    struct TempLog
+    {
+        fs::path dir;
+        fs::path path;
+
+        TempLog()
+        {
+            dir = fs::temp_directory_path() /
+                ("overlay_logger_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) +
+                 "_" + ::testing::UnitTest::GetInstance()->current_test_info()->name());
+            fs::remove_all(dir);
+            fs::create_directories(dir);
+            path = dir / "overlay.log";
+        }
+        ~TempLog() { fs::remove_all(dir); }
+
+        Logger::Options Options() const
+        {
+            Logger::Options o;
+            o.path = path.string();
+            return o;
+        }
+    };
+
+    std::vector<std::string> ReadLines(const fs::path& p)
+    {
+        std::ifstream f(p);
+        std::vector<std::string> lines;
+        for (std::string line; std::getline(f, line);) lines.push_back(line);
+        return lines;
+    }
+}
+
+TEST(Logger, WritesFormattedLinesOnFlush)
+{
+    TempLog tmp;
+    Logger log;
+    ASSERT_TRUE(log.Start(tmp.Options()));
+    log.Write(LogLevel::Info, "IPC", "connected");
+    log.Writef(LogLevel::Error, "main", "code=0x%08X", 0xC0000005u);
+    ASSERT_TRUE(log.Flush());
+
+    auto lines = ReadLines(tmp.path);
+    ASSERT_EQ(lines.size(), 2u);
+    EXPECT_NE(lines[0].find("[INFO] [IPC] connected"), std::string::npos);
+    EXPECT_NE(lines[1].find("[ERROR] [main] code=0xC0000005"), std::string::npos);
+    EXPECT_EQ(lines[0][0], '[');
+}
+
+TEST(Logger, FiltersBelowMinimumLevel)
+{
+    TempLog tmp;
+    Logger log;
+    auto opts = tmp.Options();
+    opts.minLevel = LogLevel::Warn;
+    ASSERT_TRUE(log.Start(opts));
+    EXPECT_FALSE(log.Write(LogLevel::Info, "", "hidden"));
+    EXPECT_TRUE(log.Write(LogLevel::Warn, "", "shown"));
+    log.SetLevel(LogLevel::Debug);
+    EXPECT_TRUE(log.Write(LogLevel::Debug, "", "now shown"));
+    ASSERT_TRUE(log.Flush());
+    EXPECT_EQ(ReadLines(tmp.path).size(), 2u);
+}
+
+TEST(Logger, RecordsQueuedBeforeStartAreKept)
+{
+    TempLog tmp;
+    Logger log;
+    log.Write(LogLevel::Info, "main", "early");
+    ASSERT_TRUE(log.Start(tmp.Options()));
+    ASSERT_TRUE(log.Flush());
+    auto lines = ReadLines(tmp.path);
+    ASSERT_EQ(lines.size(), 1u);
+    EXPECT_NE(lines[0].find("early"), std::string::npos);
+}
+
+TEST(Logger, FullQueueDropsAndReports)
+{
+    TempLog tmp;
+    Logger log(4);
+    for (int i = 0; i < 10; i++) log.Writef(LogLevel::Info, "", "msg %d", i);
+    EXPECT_EQ(log.Dropped(), 6u);
+
+    ASSERT_TRUE(log.Start(tmp.Options()));
+    ASSERT_TRUE(log.Flush());
+    auto lines = ReadLines(tmp.path);
+    ASSERT_EQ(lines.size(), 5u);
+    EXPECT_NE(lines[0].find("6 log messages dropped"), std::string::npos);
+    EXPECT_NE(lines[4].find("msg 3"), std::string::npos);
+}
+
+TEST(Logger, LongMessagesSpanRecordsAndReachTheFile)
+{
+    TempLog tmp;
+    Logger log;
+    ASSERT_TRUE(log.Start(tmp.Options()));
+    const std::string x = std::string(Logger::TextBytes * 3 + 17, 'x') + "end";
+    const std::string y = std::string(1000, 'y');
+    log.Write(LogLevel::Info, "", x);
+    log.Writef(LogLevel::Info, "dump", "%s|%s", y.c_str(), "tail");
+    log.Write(LogLevel::Info, "", std::string(Logger::TextBytes, 'z')); // exactly one record
+    ASSERT_TRUE(log.Flush());
+
+    auto lines = ReadLines(tmp.path);
+    ASSERT_EQ(lines.size(), 3u);
+    EXPECT_NE(lines[0].find("[INFO] " + x), std::string::npos);
+    EXPECT_EQ(lines[0].substr(lines[0].size() - x.size()), x);
+    EXPECT_EQ(lines[1].substr(lines[1].size() - y.size() - 5), y + "|tail");
+    EXPECT_NE(lines[1].find("[dump] "), std::string::npos);
+    EXPECT_EQ(std::count(lines[2].begin(), lines[2].end(), 'z'), static_cast<long>(Logger::TextBytes));
+}
+
+TEST(Logger, TruncatesBeyondMaxMessageBytes)
+{
+    TempLog tmp;
+    Logger log;
+    ASSERT_TRUE(log.Start(tmp.Options()));
+    log.Write(LogLevel::Info, "", std::string(Logger::MaxMessageBytes + 500, 'x'));
+    log.Writef(LogLevel::Info, "", "%s", std::string(Logger::MaxMessageBytes + 500, 'y').c_str());
+    log.Write(LogLevel::Info, "", "next");
+    ASSERT_TRUE(log.Flush());
+    auto lines = ReadLines(tmp.path);
+    ASSERT_EQ(lines.size(), 3u);
+    EXPECT_EQ(std::count(lines[0].begin(), lines[0].end(), 'x'), static_cast<long>(Logger::MaxMessageBytes));
+    EXPECT_EQ(std::count(lines[1].begin(), lines[1].end(), 'y'), static_cast<long>(Logger::MaxMessageBytes));
+    EXPECT_NE(lines[2].find("next"), std::string::npos);
+}
+
+TEST(Logger, LongMessageDroppedWholeWhenItDoesNotFit)
+{
+    TempLog tmp;
+    Logger log(4);
+    log.Write(LogLevel::Info, "", "a");
+    log.Write(LogLevel::Info, "", std::string(Logger::TextBytes * 3 + 1, 'x')); // 4 records, 3 free
+    EXPECT_EQ(log.Dropped(), 1u);
+    ASSERT_TRUE(log.Start(tmp.Options()));
+    ASSERT_TRUE(log.Flush());
+    auto lines = ReadLines(tmp.path);
+    ASSERT_EQ(lines.size(), 2u);
+    EXPECT_NE(lines[1].find("] a"), std::string::npos);
+}
+
+TEST(Logger, IdleWriterWakesForNewRecords)
+{
+    // No timed polling: a record written while the writer sleeps still
+    // reaches the file after the linger, without a Flush()
+    TempLog tmp;
+    Logger log;
+    ASSERT_TRUE(log.Start(tmp.Options()));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    log.Write(LogLevel::Info, "", "late");
+    for (int i = 0; i < 200 && ReadLines(tmp.path).empty(); i++)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    auto lines = ReadLines(tmp.path);
+    ASSERT_EQ(lines.size(), 1u);
+    EXPECT_NE(lines[0].find("late"), std::string::npos);
+}
+
+TEST(Logger, StopAfterFailedRotationDoesNotCrash)
+{
+    // Rotation reopens the path; a directory in its place makes that fail
+    TempLog tmp;
+    Logger log;
+    auto opts = tmp.Options();
+    opts.maxFileBytes = 10;
+    opts.keepFiles = 0;
+    ASSERT_TRUE(log.Start(opts));
+    log.Write(LogLevel::Info, "", "first batch");
+    ASSERT_TRUE(log.Flush());
+    fs::remove(tmp.path);
+    fs::create_directories(tmp.path / "busy"); // not removable, not openable
+    log.Write(LogLevel::Info, "", "rotates");
+    EXPECT_TRUE(log.Flush());
+    log.Stop();
+}
+
+TEST(Logger, ConcurrentProducersLoseNothingWhenNotFull)
+{
+    TempLog tmp;
+    Logger log(8192);
+    ASSERT_TRUE(log.Start(tmp.Options()));
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++)
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < 1000; i++) log.Writef(LogLevel::Info, "", "t%d i%d", t, i);
+        });
+    for (auto& th : threads) th.join();
+    ASSERT_TRUE(log.Flush());
+    EXPECT_EQ(log.Dropped(), 0u);
+    EXPECT_EQ(ReadLines(tmp.path).size(), 4000u);
+}
+
+TEST(Logger, RotatesBySize)
+{
+    TempLog tmp;
+    Logger log;
+    auto opts = tmp.Options();
+    opts.maxFileBytes = 2000;
+    opts.keepFiles = 2;
+    ASSERT_TRUE(log.Start(opts));
+    for (int batch = 0; batch < 12; batch++)
+    {
+        for (int i = 0; i < 10; i++) log.Writef(LogLevel::Info, "", "batch %d line %d", batch, i);
+        ASSERT_TRUE(log.Flush());
+    }
+    log.Stop();
+
+    EXPECT_TRUE(fs::exists(tmp.path));
+    EXPECT_TRUE(fs::exists(tmp.path.string() + ".1"));
+    EXPECT_TRUE(fs::exists(tmp.path.string() + ".2"));
+    EXPECT_FALSE(fs::exists(tmp.path.string() + ".3"));
+    EXPECT_LE(fs::file_size(tmp.path), 2000u);
+    auto lines = ReadLines(tmp.path);
+    ASSERT_FALSE(lines.empty());
+    EXPECT_NE(lines.back().find("batch 11 line 9"), std::string::npos);
+}
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include "Mat4.h"
+#include <cstring>
+#include <random>
+
+namespace
+{
+    // Column-major matrix applied to (x, y, 0, 1)
+    void Apply(const float* m, float x, float y, float* out)
+    {
+        for (int r = 0; r < 4; r++)
+            out[r] = m[r] * x + m[4 + r] * y + m[12 + r];
+    }
+
+    const float Identity[16] = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+}
+
+TEST(Mat4, OrthoMapsViewportCornersToClipSpace)
+{
+    float ortho[16];
+    Mat4::Ortho(ortho, 1920.0f, 1080.0f);
+
+    float p[4];
+    Apply(ortho, 0.0f, 0.0f, p);
+    EXPECT_FLOAT_EQ(p[0], -1.0f);
+    EXPECT_FLOAT_EQ(p[1], 1.0f);
+    EXPECT_FLOAT_EQ(p[3], 1.0f);
+    Apply(ortho, 1920.0f, 1080.0f, p);
+    EXPECT_FLOAT_EQ(p[0], 1.0f);
+    EXPECT_FLOAT_EQ(p[1], -1.0f);
+    Apply(ortho, 960.0f, 540.0f, p);
+    EXPECT_NEAR(p[0], 0.0f, 1e-6f);
+    EXPECT_NEAR(p[1], 0.0f, 1e-6f);
+}
+
+TEST(Mat4, OrthoWithOriginMapsTheSurfaceRect)
+{
+    // A 400x300 surface at (1000, 50) on the screen
+    float ortho[16];
+    Mat4::Ortho(ortho, 400.0f, 300.0f, 1000.0f, 50.0f);
+
+    float p[4];
+    Apply(ortho, 1000.0f, 50.0f, p);
+    EXPECT_FLOAT_EQ(p[0], -1.0f);
+    EXPECT_FLOAT_EQ(p[1], 1.0f);
+    Apply(ortho, 1400.0f, 350.0f, p);
+    EXPECT_FLOAT_EQ(p[0], 1.0f);
+    EXPECT_FLOAT_EQ(p[1], -1.0f);
+}
+
+TEST(Mat4, MultiplyComposesRightToLeft)
+{
+    // scale(2) then translate(10, 20): T * S
+    const float scale[16] = { 2, 0, 0, 0, 0, 2, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+    const float translate[16] = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 10, 20, 0, 1 };
+    float m[16];
+    Mat4::Multiply(translate, scale, m);
+
+    float p[4];
+    Apply(m, 3.0f, 4.0f, p);
+    EXPECT_FLOAT_EQ(p[0], 16.0f);
+    EXPECT_FLOAT_EQ(p[1], 28.0f);
+
+    float same[16];
+    Mat4::Multiply(m, Identity, same);
+    EXPECT_EQ(std::memcmp(same, m, sizeof(m)), 0);
+}
+
+TEST(Mat4, SimdMatchesScalar)
+{
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> dist(-1000.0f, 1000.0f);
+    for (int trial = 0; trial < 200; trial++)
+    {
+        float a[16], b[16], simd[16], scalar[16];
+        for (int i = 0; i < 16; i++)
+        {
+            a[i] = dist(rng);
+            b[i] = dist(rng);
+        }
+        Mat4::Multiply(a, b, simd);
+        Mat4::MultiplyScalar(a, b, scalar);
+        for (int i = 0; i < 16; i++)
+            ASSERT_FLOAT_EQ(simd[i], scalar[i]) << "trial " << trial << " element " << i;
+    }
+}
+
+TEST(Mat4, ProjectionTimesTransformMatchesApplyingBoth)
+{
+    float ortho[16];
+    Mat4::Ortho(ortho, 800.0f, 600.0f);
+    const float rotate[16] = { 0, 1, 0, 0, -1, 0, 0, 0, 0, 0, 1, 0, 400, 300, 0, 1 };
+    float combined[16];
+    Mat4::Multiply(ortho, rotate, combined);
+
+    float direct[4], inner[4], twoStep[4];
+    Apply(combined, 50.0f, 25.0f, direct);
+    Apply(rotate, 50.0f, 25.0f, inner);
+    Apply(ortho, inner[0], inner[1], twoStep);
+    // Clip-space values: rounding differs, a 1e-5 error is far below a pixel
+    EXPECT_NEAR(direct[0], twoStep[0], 1e-5f);
+    EXPECT_NEAR(direct[1], twoStep[1], 1e-5f);
+}
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include "OverlayAssets.h"
+#include <cstring>
+
+TEST(OverlayAssets, DocumentIsNulTerminatedAndSized)
+{
+    std::string_view doc = GetOverlayDocument();
+    EXPECT_EQ(doc.size(), OverlayAssetData::DocumentSize);
+    EXPECT_EQ(std::strlen(doc.data()), doc.size());
+}
+
+TEST(OverlayAssets, ThemeIsInlinedIntoStyleBlock)
+{
+    std::string_view doc = GetOverlayDocument();
+    EXPECT_EQ(doc.find("__THEME__"), std::string_view::npos);
+
+    size_t styleOpen = doc.find("<style>");
+    size_t styleClose = doc.find("</style>");
+    ASSERT_NE(styleOpen, std::string_view::npos);
+    ASSERT_NE(styleClose, std::string_view::npos);
+    size_t panelRule = doc.find(".panel {");
+    EXPECT_GT(panelRule, styleOpen);
+    EXPECT_LT(panelRule, styleClose);
+}
+
+TEST(OverlayAssets, DocumentHasDataModelAndClosingTags)
+{
+    std::string_view doc = GetOverlayDocument();
+    EXPECT_EQ(doc.substr(0, 5), "<rml>");
+    EXPECT_NE(doc.find("data-model=\"overlay\""), std::string_view::npos);
+    EXPECT_NE(doc.find("id=\"rec-indicator\""), std::string_view::npos);
+    EXPECT_NE(doc.rfind("</rml>"), std::string_view::npos);
+}
+
+TEST(OverlayAssets, EveryTabHasAFragment)
+{
+    for (const char* name : { "main", "sources", "audio", "filters", "transitions", "stats", "settings" })
+    {
+        std::string_view rml = GetTabFragment(name);
+        EXPECT_FALSE(rml.empty()) << name;
+        EXPECT_EQ(rml.find("active_tab"), std::string_view::npos) << name;
+    }
+    EXPECT_TRUE(GetTabFragment("bogus").empty());
+}
+
+TEST(OverlayAssets, DocumentHasEmptyTabContainer)
+{
+    std::string_view doc = GetOverlayDocument();
+    EXPECT_NE(doc.find("id=\"tab-content\""), std::string_view::npos);
+    // Pane contents come only from the fragments
+    EXPECT_EQ(doc.find("id=\"preview-img\""), std::string_view::npos);
+    EXPECT_NE(GetTabFragment("main").find("id=\"preview-img\""), std::string_view::npos);
+}
+
+// The document is usable in constant expressions (no runtime building)
+static_assert(OverlayAssetData::Document[0] == '<', "document starts with a tag");
+static_assert(OverlayAssetData::Document[OverlayAssetData::DocumentSize] == 0, "document is NUL-terminated");
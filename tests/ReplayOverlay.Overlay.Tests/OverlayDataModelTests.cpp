@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+#include "AllocCounter.h"
+#include "HeadlessRenderer.h"
+#include "OverlayDataModel.h"
+#include "OverlayState.h"
+#include <vector>
+
+// Needs RmlUi, so it is built only with OVERLAY_HEADLESS, into its own
+// executable (see AllocCounter.h)
+
+namespace
+{
+    struct ModelFixture : ::testing::Test
+    {
+        HeadlessRenderer renderer;
+        OverlayState state;
+        std::vector<IpcMessage> actions;
+        OverlayDataModel model;
+        double now = 0.0;
+
+        void SetUp() override
+        {
+            ASSERT_TRUE(renderer.Init(nullptr, 1280, 720));
+            ASSERT_TRUE(model.Init(renderer.GetRmlContext(), &state, &actions));
+            actions.reserve(16);
+        }
+        void TearDown() override { renderer.Shutdown(); }
+
+        // One stats poll as OverlayApp runs it: the model asks for stats,
+        // the response lands in the state, the next sync formats it
+        void PollStats(const nlohmann::json& response)
+        {
+            now += 1.0;
+            model.SetElapsedTime(now);
+            model.SyncFromState();
+            for (const auto& action : actions)
+                if (action.type == "get_stats") state.UpdateFromStatsJson(response, now);
+            actions.clear();
+            model.SyncFromState();
+        }
+    };
+}
+
+TEST_F(ModelFixture, IdleStatsTabNeitherAllocatesNorDirties)
+{
+    const nlohmann::json response = {
+        { "cpuUsage", 12.3 }, { "memoryUsage", 812.6 }, { "availableDiskSpace", 40960.0 },
+        { "activeFps", 59.94 }, { "averageFrameRenderTime", 1.23 },
+        { "renderSkippedFrames", 3 }, { "renderTotalFrames", 12000 },
+        { "outputSkippedFrames", 0 }, { "outputTotalFrames", 11990 },
+    };
+    model.SelectTab("stats");
+
+    // Baseline, first interval, then a sample equal to it
+    for (int i = 0; i < 3; i++) PollStats(response);
+    ASSERT_GE(state.statsGeneration, 3u);
+    model.ConsumeInvalidation();
+
+    const uint32_t generation = state.statsGeneration;
+    AllocScope scope;
+    for (int i = 0; i < 30; i++) PollStats(response);
+    const int allocs = scope.Count();
+
+    EXPECT_EQ(state.statsGeneration, generation + 30); // every poll was answered
+    EXPECT_EQ(allocs, 0);
+    EXPECT_FALSE(model.ConsumeInvalidation());
+}
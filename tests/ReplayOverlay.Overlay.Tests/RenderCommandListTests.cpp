@@ -0,0 +1,192 @@
+#include <gtest/gtest.h>
+#include "RenderCommandList.h"
+#include <cstring>
+#include <vector>
+
+namespace
+{
+    // What a GPU backend would have been asked to draw
+    struct RecordingBackend
+    {
+        std::vector<BatchVertex> vertices;
+        std::vector<uint32_t> indices;
+        std::vector<GeometryBatcher::Batch> draws;
+        std::vector<const float*> transforms;
+        int uploads = 0;
+
+        bool Upload(const BatchVertex* v, size_t vn, const uint32_t* idx, size_t in)
+        {
+            uploads++;
+            vertices.assign(v, v + vn);
+            indices.assign(idx, idx + in);
+            return true;
+        }
+
+        void Draw(const GeometryBatcher::Batch& batch, const float* transform)
+        {
+            draws.push_back(batch);
+            transforms.push_back(transform);
+        }
+    };
+
+    const BatchVertex Quad[4] = {
+        { 0.0f, 0.0f, 0xFFFFFFFFu, 0.0f, 0.0f }, { 10.0f, 0.0f, 0xFFFFFFFFu, 1.0f, 0.0f },
+        { 10.0f, 10.0f, 0xFFFFFFFFu, 1.0f, 1.0f }, { 0.0f, 10.0f, 0xFFFFFFFFu, 0.0f, 1.0f } };
+    const int QuadIndices[6] = { 0, 1, 2, 0, 2, 3 };
+    const float Scale2[16] = { 2, 0, 0, 0, 0, 2, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+
+    // A small frame: two textures, a scissored quad and a transformed one
+    void RenderFrame(GeometryBatcher& batcher, RenderCommandList& list, float x = 0.0f)
+    {
+        batcher.Add(Quad, 4, QuadIndices, 6, x, 0.0f, 0);
+        batcher.Add(Quad, 4, QuadIndices, 6, x + 20.0f, 0.0f, 0);
+        batcher.Add(Quad, 4, QuadIndices, 6, x, 20.0f, 7);
+        batcher.EnableScissor(true);
+        batcher.SetScissor({ 0, 0, 50, 50 });
+        batcher.Add(Quad, 4, QuadIndices, 6, x, 40.0f, 7);
+        batcher.EnableScissor(false);
+        batcher.SetTransform(Scale2);
+        batcher.Add(Quad, 4, QuadIndices, 6, x, 60.0f, 7);
+        batcher.SetTransform(nullptr);
+        batcher.Flush(list);
+    }
+}
+
+TEST(RenderCommandList, ReplayMatchesDirectFlush)
+{
+    GeometryBatcher direct;
+    RecordingBackend expected;
+    direct.Add(Quad, 4, QuadIndices, 6, 0.0f, 0.0f, 0);
+    direct.Add(Quad, 4, QuadIndices, 6, 20.0f, 0.0f, 0);
+    direct.Add(Quad, 4, QuadIndices, 6, 0.0f, 20.0f, 7);
+    direct.EnableScissor(true);
+    direct.SetScissor({ 0, 0, 50, 50 });
+    direct.Add(Quad, 4, QuadIndices, 6, 0.0f, 40.0f, 7);
+    direct.EnableScissor(false);
+    direct.SetTransform(Scale2);
+    direct.Add(Quad, 4, QuadIndices, 6, 0.0f, 60.0f, 7);
+    direct.Flush(expected);
+
+    GeometryBatcher batcher;
+    RenderCommandList list;
+    RenderFrame(batcher, list);
+    RecordingBackend replayed;
+    EXPECT_EQ(list.Replay(replayed), 4u);
+
+    EXPECT_EQ(replayed.uploads, 1);
+    ASSERT_EQ(replayed.vertices.size(), expected.vertices.size());
+    EXPECT_EQ(std::memcmp(replayed.vertices.data(), expected.vertices.data(),
+                          expected.vertices.size() * sizeof(BatchVertex)), 0);
+    EXPECT_EQ(replayed.indices, expected.indices);
+    ASSERT_EQ(replayed.draws.size(), expected.draws.size());
+    for (size_t i = 0; i < expected.draws.size(); i++)
+    {
+        EXPECT_EQ(replayed.draws[i].texture, expected.draws[i].texture);
+        EXPECT_EQ(replayed.draws[i].scissorEnabled, expected.draws[i].scissorEnabled);
+        EXPECT_EQ(replayed.draws[i].firstIndex, expected.draws[i].firstIndex);
+        EXPECT_EQ(replayed.draws[i].indexCount, expected.draws[i].indexCount);
+    }
+    EXPECT_TRUE(replayed.draws[2].scissor == (GeometryBatcher::Scissor{ 0, 0, 50, 50 }));
+    EXPECT_EQ(replayed.transforms[2], nullptr);
+    ASSERT_NE(replayed.transforms[3], nullptr);
+    EXPECT_EQ(std::memcmp(replayed.transforms[3], Scale2, sizeof(Scale2)), 0);
+}
+
+TEST(RenderCommandList, RecordsStateChangesOnly)
+{
+    GeometryBatcher batcher;
+    RenderCommandList list;
+    RenderFrame(batcher, list);
+
+    size_t scissors = 0, transforms = 0, draws = 0;
+    for (const auto& c : list.Commands())
+    {
+        scissors += c.op == RenderCommandList::Op::SetScissor;
+        transforms += c.op == RenderCommandList::Op::SetTransform;
+        draws += c.op == RenderCommandList::Op::Draw;
+    }
+    EXPECT_EQ(draws, 4u);
+    EXPECT_EQ(scissors, 3u);   // off, on, off
+    EXPECT_EQ(transforms, 2u); // none, scale
+}
+
+TEST(RenderCommandList, IdenticalFramesCompareEqual)
+{
+    GeometryBatcher batcher;
+    RenderCommandList a, b, moved;
+    RenderFrame(batcher, a);
+    RenderFrame(batcher, b);
+    RenderFrame(batcher, moved, 1.0f);
+
+    EXPECT_TRUE(a == b);
+    EXPECT_TRUE(RenderCommandList::Diff(a, b).empty());
+    EXPECT_FALSE(a == moved);
+    EXPECT_EQ(RenderCommandList::Diff(a, moved), "vertex 0 differs");
+
+    b.UpdateTexture(7);
+    EXPECT_FALSE(a == b);
+    EXPECT_NE(RenderCommandList::Diff(a, b).find("update_texture 0x7"), std::string::npos);
+    EXPECT_TRUE(a.DrawsSameAs(b)); // resource operations are not draws
+    EXPECT_FALSE(a.DrawsSameAs(moved));
+}
+
+TEST(RenderCommandList, SerializeRoundTrips)
+{
+    GeometryBatcher batcher;
+    RenderCommandList list;
+    list.CompileGeometry(0x100000001ull, 4, 6);
+    list.GenerateTexture(7, 32, 16);
+    RenderFrame(batcher, list);
+    list.ReleaseGeometry(0x100000001ull);
+
+    std::vector<uint8_t> bytes = list.Serialize();
+    RenderCommandList loaded;
+    ASSERT_TRUE(loaded.Deserialize(bytes.data(), bytes.size()));
+    EXPECT_TRUE(loaded == list);
+    EXPECT_EQ(loaded.Draws(), list.Draws());
+    EXPECT_EQ(loaded.Describe(), list.Describe());
+
+    RecordingBackend a, b;
+    EXPECT_EQ(list.Replay(a), loaded.Replay(b));
+    EXPECT_EQ(a.indices, b.indices);
+    ASSERT_EQ(a.transforms.size(), b.transforms.size());
+    EXPECT_EQ(std::memcmp(a.transforms.back(), b.transforms.back(), sizeof(Scale2)), 0);
+
+    // Truncated or corrupted dumps are rejected
+    EXPECT_FALSE(loaded.Deserialize(bytes.data(), bytes.size() - 1));
+    EXPECT_TRUE(loaded.Empty());
+    bytes[0] = 'X';
+    EXPECT_FALSE(loaded.Deserialize(bytes.data(), bytes.size()));
+}
+
+TEST(RenderCommandHistory, SkipsUnchangedFrames)
+{
+    GeometryBatcher batcher;
+    RenderCommandHistory history;
+
+    RenderFrame(batcher, history.Recording());
+    EXPECT_TRUE(history.EndFrame());   // nothing drawn yet
+    RenderFrame(batcher, history.Recording());
+    EXPECT_FALSE(history.EndFrame());
+    EXPECT_EQ(history.Last().Draws(), 4u); // still replayable
+
+    // A texture update between frames redraws the next one only
+    history.Recording().UpdateTexture(7);
+    RenderFrame(batcher, history.Recording());
+    EXPECT_TRUE(history.EndFrame());
+    RenderFrame(batcher, history.Recording());
+    EXPECT_FALSE(history.EndFrame());
+
+    history.Invalidate();
+    RenderFrame(batcher, history.Recording());
+    EXPECT_TRUE(history.EndFrame());
+
+    // A discarded warm-up render forces the next frame too
+    RenderFrame(batcher, history.Recording());
+    history.DiscardFrame();
+    RenderFrame(batcher, history.Recording());
+    EXPECT_TRUE(history.EndFrame());
+
+    EXPECT_EQ(history.Frames(), 6u);
+    EXPECT_EQ(history.UnchangedFrames(), 2u);
+}
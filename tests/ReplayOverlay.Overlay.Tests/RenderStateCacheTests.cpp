@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+#include "RenderStateCache.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Counts what reaches the device context
+    struct MockContext
+    {
+        int invariant = 0, streams = 0, textures = 0, rasterizer = 0, rects = 0, constants = 0, draws = 0;
+        std::vector<std::string> log;
+
+        void BindInvariantState() { invariant++; log.push_back("invariant"); }
+        void BindStream(const void*, const void*) { streams++; log.push_back("stream"); }
+        void BindTexture(const void*) { textures++; log.push_back("texture"); }
+        void SetRasterizer(bool scissor) { rasterizer++; log.push_back(scissor ? "raster+scissor" : "raster"); }
+        void SetScissorRect(const GeometryBatcher::Scissor&) { rects++; log.push_back("rect"); }
+        void WriteConstants(const float*) { constants++; log.push_back("constants"); }
+        void DrawIndexed(uint32_t, uint32_t) { draws++; log.push_back("draw"); }
+    };
+
+    const float Scale2[16] = { 2, 0, 0, 0, 0, 2, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+}
+
+TEST(RenderStateCache, BindsInvariantStateOncePerFrame)
+{
+    MockContext ctx;
+    RenderStateCache<MockContext> cache(ctx);
+    int vb = 0, ib = 0;
+
+    cache.BeginFrame();
+    cache.BindStream(&vb, &ib);
+    for (int i = 0; i < 100; i++)
+    {
+        cache.SetTransform(nullptr);
+        cache.BindTexture(nullptr);
+        cache.SetScissor(false, {});
+        cache.Draw(6, i * 6);
+    }
+
+    EXPECT_EQ(ctx.invariant, 1);
+    EXPECT_EQ(ctx.streams, 1);
+    EXPECT_EQ(ctx.constants, 1);
+    EXPECT_EQ(ctx.textures, 1);
+    EXPECT_EQ(ctx.rasterizer, 1);
+    EXPECT_EQ(ctx.rects, 0);
+    EXPECT_EQ(ctx.draws, 100);
+    EXPECT_EQ(cache.CurrentFrame().StateChanges(), 5u);
+}
+
+TEST(RenderStateCache, ReissuesOnlyChangedState)
+{
+    MockContext ctx;
+    RenderStateCache<MockContext> cache(ctx);
+    int atlas = 0, image = 0;
+
+    cache.BeginFrame();
+    cache.BindTexture(&atlas);
+    cache.BindTexture(&atlas);
+    cache.BindTexture(&image);
+    cache.BindTexture(&atlas);
+    EXPECT_EQ(ctx.textures, 3);
+
+    cache.SetScissor(true, { 0, 0, 100, 100 });
+    cache.SetScissor(true, { 0, 0, 100, 100 });
+    cache.SetScissor(true, { 0, 0, 50, 100 });  // rect only
+    cache.SetScissor(false, { 0, 0, 10, 10 });  // rasterizer only; rect ignored
+    cache.SetScissor(true, { 0, 0, 50, 100 });  // rasterizer only; rect unchanged
+    EXPECT_EQ(ctx.rasterizer, 3);
+    EXPECT_EQ(ctx.rects, 2);
+
+    cache.SetTransform(nullptr);
+    cache.SetTransform(Scale2);
+    float copy[16];
+    std::copy(Scale2, Scale2 + 16, copy);
+    cache.SetTransform(copy); // same matrix at another address
+    cache.SetTransform(nullptr);
+    EXPECT_EQ(ctx.constants, 3);
+}
+
+TEST(RenderStateCache, NewFrameForgetsShadowStateAndRollsCounters)
+{
+    MockContext ctx;
+    RenderStateCache<MockContext> cache(ctx);
+    int vb = 0, ib = 0, tex = 0;
+
+    cache.BeginFrame();
+    cache.BindStream(&vb, &ib);
+    cache.BindTexture(&tex);
+    cache.SetTransform(nullptr);
+    cache.Draw(6, 0);
+    cache.Draw(6, 6);
+
+    cache.BeginFrame();
+    auto last = cache.LastFrame();
+    EXPECT_EQ(last.invariant, 1u);
+    EXPECT_EQ(last.streams, 1u);
+    EXPECT_EQ(last.textures, 1u);
+    EXPECT_EQ(last.constants, 1u);
+    EXPECT_EQ(last.draws, 2u);
+    EXPECT_EQ(cache.CurrentFrame().invariant, 1u);
+    EXPECT_EQ(cache.CurrentFrame().draws, 0u);
+
+    // Same objects again: bound again, since the context may have changed
+    cache.BindStream(&vb, &ib);
+    cache.BindTexture(&tex);
+    cache.SetTransform(nullptr);
+    EXPECT_EQ(ctx.invariant, 2);
+    EXPECT_EQ(ctx.streams, 2);
+    EXPECT_EQ(ctx.textures, 2);
+    EXPECT_EQ(ctx.constants, 2);
+}
+
+TEST(RenderStateCache, BindsInvariantLazilyWithoutBeginFrame)
+{
+    MockContext ctx;
+    RenderStateCache<MockContext> cache(ctx);
+    int vb = 0, ib = 0;
+    cache.BindStream(&vb, &ib);
+    cache.Draw(3, 0);
+    ASSERT_GE(ctx.log.size(), 3u);
+    EXPECT_EQ(ctx.log[0], "invariant");
+    EXPECT_EQ(ctx.invariant, 1);
+}
+
+TEST(RenderStateCache, ViewportChangeRebindsInvariantAndConstants)
+{
+    MockContext ctx;
+    RenderStateCache<MockContext> cache(ctx);
+    cache.BeginFrame();
+    cache.SetTransform(nullptr);
+    cache.Draw(6, 0);
+
+    cache.InvalidateInvariant();
+    cache.SetTransform(nullptr); // projection changed with the viewport
+    cache.Draw(6, 6);
+    EXPECT_EQ(ctx.invariant, 2);
+    EXPECT_EQ(ctx.constants, 2);
+}
+
+TEST(RenderStateCache, NewStreamBufferIsRebound)
+{
+    MockContext ctx;
+    RenderStateCache<MockContext> cache(ctx);
+    int vb1 = 0, vb2 = 0, ib = 0;
+    cache.BeginFrame();
+    cache.BindStream(&vb1, &ib);
+    cache.BindStream(&vb1, &ib);
+    cache.BindStream(&vb2, &ib); // stream grew into a new buffer
+    EXPECT_EQ(ctx.streams, 2);
+}
@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include "SlotMap.h"
+#include <memory>
+#include <set>
+#include <string>
+
+TEST(SlotMap, InsertGetErase)
+{
+    SlotMap<std::string> map;
+    auto a = map.Insert("atlas");
+    auto b = map.Insert("preview");
+    EXPECT_NE(a, SlotMap<std::string>::Null);
+    EXPECT_NE(a, b);
+    ASSERT_NE(map.Get(a), nullptr);
+    EXPECT_EQ(*map.Get(a), "atlas");
+    EXPECT_EQ(*map.Get(b), "preview");
+    EXPECT_EQ(map.size(), 2u);
+
+    EXPECT_TRUE(map.Erase(a));
+    EXPECT_EQ(map.Get(a), nullptr);
+    EXPECT_FALSE(map.Erase(a));
+    EXPECT_EQ(*map.Get(b), "preview"); // moved into a's place, handle unchanged
+    EXPECT_EQ(map.size(), 1u);
+    EXPECT_EQ(map.Get(SlotMap<std::string>::Null), nullptr);
+}
+
+TEST(SlotMap, StaleHandleIsRejectedAfterSlotReuse)
+{
+    SlotMap<int> map;
+    auto old = map.Insert(1);
+    map.Erase(old);
+    auto fresh = map.Insert(2);
+    EXPECT_EQ(static_cast<uint32_t>(fresh), static_cast<uint32_t>(old)); // same slot
+    EXPECT_NE(fresh, old);
+    EXPECT_EQ(map.Get(old), nullptr);
+    EXPECT_FALSE(map.Erase(old));
+    EXPECT_EQ(*map.Get(fresh), 2);
+}
+
+TEST(SlotMap, ForgedHandlesAreRejected)
+{
+    SlotMap<int> map;
+    auto a = map.Insert(1);
+    map.Insert(2);
+    map.Erase(a);
+    // The free slot's next generation, before it is reissued
+    const SlotMap<int>::Handle forged = a + (1ull << 32);
+    EXPECT_EQ(map.Get(forged), nullptr);
+    EXPECT_EQ(map.Get(12345), nullptr);
+}
+
+TEST(SlotMap, DenseIterationAndHandleAt)
+{
+    SlotMap<int> map;
+    std::vector<SlotMap<int>::Handle> handles;
+    for (int i = 0; i < 10; i++) handles.push_back(map.Insert(i));
+    map.Erase(handles[2]);
+    map.Erase(handles[7]);
+
+    std::set<int> seen;
+    for (int v : map) seen.insert(v);
+    EXPECT_EQ(seen, (std::set<int>{ 0, 1, 3, 4, 5, 6, 8, 9 }));
+    for (size_t i = 0; i < map.size(); i++)
+        EXPECT_EQ(*map.Get(map.HandleAt(i)), *(map.begin() + i));
+}
+
+TEST(SlotMap, ClearInvalidatesEverything)
+{
+    SlotMap<std::unique_ptr<int>> map; // move-only values
+    auto a = map.Emplace(std::make_unique<int>(1));
+    auto b = map.Emplace(std::make_unique<int>(2));
+    map.Clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.Get(a), nullptr);
+    EXPECT_EQ(map.Get(b), nullptr);
+    auto c = map.Emplace(std::make_unique<int>(3));
+    EXPECT_EQ(**map.Get(c), 3);
+}
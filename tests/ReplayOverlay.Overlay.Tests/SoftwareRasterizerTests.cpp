@@ -0,0 +1,193 @@
+#include <gtest/gtest.h>
+#include "SoftwareRasterizer.h"
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr uint32_t Rgba(uint32_t r, uint32_t g, uint32_t b, uint32_t a)
+    {
+        return r | (g << 8) | (b << 16) | (a << 24);
+    }
+
+    // Axis-aligned quad as two triangles sharing the diagonal
+    void AddQuad(GeometryBatcher& batcher, float x, float y, float w, float h, uint32_t colour,
+                 uintptr_t texture = 0)
+    {
+        const BatchVertex v[4] = {
+            { 0.0f, 0.0f, colour, 0.0f, 0.0f }, { w, 0.0f, colour, 1.0f, 0.0f },
+            { w, h, colour, 1.0f, 1.0f }, { 0.0f, h, colour, 0.0f, 1.0f } };
+        const int i[6] = { 0, 1, 2, 0, 2, 3 };
+        batcher.Add(v, 4, i, 6, x, y, texture);
+    }
+
+    size_t CountPixels(const SoftwareRasterizer& r, uint32_t colour)
+    {
+        size_t n = 0;
+        for (int y = 0; y < r.Height(); y++)
+            for (int x = 0; x < r.Width(); x++)
+                n += r.Pixel(x, y) == colour;
+        return n;
+    }
+}
+
+TEST(SoftwareRasterizer, QuadCoversExactPixelsOnce)
+{
+    // Half-transparent: a pixel blended twice along the shared diagonal
+    // would come out darker than the rest
+    GeometryBatcher batcher;
+    RenderCommandList frame;
+    AddQuad(batcher, 2.0f, 3.0f, 10.0f, 5.0f, Rgba(0, 128, 0, 128));
+    batcher.Flush(frame);
+
+    SoftwareRasterizer r;
+    r.Resize(16, 16);
+    r.Render(frame);
+    EXPECT_EQ(CountPixels(r, Rgba(0, 128, 0, 128)), 50u);
+    EXPECT_EQ(r.Pixel(2, 3), Rgba(0, 128, 0, 128));
+    EXPECT_EQ(r.Pixel(11, 7), Rgba(0, 128, 0, 128));
+    EXPECT_EQ(r.Pixel(12, 7), 0u);
+    EXPECT_EQ(r.Pixel(11, 8), 0u);
+    EXPECT_EQ(r.LastFrame().triangles, 2u);
+    EXPECT_EQ(r.LastFrame().fragments, 50u);
+}
+
+TEST(SoftwareRasterizer, BlendsPremultipliedAlpha)
+{
+    GeometryBatcher batcher;
+    RenderCommandList frame;
+    AddQuad(batcher, 0.0f, 0.0f, 4.0f, 4.0f, Rgba(200, 100, 50, 255));
+    AddQuad(batcher, 0.0f, 0.0f, 4.0f, 4.0f, Rgba(0, 0, 102, 102)); // 40% blue, premultiplied
+    batcher.Flush(frame);
+
+    SoftwareRasterizer r;
+    r.Resize(4, 4);
+    r.Render(frame, Rgba(9, 9, 9, 9));
+    // src + dst * (1 - 0.4)
+    EXPECT_EQ(r.Pixel(1, 1), Rgba(120, 60, 132, 255));
+}
+
+TEST(SoftwareRasterizer, ScissorClipsDraws)
+{
+    GeometryBatcher batcher;
+    RenderCommandList frame;
+    batcher.EnableScissor(true);
+    batcher.SetScissor({ 4, 4, 8, 6 });
+    AddQuad(batcher, 0.0f, 0.0f, 16.0f, 16.0f, Rgba(255, 255, 255, 255));
+    batcher.Flush(frame);
+
+    SoftwareRasterizer r;
+    r.Resize(16, 16);
+    r.Render(frame);
+    EXPECT_EQ(CountPixels(r, Rgba(255, 255, 255, 255)), 8u);
+    EXPECT_EQ(r.Pixel(4, 4), Rgba(255, 255, 255, 255));
+    EXPECT_EQ(r.Pixel(8, 4), 0u);
+    EXPECT_EQ(r.Pixel(4, 6), 0u);
+}
+
+TEST(SoftwareRasterizer, SamplesTexturesAtTexelCentres)
+{
+    SoftwareRasterizer::Image image;
+    image.width = image.height = 2;
+    image.texels = { Rgba(255, 0, 0, 255), Rgba(0, 255, 0, 255), Rgba(0, 0, 255, 255), Rgba(128, 128, 128, 128) };
+
+    GeometryBatcher batcher;
+    RenderCommandList frame;
+    AddQuad(batcher, 0.0f, 0.0f, 2.0f, 2.0f, Rgba(255, 255, 255, 255), 42);
+    AddQuad(batcher, 2.0f, 0.0f, 2.0f, 2.0f, Rgba(255, 255, 255, 255), 99); // unresolved: white
+    batcher.Flush(frame);
+
+    SoftwareRasterizer r;
+    r.Resize(4, 2);
+    r.SetTextureLookup([&](uintptr_t handle) { return handle == 42 ? &image : nullptr; });
+    r.Render(frame);
+    EXPECT_EQ(r.Pixel(0, 0), image.texels[0]);
+    EXPECT_EQ(r.Pixel(1, 0), image.texels[1]);
+    EXPECT_EQ(r.Pixel(0, 1), image.texels[2]);
+    EXPECT_EQ(r.Pixel(1, 1), image.texels[3]);
+    EXPECT_EQ(r.Pixel(3, 1), Rgba(255, 255, 255, 255));
+}
+
+TEST(SoftwareRasterizer, ImageDoesNotDependOnThreadCount)
+{
+    // Overlapping translucent triangles across many tiles, with a transform
+    GeometryBatcher batcher;
+    RenderCommandList frame;
+    for (int i = 0; i < 200; i++)
+    {
+        const float x = static_cast<float>((i * 37) % 300);
+        const float y = static_cast<float>((i * 53) % 200);
+        AddQuad(batcher, x, y, 40.0f + i % 50, 25.0f + i % 30, Rgba(i % 128, 64, 128 - i % 128, 128 + i % 127));
+        if (i == 100)
+        {
+            const float rotate[16] = { 0.8f, 0.6f, 0, 0, -0.6f, 0.8f, 0, 0, 0, 0, 1, 0, 60, -20, 0, 1 };
+            batcher.SetTransform(rotate);
+        }
+    }
+    batcher.Flush(frame);
+
+    SoftwareRasterizer single, parallel;
+    single.Resize(333, 250);
+    parallel.Resize(333, 250);
+    single.SetThreads(1);
+    parallel.SetThreads(8);
+    single.Render(frame, Rgba(10, 20, 30, 255));
+    parallel.Render(frame, Rgba(10, 20, 30, 255));
+    EXPECT_EQ(single.Checksum(), parallel.Checksum());
+    EXPECT_EQ(single.LastFrame().fragments, parallel.LastFrame().fragments);
+    EXPECT_GT(single.LastFrame().fragments, 0u);
+    EXPECT_EQ(parallel.GetTotals().frames, 1u);
+    EXPECT_EQ(parallel.GetTotals().pixels, 333u * 250u);
+}
+
+TEST(SoftwareRasterizer, WorkersPersistAcrossFramesAndThreadCounts)
+{
+    GeometryBatcher batcher;
+    RenderCommandList frame;
+    for (int i = 0; i < 50; i++)
+        AddQuad(batcher, static_cast<float>(i * 5), static_cast<float>(i * 3), 60.0f, 40.0f, Rgba(200, i * 4, 50, 160));
+    batcher.Flush(frame);
+
+    SoftwareRasterizer reference;
+    reference.Resize(300, 200);
+    reference.SetThreads(1);
+    reference.Render(frame, Rgba(0, 0, 0, 255));
+
+    // The same workers shade every frame; changing the count restarts them
+    SoftwareRasterizer r;
+    r.Resize(300, 200);
+    for (unsigned threads : { 4u, 4u, 4u, 2u, 1u, 3u, 3u })
+    {
+        r.SetThreads(threads);
+        r.Render(frame, Rgba(0, 0, 0, 255));
+        EXPECT_EQ(r.Checksum(), reference.Checksum());
+        EXPECT_EQ(r.LastFrame().fragments, reference.LastFrame().fragments);
+    }
+    EXPECT_EQ(r.GetTotals().frames, 7u);
+}
+
+TEST(SoftwareRasterizer, WritesPpm)
+{
+    GeometryBatcher batcher;
+    RenderCommandList frame;
+    AddQuad(batcher, 0.0f, 0.0f, 1.0f, 1.0f, Rgba(1, 2, 3, 255));
+    batcher.Flush(frame);
+
+    SoftwareRasterizer r;
+    r.Resize(3, 2);
+    r.Render(frame);
+    const std::string path = ::testing::TempDir() + "raster_test.ppm";
+    ASSERT_TRUE(r.WritePpm(path));
+
+    std::ifstream in(path, std::ios::binary);
+    std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    const std::string header = "P6\n3 2\n255\n";
+    ASSERT_EQ(data.size(), header.size() + 3 * 2 * 3);
+    EXPECT_EQ(data.substr(0, header.size()), header);
+    EXPECT_EQ(data[header.size()], 1);
+    EXPECT_EQ(data[header.size() + 2], 3);
+    EXPECT_EQ(data[header.size() + 3], 0);
+    std::remove(path.c_str());
+}
@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+#include "StartupTimeline.h"
+
+TEST(StartupTimeline, MarksAreRelativeToStart)
+{
+    StartupTimeline t;
+    t.Start(1000000);
+    t.Mark("window", 3000000);
+    t.Mark("renderer", 10000000);
+    ASSERT_EQ(t.Count(), 2);
+    EXPECT_STREQ(t.At(0).name, "window");
+    EXPECT_EQ(t.At(0).atNs, 2000000u);
+    EXPECT_EQ(t.At(1).atNs, 9000000u);
+    EXPECT_DOUBLE_EQ(t.TotalMs(), 9.0);
+}
+
+TEST(StartupTimeline, MarksBeforeStartAreIgnored)
+{
+    StartupTimeline t;
+    t.Mark("early", 5);
+    EXPECT_EQ(t.Count(), 0);
+    EXPECT_FALSE(t.Finish("first_frame", 10));
+}
+
+TEST(StartupTimeline, FinishClosesTheTimelineOnce)
+{
+    StartupTimeline t;
+    t.Start(0);
+    EXPECT_TRUE(t.Finish("first_frame", 4000000));
+    EXPECT_TRUE(t.IsFinished());
+    EXPECT_FALSE(t.Finish("first_frame", 5000000));
+    t.Mark("late", 6000000);
+    EXPECT_EQ(t.Count(), 1);
+    EXPECT_DOUBLE_EQ(t.TotalMs(), 4.0);
+}
+
+TEST(StartupTimeline, KeepsAtMostMaxMarks)
+{
+    StartupTimeline t;
+    t.Start(0);
+    for (int i = 0; i < StartupTimeline::MaxMarks + 4; i++)
+        t.Mark("step", static_cast<uint64_t>(i + 1));
+    EXPECT_EQ(t.Count(), StartupTimeline::MaxMarks);
+}
+
+TEST(StartupTimeline, ReportAndLineShowSteps)
+{
+    StartupTimeline t;
+    t.Start(0);
+    t.Mark("window", 2000000);
+    t.Finish("first_frame", 5000000);
+
+    nlohmann::json r = t.Report();
+    ASSERT_EQ(r["marks"].size(), 2u);
+    EXPECT_EQ(r["marks"][1]["name"], "first_frame");
+    EXPECT_DOUBLE_EQ(r["marks"][1]["at_ms"].get<double>(), 5.0);
+    EXPECT_DOUBLE_EQ(r["marks"][1]["step_ms"].get<double>(), 3.0);
+    EXPECT_TRUE(r["complete"].get<bool>());
+
+    EXPECT_EQ(t.FormatLine(), "startup (ms, step): window 2.0 first_frame 3.0 = 5.0");
+}
@@ -0,0 +1,39 @@
+#include <gtest/gtest.h>
+#include "AllocCounter.h"
+#include "StatsFormat.h"
+
+// Built into OverlayAllocTests, not OverlayTests (see AllocCounter.h)
+
+static StatsState MakeStats()
+{
+    StatsState s;
+    s.activeFps = 59.94;
+    s.cpuUsage = 12.345;
+    s.memoryUsage = 812.6;
+    s.availableDiskSpace = 40960.0; // MB
+    s.averageFrameRenderTime = 1.234;
+    s.renderSkippedFrames = 3;
+    s.renderTotalFrames = 12000;
+    s.outputSkippedFrames = 0;
+    s.outputTotalFrames = 11990;
+    return s;
+}
+
+TEST(StatsFormat, ResyncWithSameValuesDoesNotAllocate)
+{
+    StatsPresenter p;
+    StatsHistory h;
+    auto s = MakeStats();
+    float sample[StatsHistory::MetricCount] = { 60.0f, 12.0f, 800.0f, 1.2f, 0.0f, 0.0f };
+    h.Push(0.0, sample);
+    p.SyncStats(s);
+    p.SyncTrends(h);
+
+    AllocScope scope;
+    for (int i = 0; i < 100; i++)
+    {
+        p.SyncStats(s);
+        p.SyncTrends(h);
+    }
+    EXPECT_EQ(scope.Count(), 0);
+}
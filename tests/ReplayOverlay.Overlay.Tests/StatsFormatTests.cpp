@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include "StatsFormat.h"
+
+static StatsState MakeStats()
+{
+    StatsState s;
+    s.activeFps = 59.94;
+    s.cpuUsage = 12.345;
+    s.memoryUsage = 812.6;
+    s.availableDiskSpace = 40960.0; // MB
+    s.averageFrameRenderTime = 1.234;
+    s.renderSkippedFrames = 3;
+    s.renderTotalFrames = 12000;
+    s.outputSkippedFrames = 0;
+    s.outputTotalFrames = 11990;
+    return s;
+}
+
+TEST(StatsFormat, FormatsLikePrintf)
+{
+    StatsPresenter p;
+    p.SyncStats(MakeStats());
+    EXPECT_EQ(p.Text(StatsPresenter::Fps), "59.9");
+    EXPECT_EQ(p.Text(StatsPresenter::Cpu), "12.3%");
+    EXPECT_EQ(p.Text(StatsPresenter::Memory), "813 MB");
+    EXPECT_EQ(p.Text(StatsPresenter::FrameTime), "1.23 ms");
+    EXPECT_EQ(p.Text(StatsPresenter::Disk), "40.0 GB");
+    EXPECT_EQ(p.Text(StatsPresenter::RenderSkip), "3/12000");
+    EXPECT_EQ(p.Text(StatsPresenter::OutputSkip), "0/11990");
+}
+
+TEST(StatsFormat, ColorsComeFromTable)
+{
+    StatsPresenter p;
+    p.SyncStats(MakeStats());
+    EXPECT_EQ(p.Text(StatsPresenter::FpsColorField), "#4ecca3");
+    EXPECT_EQ(p.Text(StatsPresenter::DiskColorField), "#eaeaea");
+    EXPECT_EQ(p.Text(StatsPresenter::RenderSkipColorField), "#e94560");
+    EXPECT_EQ(p.Text(StatsPresenter::OutputSkipColorField), "#eaeaea");
+
+    EXPECT_EQ(FpsColor(40.0), StatColor::Warn);
+    EXPECT_EQ(CpuColor(90.0), StatColor::Bad);
+    EXPECT_EQ(DiskColor(0.5), StatColor::Bad);
+}
+
+TEST(StatsFormat, FirstSyncReportsEveryStatsField)
+{
+    StatsPresenter p;
+    uint32_t changed = p.SyncStats(MakeStats());
+    for (int f = StatsPresenter::Fps; f <= StatsPresenter::OutputSkipColorField; f++)
+        EXPECT_TRUE(changed & (1u << f)) << StatsPresenter::VariableName(f);
+}
+
+TEST(StatsFormat, UnchangedStatsReportNothing)
+{
+    StatsPresenter p;
+    auto s = MakeStats();
+    p.SyncStats(s);
+    EXPECT_EQ(p.SyncStats(s), 0u);
+
+    s.activeFps = 30.0;
+    uint32_t changed = p.SyncStats(s);
+    EXPECT_EQ(changed, (1u << StatsPresenter::Fps) | (1u << StatsPresenter::FpsColorField));
+}
+
+TEST(StatsFormat, TrendPlaceholderWhenEmpty)
+{
+    StatsPresenter p;
+    StatsHistory h;
+    p.SyncTrends(h);
+    EXPECT_EQ(p.Text(StatsPresenter::TrendFps1m), "--");
+}
@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include "StatsHistory.h"
+#include "OverlayState.h"
+
+static void PushFps(StatsHistory& h, double t, float fps)
+{
+    float sample[StatsHistory::MetricCount] = {};
+    sample[static_cast<int>(StatsMetric::Fps)] = fps;
+    h.Push(t, sample);
+}
+
+TEST(StatsHistory, EmptySummaryHasZeroCount)
+{
+    StatsHistory h;
+    auto s = h.Summarize(StatsMetric::Fps, StatsHistory::Window1m);
+    EXPECT_EQ(s.count, 0);
+    EXPECT_EQ(h.Sequence(), 0u);
+}
+
+TEST(StatsHistory, MinMaxMeanOverWindow)
+{
+    StatsHistory h;
+    PushFps(h, 0.0, 60.0f);
+    PushFps(h, 1.0, 30.0f);
+    PushFps(h, 2.0, 45.0f);
+
+    auto s = h.Summarize(StatsMetric::Fps, StatsHistory::Window1m);
+    EXPECT_EQ(s.count, 3);
+    EXPECT_FLOAT_EQ(s.min, 30.0f);
+    EXPECT_FLOAT_EQ(s.max, 60.0f);
+    EXPECT_NEAR(s.mean, 45.0f, 1e-4f);
+}
+
+TEST(StatsHistory, ShortWindowEvictsOldSamples)
+{
+    StatsHistory h;
+    PushFps(h, 0.0, 10.0f);   // only in the 10 min window after t=61
+    for (int i = 1; i <= 61; i++)
+        PushFps(h, static_cast<double>(i), 60.0f);
+
+    auto s1 = h.Summarize(StatsMetric::Fps, StatsHistory::Window1m);
+    EXPECT_FLOAT_EQ(s1.min, 60.0f);
+    EXPECT_EQ(s1.count, 61);
+
+    auto s10 = h.Summarize(StatsMetric::Fps, StatsHistory::Window10m);
+    EXPECT_FLOAT_EQ(s10.min, 10.0f);
+    EXPECT_EQ(s10.count, 62);
+}
+
+TEST(StatsHistory, MinTracksAfterExtremeLeavesWindow)
+{
+    StatsHistory h(5.0, 50.0);
+    PushFps(h, 0.0, 90.0f);
+    PushFps(h, 1.0, 20.0f);
+    PushFps(h, 2.0, 50.0f);
+    PushFps(h, 3.0, 40.0f);
+    PushFps(h, 7.0, 70.0f); // evicts t=0 and t=1
+
+    auto s = h.Summarize(StatsMetric::Fps, StatsHistory::Window1m);
+    EXPECT_EQ(s.count, 3);
+    EXPECT_FLOAT_EQ(s.min, 40.0f);
+    EXPECT_FLOAT_EQ(s.max, 70.0f);
+}
+
+TEST(StatsHistory, PercentilesApproximateDistribution)
+{
+    StatsHistory h;
+    // 100 samples: 0..99 FPS, one per 0.5 s (all inside 1 min)
+    for (int i = 0; i < 100; i++)
+        PushFps(h, i * 0.5, static_cast<float>(i));
+
+    auto s = h.Summarize(StatsMetric::Fps, StatsHistory::Window1m);
+    // Bin width for FPS is 240/128 ~ 1.9, so allow one bin of error
+    EXPECT_NEAR(s.p95, 94.0f, 2.0f);
+    EXPECT_NEAR(s.p99, 98.0f, 2.0f);
+    EXPECT_LE(s.p99, s.max);
+}
+
+TEST(StatsHistory, CapacityOverflowKeepsLatestSamples)
+{
+    StatsHistory h(1e9, 1e9); // windows never expire by time
+    for (int i = 0; i < StatsHistory::Capacity + 10; i++)
+        PushFps(h, static_cast<double>(i), static_cast<float>(i % 100));
+
+    auto s = h.Summarize(StatsMetric::Fps, StatsHistory::Window10m);
+    EXPECT_EQ(s.count, StatsHistory::Capacity);
+    EXPECT_FLOAT_EQ(s.min, 0.0f);
+    EXPECT_FLOAT_EQ(s.max, 99.0f);
+}
+
+TEST(StatsHistory, IntervalPercentUsesDeltas)
+{
+    EXPECT_FLOAT_EQ(StatsHistory::IntervalPercent(15, 200, 5, 100), 10.0f);
+    EXPECT_FLOAT_EQ(StatsHistory::IntervalPercent(5, 100, 5, 100), 0.0f);
+    // Counter reset
+    EXPECT_FLOAT_EQ(StatsHistory::IntervalPercent(0, 10, 50, 1000), 0.0f);
+}
+
+TEST(OverlayState, UpdateFromStatsJson_RecordsHistory)
+{
+    OverlayState state;
+    state.UpdateFromStatsJson({{"activeFps", 60.0}, {"renderSkippedFrames", 0}, {"renderTotalFrames", 100}}, 1.0);
+    state.UpdateFromStatsJson({{"activeFps", 50.0}, {"renderSkippedFrames", 5}, {"renderTotalFrames", 200}}, 2.0);
+    state.UpdateFromStatsJson({{"activeFps", 60.0}, {"renderSkippedFrames", 5}, {"renderTotalFrames", 300}}, 3.0);
+
+    EXPECT_EQ(state.statsHistory.Sequence(), 2u);
+    auto fps = state.statsHistory.Summarize(StatsMetric::Fps, StatsHistory::Window1m);
+    EXPECT_FLOAT_EQ(fps.min, 50.0f);
+    EXPECT_FLOAT_EQ(fps.max, 60.0f);
+    auto skip = state.statsHistory.Summarize(StatsMetric::RenderSkipPct, StatsHistory::Window1m);
+    EXPECT_FLOAT_EQ(skip.max, 5.0f);
+}
+
+TEST(OverlayState, UpdateFromStatsJson_FirstResponseIsOnlyABaseline)
+{
+    // Counters accumulated since OBS started are not one interval's skips
+    OverlayState state;
+    state.UpdateFromStatsJson({{"activeFps", 60.0}, {"renderSkippedFrames", 900}, {"renderTotalFrames", 1000}}, 1.0);
+    EXPECT_EQ(state.statsHistory.Sequence(), 0u);
+    EXPECT_EQ(state.stats.renderSkippedFrames, 900);
+
+    state.UpdateFromStatsJson({{"activeFps", 60.0}, {"renderSkippedFrames", 901}, {"renderTotalFrames", 1100}}, 2.0);
+    EXPECT_EQ(state.statsHistory.Sequence(), 1u);
+    auto skip = state.statsHistory.Summarize(StatsMetric::RenderSkipPct, StatsHistory::Window10m);
+    EXPECT_FLOAT_EQ(skip.max, 1.0f);
+}
@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include "SurfaceLayout.h"
+
+namespace
+{
+    using Rect = SurfaceLayout::Rect;
+    constexpr int S = SurfaceLayout::Slack;
+
+    // 4K screen, 700dp panel at 150% centred 40dp from the top, REC dot top right
+    constexpr Rect Panel = { 1395, 60, 2445, 960 };
+    constexpr Rect Rec = { 3700, 30, 3810, 70 };
+
+    SurfaceLayout Screen()
+    {
+        SurfaceLayout layout;
+        layout.SetScreen(3840, 2160);
+        return layout;
+    }
+}
+
+TEST(SurfaceLayout, RectHelpers)
+{
+    const Rect a = { 0, 0, 10, 10 }, b = { 5, 5, 20, 8 };
+    EXPECT_TRUE(SurfaceLayout::Union(a, b) == (Rect{ 0, 0, 20, 10 }));
+    EXPECT_TRUE(SurfaceLayout::Union(Rect{}, b) == b);
+    EXPECT_TRUE(SurfaceLayout::Intersect(a, b) == (Rect{ 5, 5, 10, 8 }));
+    EXPECT_TRUE(SurfaceLayout::Intersect(a, { 10, 0, 20, 10 }).Empty());
+    EXPECT_TRUE(SurfaceLayout::Inflate(a, 2) == (Rect{ -2, -2, 12, 12 }));
+    EXPECT_TRUE(a.Contains(Rect{ 2, 2, 10, 10 }));
+    EXPECT_FALSE(a.Contains(b));
+}
+
+TEST(SurfaceLayout, FirstUpdatePlacesAtOnce)
+{
+    SurfaceLayout layout = Screen();
+    EXPECT_TRUE(layout.Placement() == (Rect{ 0, 0, 3840, 2160 })); // the window as created
+
+    layout.BeginFrame();
+    layout.Add(Panel);
+    EXPECT_TRUE(layout.Update(0.0));
+    EXPECT_TRUE(layout.Placement() == SurfaceLayout::Inflate(Panel, S));
+    EXPECT_EQ(layout.Changes(), 1u);
+
+    layout.BeginFrame();
+    layout.Add(Panel);
+    EXPECT_FALSE(layout.Update(0.1));
+    EXPECT_EQ(layout.Changes(), 1u);
+}
+
+TEST(SurfaceLayout, GrowsAtOnceButNotWithinSlack)
+{
+    SurfaceLayout layout = Screen();
+    layout.Add(Panel);
+    layout.Update(0.0);
+
+    // The panel grew a row: still inside the slack
+    layout.BeginFrame();
+    layout.Add(Panel.left, Panel.top, Panel.right - Panel.left, Panel.bottom - Panel.top + 20);
+    EXPECT_FALSE(layout.Update(0.1));
+
+    // The REC indicator appeared: covered this frame
+    layout.Add(Rec);
+    EXPECT_TRUE(layout.Update(0.2));
+    EXPECT_TRUE(layout.Placement().Contains(layout.Content()));
+    EXPECT_TRUE(layout.Placement() == (Rect{ Panel.left - S, 0, 3840, Panel.bottom + 20 + S }));
+}
+
+TEST(SurfaceLayout, ShrinksOnlyAfterTheDelay)
+{
+    SurfaceLayout layout = Screen();
+    layout.Add(Panel);
+    layout.Add(Rec);
+    layout.Update(0.0);
+
+    // Panel hidden: the surface is oversized, but kept for a while
+    layout.BeginFrame();
+    layout.Add(Rec);
+    EXPECT_FALSE(layout.Update(1.0));
+    EXPECT_DOUBLE_EQ(layout.ShrinkAt(), 1.0 + SurfaceLayout::ShrinkDelayS);
+
+    // Shown again in time: nothing happens
+    layout.Add(Panel);
+    EXPECT_FALSE(layout.Update(1.5));
+    EXPECT_LT(layout.ShrinkAt(), 0.0);
+
+    layout.BeginFrame();
+    layout.Add(Rec);
+    EXPECT_FALSE(layout.Update(2.0));
+    EXPECT_FALSE(layout.Update(2.0 + SurfaceLayout::ShrinkDelayS * 0.5));
+    EXPECT_TRUE(layout.Update(2.0 + SurfaceLayout::ShrinkDelayS));
+    EXPECT_TRUE(layout.Placement() == (Rect{ Rec.left - S, 0, 3840, Rec.bottom + S }));
+    EXPECT_LT(layout.ShrinkAt(), 0.0);
+    EXPECT_EQ(layout.Changes(), 2u);
+
+    // Clipped to the screen edge is not oversized
+    EXPECT_FALSE(layout.Update(10.0));
+    EXPECT_LT(layout.ShrinkAt(), 0.0);
+}
+
+TEST(SurfaceLayout, NothingVisibleShrinksToMinimum)
+{
+    SurfaceLayout layout = Screen();
+    layout.BeginFrame();
+    EXPECT_TRUE(layout.Update(0.0));
+    EXPECT_TRUE(layout.Placement() == (Rect{ 0, 0, SurfaceLayout::MinSize, SurfaceLayout::MinSize }));
+
+    layout.Add(Rec);
+    EXPECT_TRUE(layout.Update(0.1));
+    layout.BeginFrame();
+    EXPECT_FALSE(layout.Update(0.2));
+    EXPECT_TRUE(layout.Update(0.2 + SurfaceLayout::ShrinkDelayS));
+    EXPECT_EQ(layout.Placement().Width(), SurfaceLayout::MinSize);
+}
+
+TEST(SurfaceLayout, ContentOffScreenIsIgnored)
+{
+    SurfaceLayout layout = Screen();
+    layout.Add(Rect{ -500, -500, -100, -100 });
+    layout.Add(Rect{ 3800, 2100, 4000, 2300 });
+    layout.Update(0.0);
+    EXPECT_TRUE(layout.Placement() == (Rect{ 3800 - S, 2100 - S, 3840, 2160 }));
+
+    // A new screen size places the surface again at once
+    layout.SetScreen(1920, 1080);
+    layout.BeginFrame();
+    layout.Add(Rect{ 100, 100, 200, 200 });
+    EXPECT_TRUE(layout.Update(0.1));
+    EXPECT_TRUE(layout.Placement() == (Rect{ 100 - S, 100 - S, 200 + S, 200 + S }));
+}
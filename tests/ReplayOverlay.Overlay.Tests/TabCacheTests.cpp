@@ -0,0 +1,185 @@
+#include <gtest/gtest.h>
+#include "TabCache.h"
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Records what the cache asked for; each tab has a fixed element cost
+    struct FakeTabHost
+    {
+        std::map<std::string, size_t> costs;
+        std::map<std::string, bool> built;   // name -> visible
+        std::vector<std::string> log;
+
+        size_t BuildTab(const std::string& name)
+        {
+            auto it = costs.find(name);
+            if (it == costs.end()) return 0;
+            built[name] = false;
+            log.push_back("build " + name);
+            return it->second;
+        }
+        size_t TabCost(const std::string& name) { return costs[name]; }
+        void ShowTab(const std::string& name, bool visible) { built[name] = visible; }
+        void DestroyTab(const std::string& name)
+        {
+            built.erase(name);
+            log.push_back("destroy " + name);
+        }
+        bool Visible(const std::string& name) const
+        {
+            auto it = built.find(name);
+            return it != built.end() && it->second;
+        }
+    };
+
+    using Cache = TabCache<FakeTabHost>;
+}
+
+TEST(TabCache, FirstVisitBuildsThenStaysResident)
+{
+    FakeTabHost host;
+    host.costs = { {"main", 100}, {"audio", 200} };
+    Cache cache(host, 1000);
+
+    EXPECT_EQ(cache.Activate("main"), Cache::Result::Cold);
+    EXPECT_EQ(cache.Activate("audio"), Cache::Result::Cold);
+    EXPECT_EQ(cache.Activate("main"), Cache::Result::Warm);
+    EXPECT_EQ(cache.Activate("main"), Cache::Result::Unchanged);
+
+    EXPECT_EQ(cache.Builds(), 2u);
+    EXPECT_EQ(cache.Hits(), 1u);
+    EXPECT_EQ(cache.Cost(), 300u);
+    EXPECT_TRUE(host.Visible("main"));
+    EXPECT_FALSE(host.Visible("audio"));
+    EXPECT_TRUE(cache.IsResident("audio"));
+}
+
+TEST(TabCache, UnknownTabFailsAndKeepsCurrent)
+{
+    FakeTabHost host;
+    host.costs = { {"main", 100} };
+    Cache cache(host, 1000);
+    cache.Activate("main");
+
+    EXPECT_EQ(cache.Activate("bogus"), Cache::Result::Failed);
+    EXPECT_EQ(cache.Active(), "main");
+    EXPECT_TRUE(host.Visible("main"));
+}
+
+TEST(TabCache, EvictsLeastRecentlyUsedHiddenPane)
+{
+    FakeTabHost host;
+    host.costs = { {"a", 100}, {"b", 100}, {"c", 100}, {"d", 100} };
+    Cache cache(host, 300);
+
+    cache.Activate("a");
+    cache.Activate("b");
+    cache.Activate("c");
+    cache.Activate("a"); // b is now least recently used
+    uint32_t gen = cache.Generation();
+    cache.Activate("d");
+
+    EXPECT_FALSE(cache.IsResident("b"));
+    EXPECT_TRUE(cache.IsResident("a"));
+    EXPECT_TRUE(cache.IsResident("c"));
+    EXPECT_EQ(cache.Evictions(), 1u);
+    EXPECT_EQ(cache.Cost(), 300u);
+    EXPECT_NE(cache.Generation(), gen);
+}
+
+TEST(TabCache, NeverEvictsTheActivePane)
+{
+    FakeTabHost host;
+    host.costs = { {"small", 50}, {"huge", 500} };
+    Cache cache(host, 100);
+
+    cache.Activate("small");
+    EXPECT_EQ(cache.Activate("huge"), Cache::Result::Cold);
+    EXPECT_TRUE(cache.IsResident("huge"));
+    EXPECT_FALSE(cache.IsResident("small"));
+    EXPECT_TRUE(host.Visible("huge"));
+}
+
+TEST(TabCache, RemeasuresPaneWhenHidden)
+{
+    FakeTabHost host;
+    host.costs = { {"a", 100}, {"b", 100} };
+    Cache cache(host, 1000);
+
+    cache.Activate("a");
+    host.costs["a"] = 400; // a data-for list grew while open
+    cache.Activate("b");
+    EXPECT_EQ(cache.Cost(), 500u);
+}
+
+TEST(TabCache, PrebuildFillsBudgetWithoutEvicting)
+{
+    FakeTabHost host;
+    host.costs = { {"main", 100}, {"audio", 100}, {"stats", 100}, {"settings", 500} };
+    Cache cache(host, 350);
+    cache.Activate("main");
+
+    const std::vector<std::string> order = { "main", "audio", "settings", "stats" };
+    EXPECT_TRUE(cache.Prebuild(order));  // audio
+    EXPECT_FALSE(cache.Prebuild(order)); // settings doesn't fit; dropped
+    EXPECT_TRUE(cache.Prebuild(order));  // stats
+    EXPECT_FALSE(cache.Prebuild(order)); // nothing left
+
+    EXPECT_EQ(cache.Prebuilt(), 2u);
+    EXPECT_EQ(cache.Evictions(), 0u);
+    EXPECT_TRUE(cache.IsResident("audio"));
+    EXPECT_TRUE(cache.IsResident("stats"));
+    EXPECT_FALSE(cache.IsResident("settings"));
+    EXPECT_FALSE(host.Visible("audio"));
+    EXPECT_EQ(cache.Activate("audio"), Cache::Result::Warm);
+}
+
+TEST(TabCache, PrebuiltPanesAreEvictedFirst)
+{
+    FakeTabHost host;
+    host.costs = { {"a", 100}, {"b", 100}, {"c", 100} };
+    Cache cache(host, 200);
+    cache.Activate("a");
+    cache.Prebuild({ "b" });
+    cache.Activate("c");
+
+    EXPECT_FALSE(cache.IsResident("b"));
+    EXPECT_TRUE(cache.IsResident("a"));
+}
+
+TEST(TabCache, PrebuildRetriesATabOnceThereIsRoom)
+{
+    FakeTabHost host;
+    host.costs = { {"main", 100}, {"audio", 100}, {"settings", 200} };
+    Cache cache(host, 350);
+    cache.Activate("main");
+
+    const std::vector<std::string> order = { "main", "audio", "settings" };
+    EXPECT_TRUE(cache.Prebuild(order));  // audio
+    EXPECT_FALSE(cache.Prebuild(order)); // settings: 400 > 350, destroyed
+    EXPECT_FALSE(cache.Prebuild(order)); // still no room: not rebuilt
+    EXPECT_EQ(std::count(host.log.begin(), host.log.end(), "build settings"), 1);
+
+    host.costs["main"] = 20; // re-measured on the way out
+    cache.Activate("audio");
+    EXPECT_TRUE(cache.Prebuild(order));
+    EXPECT_TRUE(cache.IsResident("settings"));
+    EXPECT_EQ(cache.Cost(), 320u);
+    EXPECT_EQ(cache.Evictions(), 0u);
+}
+
+TEST(TabCache, PrebuildGivesUpOnFailedBuilds)
+{
+    FakeTabHost host;
+    host.costs = { {"main", 100} };
+    Cache cache(host, 1000);
+    cache.Activate("main");
+    EXPECT_FALSE(cache.Prebuild({ "missing" }));
+    host.costs["missing"] = 100;
+    EXPECT_FALSE(cache.Prebuild({ "missing" }));
+    EXPECT_FALSE(cache.IsResident("missing"));
+}
@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+#include "TextureAtlas.h"
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+    // RGBA texels that encode their texture id and coordinates
+    std::vector<uint8_t> MakeTexture(int id, int w, int h)
+    {
+        std::vector<uint8_t> px(static_cast<size_t>(w) * h * 4);
+        for (int y = 0; y < h; y++)
+            for (int x = 0; x < w; x++)
+            {
+                uint8_t* p = &px[(static_cast<size_t>(y) * w + x) * 4];
+                p[0] = static_cast<uint8_t>(id);
+                p[1] = static_cast<uint8_t>(x);
+                p[2] = static_cast<uint8_t>(y);
+                p[3] = 255;
+            }
+        return px;
+    }
+
+    // CPU stand-in for the page texture upload
+    struct PageImage
+    {
+        int size;
+        std::vector<uint8_t> texels;
+        explicit PageImage(int s) : size(s), texels(static_cast<size_t>(s) * s * 4, 0) {}
+
+        void Blit(const TextureAtlas::Placement& p, const std::vector<uint8_t>& src)
+        {
+            const int b = TextureAtlas::Border;
+            const int w = p.width + 2 * b, h = p.height + 2 * b;
+            std::vector<uint8_t> bordered(static_cast<size_t>(w) * h * 4);
+            TextureAtlas::CopyWithBorder(src.data(), p.width, p.height, bordered.data());
+            for (int y = 0; y < h; y++)
+                std::copy(&bordered[static_cast<size_t>(y) * w * 4], &bordered[static_cast<size_t>(y + 1) * w * 4],
+                          &texels[(static_cast<size_t>(p.y - b + y) * size + (p.x - b)) * 4]);
+        }
+
+        // Nearest-texel sample, like the UI sampler at texel centres
+        const uint8_t* Sample(float u, float v) const
+        {
+            int x = static_cast<int>(std::floor(u * size));
+            int y = static_cast<int>(std::floor(v * size));
+            return &texels[(static_cast<size_t>(y) * size + x) * 4];
+        }
+    };
+}
+
+TEST(TextureAtlas, SmallTexturesShareAPageLargeOnesDoNotFit)
+{
+    TextureAtlas atlas(512, 128);
+    bool newPage = false;
+    auto a = atlas.Insert(64, 32, &newPage);
+    EXPECT_TRUE(newPage);
+    auto b = atlas.Insert(100, 20, &newPage);
+    EXPECT_FALSE(newPage);
+    ASSERT_TRUE(a.Valid());
+    ASSERT_TRUE(b.Valid());
+    EXPECT_EQ(a.page, b.page);
+
+    EXPECT_FALSE(atlas.Fits(129, 10));
+    EXPECT_FALSE(atlas.Insert(129, 10).Valid());
+    EXPECT_FALSE(atlas.Insert(0, 10).Valid());
+    EXPECT_EQ(atlas.PageCount(), 1u);
+}
+
+TEST(TextureAtlas, EntriesAndBordersNeverOverlap)
+{
+    TextureAtlas atlas(256, 64);
+    std::mt19937 rng(3);
+    std::vector<TextureAtlas::Placement> placed;
+    for (int i = 0; i < 200; i++)
+        placed.push_back(atlas.Insert(4 + static_cast<int>(rng() % 60), 4 + static_cast<int>(rng() % 60)));
+
+    const int b = TextureAtlas::Border;
+    for (size_t i = 0; i < placed.size(); i++)
+    {
+        const auto& p = placed[i];
+        ASSERT_TRUE(p.Valid());
+        EXPECT_GE(p.x - b, 0);
+        EXPECT_GE(p.y - b, 0);
+        EXPECT_LE(p.x + p.width + b, 256);
+        EXPECT_LE(p.y + p.height + b, 256);
+        for (size_t j = 0; j < i; j++)
+        {
+            const auto& q = placed[j];
+            if (p.page != q.page) continue;
+            const bool apart = p.x + p.width + b <= q.x - b || q.x + q.width + b <= p.x - b ||
+                               p.y + p.height + b <= q.y - b || q.y + q.height + b <= p.y - b;
+            ASSERT_TRUE(apart) << i << " overlaps " << j;
+        }
+    }
+}
+
+TEST(TextureAtlas, PacksGlyphSizedEntriesEfficiently)
+{
+    // Fill exactly one page with glyph-run-sized textures, then measure how
+    // much of it is in use when the packer first gives up
+    TextureAtlas atlas(1024, 128);
+    std::mt19937 rng(11);
+    while (true)
+    {
+        bool newPage = false;
+        atlas.Insert(8 + static_cast<int>(rng() % 56), 10 + static_cast<int>(rng() % 30), &newPage);
+        if (newPage && atlas.PageCount() == 2) break;
+    }
+    auto s = atlas.GetStats();
+    // Occupancy over both pages, minus the one entry on the new page
+    const double firstPage = static_cast<double>(s.usedTexels) / (1024.0 * 1024.0);
+    EXPECT_GT(firstPage, 0.80);
+}
+
+TEST(TextureAtlas, ReleasingEveryEntryResetsThePage)
+{
+    TextureAtlas atlas(128, 64);
+    std::vector<TextureAtlas::Placement> placed;
+    for (int i = 0; i < 4; i++) placed.push_back(atlas.Insert(60, 60));
+    EXPECT_EQ(atlas.PageCount(), 1u);
+    bool newPage = false;
+    atlas.Insert(60, 60, &newPage); // page 0 is full
+    EXPECT_TRUE(newPage);
+
+    for (const auto& p : placed) atlas.Release(p);
+    EXPECT_EQ(atlas.GetStats().entries, 1u);
+    auto again = atlas.Insert(60, 60, &newPage);
+    EXPECT_FALSE(newPage);
+    EXPECT_EQ(again.page, 0u);
+    EXPECT_EQ(again.x, TextureAtlas::Border);
+}
+
+TEST(TextureAtlas, RemappedUvsSampleTheOriginalTexels)
+{
+    TextureAtlas atlas(256, 128);
+    PageImage page(256);
+    struct Entry { int id, w, h; TextureAtlas::Placement p; std::vector<uint8_t> px; };
+    std::vector<Entry> entries;
+    const int sizes[][2] = { { 16, 16 }, { 40, 9 }, { 7, 33 }, { 100, 50 }, { 1, 1 } };
+    for (int id = 0; id < 5; id++)
+    {
+        Entry e{ id + 1, sizes[id][0], sizes[id][1], {}, {} };
+        e.px = MakeTexture(e.id, e.w, e.h);
+        e.p = atlas.Insert(e.w, e.h);
+        ASSERT_EQ(e.p.page, 0u);
+        page.Blit(e.p, e.px);
+        entries.push_back(std::move(e));
+    }
+
+    for (const Entry& e : entries)
+    {
+        const UvTransform uv = atlas.UvFor(e.p);
+        // Remap through the batcher, as RenderGeometry does
+        std::vector<BatchVertex> src, dst;
+        for (int y = 0; y < e.h; y++)
+            for (int x = 0; x < e.w; x++)
+                src.push_back({ 0, 0, 0, (x + 0.5f) / e.w, (y + 0.5f) / e.h });
+        dst.resize(src.size());
+        GeometryBatcher::BakeTranslationUv(src.data(), dst.data(), src.size(), 0, 0, uv);
+
+        for (int y = 0; y < e.h; y++)
+            for (int x = 0; x < e.w; x++)
+            {
+                const BatchVertex& v = dst[static_cast<size_t>(y) * e.w + x];
+                const uint8_t* t = page.Sample(v.u, v.v);
+                ASSERT_EQ(t[0], e.id);
+                ASSERT_EQ(t[1], x);
+                ASSERT_EQ(t[2], y);
+            }
+
+        // UV 0 and 1 land on the border, which repeats the edge texels
+        const uint8_t* corner = page.Sample(uv.offsetU - 0.5f / 256, uv.offsetV - 0.5f / 256);
+        EXPECT_EQ(corner[0], e.id);
+        EXPECT_EQ(corner[1], 0);
+        const uint8_t* far = page.Sample(uv.offsetU + uv.scaleU + 0.5f / 256, uv.offsetV + uv.scaleV + 0.5f / 256);
+        EXPECT_EQ(far[0], e.id);
+        EXPECT_EQ(far[1], e.w - 1);
+        EXPECT_EQ(far[2], e.h - 1);
+    }
+}
@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+#include "TraceRecorder.h"
+#include <nlohmann/json.hpp>
+#include <atomic>
+#include <sstream>
+#include <thread>
+
+static nlohmann::json Dump(TraceRecorder& r)
+{
+    std::ostringstream out;
+    r.WriteJson(out);
+    return nlohmann::json::parse(out.str());
+}
+
+TEST(TraceRecorder, DisabledRecordsNothing)
+{
+    TraceRecorder r;
+    r.Instant("ignored");
+    {
+        TraceScope scope("ignored", r);
+    }
+    EXPECT_EQ(Dump(r)["traceEvents"].size(), 0u);
+}
+
+TEST(TraceRecorder, EmitsChromeTraceEvents)
+{
+    TraceRecorder r;
+    r.SetEnabled(true);
+    r.Begin("frame");
+    {
+        TraceScope scope("ipc.handle", "state_update", r);
+    }
+    r.Instant("config_received");
+    r.Counter("texture_bytes", 4096);
+    r.End("frame");
+
+    auto events = Dump(r)["traceEvents"];
+    ASSERT_EQ(events.size(), 5u);
+    EXPECT_EQ(events[0]["ph"], "B");
+    EXPECT_EQ(events[1]["ph"], "X");
+    EXPECT_EQ(events[1]["name"], "ipc.handle");
+    EXPECT_EQ(events[1]["args"]["detail"], "state_update");
+    EXPECT_GE(events[1]["dur"].get<double>(), 0.0);
+    EXPECT_EQ(events[2]["ph"], "i");
+    EXPECT_EQ(events[3]["ph"], "C");
+    EXPECT_EQ(events[3]["args"]["value"], 4096);
+    EXPECT_EQ(events[4]["ph"], "E");
+    for (auto& e : events)
+    {
+        EXPECT_EQ(e["pid"], 1);
+        EXPECT_TRUE(e.contains("ts"));
+    }
+    EXPECT_LE(events[0]["ts"].get<double>(), events[4]["ts"].get<double>());
+}
+
+TEST(TraceRecorder, RingKeepsMostRecentEvents)
+{
+    TraceRecorder r;
+    r.SetEnabled(true);
+    const size_t total = TraceRecorder::RingCapacity + 100;
+    for (size_t i = 0; i < total; i++)
+        r.Counter("n", static_cast<int64_t>(i));
+    EXPECT_EQ(r.BufferedOnThisThread(), TraceRecorder::RingCapacity);
+
+    auto events = Dump(r)["traceEvents"];
+    ASSERT_EQ(events.size(), TraceRecorder::RingCapacity);
+    EXPECT_EQ(events.front()["args"]["value"], 100);
+    EXPECT_EQ(events.back()["args"]["value"], static_cast<int64_t>(total - 1));
+}
+
+TEST(TraceRecorder, EachThreadGetsItsOwnTrack)
+{
+    TraceRecorder r;
+    r.SetEnabled(true);
+    TraceRecorder::SetThreadName("main");
+    r.Instant("on main");
+    std::thread worker([&] {
+        TraceRecorder::SetThreadName("worker");
+        for (int i = 0; i < 10; i++) r.Instant("on worker");
+    });
+    worker.join();
+
+    auto events = Dump(r)["traceEvents"];
+    int mainEvents = 0, workerEvents = 0, names = 0;
+    for (auto& e : events)
+    {
+        if (e["ph"] == "M") { names++; continue; }
+        (e["tid"] == 1 ? mainEvents : workerEvents)++;
+    }
+    EXPECT_EQ(names, 2);
+    EXPECT_EQ(mainEvents, 1);
+    EXPECT_EQ(workerEvents, 10);
+    TraceRecorder::SetThreadName(nullptr);
+}
+
+TEST(TraceRecorder, ReenablingStartsFreshSession)
+{
+    TraceRecorder r;
+    r.SetEnabled(true);
+    r.Instant("old");
+    r.SetEnabled(false);
+    r.Instant("dropped");
+    r.SetEnabled(true);
+    r.Instant("new");
+    auto events = Dump(r)["traceEvents"];
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0]["name"], "new");
+    EXPECT_TRUE(r.IsEnabled()); // WriteJson restores the recording state
+}
+
+TEST(TraceRecorder, EscapesDynamicNames)
+{
+    TraceRecorder r;
+    r.SetEnabled(true);
+    r.Instant("msg", r.Intern("we\"ird\\type\n"));
+    auto events = Dump(r)["traceEvents"];
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0]["args"]["detail"], "we\"ird\\type\n");
+    EXPECT_EQ(r.Intern("x"), r.Intern(std::string("x")));
+}
+
+TEST(TraceRecorder, InternCacheReturnsStableCopies)
+{
+    TraceRecorder r;
+    TraceInternCache cache(r);
+    EXPECT_EQ(cache.Get("state_update"), nullptr); // off: nothing interned
+
+    r.SetEnabled(true);
+    std::string type = "state_update";
+    const char* first = cache.Get(type);
+    type = "stats_response";
+    const char* other = cache.Get(type);
+    ASSERT_NE(first, nullptr);
+    EXPECT_STREQ(first, "state_update");
+    EXPECT_STREQ(other, "stats_response");
+    EXPECT_EQ(cache.Get(std::string("state_update")), first);
+    EXPECT_EQ(r.Intern("state_update"), first);
+}
+
+TEST(TraceRecorder, WriteJsonSeesOnlyCompleteEvents)
+{
+    // A producer racing WriteJson: every dumped event must be whole
+    TraceRecorder r;
+    r.SetEnabled(true);
+    std::atomic<int> pushed{ 0 };
+    std::atomic<bool> stop{ false };
+    std::thread producer([&] {
+        for (int i = 0; i < 20000 && !stop.load(); i++)
+        {
+            r.Complete("work", 1000, 3000, "detail");
+            pushed.store(i + 1);
+        }
+    });
+    while (pushed.load() == 0) std::this_thread::yield();
+    for (int i = 0; i < 5; i++)
+    {
+        for (auto& e : Dump(r)["traceEvents"])
+        {
+            if (e["ph"] == "M") continue;
+            EXPECT_EQ(e["name"], "work");
+            EXPECT_EQ(e["args"]["detail"], "detail");
+            EXPECT_DOUBLE_EQ(e["dur"].get<double>(), 2.0);
+        }
+    }
+    stop = true;
+    producer.join();
+}